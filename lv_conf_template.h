@@ -94,6 +94,23 @@ typedef int16_t lv_coord_t;
 
 /* Automatically defrag. on free. Defrag. means joining the adjacent free cells. */
 #  define LV_MEM_AUTO_DEFRAG  1
+
+/* 1: Defrag. incrementally instead of joining all the free cells in every 16th `lv_mem_free`.
+ * The following free cells are joined on free, the passed free cells while searching on allocation
+ * and an `lv_task` joins the rest in small steps (`lv_mem_defrag_step()`). Not used with `LV_MEM_TLSF`. */
+#  define LV_MEM_DEFRAG_INCREMENTAL 0
+#  if LV_MEM_DEFRAG_INCREMENTAL
+/* Period of the defrag. task in milliseconds */
+#    define LV_MEM_DEFRAG_PERIOD    50
+/* Maximal number of cells checked in a run of the task or joined in an `lv_mem_alloc/free` to keep the pauses short */
+#    define LV_MEM_DEFRAG_STEP      64
+#  endif
+
+/* 1: Use a two-level segregated fit (TLSF) allocator. It allocates and frees in constant time,
+ * joins the adjacent free blocks immediately (no defrag. is required)
+ * and more memory pools can be added with `lv_mem_add_pool()`.
+ * It needs about 2 kB static RAM for the free lists. */
+#  define LV_MEM_TLSF         0
 #else       /*LV_MEM_CUSTOM*/
 #  define LV_MEM_CUSTOM_INCLUDE <stdlib.h>   /*Header for the dynamic memory function*/
 #  define LV_MEM_CUSTOM_ALLOC   malloc       /*Wrapper to malloc*/
@@ -104,6 +121,77 @@ typedef int16_t lv_coord_t;
  * The standard functions might or might not be faster depending on their implementation. */
 #define LV_MEMCPY_MEMSET_STD    0
 
+/* 1: Get the temporary buffers of drawing (`_lv_mem_buf_get()`) from a static arena
+ * by simply bumping a pointer instead of using `lv_mem_alloc`.
+ * The buffers are given back in reverse order and the arena is reset after every refresh.
+ * Buffers which don't fit are still allocated with `lv_mem_alloc`.
+ * Read the high-water mark with `lv_mem_buf_get_stat()` to set the size exactly. */
+#define LV_MEM_BUF_ARENA        0
+#if LV_MEM_BUF_ARENA
+/* Size of the arena in bytes. A few lines of pixels and masks are enough for most of the drawings. */
+#  define LV_MEM_BUF_ARENA_SIZE (LV_HOR_RES_MAX * 16)
+#endif
+
+/* Maximal number of screens with their own arena at the same time. 0: disable the screen arenas.
+ * All the objects, `ext_attr`s and style lists of a screen created by `lv_obj_create_scr_arena()`
+ * are allocated from one block of `lv_mem_alloc`, so deleting the screen frees them at once.
+ * The objects are still notified about the deletion one by one.
+ * Can't be used with `LV_ENABLE_GC`. */
+#define LV_MEM_ARENA_CNT        0
+
+/* 1: Serve the small allocations of `lv_mem_alloc` (objects, `ext_attr`, style lists, etc.)
+ * from fixed size pools (16..160 bytes) in a dedicated memory area.
+ * The area is divided into pages which are assigned to the pools on demand.
+ * It keeps the heap unfragmented and makes creating and deleting objects faster.
+ * The allocations fall back to the heap if the area is full.
+ * Read the usage of the pools with `lv_mem_slab_get_stat()`. Can't be used with `LV_ENABLE_GC`. */
+#define LV_MEM_SLAB             0
+#if LV_MEM_SLAB
+/* Size of the memory area of the pools in bytes */
+#  define LV_MEM_SLAB_SIZE      (8U * 1024U)
+#endif
+
+/* 1: Record the owner of every allocation of `lv_mem` (e.g. objects, styles, texts, image cache, fonts)
+ * to show the live bytes and the high-water mark per owner and per object type
+ * and to find the leaks between two snapshots. See `lv_mem_prof_dump()`.
+ * It adds a header to every allocation. Can't be used with `LV_ENABLE_GC`. */
+#define LV_MEM_PROFILER         0
+#if LV_MEM_PROFILER
+/* 1: Record the address of the function which called `lv_mem_alloc` too (GCC and Clang only) */
+#  define LV_MEM_PROFILER_CALLER 0
+#endif
+
+/* 1: Make `lv_mem_alloc/free/realloc`, `_lv_mem_buf_get/release` and the memory profiler callable from several threads
+ * (e.g. for parallel rendering or background image decoding).
+ * The heap is protected by a lock and every thread keeps a few freed small blocks in its own cache
+ * to allocate and free most of the small blocks without the lock.
+ * It adds a header to every allocation. Can't be used with `LV_ENABLE_GC`. */
+#define LV_MEM_THREAD_SAFE      0
+#if LV_MEM_THREAD_SAFE
+/* Number of freed blocks cached per size class (16, 32, 64 and 128 bytes) in every thread. 0: always use the lock */
+#  define LV_MEM_THREAD_CACHE_CNT   8
+
+/* Storage class of the per thread variables, e.g. `_Thread_local` in C11 or `__thread` with GCC and Clang */
+#  define LV_MEM_THREAD_LOCAL       __thread
+
+/* 1: Use custom lock functions instead of the built-in spin lock (which needs GCC or Clang) */
+#  define LV_MEM_LOCK_CUSTOM        0
+#  if LV_MEM_LOCK_CUSTOM
+#    define LV_MEM_LOCK_CUSTOM_INCLUDE <stdint.h>   /*Header for the lock functions*/
+#    define LV_MEM_LOCK_CUSTOM_LOCK    my_mem_lock  /*Lock the heap: `void my_mem_lock(void)`*/
+#    define LV_MEM_LOCK_CUSTOM_UNLOCK  my_mem_unlock /*Unlock the heap: `void my_mem_unlock(void)`*/
+#  endif
+#endif
+
+/* 1: Measure how long `lv_mem_alloc/free/realloc` and the defrag. run and collect a histogram of the durations
+ * to see the longest pauses caused by the memory manager. See `lv_mem_pause_get_stat()`. */
+#define LV_MEM_PAUSE_HIST       0
+#if LV_MEM_PAUSE_HIST
+/* A clock with fine resolution, e.g. microseconds or CPU cycles. The histogram is in its unit. */
+#  define LV_MEM_PAUSE_HIST_INCLUDE   <stdint.h>    /*Header for the clock function*/
+#  define LV_MEM_PAUSE_HIST_TIME_EXPR (my_us_get()) /*Expression evaluating to the current time as `uint32_t`*/
+#endif
+
 /* Garbage Collector settings
  * Used if lvgl is binded to higher level language and the memory is managed by that language */
 #define LV_ENABLE_GC 0
@@ -184,6 +272,11 @@ typedef void * lv_anim_user_data_t;
 /* 1: Use image zoom and rotation*/
 #define LV_USE_IMG_TRANSFORM    1
 
+/* Size of the buffer in bytes to keep the source rows of the images
+ * which are zoomed or rotated but can be read only line-by-line (e.g. files).
+ * Such images are drawn in tiles whose source rows fit into this buffer.*/
+#define LV_IMG_TRANSFORM_ROW_CACHE_SIZE  (4 * 1024)
+
 /* 1: Enable object groups (for keyboard/encoder navigation) */
 #define LV_USE_GROUP            1
 #if LV_USE_GROUP
@@ -217,6 +310,25 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h" */
 typedef void * lv_fs_drv_user_data_t;
 #endif
 
+/* 1: Cache the reads of the files opened for reading in blocks.
+ * The small reads and the seeks (e.g. image rows, fonts) are served from RAM instead of calling the driver.
+ * Useful if every access to the storage has a large latency (e.g. SD card, SPI flash).
+ * The block size and count can be changed per driver in `lv_fs_drv_t` */
+#define LV_FS_CACHE                 0
+#if LV_FS_CACHE
+#define LV_FS_CACHE_BLOCK_SIZE      512     /*Default size of a block [bytes]*/
+#define LV_FS_CACHE_BLOCK_CNT       4       /*Default number of blocks of an opened file*/
+#define LV_FS_CACHE_READAHEAD       2       /*Number of blocks to read at once when a file is read sequentially*/
+#endif
+
+/* 1: Register a POSIX drive which memory maps the files (`mmap`).
+ * The image decoder and the lazy font loader use the mapped data directly without copying it.*/
+#define LV_USE_FS_MMAP              0
+#if LV_USE_FS_MMAP
+#define LV_FS_MMAP_LETTER           'M'     /*Letter of the drive, e.g. "M:folder/img.bin"*/
+#define LV_FS_MMAP_PATH             ""      /*Prefix of the paths. E.g. "/" to use absolute paths*/
+#endif
+
 /*1: Add a `user_data` to drivers and objects*/
 #define LV_USE_USER_DATA        0
 
@@ -237,6 +349,13 @@ typedef void * lv_fs_drv_user_data_t;
 /* 1: Enable alpha indexed images */
 #define LV_IMG_CF_ALPHA         1
 
+/* 1: Enable the run-length encoded true color images (`LV_IMG_CF_RLE_...`)*/
+#define LV_IMG_CF_RLE           1
+
+/* 1: Decode the whole RLE image when it's opened and keep it in the image cache.
+ * 0: Decode only the drawn lines of the RLE images. Requires less RAM but slower.*/
+#define LV_IMG_RLE_DECODE_FULL  0
+
 /* Default image cache size. Image caching keeps the images opened.
  * If only the built-in image formats are used there is no real advantage of caching.
  * (I.e. no new image decoder is added)
@@ -245,6 +364,25 @@ typedef void * lv_fs_drv_user_data_t;
  * Set it to 0 to disable caching */
 #define LV_IMG_CACHE_DEF_SIZE       1
 
+/* Default memory budget of the image cache in bytes.
+ * The decoders report (or the cache estimates) how much memory an opened image keeps allocated
+ * and the least recently used images are closed if the sum exceeds this limit.
+ * Set it to 0 to limit only the number of cached images */
+#define LV_IMG_CACHE_DEF_MEM_LIMIT  0
+
+/* 1: Open the file images and the images of custom decoders (`LV_IMG_CF_RAW...`) in an `lv_task`
+ * instead of during rendering. Until an image is opened a placeholder is drawn
+ * (see `lv_img_cache_set_placeholder()`) and the image's area is invalidated when it's ready.
+ * An image is decoded in one run of the task unless a worker thread is set by `lv_img_cache_set_worker()`.
+ * Requires LV_IMG_CACHE_DEF_SIZE > 0 */
+#define LV_IMG_CACHE_ASYNC          0
+
+/* 1: Generate downscaled versions (1/2, 1/4, ...) of the cached true color images
+ * when they are drawn zoomed out and draw the level closest to the zoom.
+ * The levels are counted in the memory budget of the cache.
+ * Requires LV_IMG_CACHE_DEF_SIZE > 0 and LV_USE_IMG_TRANSFORM = 1 */
+#define LV_IMG_CACHE_MIPMAP         0
+
 /*Declare the type of the user data of image decoder (can be e.g. `void *`, `int`, `struct`)*/
 typedef void * lv_img_decoder_user_data_t;
 
@@ -360,7 +498,8 @@ typedef void * lv_indev_drv_user_data_t;            /*Type of user data in the i
  * If disabled `LV_USE_ASSERT_NULL` will be performed instead (if it's enabled) */
 #define LV_USE_ASSERT_STR       0
 
-/* Check NULL, the object's type and existence (e.g. not deleted). (Quite slow)
+/* Check NULL, the object's type and existence (e.g. not deleted).
+ * (Fast: the live objects are stored in a hash table which needs about 2 pointers per object)
  * If disabled `LV_USE_ASSERT_NULL` will be performed instead (if it's enabled) */
 #define LV_USE_ASSERT_OBJ       0
 
@@ -432,6 +571,11 @@ typedef void * lv_indev_drv_user_data_t;            /*Type of user data in the i
  */
 #define LV_USE_FONT_COMPRESSED 1
 
+/* Number of resolved letter -> font pairs to cache for fonts with `fallback` fonts.
+ * Without it the letters missing from a font are searched in every fallback font again
+ * each time they are drawn or measured. 0: disable the cache*/
+#define LV_FONT_FALLBACK_CACHE_SIZE 64
+
 /* Enable subpixel rendering */
 #define LV_USE_FONT_SUBPX 1
 #if LV_USE_FONT_SUBPX
@@ -514,6 +658,19 @@ typedef void * lv_font_user_data_t;
 /* The control character to use for signalling text recoloring. */
 #define LV_TXT_COLOR_CMD "#"
 
+/* Size of a temporary buffer [bytes] where the letters of a text line are rendered
+ * to blend them with one call per row instead of one call per letter.
+ * Lines requiring more memory (clip area width x line height) are drawn letter by letter
+ * and so are all lines if the buffer can't be allocated.
+ * Set it to 0 to always draw letter by letter. */
+#define LV_TXT_LINE_BATCH_BUF_SIZE          (8U * 1024U)
+
+/* Number of fonts whose advance width of the printable ASCII letters (0x20-0x7E) are cached
+ * to measure texts without getting the glyph descriptor of every letter.
+ * The fonts are stored in 4-way sets (rounded up) and the least recently used one is replaced.
+ * Each font needs ~128 bytes. Set it to 0 to always use the glyph descriptors. */
+#define LV_TXT_ASCII_WIDTH_CACHE_SIZE       4
+
 /* Support bidirectional texts.
  * Allows mixing Left-to-Right and Right-to-Left texts.
  * The direction will be processed according to the Unicode Bidirectional Algorithm:
@@ -568,6 +725,13 @@ typedef void * lv_obj_user_data_t;
  */
 #define LV_USE_EXT_CLICK_AREA  LV_EXT_CLICK_AREA_TINY
 
+/* 1: Move the rarely used attributes of the objects (event callback, group, user data,
+ * realign parameters and extra click area) to a side table allocated only when one of them is set.
+ * It makes the objects smaller but setting any of these attributes costs an extra allocation.
+ * Note that `lv_obj_align()` saves the parameters for `lv_obj_realign()` only if the object already has a side table
+ * so call `lv_obj_set_auto_realign()` before `lv_obj_align()`.*/
+#define LV_OBJ_SIDE_TABLE       0
+
 /*==================
  *  LV OBJ X USAGE
  *================*/
@@ -0,0 +1,191 @@
+#!/usr/bin/env python3
+
+'''
+Convert images to LVGL's true color image formats, optionally run-length encoded (LV_IMG_CF_RLE_...).
+The output is either a C file with an `lv_img_dsc_t` or a binary file to load with `lv_fs`.
+Requires Pillow: pip install Pillow
+Example: python3 img_conv_rle.py logo.png --cf TRUE_COLOR_ALPHA --rle -o logo.c
+'''
+
+import argparse
+import os
+import struct
+import sys
+
+if sys.version_info < (3,6,0):
+  print("Python >=3.6 is required", file=sys.stderr)
+  exit(1)
+
+CF = {
+  "TRUE_COLOR": 4,
+  "TRUE_COLOR_ALPHA": 5,
+  "TRUE_COLOR_CHROMA_KEYED": 6,
+}
+CF_RLE_OFS = 11           # LV_IMG_CF_RLE_TRUE_COLOR - LV_IMG_CF_TRUE_COLOR
+RLE_RUN = 0x80            # LV_IMG_RLE_RUN
+RLE_MAX = 128             # Max. pixels in a packet
+CHROMA_KEY = (0, 0xFF, 0) # LV_COLOR_TRANSP (lime)
+
+def color_bytes(r, g, b, depth):
+  '''Convert an RGB color to the byte order of `lv_color_t`'''
+  if depth == "8":
+    return bytes([(r & 0xE0) | ((g >> 3) & 0x1C) | (b >> 6)])
+  if depth == "16" or depth == "16swap":
+    c = ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3)
+    return struct.pack(">H" if depth == "16swap" else "<H", c)
+  return bytes([b, g, r, 0xFF])
+
+def convert_pixels(img, cf, depth):
+  '''Get the rows of the image as lists of pixels (bytes)'''
+  w, h = img.size
+  px = img.convert("RGBA").load()
+  rows = []
+  for y in range(h):
+    row = []
+    for x in range(w):
+      r, g, b, a = px[x, y]
+      if cf == "TRUE_COLOR_CHROMA_KEYED" and a < 128:
+        r, g, b = CHROMA_KEY
+      c = color_bytes(r, g, b, depth)
+      if cf == "TRUE_COLOR_ALPHA":
+        c += bytes([a])
+      row.append(c)
+    rows.append(row)
+  return rows
+
+def rle_encode_row(row):
+  '''Encode a row as packets: runs of 2 or more equal pixels and literal blocks in between'''
+  out = bytearray()
+  x = 0
+  w = len(row)
+  while x < w:
+    run = 1
+    while x + run < w and run < RLE_MAX and row[x + run] == row[x]:
+      run += 1
+    if run >= 2:
+      out.append(RLE_RUN | (run - 1))
+      out += row[x]
+      x += run
+    else:
+      lit = 1
+      while x + lit < w and lit < RLE_MAX and (x + lit + 1 >= w or row[x + lit] != row[x + lit + 1]):
+        lit += 1
+      out.append(lit - 1)
+      for p in row[x:x + lit]:
+        out += p
+      x += lit
+  return out
+
+def rle_encode(rows):
+  '''Prepend the little endian row offsets to the encoded rows'''
+  table = bytearray()
+  data = bytearray()
+  for y, row in enumerate(rows):
+    table += struct.pack("<I", len(data))
+    enc = rle_encode_row(row)
+    dec = rle_decode_row(enc, len(row[0]), len(row))
+    if dec != row:
+      x = next((i for i, (a, b) in enumerate(zip(dec, row)) if a != b), min(len(dec), len(row)))
+      raise ValueError("RLE round trip failed in row %d at pixel %d (data offset %d)" % (y, x, len(data)))
+    data += enc
+  table += struct.pack("<I", len(data))
+  return bytes(table + data)
+
+def rle_decode_row(data, px_size, w):
+  '''Decode a row like `rle_decode_line()` of the built-in decoder. Used to verify the encoder'''
+  out = []
+  i = 0
+  while len(out) < w:
+    ctrl = data[i]
+    i += 1
+    cnt = (ctrl & ~RLE_RUN) + 1
+    if ctrl & RLE_RUN:
+      out += [data[i:i + px_size]] * cnt
+      i += px_size
+    else:
+      for _ in range(cnt):
+        out.append(data[i:i + px_size])
+        i += px_size
+  return out
+
+def encode(rows, rle):
+  if rle:
+    return rle_encode(rows)
+  return b"".join(b"".join(row) for row in rows)
+
+def header_bytes(cf, w, h):
+  return struct.pack("<I", cf | (w << 10) | (h << 21))
+
+def c_array(data):
+  lines = []
+  for i in range(0, len(data), 16):
+    lines.append("  " + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",")
+  return "\n".join(lines)
+
+def write_c(path, name, img, cf, rle):
+  w, h = img.size
+  cf_name = "LV_IMG_CF_" + ("RLE_" if rle else "") + cf
+  maps = [("LV_COLOR_DEPTH == 1 || LV_COLOR_DEPTH == 8", "8"),
+          ("LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP == 0", "16"),
+          ("LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP != 0", "16swap"),
+          ("LV_COLOR_DEPTH == 32", "32")]
+
+  out = []
+  out.append('#include "lvgl/lvgl.h"\n')
+  out.append("#ifndef LV_ATTRIBUTE_MEM_ALIGN\n#define LV_ATTRIBUTE_MEM_ALIGN\n#endif\n")
+  out.append("const LV_ATTRIBUTE_MEM_ALIGN uint8_t %s_map[] = {" % name)
+  for cond, depth in maps:
+    out.append("#if %s" % cond)
+    out.append(c_array(encode(convert_pixels(img, cf, depth), rle)))
+    out.append("#endif")
+  out.append("};\n")
+  out.append("const lv_img_dsc_t %s = {" % name)
+  out.append("  .header.always_zero = 0,")
+  out.append("  .header.w = %d," % w)
+  out.append("  .header.h = %d," % h)
+  out.append("  .data_size = sizeof(%s_map)," % name)
+  out.append("  .header.cf = %s," % cf_name)
+  out.append("  .data = %s_map," % name)
+  out.append("};\n")
+
+  with open(path, "w") as f:
+    f.write("\n".join(out))
+
+def write_bin(path, img, cf, depth, rle):
+  w, h = img.size
+  cf_id = CF[cf] + (CF_RLE_OFS if rle else 0)
+  with open(path, "wb") as f:
+    f.write(header_bytes(cf_id, w, h))
+    f.write(encode(convert_pixels(img, cf, depth), rle))
+
+def main():
+  parser = argparse.ArgumentParser(description="Convert images to LVGL true color or RLE compressed images. Requires Pillow.")
+  parser.add_argument("image", help="The image to convert. E.g. logo.png")
+  parser.add_argument("--cf", choices=CF.keys(), default="TRUE_COLOR", help="Color format")
+  parser.add_argument("--rle", action="store_true", help="Run-length encode the pixels")
+  parser.add_argument("--depth", choices=["8", "16", "16swap", "32"], default="16",
+                      help="Color depth of binary files. C files contain all depths")
+  parser.add_argument("-o", "--output", required=True, help="Output file: *.c or *.bin")
+  parser.add_argument("--name", help="Name of the C variable. Default: the name of the output file")
+  args = parser.parse_args()
+
+  try:
+    from PIL import Image
+  except ImportError:
+    print("Pillow is required: pip install Pillow", file=sys.stderr)
+    exit(1)
+
+  img = Image.open(args.image)
+  w, h = img.size
+  if w >= 2048 or h >= 2048:
+    print("The image must be smaller than 2048x2048", file=sys.stderr)
+    exit(1)
+
+  if args.output.endswith(".bin"):
+    write_bin(args.output, img, args.cf, args.depth, args.rle)
+  else:
+    name = args.name or os.path.splitext(os.path.basename(args.output))[0]
+    write_c(args.output, name, img, args.cf, args.rle)
+
+if __name__ == "__main__":
+  main()
@@ -231,6 +231,47 @@
 #    define  LV_MEM_AUTO_DEFRAG  1
 #  endif
 #endif
+
+/* 1: Defrag. incrementally instead of joining all the free cells in every 16th `lv_mem_free`.
+ * The following free cells are joined on free, the passed free cells while searching on allocation
+ * and an `lv_task` joins the rest in small steps (`lv_mem_defrag_step()`). Not used with `LV_MEM_TLSF`. */
+#ifndef LV_MEM_DEFRAG_INCREMENTAL
+#  ifdef CONFIG_LV_MEM_DEFRAG_INCREMENTAL
+#    define LV_MEM_DEFRAG_INCREMENTAL CONFIG_LV_MEM_DEFRAG_INCREMENTAL
+#  else
+#    define  LV_MEM_DEFRAG_INCREMENTAL 0
+#  endif
+#endif
+#  if LV_MEM_DEFRAG_INCREMENTAL
+/* Period of the defrag. task in milliseconds */
+#ifndef LV_MEM_DEFRAG_PERIOD
+#  ifdef CONFIG_LV_MEM_DEFRAG_PERIOD
+#    define LV_MEM_DEFRAG_PERIOD CONFIG_LV_MEM_DEFRAG_PERIOD
+#  else
+#    define  LV_MEM_DEFRAG_PERIOD    50
+#  endif
+#endif
+/* Maximal number of cells checked in a run of the task or joined in an `lv_mem_alloc/free` to keep the pauses short */
+#ifndef LV_MEM_DEFRAG_STEP
+#  ifdef CONFIG_LV_MEM_DEFRAG_STEP
+#    define LV_MEM_DEFRAG_STEP CONFIG_LV_MEM_DEFRAG_STEP
+#  else
+#    define  LV_MEM_DEFRAG_STEP      64
+#  endif
+#endif
+#  endif
+
+/* 1: Use a two-level segregated fit (TLSF) allocator. It allocates and frees in constant time,
+ * joins the adjacent free blocks immediately (no defrag. is required)
+ * and more memory pools can be added with `lv_mem_add_pool()`.
+ * It needs about 2 kB static RAM for the free lists. */
+#ifndef LV_MEM_TLSF
+#  ifdef CONFIG_LV_MEM_TLSF
+#    define LV_MEM_TLSF CONFIG_LV_MEM_TLSF
+#  else
+#    define  LV_MEM_TLSF         0
+#  endif
+#endif
 #else       /*LV_MEM_CUSTOM*/
 #ifndef LV_MEM_CUSTOM_INCLUDE
 #  ifdef CONFIG_LV_MEM_CUSTOM_INCLUDE
@@ -265,6 +306,179 @@
 #  endif
 #endif
 
+/* 1: Get the temporary buffers of drawing (`_lv_mem_buf_get()`) from a static arena
+ * by simply bumping a pointer instead of using `lv_mem_alloc`.
+ * The buffers are given back in reverse order and the arena is reset after every refresh.
+ * Buffers which don't fit are still allocated with `lv_mem_alloc`.
+ * Read the high-water mark with `lv_mem_buf_get_stat()` to set the size exactly. */
+#ifndef LV_MEM_BUF_ARENA
+#  ifdef CONFIG_LV_MEM_BUF_ARENA
+#    define LV_MEM_BUF_ARENA CONFIG_LV_MEM_BUF_ARENA
+#  else
+#    define  LV_MEM_BUF_ARENA        0
+#  endif
+#endif
+#if LV_MEM_BUF_ARENA
+/* Size of the arena in bytes. A few lines of pixels and masks are enough for most of the drawings. */
+#ifndef LV_MEM_BUF_ARENA_SIZE
+#  ifdef CONFIG_LV_MEM_BUF_ARENA_SIZE
+#    define LV_MEM_BUF_ARENA_SIZE CONFIG_LV_MEM_BUF_ARENA_SIZE
+#  else
+#    define  LV_MEM_BUF_ARENA_SIZE (LV_HOR_RES_MAX * 16)
+#  endif
+#endif
+#endif
+
+/* Maximal number of screens with their own arena at the same time. 0: disable the screen arenas.
+ * All the objects, `ext_attr`s and style lists of a screen created by `lv_obj_create_scr_arena()`
+ * are allocated from one block of `lv_mem_alloc`, so deleting the screen frees them at once.
+ * The objects are still notified about the deletion one by one.
+ * Can't be used with `LV_ENABLE_GC`. */
+#ifndef LV_MEM_ARENA_CNT
+#  ifdef CONFIG_LV_MEM_ARENA_CNT
+#    define LV_MEM_ARENA_CNT CONFIG_LV_MEM_ARENA_CNT
+#  else
+#    define  LV_MEM_ARENA_CNT        0
+#  endif
+#endif
+
+/* 1: Serve the small allocations of `lv_mem_alloc` (objects, `ext_attr`, style lists, etc.)
+ * from fixed size pools (16..160 bytes) in a dedicated memory area.
+ * The area is divided into pages which are assigned to the pools on demand.
+ * It keeps the heap unfragmented and makes creating and deleting objects faster.
+ * The allocations fall back to the heap if the area is full.
+ * Read the usage of the pools with `lv_mem_slab_get_stat()`. Can't be used with `LV_ENABLE_GC`. */
+#ifndef LV_MEM_SLAB
+#  ifdef CONFIG_LV_MEM_SLAB
+#    define LV_MEM_SLAB CONFIG_LV_MEM_SLAB
+#  else
+#    define  LV_MEM_SLAB             0
+#  endif
+#endif
+#if LV_MEM_SLAB
+/* Size of the memory area of the pools in bytes */
+#ifndef LV_MEM_SLAB_SIZE
+#  ifdef CONFIG_LV_MEM_SLAB_SIZE
+#    define LV_MEM_SLAB_SIZE CONFIG_LV_MEM_SLAB_SIZE
+#  else
+#    define  LV_MEM_SLAB_SIZE      (8U * 1024U)
+#  endif
+#endif
+#endif
+
+/* 1: Record the owner of every allocation of `lv_mem` (e.g. objects, styles, texts, image cache, fonts)
+ * to show the live bytes and the high-water mark per owner and per object type
+ * and to find the leaks between two snapshots. See `lv_mem_prof_dump()`.
+ * It adds a header to every allocation. Can't be used with `LV_ENABLE_GC`. */
+#ifndef LV_MEM_PROFILER
+#  ifdef CONFIG_LV_MEM_PROFILER
+#    define LV_MEM_PROFILER CONFIG_LV_MEM_PROFILER
+#  else
+#    define  LV_MEM_PROFILER         0
+#  endif
+#endif
+#if LV_MEM_PROFILER
+/* 1: Record the address of the function which called `lv_mem_alloc` too (GCC and Clang only) */
+#ifndef LV_MEM_PROFILER_CALLER
+#  ifdef CONFIG_LV_MEM_PROFILER_CALLER
+#    define LV_MEM_PROFILER_CALLER CONFIG_LV_MEM_PROFILER_CALLER
+#  else
+#    define  LV_MEM_PROFILER_CALLER 0
+#  endif
+#endif
+#endif
+
+/* 1: Make `lv_mem_alloc/free/realloc`, `_lv_mem_buf_get/release` and the memory profiler callable from several threads
+ * (e.g. for parallel rendering or background image decoding).
+ * The heap is protected by a lock and every thread keeps a few freed small blocks in its own cache
+ * to allocate and free most of the small blocks without the lock.
+ * It adds a header to every allocation. Can't be used with `LV_ENABLE_GC`. */
+#ifndef LV_MEM_THREAD_SAFE
+#  ifdef CONFIG_LV_MEM_THREAD_SAFE
+#    define LV_MEM_THREAD_SAFE CONFIG_LV_MEM_THREAD_SAFE
+#  else
+#    define  LV_MEM_THREAD_SAFE      0
+#  endif
+#endif
+#if LV_MEM_THREAD_SAFE
+/* Number of freed blocks cached per size class (16, 32, 64 and 128 bytes) in every thread. 0: always use the lock */
+#ifndef LV_MEM_THREAD_CACHE_CNT
+#  ifdef CONFIG_LV_MEM_THREAD_CACHE_CNT
+#    define LV_MEM_THREAD_CACHE_CNT CONFIG_LV_MEM_THREAD_CACHE_CNT
+#  else
+#    define  LV_MEM_THREAD_CACHE_CNT   8
+#  endif
+#endif
+
+/* Storage class of the per thread variables, e.g. `_Thread_local` in C11 or `__thread` with GCC and Clang */
+#ifndef LV_MEM_THREAD_LOCAL
+#  ifdef CONFIG_LV_MEM_THREAD_LOCAL
+#    define LV_MEM_THREAD_LOCAL CONFIG_LV_MEM_THREAD_LOCAL
+#  else
+#    define  LV_MEM_THREAD_LOCAL       __thread
+#  endif
+#endif
+
+/* 1: Use custom lock functions instead of the built-in spin lock (which needs GCC or Clang) */
+#ifndef LV_MEM_LOCK_CUSTOM
+#  ifdef CONFIG_LV_MEM_LOCK_CUSTOM
+#    define LV_MEM_LOCK_CUSTOM CONFIG_LV_MEM_LOCK_CUSTOM
+#  else
+#    define  LV_MEM_LOCK_CUSTOM        0
+#  endif
+#endif
+#  if LV_MEM_LOCK_CUSTOM
+#ifndef LV_MEM_LOCK_CUSTOM_INCLUDE
+#  ifdef CONFIG_LV_MEM_LOCK_CUSTOM_INCLUDE
+#    define LV_MEM_LOCK_CUSTOM_INCLUDE CONFIG_LV_MEM_LOCK_CUSTOM_INCLUDE
+#  else
+#    define  LV_MEM_LOCK_CUSTOM_INCLUDE <stdint.h>   /*Header for the lock functions*/
+#  endif
+#endif
+#ifndef LV_MEM_LOCK_CUSTOM_LOCK
+#  ifdef CONFIG_LV_MEM_LOCK_CUSTOM_LOCK
+#    define LV_MEM_LOCK_CUSTOM_LOCK CONFIG_LV_MEM_LOCK_CUSTOM_LOCK
+#  else
+#    define  LV_MEM_LOCK_CUSTOM_LOCK    my_mem_lock  /*Lock the heap: `void my_mem_lock(void)`*/
+#  endif
+#endif
+#ifndef LV_MEM_LOCK_CUSTOM_UNLOCK
+#  ifdef CONFIG_LV_MEM_LOCK_CUSTOM_UNLOCK
+#    define LV_MEM_LOCK_CUSTOM_UNLOCK CONFIG_LV_MEM_LOCK_CUSTOM_UNLOCK
+#  else
+#    define  LV_MEM_LOCK_CUSTOM_UNLOCK  my_mem_unlock /*Unlock the heap: `void my_mem_unlock(void)`*/
+#  endif
+#endif
+#  endif
+#endif
+
+/* 1: Measure how long `lv_mem_alloc/free/realloc` and the defrag. run and collect a histogram of the durations
+ * to see the longest pauses caused by the memory manager. See `lv_mem_pause_get_stat()`. */
+#ifndef LV_MEM_PAUSE_HIST
+#  ifdef CONFIG_LV_MEM_PAUSE_HIST
+#    define LV_MEM_PAUSE_HIST CONFIG_LV_MEM_PAUSE_HIST
+#  else
+#    define  LV_MEM_PAUSE_HIST       0
+#  endif
+#endif
+#if LV_MEM_PAUSE_HIST
+/* A clock with fine resolution, e.g. microseconds or CPU cycles. The histogram is in its unit. */
+#ifndef LV_MEM_PAUSE_HIST_INCLUDE
+#  ifdef CONFIG_LV_MEM_PAUSE_HIST_INCLUDE
+#    define LV_MEM_PAUSE_HIST_INCLUDE CONFIG_LV_MEM_PAUSE_HIST_INCLUDE
+#  else
+#    define  LV_MEM_PAUSE_HIST_INCLUDE   <stdint.h>    /*Header for the clock function*/
+#  endif
+#endif
+#ifndef LV_MEM_PAUSE_HIST_TIME_EXPR
+#  ifdef CONFIG_LV_MEM_PAUSE_HIST_TIME_EXPR
+#    define LV_MEM_PAUSE_HIST_TIME_EXPR CONFIG_LV_MEM_PAUSE_HIST_TIME_EXPR
+#  else
+#    define  LV_MEM_PAUSE_HIST_TIME_EXPR (my_us_get()) /*Expression evaluating to the current time as `uint32_t`*/
+#  endif
+#endif
+#endif
+
 /* Garbage Collector settings
  * Used if lvgl is binded to higher level language and the memory is managed by that language */
 #ifndef LV_ENABLE_GC
@@ -464,6 +678,17 @@
 #  endif
 #endif
 
+/* Size of the buffer in bytes to keep the source rows of the images
+ * which are zoomed or rotated but can be read only line-by-line (e.g. files).
+ * Such images are drawn in tiles whose source rows fit into this buffer.*/
+#ifndef LV_IMG_TRANSFORM_ROW_CACHE_SIZE
+#  ifdef CONFIG_LV_IMG_TRANSFORM_ROW_CACHE_SIZE
+#    define LV_IMG_TRANSFORM_ROW_CACHE_SIZE CONFIG_LV_IMG_TRANSFORM_ROW_CACHE_SIZE
+#  else
+#    define  LV_IMG_TRANSFORM_ROW_CACHE_SIZE  (4 * 1024)
+#  endif
+#endif
+
 /* 1: Enable object groups (for keyboard/encoder navigation) */
 #ifndef LV_USE_GROUP
 #  ifdef CONFIG_LV_USE_GROUP
@@ -543,6 +768,67 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h" */
 /*Declare the type of the user data of file system drivers (can be e.g. `void *`, `int`, `struct`)*/
 #endif
 
+/* 1: Cache the reads of the files opened for reading in blocks.
+ * The small reads and the seeks (e.g. image rows, fonts) are served from RAM instead of calling the driver.
+ * Useful if every access to the storage has a large latency (e.g. SD card, SPI flash).
+ * The block size and count can be changed per driver in `lv_fs_drv_t` */
+#ifndef LV_FS_CACHE
+#  ifdef CONFIG_LV_FS_CACHE
+#    define LV_FS_CACHE CONFIG_LV_FS_CACHE
+#  else
+#    define  LV_FS_CACHE                 0
+#  endif
+#endif
+#if LV_FS_CACHE
+#ifndef LV_FS_CACHE_BLOCK_SIZE
+#  ifdef CONFIG_LV_FS_CACHE_BLOCK_SIZE
+#    define LV_FS_CACHE_BLOCK_SIZE CONFIG_LV_FS_CACHE_BLOCK_SIZE
+#  else
+#    define  LV_FS_CACHE_BLOCK_SIZE      512     /*Default size of a block [bytes]*/
+#  endif
+#endif
+#ifndef LV_FS_CACHE_BLOCK_CNT
+#  ifdef CONFIG_LV_FS_CACHE_BLOCK_CNT
+#    define LV_FS_CACHE_BLOCK_CNT CONFIG_LV_FS_CACHE_BLOCK_CNT
+#  else
+#    define  LV_FS_CACHE_BLOCK_CNT       4       /*Default number of blocks of an opened file*/
+#  endif
+#endif
+#ifndef LV_FS_CACHE_READAHEAD
+#  ifdef CONFIG_LV_FS_CACHE_READAHEAD
+#    define LV_FS_CACHE_READAHEAD CONFIG_LV_FS_CACHE_READAHEAD
+#  else
+#    define  LV_FS_CACHE_READAHEAD       2       /*Number of blocks to read at once when a file is read sequentially*/
+#  endif
+#endif
+#endif
+
+/* 1: Register a POSIX drive which memory maps the files (`mmap`).
+ * The image decoder and the lazy font loader use the mapped data directly without copying it.*/
+#ifndef LV_USE_FS_MMAP
+#  ifdef CONFIG_LV_USE_FS_MMAP
+#    define LV_USE_FS_MMAP CONFIG_LV_USE_FS_MMAP
+#  else
+#    define  LV_USE_FS_MMAP              0
+#  endif
+#endif
+#if LV_USE_FS_MMAP
+#ifndef LV_FS_MMAP_LETTER
+#  ifdef CONFIG_LV_FS_MMAP_LETTER
+#    define LV_FS_MMAP_LETTER CONFIG_LV_FS_MMAP_LETTER
+#  else
+#    define  LV_FS_MMAP_LETTER           'M'     /*Letter of the drive, e.g. "M:folder/img.bin"*/
+#  endif
+#endif
+#ifndef LV_FS_MMAP_PATH
+#  ifdef CONFIG_LV_FS_MMAP_PATH
+#    define LV_FS_MMAP_PATH CONFIG_LV_FS_MMAP_PATH
+#  else
+#    define  LV_FS_MMAP_PATH             ""      /*Prefix of the paths. E.g. "/" to use absolute paths*/
+#  endif
+#endif
+#endif
+
 /*1: Add a `user_data` to drivers and objects*/
 #ifndef LV_USE_USER_DATA
 #  ifdef CONFIG_LV_USE_USER_DATA
@@ -599,6 +885,25 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h" */
 #  endif
 #endif
 
+/* 1: Enable the run-length encoded true color images (`LV_IMG_CF_RLE_...`)*/
+#ifndef LV_IMG_CF_RLE
+#  ifdef CONFIG_LV_IMG_CF_RLE
+#    define LV_IMG_CF_RLE CONFIG_LV_IMG_CF_RLE
+#  else
+#    define  LV_IMG_CF_RLE           1
+#  endif
+#endif
+
+/* 1: Decode the whole RLE image when it's opened and keep it in the image cache.
+ * 0: Decode only the drawn lines of the RLE images. Requires less RAM but slower.*/
+#ifndef LV_IMG_RLE_DECODE_FULL
+#  ifdef CONFIG_LV_IMG_RLE_DECODE_FULL
+#    define LV_IMG_RLE_DECODE_FULL CONFIG_LV_IMG_RLE_DECODE_FULL
+#  else
+#    define  LV_IMG_RLE_DECODE_FULL  0
+#  endif
+#endif
+
 /* Default image cache size. Image caching keeps the images opened.
  * If only the built-in image formats are used there is no real advantage of caching.
  * (I.e. no new image decoder is added)
@@ -613,6 +918,43 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h" */
 #  endif
 #endif
 
+/* Default memory budget of the image cache in bytes.
+ * The decoders report (or the cache estimates) how much memory an opened image keeps allocated
+ * and the least recently used images are closed if the sum exceeds this limit.
+ * Set it to 0 to limit only the number of cached images */
+#ifndef LV_IMG_CACHE_DEF_MEM_LIMIT
+#  ifdef CONFIG_LV_IMG_CACHE_DEF_MEM_LIMIT
+#    define LV_IMG_CACHE_DEF_MEM_LIMIT CONFIG_LV_IMG_CACHE_DEF_MEM_LIMIT
+#  else
+#    define  LV_IMG_CACHE_DEF_MEM_LIMIT  0
+#  endif
+#endif
+
+/* 1: Open the file images and the images of custom decoders (`LV_IMG_CF_RAW...`) in an `lv_task`
+ * instead of during rendering. Until an image is opened a placeholder is drawn
+ * (see `lv_img_cache_set_placeholder()`) and the image's area is invalidated when it's ready.
+ * An image is decoded in one run of the task unless a worker thread is set by `lv_img_cache_set_worker()`.
+ * Requires LV_IMG_CACHE_DEF_SIZE > 0 */
+#ifndef LV_IMG_CACHE_ASYNC
+#  ifdef CONFIG_LV_IMG_CACHE_ASYNC
+#    define LV_IMG_CACHE_ASYNC CONFIG_LV_IMG_CACHE_ASYNC
+#  else
+#    define  LV_IMG_CACHE_ASYNC          0
+#  endif
+#endif
+
+/* 1: Generate downscaled versions (1/2, 1/4, ...) of the cached true color images
+ * when they are drawn zoomed out and draw the level closest to the zoom.
+ * The levels are counted in the memory budget of the cache.
+ * Requires LV_IMG_CACHE_DEF_SIZE > 0 and LV_USE_IMG_TRANSFORM = 1 */
+#ifndef LV_IMG_CACHE_MIPMAP
+#  ifdef CONFIG_LV_IMG_CACHE_MIPMAP
+#    define LV_IMG_CACHE_MIPMAP CONFIG_LV_IMG_CACHE_MIPMAP
+#  else
+#    define  LV_IMG_CACHE_MIPMAP         0
+#  endif
+#endif
+
 /*Declare the type of the user data of image decoder (can be e.g. `void *`, `int`, `struct`)*/
 
 /*=====================
@@ -851,7 +1193,8 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h" */
 #  endif
 #endif
 
-/* Check NULL, the object's type and existence (e.g. not deleted). (Quite slow)
+/* Check NULL, the object's type and existence (e.g. not deleted).
+ * (Fast: the live objects are stored in a hash table which needs about 2 pointers per object)
  * If disabled `LV_USE_ASSERT_NULL` will be performed instead (if it's enabled) */
 #ifndef LV_USE_ASSERT_OBJ
 #  ifdef CONFIG_LV_USE_ASSERT_OBJ
@@ -1115,6 +1458,17 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h" */
 #  endif
 #endif
 
+/* Number of resolved letter -> font pairs to cache for fonts with `fallback` fonts.
+ * Without it the letters missing from a font are searched in every fallback font again
+ * each time they are drawn or measured. 0: disable the cache*/
+#ifndef LV_FONT_FALLBACK_CACHE_SIZE
+#  ifdef CONFIG_LV_FONT_FALLBACK_CACHE_SIZE
+#    define LV_FONT_FALLBACK_CACHE_SIZE CONFIG_LV_FONT_FALLBACK_CACHE_SIZE
+#  else
+#    define  LV_FONT_FALLBACK_CACHE_SIZE 64
+#  endif
+#endif
+
 /* Enable subpixel rendering */
 #ifndef LV_USE_FONT_SUBPX
 #  ifdef CONFIG_LV_USE_FONT_SUBPX
@@ -1322,6 +1676,31 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h" */
 #  endif
 #endif
 
+/* Size of a temporary buffer [bytes] where the letters of a text line are rendered
+ * to blend them with one call per row instead of one call per letter.
+ * Lines requiring more memory (clip area width x line height) are drawn letter by letter
+ * and so are all lines if the buffer can't be allocated.
+ * Set it to 0 to always draw letter by letter. */
+#ifndef LV_TXT_LINE_BATCH_BUF_SIZE
+#  ifdef CONFIG_LV_TXT_LINE_BATCH_BUF_SIZE
+#    define LV_TXT_LINE_BATCH_BUF_SIZE CONFIG_LV_TXT_LINE_BATCH_BUF_SIZE
+#  else
+#    define  LV_TXT_LINE_BATCH_BUF_SIZE          (8U * 1024U)
+#  endif
+#endif
+
+/* Number of fonts whose advance width of the printable ASCII letters (0x20-0x7E) are cached
+ * to measure texts without getting the glyph descriptor of every letter.
+ * The fonts are stored in 4-way sets (rounded up) and the least recently used one is replaced.
+ * Each font needs ~128 bytes. Set it to 0 to always use the glyph descriptors. */
+#ifndef LV_TXT_ASCII_WIDTH_CACHE_SIZE
+#  ifdef CONFIG_LV_TXT_ASCII_WIDTH_CACHE_SIZE
+#    define LV_TXT_ASCII_WIDTH_CACHE_SIZE CONFIG_LV_TXT_ASCII_WIDTH_CACHE_SIZE
+#  else
+#    define  LV_TXT_ASCII_WIDTH_CACHE_SIZE       4
+#  endif
+#endif
+
 /* Support bidirectional texts.
  * Allows mixing Left-to-Right and Right-to-Left texts.
  * The direction will be processed according to the Unicode Bidirectional Algorithm:
@@ -1453,6 +1832,19 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h" */
 #  endif
 #endif
 
+/* 1: Move the rarely used attributes of the objects (event callback, group, user data,
+ * realign parameters and extra click area) to a side table allocated only when one of them is set.
+ * It makes the objects smaller but setting any of these attributes costs an extra allocation.
+ * Note that `lv_obj_align()` saves the parameters for `lv_obj_realign()` only if the object already has a side table
+ * so call `lv_obj_set_auto_realign()` before `lv_obj_align()`.*/
+#ifndef LV_OBJ_SIDE_TABLE
+#  ifdef CONFIG_LV_OBJ_SIDE_TABLE
+#    define LV_OBJ_SIDE_TABLE CONFIG_LV_OBJ_SIDE_TABLE
+#  else
+#    define  LV_OBJ_SIDE_TABLE       0
+#  endif
+#endif
+
 /*==================
  *  LV OBJ X USAGE
  *================*/
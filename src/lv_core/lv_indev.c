@@ -1150,10 +1150,10 @@ lv_obj_t * lv_indev_search_obj(lv_obj_t * obj, lv_point_t * point)
 
     /*If the point is on this object check its children too*/
     if(lv_obj_hittest(obj, point)) {
-        lv_obj_t * i;
-
-        _LV_LL_READ(obj->child_ll, i) {
-            found_p = lv_indev_search_obj(i, point);
+        /*Start from the foreground*/
+        uint32_t i;
+        for(i = obj->child_cnt; i > 0; i--) {
+            found_p = lv_indev_search_obj(obj->children[i - 1], point);
 
             /*If a child was found then break*/
             if(found_p != NULL) {
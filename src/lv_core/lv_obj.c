@@ -18,6 +18,7 @@
 #include "../lv_misc/lv_task.h"
 #include "../lv_misc/lv_async.h"
 #include "../lv_misc/lv_fs.h"
+#include "../lv_misc/lv_fs_mmap.h"
 #include "../lv_misc/lv_gc.h"
 #include "../lv_misc/lv_math.h"
 #include "../lv_misc/lv_log.h"
@@ -46,6 +47,11 @@
 #define LV_OBJX_NAME "lv_obj"
 #define LV_OBJ_DEF_WIDTH    (LV_DPX(100))
 #define LV_OBJ_DEF_HEIGHT   (LV_DPX(50))
+#define VALID_TBL_NONE      0xFFFFFFFF
+
+#if LV_MEM_PROFILER
+    #define OBJ_MEM_TYPE_MAX    32
+#endif
 
 /**********************
  *      TYPEDEFS
@@ -110,6 +116,14 @@ typedef enum {
     STYLE_COMPARE_DIFF,
 } style_snapshot_res_t;
 
+#if LV_MEM_PROFILER
+typedef struct {
+    const char * type;
+    uint32_t cnt;
+    uint32_t size;
+} obj_mem_type_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -142,6 +156,29 @@ static void update_style_cache_children(lv_obj_t * obj);
 static void invalidate_style_cache(lv_obj_t * obj, uint8_t part, lv_style_property_t prop);
 static void style_snapshot(lv_obj_t * obj, uint8_t part, style_snapshot_t * shot);
 static style_snapshot_res_t style_snapshot_compare(style_snapshot_t * shot1, style_snapshot_t * shot2);
+static bool child_reserve(lv_obj_t * parent);
+static void child_insert(lv_obj_t * parent, lv_obj_t * obj, uint32_t id);
+static void child_remove(lv_obj_t * parent, lv_obj_t * obj);
+static void child_free_unused(lv_obj_t * parent);
+static void obj_mem_free(void * p);
+#if LV_OBJ_SIDE_TABLE
+static bool side_alloc(lv_obj_t * obj);
+#endif
+#if LV_MEM_ARENA_CNT
+static lv_mem_arena_t * obj_get_arena(const lv_obj_t * obj);
+static inline bool in_del_arena(const void * p);
+static void arena_del_anims(lv_mem_arena_t * arena);
+#endif
+#if LV_USE_DEBUG && LV_USE_ASSERT_OBJ
+static void valid_tbl_add(lv_obj_t * obj);
+static void valid_tbl_remove(const lv_obj_t * obj);
+static uint32_t valid_tbl_find(const lv_obj_t * obj);
+static inline uint32_t valid_tbl_hash(const lv_obj_t * obj);
+#endif
+#if LV_MEM_PROFILER
+static uint32_t obj_mem_collect(obj_mem_type_t * types);
+static void obj_mem_collect_children(lv_obj_t * obj, obj_mem_type_t * types, uint32_t * type_cnt);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -149,10 +186,41 @@ static style_snapshot_res_t style_snapshot_compare(style_snapshot_t * shot1, sty
 static bool lv_initialized = false;
 static lv_event_temp_data_t * event_temp_data_head;
 static const void * event_act_data;
+#if LV_OBJ_SIDE_TABLE
+static const lv_obj_side_t side_def;    /*The default values of the attributes in the side table*/
+#endif
+#if LV_MEM_ARENA_CNT
+static lv_mem_arena_t * scr_arena_new;  /*Arena for the screen being created by `lv_obj_create_scr_arena`*/
+static lv_mem_arena_t * del_arena;      /*Arena of the screen being deleted*/
+#endif
+#if LV_USE_DEBUG && LV_USE_ASSERT_OBJ
+/*The live objects are stored in `_lv_obj_valid_tbl` with open addressing*/
+static uint32_t valid_tbl_size;         /*Number of slots. Power of 2*/
+static uint32_t valid_tbl_cnt;          /*Number of stored objects*/
+static bool valid_tbl_lost;             /*An object couldn't be stored: search in the hierarchy too*/
+#endif
 
 /**********************
  *      MACROS
  **********************/
+#if LV_OBJ_SIDE_TABLE
+/*Read the rarely used attributes from the side table or from the defaults if the object has no side table.
+ *Write them only after `SIDE_ALLOC`*/
+#define SIDE(obj)       ((obj)->side ? (const lv_obj_side_t *)(obj)->side : &side_def)
+#define SIDE_W(obj)     ((obj)->side)
+#define SIDE_ALLOC(obj) side_alloc(obj)
+#else
+#define SIDE(obj)       (obj)
+#define SIDE_W(obj)     (obj)
+#define SIDE_ALLOC(obj) true
+#endif
+
+/*The arena in which the memories of an object should be allocated. NULL: use the heap*/
+#if LV_MEM_ARENA_CNT
+#define OBJ_ARENA(obj)  obj_get_arena(obj)
+#else
+#define OBJ_ARENA(obj)  NULL
+#endif
 
 /**********************
  *   GLOBAL FUNCTIONS
@@ -171,12 +239,25 @@ void lv_init(void)
 
     LV_LOG_TRACE("lv_init started");
 
+#if LV_USE_DEBUG && LV_USE_ASSERT_OBJ
+    LV_GC_ROOT(_lv_obj_valid_tbl) = NULL;
+    valid_tbl_size = 0;
+    valid_tbl_cnt = 0;
+    valid_tbl_lost = false;
+#endif
+
     /*Initialize the lv_misc modules*/
     _lv_mem_init();
     _lv_task_core_init();
+#if LV_MEM_CUSTOM == 0 && LV_MEM_DEFRAG_INCREMENTAL
+    _lv_mem_defrag_task_init();
+#endif
 
 #if LV_USE_FILESYSTEM
     _lv_fs_init();
+#if LV_USE_FS_MMAP
+    _lv_fs_mmap_init();
+#endif
 #endif
 
 #if LV_USE_ANIMATION
@@ -218,6 +299,7 @@ void lv_init(void)
     _lv_img_decoder_init();
 #if LV_IMG_CACHE_DEF_SIZE
     lv_img_cache_set_size(LV_IMG_CACHE_DEF_SIZE);
+    _lv_img_cache_async_init();
 #endif
     /*Test if the IDE has UTF-8 encoding*/
     char * txt = "Á";
@@ -277,11 +359,25 @@ lv_obj_t * lv_obj_create(lv_obj_t * parent, const lv_obj_t * copy)
             return NULL;
         }
 
+        _lv_mem_tag_push(LV_MEM_TAG_OBJ);
         new_obj = _lv_ll_ins_head(&disp->scr_ll);
+        _lv_mem_tag_pop();
         LV_ASSERT_MEM(new_obj);
         if(new_obj == NULL) return NULL;
 
         _lv_memset_00(new_obj, sizeof(lv_obj_t));
+#if LV_USE_DEBUG && LV_USE_ASSERT_OBJ
+        new_obj->sentinel = LV_DEBUG_OBJ_SENTINEL_VALUE;
+        valid_tbl_add(new_obj);
+#endif
+
+#if LV_MEM_ARENA_CNT
+        /*Attach the arena before anything is allocated for the screen*/
+        if(scr_arena_new) {
+            scr_arena_new->owner = new_obj;
+            scr_arena_new = NULL;
+        }
+#endif
 
 #if LV_USE_BIDI
         new_obj->base_dir     = LV_BIDI_BASE_DIR_DEF;
@@ -292,7 +388,6 @@ lv_obj_t * lv_obj_create(lv_obj_t * parent, const lv_obj_t * copy)
         /*Set the callbacks*/
         new_obj->signal_cb = lv_obj_signal;
         new_obj->design_cb = lv_obj_design;
-        new_obj->event_cb = NULL;
 
         /*Set coordinates to full screen size*/
         new_obj->coords.x1    = 0;
@@ -305,13 +400,21 @@ lv_obj_t * lv_obj_create(lv_obj_t * parent, const lv_obj_t * copy)
         LV_LOG_TRACE("Object create started");
         LV_ASSERT_OBJ(parent, LV_OBJX_NAME);
 
-        new_obj = _lv_ll_ins_head(&parent->child_ll);
+        if(!child_reserve(parent)) return NULL;
+
+        new_obj = _lv_mem_arena_realloc(OBJ_ARENA(parent), NULL, sizeof(lv_obj_t), LV_MEM_TAG_OBJ);
         LV_ASSERT_MEM(new_obj);
         if(new_obj == NULL) return NULL;
 
         _lv_memset_00(new_obj, sizeof(lv_obj_t));
+#if LV_USE_DEBUG && LV_USE_ASSERT_OBJ
+        new_obj->sentinel = LV_DEBUG_OBJ_SENTINEL_VALUE;
+        valid_tbl_add(new_obj);
+#endif
 
+        /*The new object is in the foreground*/
         new_obj->parent = parent;
+        child_insert(parent, new_obj, parent->child_cnt);
 
 #if LV_USE_BIDI
         new_obj->base_dir     = LV_BIDI_DIR_INHERIT;
@@ -322,7 +425,6 @@ lv_obj_t * lv_obj_create(lv_obj_t * parent, const lv_obj_t * copy)
         /*Set the callbacks (signal:cb is required in `lv_obj_get_base_dir` if `LV_USE_ASSERT_OBJ` is enabled)*/
         new_obj->signal_cb = lv_obj_signal;
         new_obj->design_cb = lv_obj_design;
-        new_obj->event_cb = NULL;
 
         new_obj->coords.y1    = parent->coords.y1;
         new_obj->coords.y2    = parent->coords.y1 + LV_OBJ_DEF_HEIGHT;
@@ -336,10 +438,14 @@ lv_obj_t * lv_obj_create(lv_obj_t * parent, const lv_obj_t * copy)
         }
     }
 
-    _lv_ll_init(&(new_obj->child_ll), sizeof(lv_obj_t));
-
     new_obj->ext_draw_pad = 0;
 
+#if LV_OBJ_SIDE_TABLE
+    /*The rarely used attributes have their default values until a side table is allocated*/
+    new_obj->side = NULL;
+#else
+    new_obj->event_cb = NULL;
+
 #if LV_USE_EXT_CLICK_AREA == LV_EXT_CLICK_AREA_FULL
     _lv_memset_00(&new_obj->ext_click_pad, sizeof(new_obj->ext_click_pad));
 #elif LV_USE_EXT_CLICK_AREA == LV_EXT_CLICK_AREA_TINY
@@ -364,6 +470,7 @@ lv_obj_t * lv_obj_create(lv_obj_t * parent, const lv_obj_t * copy)
 #if LV_USE_GROUP
     new_obj->group_p = NULL;
 #endif
+#endif /*LV_OBJ_SIDE_TABLE*/
 
     /*Set attributes*/
     new_obj->adv_hittest  = 0;
@@ -394,7 +501,17 @@ lv_obj_t * lv_obj_create(lv_obj_t * parent, const lv_obj_t * copy)
     if(copy != NULL) {
         lv_area_copy(&new_obj->coords, &copy->coords);
         new_obj->ext_draw_pad = copy->ext_draw_pad;
+        new_obj->base_dir = copy->base_dir;
 
+#if LV_OBJ_SIDE_TABLE
+        if(copy->side && side_alloc(new_obj)) {
+            _lv_memcpy(new_obj->side, copy->side, sizeof(lv_obj_side_t));
+#if LV_USE_GROUP
+            /*Joined to the group below*/
+            new_obj->side->group_p = NULL;
+#endif
+        }
+#else
 #if LV_USE_EXT_CLICK_AREA == LV_EXT_CLICK_AREA_FULL
         lv_area_copy(&new_obj->ext_click_pad, &copy->ext_click_pad);
 #elif LV_USE_EXT_CLICK_AREA == LV_EXT_CLICK_AREA_TINY
@@ -407,8 +524,6 @@ lv_obj_t * lv_obj_create(lv_obj_t * parent, const lv_obj_t * copy)
         _lv_memcpy(&new_obj->user_data, &copy->user_data, sizeof(lv_obj_user_data_t));
 #endif
 
-        new_obj->base_dir = copy->base_dir;
-
         /*Copy realign*/
 #if LV_USE_OBJ_REALIGN
         new_obj->realign.align        = copy->realign.align;
@@ -421,6 +536,7 @@ lv_obj_t * lv_obj_create(lv_obj_t * parent, const lv_obj_t * copy)
         /*Only copy the `event_cb`. `signal_cb` and `design_cb` will be copied in the derived
          * object type (e.g. `lv_btn`)*/
         new_obj->event_cb = copy->event_cb;
+#endif /*LV_OBJ_SIDE_TABLE*/
 
         /*Copy attributes*/
         new_obj->adv_hittest  = copy->adv_hittest;
@@ -439,8 +555,8 @@ lv_obj_t * lv_obj_create(lv_obj_t * parent, const lv_obj_t * copy)
 
 #if LV_USE_GROUP
         /*Add to the same group*/
-        if(copy->group_p != NULL) {
-            lv_group_add_obj(copy->group_p, new_obj);
+        if(SIDE(copy)->group_p != NULL) {
+            lv_group_add_obj(SIDE(copy)->group_p, new_obj);
         }
 #endif
 
@@ -463,6 +579,37 @@ lv_obj_t * lv_obj_create(lv_obj_t * parent, const lv_obj_t * copy)
     return new_obj;
 }
 
+#if LV_MEM_ARENA_CNT
+/**
+ * Create a screen with its own arena. The objects created on the screen, their `ext_attr`s, children arrays
+ * and style lists are allocated from the arena and deleting the screen frees the arena at once.
+ * The objects still get `LV_EVENT_DELETE` and `LV_SIGNAL_CLEANUP` one by one (e.g. to free the texts of the labels)
+ * so the deletion still takes time in proportion to the number of objects.
+ * The memories of the deleted objects are given back to the arena only if they are on its top,
+ * so it's useful for screens which are created and deleted as a whole.
+ * If the arena is full the new memories are allocated with `lv_mem_alloc`.
+ * @param arena_size size of the arena in bytes. See `lv_obj_get_arena()` to measure it.
+ * @return pointer to the new screen. If the arena can't be created it's a normal screen.
+ */
+lv_obj_t * lv_obj_create_scr_arena(uint32_t arena_size)
+{
+    scr_arena_new = _lv_mem_arena_create(arena_size, NULL);
+    if(scr_arena_new == NULL) {
+        LV_LOG_WARN("lv_obj_create_scr_arena: couldn't create the arena, use the heap");
+    }
+
+    lv_obj_t * scr = lv_obj_create(NULL, NULL);
+
+    /*Not used if the screen couldn't be created*/
+    if(scr_arena_new) {
+        _lv_mem_arena_del(scr_arena_new);
+        scr_arena_new = NULL;
+    }
+
+    return scr;
+}
+#endif
+
 /**
  * Delete 'obj' and all of its children
  * @param obj pointer to an object to delete
@@ -482,8 +629,23 @@ lv_res_t lv_obj_del(lv_obj_t * obj)
         if(disp->act_scr == obj) act_scr_del = true;
     }
 
+#if LV_MEM_ARENA_CNT
+    /*The animations of the objects in the arena are deleted at once instead of one by one*/
+    lv_mem_arena_t * del_arena_prev = del_arena;
+    lv_mem_arena_t * arena = par == NULL ? _lv_mem_arena_get_by_owner(obj) : NULL;
+    if(arena) del_arena = arena;
+#endif
+
     obj_del_core(obj);
 
+#if LV_MEM_ARENA_CNT
+    if(arena) {
+        arena_del_anims(arena);
+        _lv_mem_arena_del(arena);
+        del_arena = del_arena_prev;
+    }
+#endif
+
     /*Send a signal to the parent to notify it about the child delete*/
     if(par) {
         par->signal_cb(par, LV_SIGNAL_CHILD_CHG, NULL);
@@ -682,7 +844,22 @@ void lv_obj_set_parent(lv_obj_t * obj, lv_obj_t * parent)
         old_pos.x = old_par->coords.x2 - obj->coords.x2;
     }
 
-    _lv_ll_chg_list(&obj->parent->child_ll, &parent->child_ll, obj, true);
+#if LV_MEM_ARENA_CNT
+    /*The object (or its children) would be freed with the arena of its old screen*/
+    lv_mem_arena_t * old_arena = obj_get_arena(old_par);
+    if(old_arena && old_arena != obj_get_arena(parent)) {
+        LV_LOG_WARN("lv_obj_set_parent: can't move an object out of the arena of its screen");
+        return;
+    }
+#endif
+
+    /*Make room first to not lose the object if out of memory*/
+    if(!child_reserve(parent)) return;
+
+    /*The new parent can be the old parent too. Then the object is moved to the foreground.*/
+    child_remove(old_par, obj);
+    child_insert(parent, obj, parent->child_cnt);
+    child_free_unused(old_par);
     obj->parent = parent;
 
     if(new_base_dir != LV_BIDI_DIR_RTL) {
@@ -714,11 +891,13 @@ void lv_obj_move_foreground(lv_obj_t * obj)
     lv_obj_t * parent = lv_obj_get_parent(obj);
 
     /*Do nothing of already in the foreground*/
-    if(_lv_ll_get_head(&parent->child_ll) == obj) return;
+    if(obj->child_id == parent->child_cnt - 1) return;
 
     lv_obj_invalidate(parent);
 
-    _lv_ll_chg_list(&parent->child_ll, &parent->child_ll, obj, true);
+    /*Removing makes room for inserting*/
+    child_remove(parent, obj);
+    child_insert(parent, obj, parent->child_cnt);
 
     /*Notify the new parent about the child*/
     parent->signal_cb(parent, LV_SIGNAL_CHILD_CHG, obj);
@@ -737,11 +916,12 @@ void lv_obj_move_background(lv_obj_t * obj)
     lv_obj_t * parent = lv_obj_get_parent(obj);
 
     /*Do nothing of already in the background*/
-    if(_lv_ll_get_tail(&parent->child_ll) == obj) return;
+    if(obj->child_id == 0) return;
 
     lv_obj_invalidate(parent);
 
-    _lv_ll_chg_list(&parent->child_ll, &parent->child_ll, obj, false);
+    child_remove(parent, obj);
+    child_insert(parent, obj, 0);
 
     /*Notify the new parent about the child*/
     parent->signal_cb(parent, LV_SIGNAL_CHILD_CHG, obj);
@@ -871,7 +1051,7 @@ void lv_obj_set_size(lv_obj_t * obj, lv_coord_t w, lv_coord_t h)
 
     /*Tell the children the parent's size has changed*/
     lv_obj_t * i;
-    _LV_LL_READ(obj->child_ll, i) {
+    _LV_OBJ_CHILD_READ(obj, i) {
         i->signal_cb(i, LV_SIGNAL_PARENT_SIZE_CHG,  &ori);
     }
 
@@ -880,7 +1060,7 @@ void lv_obj_set_size(lv_obj_t * obj, lv_coord_t w, lv_coord_t h)
 
     /*Automatically realign the object if required*/
 #if LV_USE_OBJ_REALIGN
-    if(obj->realign.auto_realign) lv_obj_realign(obj);
+    if(SIDE(obj)->realign.auto_realign) lv_obj_realign(obj);
 #endif
 }
 
@@ -982,11 +1162,12 @@ void lv_obj_align(lv_obj_t * obj, const lv_obj_t * base, lv_align_t align, lv_co
 
 #if LV_USE_OBJ_REALIGN
     /*Save the last align parameters to use them in `lv_obj_realign`*/
-    obj->realign.align       = align;
-    obj->realign.xofs        = x_ofs;
-    obj->realign.yofs        = y_ofs;
-    obj->realign.base        = base;
-    obj->realign.mid_align = 0;
+    if(!SIDE_ALLOC(obj)) return;
+    SIDE_W(obj)->realign.align       = align;
+    SIDE_W(obj)->realign.xofs        = x_ofs;
+    SIDE_W(obj)->realign.yofs        = y_ofs;
+    SIDE_W(obj)->realign.base        = base;
+    SIDE_W(obj)->realign.mid_align = 0;
 #endif
 }
 
@@ -1048,11 +1229,12 @@ void lv_obj_align_mid(lv_obj_t * obj, const lv_obj_t * base, lv_align_t align, l
 
 #if LV_USE_OBJ_REALIGN
     /*Save the last align parameters to use them in `lv_obj_realign`*/
-    obj->realign.align       = align;
-    obj->realign.xofs        = x_ofs;
-    obj->realign.yofs        = y_ofs;
-    obj->realign.base        = base;
-    obj->realign.mid_align = 1;
+    if(!SIDE_ALLOC(obj)) return;
+    SIDE_W(obj)->realign.align       = align;
+    SIDE_W(obj)->realign.xofs        = x_ofs;
+    SIDE_W(obj)->realign.yofs        = y_ofs;
+    SIDE_W(obj)->realign.base        = base;
+    SIDE_W(obj)->realign.mid_align = 1;
 #endif
 }
 
@@ -1096,6 +1278,27 @@ void lv_obj_align_mid_y(lv_obj_t * obj, const lv_obj_t * base, lv_align_t align,
     obj_align_mid_core(obj, base, align, false, true, 0, y_ofs);
 }
 
+/**
+ * Align an object to an other object without saving the parameters for `lv_obj_realign`.
+ * Used by the layouts which align all the children anyway.
+ * @param obj pointer to an object to align
+ * @param base pointer to an object (if NULL the parent is used). 'obj' will be aligned to it.
+ * @param align type of alignment (see 'lv_align_t' enum)
+ * @param x_ofs x coordinate offset after alignment
+ * @param y_ofs y coordinate offset after alignment
+ */
+void _lv_obj_align_no_save(lv_obj_t * obj, const lv_obj_t * base, lv_align_t align, lv_coord_t x_ofs,
+                           lv_coord_t y_ofs)
+{
+    LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
+
+    if(base == NULL) base = lv_obj_get_parent(obj);
+
+    LV_ASSERT_OBJ(base, LV_OBJX_NAME);
+
+    obj_align_core(obj, base, align, true, true, x_ofs, y_ofs);
+}
+
 /**
  * Realign the object based on the last `lv_obj_align` parameters.
  * @param obj pointer to an object
@@ -1105,10 +1308,12 @@ void lv_obj_realign(lv_obj_t * obj)
     LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
 
 #if LV_USE_OBJ_REALIGN
-    if(obj->realign.mid_align)
-        lv_obj_align_mid(obj, obj->realign.base, obj->realign.align, obj->realign.xofs, obj->realign.yofs);
+    /*Copy the parameters because aligning overwrites them*/
+    lv_realign_t realign = SIDE(obj)->realign;
+    if(realign.mid_align)
+        lv_obj_align_mid(obj, realign.base, realign.align, realign.xofs, realign.yofs);
     else
-        lv_obj_align(obj, obj->realign.base, obj->realign.align, obj->realign.xofs, obj->realign.yofs);
+        lv_obj_align(obj, realign.base, realign.align, realign.xofs, realign.yofs);
 #else
     (void)obj;
     LV_LOG_WARN("lv_obj_realign: no effect because LV_USE_OBJ_REALIGN = 0");
@@ -1126,7 +1331,8 @@ void lv_obj_set_auto_realign(lv_obj_t * obj, bool en)
     LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
 
 #if LV_USE_OBJ_REALIGN
-    obj->realign.auto_realign = en ? 1 : 0;
+    if(!SIDE_ALLOC(obj)) return;
+    SIDE_W(obj)->realign.auto_realign = en ? 1 : 0;
 #else
     (void)obj;
     (void)en;
@@ -1149,13 +1355,15 @@ void lv_obj_set_ext_click_area(lv_obj_t * obj, lv_coord_t left, lv_coord_t right
     LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
 
 #if LV_USE_EXT_CLICK_AREA == LV_EXT_CLICK_AREA_FULL
-    obj->ext_click_pad.x1 = left;
-    obj->ext_click_pad.x2 = right;
-    obj->ext_click_pad.y1 = top;
-    obj->ext_click_pad.y2 = bottom;
+    if(!SIDE_ALLOC(obj)) return;
+    SIDE_W(obj)->ext_click_pad.x1 = left;
+    SIDE_W(obj)->ext_click_pad.x2 = right;
+    SIDE_W(obj)->ext_click_pad.y1 = top;
+    SIDE_W(obj)->ext_click_pad.y2 = bottom;
 #elif LV_USE_EXT_CLICK_AREA == LV_EXT_CLICK_AREA_TINY
-    obj->ext_click_pad_hor = LV_MATH_MAX(left, right);
-    obj->ext_click_pad_ver = LV_MATH_MAX(top, bottom);
+    if(!SIDE_ALLOC(obj)) return;
+    SIDE_W(obj)->ext_click_pad_hor = LV_MATH_MAX(left, right);
+    SIDE_W(obj)->ext_click_pad_ver = LV_MATH_MAX(top, bottom);
 #else
     (void)obj;    /*Unused*/
     (void)left;   /*Unused*/
@@ -1860,7 +2068,12 @@ void lv_obj_set_event_cb(lv_obj_t * obj, lv_event_cb_t event_cb)
 {
     LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
 
-    obj->event_cb = event_cb;
+#if LV_OBJ_SIDE_TABLE
+    /*Don't allocate a side table only to remove a not existing callback*/
+    if(event_cb == NULL && obj->side == NULL) return;
+#endif
+    if(!SIDE_ALLOC(obj)) return;
+    SIDE_W(obj)->event_cb = event_cb;
 }
 
 /**
@@ -1877,7 +2090,7 @@ lv_res_t lv_event_send(lv_obj_t * obj, lv_event_t event, const void * data)
     LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
 
     lv_res_t res;
-    res = lv_event_send_func(obj->event_cb, obj, event, data);
+    res = lv_event_send_func(SIDE(obj)->event_cb, obj, event, data);
     return res;
 }
 
@@ -2054,7 +2267,7 @@ void * lv_obj_allocate_ext_attr(lv_obj_t * obj, uint16_t ext_size)
 {
     LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
 
-    void * new_ext = lv_mem_realloc(obj->ext_attr, ext_size);
+    void * new_ext = _lv_mem_arena_realloc(OBJ_ARENA(obj), obj->ext_attr, ext_size, LV_MEM_TAG_OBJ);
     if(new_ext == NULL) return NULL;
 
     obj->ext_attr = new_ext;
@@ -2154,16 +2367,8 @@ lv_obj_t * lv_obj_get_child(const lv_obj_t * obj, const lv_obj_t * child)
 {
     LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
 
-    lv_obj_t * result = NULL;
-
-    if(child == NULL) {
-        result = _lv_ll_get_head(&obj->child_ll);
-    }
-    else {
-        result = _lv_ll_get_next(&obj->child_ll, child);
-    }
-
-    return result;
+    uint32_t id = child == NULL ? obj->child_cnt : child->child_id;
+    return id > 0 ? obj->children[id - 1] : NULL;
 }
 
 /**
@@ -2177,16 +2382,8 @@ lv_obj_t * lv_obj_get_child_back(const lv_obj_t * obj, const lv_obj_t * child)
 {
     LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
 
-    lv_obj_t * result = NULL;
-
-    if(child == NULL) {
-        result = _lv_ll_get_tail(&obj->child_ll);
-    }
-    else {
-        result = _lv_ll_get_prev(&obj->child_ll, child);
-    }
-
-    return result;
+    uint32_t id = child == NULL ? 0 : child->child_id + 1;
+    return id < obj->child_cnt ? obj->children[id] : NULL;
 }
 
 /**
@@ -2198,12 +2395,7 @@ uint16_t lv_obj_count_children(const lv_obj_t * obj)
 {
     LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
 
-    lv_obj_t * i;
-    uint16_t cnt = 0;
-
-    _LV_LL_READ(obj->child_ll, i) cnt++;
-
-    return cnt;
+    return (uint16_t)obj->child_cnt;
 }
 
 /** Recursively count the children of an object
@@ -2217,7 +2409,7 @@ uint16_t lv_obj_count_children_recursive(const lv_obj_t * obj)
     lv_obj_t * i;
     uint16_t cnt = 0;
 
-    _LV_LL_READ(obj->child_ll, i) {
+    _LV_OBJ_CHILD_READ(obj, i) {
         cnt++;                                     /*Count the child*/
         cnt += lv_obj_count_children_recursive(i); /*recursively count children's children*/
     }
@@ -2225,6 +2417,45 @@ uint16_t lv_obj_count_children_recursive(const lv_obj_t * obj)
     return cnt;
 }
 
+/**
+ * Get a child of an object by its index
+ * @param obj pointer to an object
+ * @param id index of the child. 0: the "oldest" child in the background
+ * @return pointer to the child or NULL if `id` is out of range
+ */
+lv_obj_t * lv_obj_get_child_by_id(const lv_obj_t * obj, uint32_t id)
+{
+    LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
+
+    return id < obj->child_cnt ? obj->children[id] : NULL;
+}
+
+/**
+ * Get the index of an object among the children of its parent
+ * @param obj pointer to an object
+ * @return index of the object. 0: the "oldest" child in the background. Always 0 for screens.
+ */
+uint32_t lv_obj_get_child_id(const lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
+
+    return obj->child_id;
+}
+
+#if LV_MEM_ARENA_CNT
+/**
+ * Get the arena of the screen of an object to see its usage
+ * @param obj pointer to an object
+ * @return the arena or NULL if the screen was not created by `lv_obj_create_scr_arena()`
+ */
+const lv_mem_arena_t * lv_obj_get_arena(const lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
+
+    return obj_get_arena(obj);
+}
+#endif
+
 /*---------------------
  * Coordinate get
  *--------------------*/
@@ -2436,7 +2667,7 @@ bool lv_obj_get_auto_realign(const lv_obj_t * obj)
     LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
 
 #if LV_USE_OBJ_REALIGN
-    return obj->realign.auto_realign ? true : false;
+    return SIDE(obj)->realign.auto_realign ? true : false;
 #else
     (void)obj;
     return false;
@@ -2453,9 +2684,9 @@ lv_coord_t lv_obj_get_ext_click_pad_left(const lv_obj_t * obj)
     LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
 
 #if LV_USE_EXT_CLICK_AREA == LV_EXT_CLICK_AREA_TINY
-    return obj->ext_click_pad_hor;
+    return SIDE(obj)->ext_click_pad_hor;
 #elif LV_USE_EXT_CLICK_AREA == LV_EXT_CLICK_AREA_FULL
-    return obj->ext_click_pad.x1;
+    return SIDE(obj)->ext_click_pad.x1;
 #else
     (void)obj;    /*Unused*/
     return 0;
@@ -2472,9 +2703,9 @@ lv_coord_t lv_obj_get_ext_click_pad_right(const lv_obj_t * obj)
     LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
 
 #if LV_USE_EXT_CLICK_AREA == LV_EXT_CLICK_AREA_TINY
-    return obj->ext_click_pad_hor;
+    return SIDE(obj)->ext_click_pad_hor;
 #elif LV_USE_EXT_CLICK_AREA == LV_EXT_CLICK_AREA_FULL
-    return obj->ext_click_pad.x2;
+    return SIDE(obj)->ext_click_pad.x2;
 #else
     (void)obj; /*Unused*/
     return 0;
@@ -2491,9 +2722,9 @@ lv_coord_t lv_obj_get_ext_click_pad_top(const lv_obj_t * obj)
     LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
 
 #if LV_USE_EXT_CLICK_AREA == LV_EXT_CLICK_AREA_TINY
-    return obj->ext_click_pad_ver;
+    return SIDE(obj)->ext_click_pad_ver;
 #elif LV_USE_EXT_CLICK_AREA == LV_EXT_CLICK_AREA_FULL
-    return obj->ext_click_pad.y1;
+    return SIDE(obj)->ext_click_pad.y1;
 #else
     (void)obj; /*Unused*/
     return 0;
@@ -2510,9 +2741,9 @@ lv_coord_t lv_obj_get_ext_click_pad_bottom(const lv_obj_t * obj)
     LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
 
 #if LV_USE_EXT_CLICK_AREA == LV_EXT_CLICK_AREA_TINY
-    return obj->ext_click_pad_ver;
+    return SIDE(obj)->ext_click_pad_ver;
 #elif LV_USE_EXT_CLICK_AREA == LV_EXT_CLICK_AREA_FULL
-    return obj->ext_click_pad.y2;
+    return SIDE(obj)->ext_click_pad.y2;
 #else
     (void)obj; /*Unused*/
     return 0;
@@ -3136,7 +3367,7 @@ lv_event_cb_t lv_obj_get_event_cb(const lv_obj_t * obj)
 {
     LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
 
-    return obj->event_cb;
+    return SIDE(obj)->event_cb;
 }
 
 /*------------------
@@ -3186,6 +3417,49 @@ void lv_obj_get_type(const lv_obj_t * obj, lv_obj_type_t * buf)
     }
 }
 
+#if LV_MEM_PROFILER
+/**
+ * Get the memory used by the objects of a type on all displays.
+ * The objects, their `ext_attr` and the style list of their main part are counted.
+ * @param type name of a type, e.g. "lv_btn" or NULL to count every object
+ * @param cnt store the number of objects here. Can be NULL.
+ * @return the used memory in bytes
+ */
+uint32_t lv_obj_mem_prof_get_type_size(const char * type, uint32_t * cnt)
+{
+    obj_mem_type_t types[OBJ_MEM_TYPE_MAX];
+    uint32_t type_cnt = obj_mem_collect(types);
+
+    uint32_t size = 0;
+    uint32_t obj_cnt = 0;
+    uint32_t i;
+    for(i = 0; i < type_cnt; i++) {
+        if(type == NULL || strcmp(types[i].type, type) == 0) {
+            size += types[i].size;
+            obj_cnt += types[i].cnt;
+        }
+    }
+
+    if(cnt) *cnt = obj_cnt;
+    return size;
+}
+
+/**
+ * Log the number of objects and their memory usage per object type with `LV_LOG_USER`.
+ * The objects, their `ext_attr` and the style list of their main part are counted.
+ */
+void lv_obj_mem_prof_dump(void)
+{
+    obj_mem_type_t types[OBJ_MEM_TYPE_MAX];
+    uint32_t type_cnt = obj_mem_collect(types);
+
+    uint32_t i;
+    for(i = 0; i < type_cnt; i++) {
+        LV_LOG_USER("%s: %d objects, %d bytes", types[i].type, types[i].cnt, types[i].size);
+    }
+}
+#endif
+
 #if LV_USE_USER_DATA
 
 /**
@@ -3197,7 +3471,7 @@ lv_obj_user_data_t lv_obj_get_user_data(const lv_obj_t * obj)
 {
     LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
 
-    return obj->user_data;
+    return SIDE(obj)->user_data;
 }
 
 /**
@@ -3209,7 +3483,9 @@ lv_obj_user_data_t * lv_obj_get_user_data_ptr(const lv_obj_t * obj)
 {
     LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
 
-    return (lv_obj_user_data_t *)&obj->user_data;
+    /*The user data can be written through the pointer so it needs a side table*/
+    if(!SIDE_ALLOC((lv_obj_t *)obj)) return NULL;
+    return (lv_obj_user_data_t *)&SIDE_W(obj)->user_data;
 }
 
 /**
@@ -3221,7 +3497,8 @@ void lv_obj_set_user_data(lv_obj_t * obj, lv_obj_user_data_t data)
 {
     LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
 
-    _lv_memcpy(&obj->user_data, &data, sizeof(lv_obj_user_data_t));
+    if(!SIDE_ALLOC(obj)) return;
+    _lv_memcpy(&SIDE_W(obj)->user_data, &data, sizeof(lv_obj_user_data_t));
 }
 #endif
 
@@ -3235,13 +3512,32 @@ void * lv_obj_get_group(const lv_obj_t * obj)
     LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
 
 #if LV_USE_GROUP
-    return obj->group_p;
+    return SIDE(obj)->group_p;
 #else
     LV_UNUSED(obj);
     return NULL;
 #endif
 }
 
+/**
+ * Set the group of the object. Only the group module should call it.
+ * @param obj pointer to an object
+ * @param group pointer to a group or NULL to tell the object is not in a group
+ */
+void _lv_obj_set_group(lv_obj_t * obj, void * group)
+{
+#if LV_USE_GROUP
+#if LV_OBJ_SIDE_TABLE
+    if(group == NULL && obj->side == NULL) return;
+#endif
+    if(!SIDE_ALLOC(obj)) return;
+    SIDE_W(obj)->group_p = group;
+#else
+    LV_UNUSED(obj);
+    LV_UNUSED(group);
+#endif
+}
+
 /**
  * Tell whether the object is the focused object of a group or not.
  * @param obj pointer to an object
@@ -3252,8 +3548,9 @@ bool lv_obj_is_focused(const lv_obj_t * obj)
     LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
 
 #if LV_USE_GROUP
-    if(obj->group_p) {
-        if(lv_group_get_focused(obj->group_p) == obj) return true;
+    lv_group_t * g = SIDE(obj)->group_p;
+    if(g) {
+        if(lv_group_get_focused(g) == obj) return true;
     }
     return false;
 #else
@@ -3278,18 +3575,19 @@ bool lv_obj_is_point_on_coords(lv_obj_t * obj, const lv_point_t * point)
 {
 #if LV_USE_EXT_CLICK_AREA == LV_EXT_CLICK_AREA_TINY
     lv_area_t ext_area;
-    ext_area.x1 = obj->coords.x1 - obj->ext_click_pad_hor;
-    ext_area.x2 = obj->coords.x2 + obj->ext_click_pad_hor;
-    ext_area.y1 = obj->coords.y1 - obj->ext_click_pad_ver;
-    ext_area.y2 = obj->coords.y2 + obj->ext_click_pad_ver;
+    ext_area.x1 = obj->coords.x1 - SIDE(obj)->ext_click_pad_hor;
+    ext_area.x2 = obj->coords.x2 + SIDE(obj)->ext_click_pad_hor;
+    ext_area.y1 = obj->coords.y1 - SIDE(obj)->ext_click_pad_ver;
+    ext_area.y2 = obj->coords.y2 + SIDE(obj)->ext_click_pad_ver;
 
     if(!_lv_area_is_point_on(&ext_area, point, 0)) {
 #elif LV_USE_EXT_CLICK_AREA == LV_EXT_CLICK_AREA_FULL
     lv_area_t ext_area;
-    ext_area.x1 = obj->coords.x1 - obj->ext_click_pad.x1;
-    ext_area.x2 = obj->coords.x2 + obj->ext_click_pad.x2;
-    ext_area.y1 = obj->coords.y1 - obj->ext_click_pad.y1;
-    ext_area.y2 = obj->coords.y2 + obj->ext_click_pad.y2;
+    const lv_area_t * pad = &SIDE(obj)->ext_click_pad;
+    ext_area.x1 = obj->coords.x1 - pad->x1;
+    ext_area.x2 = obj->coords.x2 + pad->x2;
+    ext_area.y1 = obj->coords.y1 - pad->y1;
+    ext_area.y2 = obj->coords.y2 + pad->y2;
 
     if(!_lv_area_is_point_on(&ext_area, point, 0)) {
 #else
@@ -3719,13 +4017,19 @@ bool lv_debug_check_obj_type(const lv_obj_t * obj, const char * obj_type)
 }
 
 /**
- * Check if any object is still "alive", and part of the hierarchy
+ * Check if any object is still "alive", and part of the hierarchy.
+ * With `LV_USE_ASSERT_OBJ` the live objects are kept in a hash table so it's constant time.
  * @param obj pointer to an object
- * @param obj_type type of the object. (e.g. "lv_btn")
  * @return true: valid
  */
 bool lv_debug_check_obj_valid(const lv_obj_t * obj)
 {
+#if LV_USE_DEBUG && LV_USE_ASSERT_OBJ
+    /*Don't read the object until it's found: it might be freed*/
+    if(valid_tbl_find(obj) != VALID_TBL_NONE) return obj->sentinel == LV_DEBUG_OBJ_SENTINEL_VALUE;
+    if(valid_tbl_lost == false) return false;
+#endif
+
     lv_disp_t * disp = lv_disp_get_next(NULL);
     while(disp) {
         lv_obj_t * scr;
@@ -3746,6 +4050,228 @@ bool lv_debug_check_obj_valid(const lv_obj_t * obj)
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Make sure there is room for one more child in the `children` array of an object.
+ * The array grows by doubling its size.
+ * @param parent pointer to an object
+ * @return true: there is room for a new child; false: out of memory
+ */
+static bool child_reserve(lv_obj_t * parent)
+{
+    if(parent->child_cnt < parent->child_cap) return true;
+
+    uint32_t new_cap = parent->child_cap ? parent->child_cap * 2 : 1;
+    lv_obj_t ** new_children = _lv_mem_arena_realloc(OBJ_ARENA(parent), parent->children, new_cap * sizeof(lv_obj_t *),
+                                                     LV_MEM_TAG_OBJ);
+    LV_ASSERT_MEM(new_children);
+    if(new_children == NULL) return false;
+
+    parent->children = new_children;
+    parent->child_cap = new_cap;
+    return true;
+}
+
+/**
+ * Insert an object into the `children` array of its parent. `child_reserve` has to be called before it.
+ * @param parent pointer to an object
+ * @param obj pointer to the child to insert
+ * @param id the new index of the child. The children from `id` are shifted toward the foreground.
+ */
+static void child_insert(lv_obj_t * parent, lv_obj_t * obj, uint32_t id)
+{
+    uint32_t i;
+    for(i = parent->child_cnt; i > id; i--) {
+        parent->children[i] = parent->children[i - 1];
+        parent->children[i]->child_id = i;
+    }
+
+    parent->children[id] = obj;
+    obj->child_id = id;
+    parent->child_cnt++;
+}
+
+/**
+ * Remove an object from the `children` array of its parent.
+ * The array is kept even if it's empty to let the object be inserted again. See `child_free_unused`.
+ * @param parent pointer to an object
+ * @param obj pointer to a child of `parent`
+ */
+static void child_remove(lv_obj_t * parent, lv_obj_t * obj)
+{
+    uint32_t i;
+    for(i = obj->child_id; i + 1 < parent->child_cnt; i++) {
+        parent->children[i] = parent->children[i + 1];
+        parent->children[i]->child_id = i;
+    }
+
+    parent->child_cnt--;
+    obj->child_id = 0;
+}
+
+/**
+ * Free the `children` array of an object if it has no children anymore
+ * @param parent pointer to an object
+ */
+static void child_free_unused(lv_obj_t * parent)
+{
+    if(parent->child_cnt > 0 || parent->children == NULL) return;
+
+    obj_mem_free(parent->children);
+    parent->children = NULL;
+    parent->child_cap = 0;
+}
+
+/**
+ * Free a memory of an object (e.g. the object itself or its `ext_attr`)
+ * @param p pointer to a memory allocated with `_lv_mem_arena_realloc()`
+ */
+static void obj_mem_free(void * p)
+{
+#if LV_MEM_ARENA_CNT
+    /*The memories in the arena of the screen being deleted are freed with the arena at once*/
+    if(in_del_arena(p)) return;
+#endif
+
+    _lv_mem_arena_free(p);
+}
+
+#if LV_OBJ_SIDE_TABLE
+/**
+ * Allocate the side table of an object if it has no side table yet
+ * @param obj pointer to an object
+ * @return true: the object has a side table; false: out of memory
+ */
+static bool side_alloc(lv_obj_t * obj)
+{
+    if(obj->side) return true;
+
+    obj->side = _lv_mem_arena_realloc(OBJ_ARENA(obj), NULL, sizeof(lv_obj_side_t), LV_MEM_TAG_OBJ);
+    LV_ASSERT_MEM(obj->side);
+    if(obj->side == NULL) return false;
+
+    /*The defaults of all attributes are zero*/
+    _lv_memset_00(obj->side, sizeof(lv_obj_side_t));
+    return true;
+}
+#endif
+
+#if LV_MEM_ARENA_CNT
+/**
+ * Get the arena of the screen of an object
+ * @param obj pointer to an object
+ * @return the arena or NULL if the screen has no arena
+ */
+static lv_mem_arena_t * obj_get_arena(const lv_obj_t * obj)
+{
+    while(obj->parent) obj = obj->parent;
+    return _lv_mem_arena_get_by_owner(obj);
+}
+
+/**
+ * Tell whether a memory is in the arena of the screen being deleted
+ * @param p any pointer
+ * @return true: `p` will be freed with the arena
+ */
+static inline bool in_del_arena(const void * p)
+{
+    if(del_arena == NULL) return false;
+
+    const uint8_t * p8 = p;
+    return p8 >= del_arena->buf && p8 < del_arena->buf + del_arena->size;
+}
+
+/**
+ * Delete the animations and the style transitions of the objects in an arena in one pass
+ * @param arena pointer to the arena of a screen being deleted
+ */
+static void arena_del_anims(lv_mem_arena_t * arena)
+{
+#if LV_USE_ANIMATION
+    lv_style_trans_t * tr;
+    lv_style_trans_t * tr_prev;
+    tr = _lv_ll_get_tail(&LV_GC_ROOT(_lv_obj_style_trans_ll));
+    while(tr != NULL) {
+        /*'tr' might be deleted, so get the next object while 'tr' is valid*/
+        tr_prev = _lv_ll_get_prev(&LV_GC_ROOT(_lv_obj_style_trans_ll), tr);
+
+        /*The object is already deleted so its transition style is not updated*/
+        if(_lv_mem_arena_find(tr->obj) == arena) {
+            lv_anim_del(tr, NULL);
+            _lv_ll_remove(&LV_GC_ROOT(_lv_obj_style_trans_ll), tr);
+            lv_mem_free(tr);
+        }
+        tr = tr_prev;
+    }
+
+    _lv_anim_del_range(arena->buf, arena->buf + arena->size);
+#else
+    LV_UNUSED(arena);
+#endif
+}
+#endif
+
+#if LV_MEM_PROFILER
+/**
+ * Sum the memory usage of the objects per type on all displays
+ * @param types an array with `OBJ_MEM_TYPE_MAX` elements to store the types
+ * @return number of types in `types`
+ */
+static uint32_t obj_mem_collect(obj_mem_type_t * types)
+{
+    uint32_t type_cnt = 0;
+    lv_disp_t * disp = lv_disp_get_next(NULL);
+    while(disp) {
+        lv_obj_t * scr;
+        _LV_LL_READ(disp->scr_ll, scr) {
+            obj_mem_collect_children(scr, types, &type_cnt);
+        }
+        disp = lv_disp_get_next(disp);
+    }
+
+    return type_cnt;
+}
+
+static void obj_mem_collect_children(lv_obj_t * obj, obj_mem_type_t * types, uint32_t * type_cnt)
+{
+    uint32_t size = _lv_mem_arena_get_size(obj) + _lv_mem_arena_get_size(obj->ext_attr);
+    size += _lv_mem_arena_get_size(obj->style_list.style_list);
+    size += _lv_mem_arena_get_size(obj->children);
+#if LV_OBJ_SIDE_TABLE
+    size += _lv_mem_arena_get_size(obj->side);
+#endif
+    if(obj->style_list.has_local) {
+        lv_style_t * local = lv_style_list_get_local_style(&obj->style_list);
+        size += _lv_mem_arena_get_size(local) + _lv_mem_arena_get_size(local->map);
+    }
+
+    lv_obj_type_t type_buf;
+    lv_obj_get_type(obj, &type_buf);
+
+    uint32_t i;
+    for(i = 0; i < *type_cnt; i++) {
+        if(strcmp(types[i].type, type_buf.type[0]) == 0) break;
+    }
+
+    /*The types which don't fit into the array are not counted*/
+    if(i == *type_cnt && i < OBJ_MEM_TYPE_MAX) {
+        types[i].type = type_buf.type[0];
+        types[i].cnt = 0;
+        types[i].size = 0;
+        (*type_cnt)++;
+    }
+
+    if(i < *type_cnt) {
+        types[i].cnt++;
+        types[i].size += size;
+    }
+
+    lv_obj_t * child;
+    _LV_OBJ_CHILD_READ(obj, child) {
+        obj_mem_collect_children(child, types, type_cnt);
+    }
+}
+#endif
+
 static void lv_obj_del_async_cb(void * obj)
 {
     LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
@@ -3772,20 +4298,22 @@ static void obj_del_core(lv_obj_t * obj)
 #endif
 
     /*Recursively delete the children*/
-    lv_obj_t * i;
-    i = _lv_ll_get_head(&(obj->child_ll));
-    while(i != NULL) {
+    /*Delete from the foreground to remove always the last element of the array*/
+    while(obj->child_cnt > 0) {
         /*Call the recursive delete to the child too*/
-        obj_del_core(i);
-
-        /*Set i to the new head node*/
-        i = _lv_ll_get_head(&(obj->child_ll));
+        obj_del_core(obj->children[obj->child_cnt - 1]);
     }
 
     /*Remove the animations from this object*/
 #if LV_USE_ANIMATION
-    lv_anim_del(obj, NULL);
-    trans_del(obj, 0xFF, 0xFF, NULL);
+#if LV_MEM_ARENA_CNT
+    /*`lv_obj_del` deletes them at once*/
+    if(!in_del_arena(obj))
+#endif
+    {
+        lv_anim_del(obj, NULL);
+        trans_del(obj, 0xFF, 0xFF, NULL);
+    }
 #endif
 
     lv_event_mark_deleted(obj);
@@ -3819,12 +4347,22 @@ static void obj_del_core(lv_obj_t * obj)
         _lv_ll_remove(&d->scr_ll, obj);
     }
     else {
-        _lv_ll_remove(&(par->child_ll), obj);
+        child_remove(par, obj);
+        child_free_unused(par);
     }
 
+#if LV_USE_DEBUG && LV_USE_ASSERT_OBJ
+    /*From now on `LV_ASSERT_OBJ` rejects the object*/
+    obj->sentinel = 0;
+    valid_tbl_remove(obj);
+#endif
+
     /*Delete the base objects*/
-    if(obj->ext_attr != NULL) lv_mem_free(obj->ext_attr);
-    lv_mem_free(obj); /*Free the object itself*/
+    if(obj->ext_attr != NULL) obj_mem_free(obj->ext_attr);
+#if LV_OBJ_SIDE_TABLE
+    if(obj->side != NULL) obj_mem_free(obj->side);
+#endif
+    obj_mem_free(obj); /*Free the object itself*/
 }
 
 /**
@@ -3983,7 +4521,7 @@ static lv_res_t lv_obj_signal(lv_obj_t * obj, lv_signal_t sign, void * param)
     }
 #if LV_USE_OBJ_REALIGN
     else if(sign == LV_SIGNAL_PARENT_SIZE_CHG) {
-        if(obj->realign.auto_realign) {
+        if(SIDE(obj)->realign.auto_realign) {
             lv_obj_realign(obj);
         }
     }
@@ -4043,7 +4581,7 @@ static lv_res_t lv_obj_signal(lv_obj_t * obj, lv_signal_t sign, void * param)
 static void refresh_children_position(lv_obj_t * obj, lv_coord_t x_diff, lv_coord_t y_diff)
 {
     lv_obj_t * i;
-    _LV_LL_READ(obj->child_ll, i) {
+    _LV_OBJ_CHILD_READ(obj, i) {
         i->coords.x1 += x_diff;
         i->coords.y1 += y_diff;
         i->coords.x2 += x_diff;
@@ -4314,7 +4852,9 @@ static lv_style_trans_t * trans_create(lv_obj_t * obj, lv_style_property_t prop,
             }
         }
 
+        _lv_mem_tag_push(LV_MEM_TAG_STYLE);
         tr = _lv_ll_ins_head(&LV_GC_ROOT(_lv_obj_style_trans_ll));
+        _lv_mem_tag_pop();
         LV_ASSERT_MEM(tr);
         if(tr == NULL) return NULL;
         tr->start_value._int = int1;
@@ -4336,7 +4876,9 @@ static lv_style_trans_t * trans_create(lv_obj_t * obj, lv_style_property_t prop,
         obj->state = new_state;
         _lv_style_set_color(style_trans, prop, c1);    /*Be sure `trans_style` has a valid value */
 
+        _lv_mem_tag_push(LV_MEM_TAG_STYLE);
         tr = _lv_ll_ins_head(&LV_GC_ROOT(_lv_obj_style_trans_ll));
+        _lv_mem_tag_pop();
         LV_ASSERT_MEM(tr);
         if(tr == NULL) return NULL;
         tr->start_value._color = c1;
@@ -4359,7 +4901,9 @@ static lv_style_trans_t * trans_create(lv_obj_t * obj, lv_style_property_t prop,
         obj->state = new_state;
         _lv_style_set_opa(style_trans, prop, o1);   /*Be sure `trans_style` has a valid value */
 
+        _lv_mem_tag_push(LV_MEM_TAG_STYLE);
         tr = _lv_ll_ins_head(&LV_GC_ROOT(_lv_obj_style_trans_ll));
+        _lv_mem_tag_pop();
         LV_ASSERT_MEM(tr);
         if(tr == NULL) return NULL;
         tr->start_value._opa = o1;
@@ -4381,7 +4925,9 @@ static lv_style_trans_t * trans_create(lv_obj_t * obj, lv_style_property_t prop,
         obj->state = new_state;
         _lv_style_set_ptr(style_trans, prop, p1);   /*Be sure `trans_style` has a valid value */
 
+        _lv_mem_tag_push(LV_MEM_TAG_STYLE);
         tr = _lv_ll_ins_head(&LV_GC_ROOT(_lv_obj_style_trans_ll));
+        _lv_mem_tag_pop();
         LV_ASSERT_MEM(tr);
         if(tr == NULL) return NULL;
         tr->start_value._ptr = p1;
@@ -4539,11 +5085,110 @@ static void lv_event_mark_deleted(lv_obj_t * obj)
     }
 }
 
+#if LV_USE_DEBUG && LV_USE_ASSERT_OBJ
+/**
+ * Add a new object to the table of the live objects.
+ * The table is doubled when it would be more than 3/4 full to keep the searches short.
+ * @param obj pointer to an object
+ */
+static void valid_tbl_add(lv_obj_t * obj)
+{
+    if((valid_tbl_cnt + 1) * 4 > valid_tbl_size * 3) {
+        uint32_t new_size = valid_tbl_size ? valid_tbl_size * 2 : 32;
+        lv_obj_t ** new_tbl = lv_mem_alloc_tag(new_size * sizeof(lv_obj_t *), LV_MEM_TAG_OBJ);
+        if(new_tbl == NULL) {
+            LV_LOG_WARN("valid_tbl_add: couldn't grow the table. Search the objects in the hierarchy.");
+            valid_tbl_lost = true;
+            return;
+        }
+        _lv_memset_00(new_tbl, new_size * sizeof(lv_obj_t *));
+
+        lv_obj_t ** old_tbl = LV_GC_ROOT(_lv_obj_valid_tbl);
+        uint32_t old_size = valid_tbl_size;
+        LV_GC_ROOT(_lv_obj_valid_tbl) = new_tbl;
+        valid_tbl_size = new_size;
+        valid_tbl_cnt = 0;
+
+        uint32_t i;
+        for(i = 0; i < old_size; i++) {
+            if(old_tbl[i]) valid_tbl_add(old_tbl[i]);
+        }
+        lv_mem_free(old_tbl);
+    }
+
+    /*Linear probing: store in the first empty slot from the hashed one*/
+    lv_obj_t ** tbl = LV_GC_ROOT(_lv_obj_valid_tbl);
+    uint32_t mask = valid_tbl_size - 1;
+    uint32_t i = valid_tbl_hash(obj) & mask;
+    while(tbl[i]) i = (i + 1) & mask;
+
+    tbl[i] = obj;
+    valid_tbl_cnt++;
+}
+
+/**
+ * Remove a deleted object from the table of the live objects
+ * @param obj pointer to an object
+ */
+static void valid_tbl_remove(const lv_obj_t * obj)
+{
+    uint32_t i = valid_tbl_find(obj);
+    if(i == VALID_TBL_NONE) return;
+
+    /* Fill the gap with the following objects which wouldn't be found after an empty slot.
+     * This way no "deleted" marks are required.*/
+    lv_obj_t ** tbl = LV_GC_ROOT(_lv_obj_valid_tbl);
+    uint32_t mask = valid_tbl_size - 1;
+    uint32_t j = i;
+    while(1) {
+        j = (j + 1) & mask;
+        if(tbl[j] == NULL) break;
+
+        /*Keep it if its hashed slot is after the gap*/
+        uint32_t h = valid_tbl_hash(tbl[j]) & mask;
+        if(((j - h) & mask) < ((j - i) & mask)) continue;
+
+        tbl[i] = tbl[j];
+        i = j;
+    }
+
+    tbl[i] = NULL;
+    valid_tbl_cnt--;
+}
+
+/**
+ * Search an object in the table of the live objects
+ * @param obj pointer to an object
+ * @return index of the object's slot or `VALID_TBL_NONE` if not found
+ */
+static uint32_t valid_tbl_find(const lv_obj_t * obj)
+{
+    if(valid_tbl_size == 0) return VALID_TBL_NONE;
+
+    lv_obj_t ** tbl = LV_GC_ROOT(_lv_obj_valid_tbl);
+    uint32_t mask = valid_tbl_size - 1;
+    uint32_t i = valid_tbl_hash(obj) & mask;
+    while(tbl[i]) {
+        if(tbl[i] == obj) return i;
+        i = (i + 1) & mask;
+    }
+
+    return VALID_TBL_NONE;
+}
+
+static inline uint32_t valid_tbl_hash(const lv_obj_t * obj)
+{
+    /*Fibonacci hashing. The lowest bits of the address are always 0 due to the alignment.*/
+    uint32_t h = (uint32_t)((lv_uintptr_t)obj >> 2) * 2654435769U;
+    return h ^ (h >> 16);
+}
+#endif
+
 static bool obj_valid_child(const lv_obj_t * parent, const lv_obj_t * obj_to_find)
 {
     /*Check all children of `parent`*/
     lv_obj_t * child;
-    _LV_LL_READ(parent->child_ll, child) {
+    _LV_OBJ_CHILD_READ(parent, child) {
         if(child == obj_to_find) return true;
 
         /*Check the children*/
@@ -43,6 +43,8 @@ extern "C" {
 
 #define LV_MAX_ANCESTOR_NUM 8
 
+#define LV_DEBUG_OBJ_SENTINEL_VALUE 0x5AC3E10B
+
 #define LV_EXT_CLICK_AREA_OFF  0
 #define LV_EXT_CLICK_AREA_TINY 1
 #define LV_EXT_CLICK_AREA_FULL 2
@@ -193,24 +195,62 @@ enum {
 
 typedef uint8_t lv_state_t;
 
+#if LV_OBJ_SIDE_TABLE
+/** The rarely used attributes of an object. Allocated only when any of them is set.*/
+typedef struct {
+    lv_event_cb_t event_cb; /**< Event callback function */
+
+#if LV_USE_EXT_CLICK_AREA == LV_EXT_CLICK_AREA_TINY
+    uint8_t ext_click_pad_hor; /**< Extra click padding in horizontal direction */
+    uint8_t ext_click_pad_ver; /**< Extra click padding in vertical direction */
+#elif LV_USE_EXT_CLICK_AREA == LV_EXT_CLICK_AREA_FULL
+    lv_area_t ext_click_pad;   /**< Extra click padding area. */
+#endif
+
+#if LV_USE_GROUP != 0
+    void * group_p;
+#endif
+
+#if LV_USE_OBJ_REALIGN
+    lv_realign_t realign;       /**< Information about the last call to ::lv_obj_align. */
+#endif
+
+#if LV_USE_USER_DATA
+    lv_obj_user_data_t user_data; /**< Custom user data for object. */
+#endif
+} lv_obj_side_t;
+#endif
+
 typedef struct _lv_obj_t {
     struct _lv_obj_t * parent; /**< Pointer to the parent object*/
-    lv_ll_t child_ll;       /**< Linked list to store the children objects*/
+#if LV_USE_DEBUG && LV_USE_ASSERT_OBJ
+    uint32_t sentinel;      /**< `LV_DEBUG_OBJ_SENTINEL_VALUE` while the object is alive*/
+#endif
+    struct _lv_obj_t ** children; /**< The children from the background to the foreground (NULL if no children)*/
+    uint32_t child_cnt;     /**< Number of children*/
+    uint32_t child_cap;     /**< Number of children `children` has room for*/
+    uint32_t child_id;      /**< Index of the object in the `children` of its parent*/
 
     lv_area_t coords; /**< Coordinates of the object (x1, y1, x2, y2)*/
 
+#if LV_OBJ_SIDE_TABLE
+    lv_obj_side_t * side;   /**< The rarely used attributes or NULL if none of them is set*/
+#else
     lv_event_cb_t event_cb; /**< Event callback function */
+#endif
     lv_signal_cb_t signal_cb; /**< Object type specific signal function*/
     lv_design_cb_t design_cb; /**< Object type specific design function*/
 
     void * ext_attr;            /**< Object type specific extended data*/
     lv_style_list_t style_list;
 
+#if LV_OBJ_SIDE_TABLE == 0
 #if LV_USE_EXT_CLICK_AREA == LV_EXT_CLICK_AREA_TINY
     uint8_t ext_click_pad_hor; /**< Extra click padding in horizontal direction */
     uint8_t ext_click_pad_ver; /**< Extra click padding in vertical direction */
 #elif LV_USE_EXT_CLICK_AREA == LV_EXT_CLICK_AREA_FULL
     lv_area_t ext_click_pad;   /**< Extra click padding area. */
+#endif
 #endif
 
     lv_coord_t ext_draw_pad; /**< EXTend the size in every direction for drawing. */
@@ -230,7 +270,7 @@ typedef struct _lv_obj_t {
     lv_drag_dir_t drag_dir  : 3; /**<  Which directions the object can be dragged in */
     lv_bidi_dir_t base_dir  : 2; /**< Base direction of texts related to this object */
 
-#if LV_USE_GROUP != 0
+#if LV_USE_GROUP != 0 && LV_OBJ_SIDE_TABLE == 0
     void * group_p;
 #endif
 
@@ -238,11 +278,11 @@ typedef struct _lv_obj_t {
                                      'OR'ed values from `lv_protect_t`*/
     lv_state_t state;
 
-#if LV_USE_OBJ_REALIGN
+#if LV_USE_OBJ_REALIGN && LV_OBJ_SIDE_TABLE == 0
     lv_realign_t realign;       /**< Information about the last call to ::lv_obj_align. */
 #endif
 
-#if LV_USE_USER_DATA
+#if LV_USE_USER_DATA && LV_OBJ_SIDE_TABLE == 0
     lv_obj_user_data_t user_data; /**< Custom user data for object. */
 #endif
 
@@ -308,6 +348,21 @@ void lv_deinit(void);
  */
 lv_obj_t * lv_obj_create(lv_obj_t * parent, const lv_obj_t * copy);
 
+#if LV_MEM_ARENA_CNT
+/**
+ * Create a screen with its own arena. The objects created on the screen, their `ext_attr`s, children arrays
+ * and style lists are allocated from the arena and deleting the screen frees the arena at once.
+ * The objects still get `LV_EVENT_DELETE` and `LV_SIGNAL_CLEANUP` one by one (e.g. to free the texts of the labels)
+ * so the deletion still takes time in proportion to the number of objects.
+ * The memories of the deleted objects are given back to the arena only if they are on its top,
+ * so it's useful for screens which are created and deleted as a whole.
+ * If the arena is full the new memories are allocated with `lv_mem_alloc`.
+ * @param arena_size size of the arena in bytes. See `lv_obj_get_arena()` to measure it.
+ * @return pointer to the new screen. If the arena can't be created it's a normal screen.
+ */
+lv_obj_t * lv_obj_create_scr_arena(uint32_t arena_size);
+#endif
+
 /**
  * Delete 'obj' and all of its children
  * @param obj pointer to an object to delete
@@ -527,6 +582,18 @@ void lv_obj_align_mid_x(lv_obj_t * obj, const lv_obj_t * base, lv_align_t align,
  */
 void lv_obj_align_mid_y(lv_obj_t * obj, const lv_obj_t * base, lv_align_t align, lv_coord_t y_ofs);
 
+/**
+ * Align an object to an other object without saving the parameters for `lv_obj_realign`.
+ * Used by the layouts which align all the children anyway.
+ * @param obj pointer to an object to align
+ * @param base pointer to an object (if NULL the parent is used). 'obj' will be aligned to it.
+ * @param align type of alignment (see 'lv_align_t' enum)
+ * @param x_ofs x coordinate offset after alignment
+ * @param y_ofs y coordinate offset after alignment
+ */
+void _lv_obj_align_no_save(lv_obj_t * obj, const lv_obj_t * base, lv_align_t align, lv_coord_t x_ofs,
+                           lv_coord_t y_ofs);
+
 /**
  * Realign the object based on the last `lv_obj_align` parameters.
  * @param obj pointer to an object
@@ -975,6 +1042,30 @@ uint16_t lv_obj_count_children(const lv_obj_t * obj);
  */
 uint16_t lv_obj_count_children_recursive(const lv_obj_t * obj);
 
+/**
+ * Get a child of an object by its index
+ * @param obj pointer to an object
+ * @param id index of the child. 0: the "oldest" child in the background
+ * @return pointer to the child or NULL if `id` is out of range
+ */
+lv_obj_t * lv_obj_get_child_by_id(const lv_obj_t * obj, uint32_t id);
+
+/**
+ * Get the index of an object among the children of its parent
+ * @param obj pointer to an object
+ * @return index of the object. 0: the "oldest" child in the background. Always 0 for screens.
+ */
+uint32_t lv_obj_get_child_id(const lv_obj_t * obj);
+
+#if LV_MEM_ARENA_CNT
+/**
+ * Get the arena of the screen of an object to see its usage
+ * @param obj pointer to an object
+ * @return the arena or NULL if the screen was not created by `lv_obj_create_scr_arena()`
+ */
+const lv_mem_arena_t * lv_obj_get_arena(const lv_obj_t * obj);
+#endif
+
 /*---------------------
  * Coordinate get
  *--------------------*/
@@ -1366,6 +1457,23 @@ void * lv_obj_get_ext_attr(const lv_obj_t * obj);
  */
 void lv_obj_get_type(const lv_obj_t * obj, lv_obj_type_t * buf);
 
+#if LV_MEM_PROFILER
+/**
+ * Get the memory used by the objects of a type on all displays.
+ * The objects, their `ext_attr` and the style list of their main part are counted.
+ * @param type name of a type, e.g. "lv_btn" or NULL to count every object
+ * @param cnt store the number of objects here. Can be NULL.
+ * @return the used memory in bytes
+ */
+uint32_t lv_obj_mem_prof_get_type_size(const char * type, uint32_t * cnt);
+
+/**
+ * Log the number of objects and their memory usage per object type with `LV_LOG_USER`.
+ * The objects, their `ext_attr` and the style list of their main part are counted.
+ */
+void lv_obj_mem_prof_dump(void);
+#endif
+
 #if LV_USE_USER_DATA
 /**
  * Get the object's user data
@@ -1397,6 +1505,13 @@ void lv_obj_set_user_data(lv_obj_t * obj, lv_obj_user_data_t data);
  */
 void * lv_obj_get_group(const lv_obj_t * obj);
 
+/**
+ * Set the group of the object. Only for `lv_group`, use `lv_group_add_obj()` to add an object to a group.
+ * @param obj pointer to an object
+ * @param group pointer to a group or NULL
+ */
+void _lv_obj_set_group(lv_obj_t * obj, void * group);
+
 /**
  * Tell whether the object is the focused object of a group or not.
  * @param obj pointer to an object
@@ -1471,9 +1586,9 @@ void lv_obj_fade_out(lv_obj_t * obj, uint32_t time, uint32_t delay);
 bool lv_debug_check_obj_type(const lv_obj_t * obj, const char * obj_type);
 
 /**
- * Check if any object is still "alive", and part of the hierarchy
+ * Check if any object is still "alive", and part of the hierarchy.
+ * With `LV_USE_ASSERT_OBJ` the live objects are kept in a hash table so it's constant time.
  * @param obj pointer to an object
- * @param obj_type type of the object. (e.g. "lv_btn")
  * @return true: valid
  */
 bool lv_debug_check_obj_valid(const lv_obj_t * obj);
@@ -1498,6 +1613,22 @@ bool lv_debug_check_obj_valid(const lv_obj_t * obj);
  */
 #define LV_EVENT_CB_DECLARE(name) static void name(lv_obj_t * obj, lv_event_t e)
 
+/**
+ * Iterate through the children of an object from the "youngest" (foreground) to the "oldest" (background)
+ * like `_LV_LL_READ`. The children must not be added or removed in the loop.
+ */
+#define _LV_OBJ_CHILD_READ(obj, child)                                                          \
+    for(child = (obj)->child_cnt ? (obj)->children[(obj)->child_cnt - 1] : NULL; child != NULL; \
+        child = child->child_id ? (obj)->children[child->child_id - 1] : NULL)
+
+/**
+ * Iterate through the children of an object from the "oldest" (background) to the "youngest" (foreground)
+ * like `_LV_LL_READ_BACK`. The children must not be added or removed in the loop.
+ */
+#define _LV_OBJ_CHILD_READ_BACK(obj, child)                                  \
+    for(child = (obj)->child_cnt ? (obj)->children[0] : NULL; child != NULL; \
+        child = child->child_id + 1 < (obj)->child_cnt ? (obj)->children[child->child_id + 1] : NULL)
+
 #if LV_USE_DEBUG
 
 # ifndef LV_DEBUG_IS_OBJ
@@ -598,9 +598,10 @@ static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj)
         }
 #endif
 
-        lv_obj_t * i;
-        _LV_LL_READ(obj->child_ll, i) {
-            found_p = lv_refr_get_top_obj(area_p, i);
+        /*Start from the foreground*/
+        uint32_t i;
+        for(i = obj->child_cnt; i > 0; i--) {
+            found_p = lv_refr_get_top_obj(area_p, obj->children[i - 1]);
 
             /*If a children is ok then break*/
             if(found_p != NULL) {
@@ -644,12 +645,10 @@ static void lv_refr_obj_and_children(lv_obj_t * top_p, const lv_area_t * mask_p)
     /*Do until not reach the screen*/
     while(par != NULL) {
         /*object before border_p has to be redrawn*/
-        lv_obj_t * i = _lv_ll_get_prev(&(par->child_ll), border_p);
-
-        while(i != NULL) {
+        uint32_t i;
+        for(i = border_p->child_id + 1; i < par->child_cnt; i++) {
             /*Refresh the objects*/
-            lv_refr_obj(i, mask_p);
-            i = _lv_ll_get_prev(&(par->child_ll), i);
+            lv_refr_obj(par->children[i], mask_p);
         }
 
         /*Call the post draw design function of the parents of the to object*/
@@ -715,9 +714,11 @@ static void lv_refr_obj(lv_obj_t * obj, const lv_area_t * mask_ori_p)
         union_ok = _lv_area_intersect(&obj_mask, mask_ori_p, &obj_area);
         if(union_ok != false) {
             lv_area_t mask_child; /*Mask from obj and its child*/
-            lv_obj_t * child_p;
             lv_area_t child_area;
-            _LV_LL_READ_BACK(obj->child_ll, child_p) {
+            uint32_t i;
+            /*Draw from the background to the foreground*/
+            for(i = 0; i < obj->child_cnt; i++) {
+                lv_obj_t * child_p = obj->children[i];
                 lv_obj_get_coords(child_p, &child_area);
                 ext_size = child_p->ext_draw_pad;
                 child_area.x1 -= ext_size;
@@ -28,6 +28,7 @@ static inline uint8_t get_style_prop_id(const lv_style_t * style, size_t idx);
 static inline uint8_t get_style_prop_attr(const lv_style_t * style, size_t idx);
 static inline size_t get_prop_size(uint8_t prop_id);
 static inline size_t get_next_prop_index(uint8_t prop_id, size_t id);
+static inline void * style_mem_alloc(const void * owner, size_t size);
 
 /**********************
  *  GLOBAL VARIABLES
@@ -69,7 +70,7 @@ void lv_style_copy(lv_style_t * style_dest, const lv_style_t * style_src)
     uint16_t size = _lv_style_get_mem_size(style_src);
     if(size == 0) return;
 
-    style_dest->map = lv_mem_alloc(size);
+    style_dest->map = style_mem_alloc(style_dest, size);
     if(style_dest->map)
         _lv_memcpy(style_dest->map, style_src->map, size);
 }
@@ -140,14 +141,14 @@ void lv_style_list_copy(lv_style_list_t * list_dest, const lv_style_list_t * lis
     /*Copy the styles but skip the transitions*/
     if(list_src->has_local == 0) {
         if(list_src->has_trans) {
-            list_dest->style_list = lv_mem_alloc((list_src->style_cnt - 1) * sizeof(lv_style_t *));
+            list_dest->style_list = style_mem_alloc(list_dest, (list_src->style_cnt - 1) * sizeof(lv_style_t *));
             if(list_dest->style_list) {
                 _lv_memcpy(list_dest->style_list, list_src->style_list + 1, (list_src->style_cnt - 1) * sizeof(lv_style_t *));
                 list_dest->style_cnt = list_src->style_cnt - 1;
             }
         }
         else {
-            list_dest->style_list = lv_mem_alloc(list_src->style_cnt * sizeof(lv_style_t *));
+            list_dest->style_list = style_mem_alloc(list_dest, list_src->style_cnt * sizeof(lv_style_t *));
             if(list_dest->style_list) {
                 _lv_memcpy(list_dest->style_list, list_src->style_list, list_src->style_cnt * sizeof(lv_style_t *));
                 list_dest->style_cnt = list_src->style_cnt;
@@ -156,14 +157,14 @@ void lv_style_list_copy(lv_style_list_t * list_dest, const lv_style_list_t * lis
     }
     else {
         if(list_src->has_trans) {
-            list_dest->style_list = lv_mem_alloc((list_src->style_cnt - 2) * sizeof(lv_style_t *));
+            list_dest->style_list = style_mem_alloc(list_dest, (list_src->style_cnt - 2) * sizeof(lv_style_t *));
             if(list_dest->style_list) {
                 _lv_memcpy(list_dest->style_list, list_src->style_list + 2, (list_src->style_cnt - 2) * sizeof(lv_style_t *));
                 list_dest->style_cnt = list_src->style_cnt - 2;
             }
         }
         else {
-            list_dest->style_list = lv_mem_alloc((list_src->style_cnt - 1) * sizeof(lv_style_t *));
+            list_dest->style_list = style_mem_alloc(list_dest, (list_src->style_cnt - 1) * sizeof(lv_style_t *));
             if(list_dest->style_list) {
                 _lv_memcpy(list_dest->style_list, list_src->style_list + 1, (list_src->style_cnt - 1) * sizeof(lv_style_t *));
                 list_dest->style_cnt = list_src->style_cnt - 1;
@@ -194,8 +195,9 @@ void _lv_style_list_add_style(lv_style_list_t * list, lv_style_t * style)
     _lv_style_list_remove_style(list, style);
 
     lv_style_t ** new_styles;
-    if(list->style_cnt == 0) new_styles = lv_mem_alloc(sizeof(lv_style_t *));
-    else new_styles = lv_mem_realloc(list->style_list, sizeof(lv_style_t *) * (list->style_cnt + 1));
+    if(list->style_cnt == 0) new_styles = style_mem_alloc(list, sizeof(lv_style_t *));
+    else new_styles = _lv_mem_arena_realloc(NULL, list->style_list, sizeof(lv_style_t *) * (list->style_cnt + 1),
+                                                LV_MEM_TAG_STYLE);
     LV_ASSERT_MEM(new_styles);
     if(new_styles == NULL) {
         LV_LOG_WARN("lv_style_list_add_style: couldn't add the style");
@@ -240,14 +242,14 @@ void _lv_style_list_remove_style(lv_style_list_t * list, lv_style_t * style)
     if(found == false) return;
 
     if(list->style_cnt == 1) {
-        lv_mem_free(list->style_list);
+        _lv_mem_arena_free(list->style_list);
         list->style_list = NULL;
         list->style_cnt = 0;
         list->has_local = 0;
         return;
     }
 
-    lv_style_t ** new_styles = lv_mem_alloc(sizeof(lv_style_t *) * (list->style_cnt - 1));
+    lv_style_t ** new_styles = style_mem_alloc(list, sizeof(lv_style_t *) * (list->style_cnt - 1));
     LV_ASSERT_MEM(new_styles);
     if(new_styles == NULL) {
         LV_LOG_WARN("lv_style_list_remove_style: couldn't reallocate style list");
@@ -259,7 +261,7 @@ void _lv_style_list_remove_style(lv_style_list_t * list, lv_style_t * style)
         new_styles[j++] = list->style_list[i];
     }
 
-    lv_mem_free(list->style_list);
+    _lv_mem_arena_free(list->style_list);
 
     list->style_cnt--;
     list->style_list = new_styles;
@@ -280,7 +282,7 @@ void _lv_style_list_reset(lv_style_list_t * list)
         lv_style_t * local = lv_style_list_get_local_style(list);
         if(local) {
             lv_style_reset(local);
-            lv_mem_free(local);
+            _lv_mem_arena_free(local);
         }
     }
 
@@ -288,11 +290,11 @@ void _lv_style_list_reset(lv_style_list_t * list)
         lv_style_t * trans = _lv_style_list_get_transition_style(list);
         if(trans) {
             lv_style_reset(trans);
-            lv_mem_free(trans);
+            _lv_mem_arena_free(trans);
         }
     }
 
-    if(list->style_cnt > 0) lv_mem_free(list->style_list);
+    if(list->style_cnt > 0) _lv_mem_arena_free(list->style_list);
     list->style_list = NULL;
     list->style_cnt = 0;
     list->has_local = 0;
@@ -309,7 +311,7 @@ void _lv_style_list_reset(lv_style_list_t * list)
  */
 void lv_style_reset(lv_style_t * style)
 {
-    lv_mem_free(style->map);
+    _lv_mem_arena_free(style->map);
     lv_style_init(style);
 }
 
@@ -651,7 +653,7 @@ lv_style_t * _lv_style_list_add_trans_style(lv_style_list_t * list)
     LV_ASSERT_STYLE_LIST(list);
     if(list->has_trans) return _lv_style_list_get_transition_style(list);
 
-    lv_style_t * trans_style = lv_mem_alloc(sizeof(lv_style_t));
+    lv_style_t * trans_style = style_mem_alloc(list, sizeof(lv_style_t));
     LV_ASSERT_MEM(trans_style);
     if(trans_style == NULL) {
         LV_LOG_WARN("lv_style_list_add_trans_style: couldn't create transition style");
@@ -1043,7 +1045,7 @@ static lv_style_t * get_alloc_local_style(lv_style_list_t * list)
 
     if(list->has_local) return lv_style_list_get_style(list, list->has_trans ? 1 : 0);
 
-    lv_style_t * local_style = lv_mem_alloc(sizeof(lv_style_t));
+    lv_style_t * local_style = style_mem_alloc(list, sizeof(lv_style_t));
     LV_ASSERT_MEM(local_style);
     if(local_style == NULL) {
         LV_LOG_WARN("get_local_style: couldn't create local style");
@@ -1065,12 +1067,24 @@ static lv_style_t * get_alloc_local_style(lv_style_list_t * list)
  */
 static inline bool style_resize(lv_style_t * style, size_t sz)
 {
-    uint8_t * new_map = lv_mem_realloc(style->map, sz);
+    uint8_t * new_map = _lv_mem_arena_realloc(_lv_mem_arena_find(style), style->map, sz, LV_MEM_TAG_STYLE);
     if(sz && new_map == NULL) return false;
     style->map = new_map;
     return true;
 }
 
+/**
+ * Allocate a memory for a style or a style list.
+ * If `owner` is in an arena (e.g. a part of an object on a screen with arena) the memory is allocated there too.
+ * @param owner pointer to the style or style list which will own the memory
+ * @param size size of the memory in bytes
+ * @return pointer to the allocated memory
+ */
+static inline void * style_mem_alloc(const void * owner, size_t size)
+{
+    return _lv_mem_arena_realloc(_lv_mem_arena_find(owner), NULL, size, LV_MEM_TAG_STYLE);
+}
+
 /**
  * Get style property in index.
  * @param style pointer to style.
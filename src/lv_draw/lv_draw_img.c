@@ -23,9 +23,35 @@
  *      DEFINES
  *********************/
 
+#if LV_USE_IMG_TRANSFORM && LV_IMG_TRANSFORM_ROW_CACHE_SIZE < 9 * LV_IMG_PX_SIZE_ALPHA_BYTE
+#error "LV_IMG_TRANSFORM_ROW_CACHE_SIZE is too small: at least 3x3 source pixels are required to draw a pixel"
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
+/*The ways `lv_draw_map` can write the pixels of an image into the draw buffer*/
+typedef enum {
+    BLIT_GENERIC,       /*Build a color and a mask buffer pixel-by-pixel and blend them*/
+    BLIT_COPY,          /*Blend the map as it is (plain row copy with full opacity)*/
+    BLIT_CHROMA_KEYED,  /*Write the not chroma keyed pixels directly into the draw buffer*/
+    BLIT_ALPHA,         /*Mix the pixels directly into the draw buffer by their alpha byte*/
+} blit_mode_t;
+
+#if LV_USE_IMG_TRANSFORM
+/*Data to draw a transformed image which can be read only line-by-line*/
+typedef struct {
+    const lv_area_t * coords;
+    const lv_draw_img_dsc_t * draw_dsc;
+    lv_img_decoder_dsc_t * dec_dsc;
+    lv_img_transform_dsc_t trans_dsc;   /*Only to get the source coordinates*/
+    uint8_t * rows;                     /*The loaded source rows*/
+    lv_area_t rows_area;                /*The part of the image in `rows`*/
+    uint8_t px_size;
+    bool chroma_keyed;
+    bool alpha_byte;
+} transform_lines_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
@@ -39,8 +65,26 @@ LV_ATTRIBUTE_FAST_MEM static void lv_draw_map(const lv_area_t * map_area, const
                                               const lv_draw_img_dsc_t * draw_dsc,
                                               bool chroma_key, bool alpha_byte);
 
+static blit_mode_t get_blit_mode(const lv_disp_t * disp, const lv_draw_img_dsc_t * draw_dsc, bool chroma_key,
+                                 bool alpha_byte);
+LV_ATTRIBUTE_FAST_MEM static void blit_chroma_keyed(lv_disp_buf_t * vdb, const lv_area_t * map_area,
+                                                    const lv_area_t * draw_area, const uint8_t * map_p, lv_opa_t opa);
+LV_ATTRIBUTE_FAST_MEM static void blit_alpha(lv_disp_buf_t * vdb, const lv_area_t * map_area,
+                                             const lv_area_t * draw_area, const uint8_t * map_p, lv_opa_t opa, bool antialias);
+static inline lv_color_t read_color(const uint8_t * px);
 static void show_error(const lv_area_t * coords, const lv_area_t * clip_area, const char * msg);
 static void draw_cleanup(lv_img_cache_entry_t * cache);
+static void get_draw_area(const lv_area_t * coords, const lv_draw_img_dsc_t * draw_dsc, lv_area_t * res);
+#if LV_USE_IMG_TRANSFORM
+static lv_res_t draw_transformed_lines(const lv_area_t * coords, const lv_area_t * clip_area,
+                                       lv_img_decoder_dsc_t * dec_dsc, const lv_draw_img_dsc_t * draw_dsc,
+                                       bool chroma_keyed, bool alpha_byte);
+static lv_res_t draw_transformed_tile(transform_lines_t * tl, const lv_area_t * tile);
+static lv_res_t load_rows(transform_lines_t * tl, const lv_area_t * src_area);
+#endif
+#if LV_IMG_CACHE_ASYNC
+static void draw_placeholder(const lv_area_t * coords, const lv_area_t * clip_area, const lv_draw_img_dsc_t * draw_dsc);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -94,7 +138,7 @@ void lv_draw_img(const lv_area_t * coords, const lv_area_t * mask, const void *
 /**
  * Get the pixel size of a color format in bits
  * @param cf a color format (`LV_IMG_CF_...`)
- * @return the pixel size in bits
+ * @return the pixel size in bits. The size of the decoded pixels for `LV_IMG_CF_RLE_...` formats.
  */
 uint8_t lv_img_cf_get_px_size(lv_img_cf_t cf)
 {
@@ -107,9 +151,12 @@ uint8_t lv_img_cf_get_px_size(lv_img_cf_t cf)
             break;
         case LV_IMG_CF_TRUE_COLOR:
         case LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED:
+        case LV_IMG_CF_RLE_TRUE_COLOR:
+        case LV_IMG_CF_RLE_TRUE_COLOR_CHROMA_KEYED:
             px_size = LV_COLOR_SIZE;
             break;
         case LV_IMG_CF_TRUE_COLOR_ALPHA:
+        case LV_IMG_CF_RLE_TRUE_COLOR_ALPHA:
             px_size = LV_IMG_PX_SIZE_ALPHA_BYTE << 3;
             break;
         case LV_IMG_CF_INDEXED_1BIT:
@@ -148,6 +195,7 @@ bool lv_img_cf_is_chroma_keyed(lv_img_cf_t cf)
     switch(cf) {
         case LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED:
         case LV_IMG_CF_RAW_CHROMA_KEYED:
+        case LV_IMG_CF_RLE_TRUE_COLOR_CHROMA_KEYED:
         case LV_IMG_CF_INDEXED_1BIT:
         case LV_IMG_CF_INDEXED_2BIT:
         case LV_IMG_CF_INDEXED_4BIT:
@@ -175,6 +223,7 @@ bool lv_img_cf_has_alpha(lv_img_cf_t cf)
     switch(cf) {
         case LV_IMG_CF_TRUE_COLOR_ALPHA:
         case LV_IMG_CF_RAW_ALPHA:
+        case LV_IMG_CF_RLE_TRUE_COLOR_ALPHA:
         case LV_IMG_CF_INDEXED_1BIT:
         case LV_IMG_CF_INDEXED_2BIT:
         case LV_IMG_CF_INDEXED_4BIT:
@@ -236,7 +285,20 @@ LV_ATTRIBUTE_FAST_MEM static lv_res_t lv_img_draw_core(const lv_area_t * coords,
 {
     if(draw_dsc->opa <= LV_OPA_MIN) return LV_RES_OK;
 
+#if LV_IMG_CACHE_ASYNC
+    /*Draw a placeholder until the image is opened and invalidate the image's area then*/
+    lv_area_t inv_area;
+    get_draw_area(coords, draw_dsc, &inv_area);
+    bool pending;
+    lv_img_cache_entry_t * cdsc = _lv_img_cache_open_async(src, draw_dsc->recolor, LV_IMG_CACHE_PRIO_VISIBLE,
+                                                           &inv_area, &pending);
+    if(pending) {
+        draw_placeholder(coords, clip_area, draw_dsc);
+        return LV_RES_OK;
+    }
+#else
     lv_img_cache_entry_t * cdsc = _lv_img_cache_open(src, draw_dsc->recolor);
+#endif
 
     if(cdsc == NULL) return LV_RES_INV;
 
@@ -252,20 +314,49 @@ LV_ATTRIBUTE_FAST_MEM static lv_res_t lv_img_draw_core(const lv_area_t * coords,
      * Just draw it!*/
     else if(cdsc->dec_dsc.img_data) {
         lv_area_t map_area_rot;
-        lv_area_copy(&map_area_rot, coords);
-        if(draw_dsc->angle || draw_dsc->zoom != LV_IMG_ZOOM_NONE) {
-            int32_t w = lv_area_get_width(coords);
-            int32_t h = lv_area_get_height(coords);
+        get_draw_area(coords, draw_dsc, &map_area_rot);
 
-            _lv_img_buf_get_transformed_area(&map_area_rot, w, h, draw_dsc->angle, draw_dsc->zoom, &draw_dsc->pivot);
+        lv_area_t mask_com; /*Common area of mask and coords*/
+        bool union_ok;
+        union_ok = _lv_area_intersect(&mask_com, clip_area, &map_area_rot);
+        /*Out of mask. There is nothing to draw so the image is drawn successfully.*/
+        if(union_ok == false) {
+            draw_cleanup(cdsc);
+            return LV_RES_OK;
+        }
 
-            map_area_rot.x1 += coords->x1;
-            map_area_rot.y1 += coords->y1;
-            map_area_rot.x2 += coords->x1;
-            map_area_rot.y2 += coords->y1;
+#if LV_IMG_CACHE_MIPMAP
+        /*Draw the zoomed out images from a downscaled level*/
+        uint8_t level;
+        const uint8_t * level_data = _lv_img_cache_get_mipmap(cdsc, draw_dsc->zoom, &level);
+        if(level) {
+            lv_draw_img_dsc_t level_dsc;
+            _lv_memcpy_small(&level_dsc, draw_dsc, sizeof(level_dsc));
+            level_dsc.zoom = draw_dsc->zoom << level;
+            level_dsc.pivot.x = draw_dsc->pivot.x >> level;
+            level_dsc.pivot.y = draw_dsc->pivot.y >> level;
+
+            /*Place the level to keep the pivot where it is on the original image*/
+            lv_area_t level_coords;
+            level_coords.x1 = coords->x1 + draw_dsc->pivot.x - level_dsc.pivot.x;
+            level_coords.y1 = coords->y1 + draw_dsc->pivot.y - level_dsc.pivot.y;
+            lv_area_set_width(&level_coords, cdsc->dec_dsc.header.w >> level);
+            lv_area_set_height(&level_coords, cdsc->dec_dsc.header.h >> level);
+
+            lv_draw_map(&level_coords, &mask_com, level_data, &level_dsc, chroma_keyed, alpha_byte);
         }
+        else
+#endif
+        lv_draw_map(coords, &mask_com, cdsc->dec_dsc.img_data, draw_dsc, chroma_keyed, alpha_byte);
+    }
+#if LV_USE_IMG_TRANSFORM
+    /* The image is transformed but it can be read only line-by-line.
+     * Draw it in tiles and read only the source rows required by a tile*/
+    else if(draw_dsc->angle != 0 || draw_dsc->zoom != LV_IMG_ZOOM_NONE) {
+        lv_area_t map_area_rot;
+        get_draw_area(coords, draw_dsc, &map_area_rot);
 
-        lv_area_t mask_com; /*Common area of mask and coords*/
+        lv_area_t mask_com; /*Common area of mask and the transformed coords*/
         bool union_ok;
         union_ok = _lv_area_intersect(&mask_com, clip_area, &map_area_rot);
         /*Out of mask. There is nothing to draw so the image is drawn successfully.*/
@@ -274,8 +365,17 @@ LV_ATTRIBUTE_FAST_MEM static lv_res_t lv_img_draw_core(const lv_area_t * coords,
             return LV_RES_OK;
         }
 
-        lv_draw_map(coords, &mask_com, cdsc->dec_dsc.img_data, draw_dsc, chroma_keyed, alpha_byte);
+        lv_res_t read_res;
+        read_res = draw_transformed_lines(coords, &mask_com, &cdsc->dec_dsc, draw_dsc, chroma_keyed, alpha_byte);
+        if(read_res != LV_RES_OK) {
+            LV_LOG_WARN("Image draw can't read the line");
+            draw_cleanup(cdsc);
+            /*Drop the image from the cache to try to open it again next time*/
+            lv_img_cache_invalidate_src(src);
+            return LV_RES_INV;
+        }
     }
+#endif
     /* The whole uncompressed image is not available. Try to read it line-by-line*/
     else {
         lv_area_t mask_com; /*Common area of mask and coords*/
@@ -306,10 +406,11 @@ LV_ATTRIBUTE_FAST_MEM static lv_res_t lv_img_draw_core(const lv_area_t * coords,
 
             read_res = lv_img_decoder_read_line(&cdsc->dec_dsc, x, y, width, buf);
             if(read_res != LV_RES_OK) {
-                lv_img_decoder_close(&cdsc->dec_dsc);
                 LV_LOG_WARN("Image draw can't read the line");
                 _lv_mem_buf_release(buf);
                 draw_cleanup(cdsc);
+                /*Drop the image from the cache to try to open it again next time*/
+                lv_img_cache_invalidate_src(src);
                 return LV_RES_INV;
             }
 
@@ -356,9 +457,11 @@ LV_ATTRIBUTE_FAST_MEM static void lv_draw_map(const lv_area_t * map_area, const
 
     uint8_t other_mask_cnt = lv_draw_mask_get_cnt();
 
+    /*Choose the fastest way to draw the image up front*/
+    blit_mode_t blit = get_blit_mode(disp, draw_dsc, chroma_key, alpha_byte);
+
     /*The simplest case just copy the pixels into the VDB*/
-    if(other_mask_cnt == 0 && draw_dsc->angle == 0 && draw_dsc->zoom == LV_IMG_ZOOM_NONE &&
-       chroma_key == false && alpha_byte == false && draw_dsc->recolor_opa == LV_OPA_TRANSP) {
+    if(blit == BLIT_COPY) {
         _lv_blend_map(clip_area, map_area, (lv_color_t *)map_p, NULL, LV_DRAW_MASK_RES_FULL_COVER, draw_dsc->opa,
                       draw_dsc->blend_mode);
     }
@@ -379,6 +482,16 @@ LV_ATTRIBUTE_FAST_MEM static void lv_draw_map(const lv_area_t * map_area, const
         lv_gpu_nxp_pxp_disable_recolor();
     }
 #endif
+    else if(blit == BLIT_CHROMA_KEYED) {
+        blit_chroma_keyed(vdb, map_area, &draw_area, map_p, draw_dsc->opa);
+    }
+    else if(blit == BLIT_ALPHA) {
+#if LV_ANTIALIAS
+        blit_alpha(vdb, map_area, &draw_area, map_p, draw_dsc->opa, disp->driver.antialiasing);
+#else
+        blit_alpha(vdb, map_area, &draw_area, map_p, draw_dsc->opa, false);
+#endif
+    }
     /*In the other cases every pixel need to be checked one-by-one*/
     else {
         /*The pixel size in byte is different if an alpha byte is added too*/
@@ -519,6 +632,7 @@ LV_ATTRIBUTE_FAST_MEM static void lv_draw_map(const lv_area_t * map_area, const
             int32_t x;
             int32_t y;
 #if LV_USE_IMG_TRANSFORM
+            int32_t rot_x = disp_area->x1 + draw_area.x1 - map_area->x1;
             int32_t rot_y = disp_area->y1 + draw_area.y1 - map_area->y1;
 #endif
             for(y = 0; y < draw_area_h; y++) {
@@ -526,61 +640,51 @@ LV_ATTRIBUTE_FAST_MEM static void lv_draw_map(const lv_area_t * map_area, const
                 uint32_t px_i_start = px_i;
 
 #if LV_USE_IMG_TRANSFORM
-                int32_t rot_x = disp_area->x1 + draw_area.x1 - map_area->x1;
-#endif
-                for(x = 0; x < draw_area_w; x++, map_px += px_size_byte, px_i++) {
-
-#if LV_USE_IMG_TRANSFORM
-                    if(transform) {
-
-                        /*Transform*/
-                        bool ret;
-                        ret = _lv_img_buf_transform(&trans_dsc, rot_x + x, rot_y + y);
-                        if(ret == false) {
-                            mask_buf[px_i] = LV_OPA_TRANSP;
-                            continue;
-                        }
-                        else {
-                            mask_buf[px_i] = trans_dsc.res.opa;
-                            c.full = trans_dsc.res.color.full;
+                if(transform) {
+                    /*Transform the whole line at once*/
+                    _lv_img_buf_transform_line(&trans_dsc, rot_x, rot_y + y, draw_area_w, &map2[px_i], &mask_buf[px_i]);
+                    if(draw_dsc->recolor_opa != 0) {
+                        for(x = 0; x < draw_area_w; x++) {
+                            if(mask_buf[px_i + x] == LV_OPA_TRANSP) continue;
+                            map2[px_i + x] = lv_color_mix_premult(recolor_premult, map2[px_i + x], recolor_opa_inv);
                         }
                     }
-                    /*No transform*/
-                    else
+                    px_i += draw_area_w;
+                }
+                else
 #endif
-                    {
-                        if(alpha_byte) {
-                            lv_opa_t px_opa = map_px[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
-                            mask_buf[px_i] = px_opa;
-                            if(px_opa == 0) {
+                for(x = 0; x < draw_area_w; x++, map_px += px_size_byte, px_i++) {
+                    if(alpha_byte) {
+                        lv_opa_t px_opa = map_px[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
+                        mask_buf[px_i] = px_opa;
+                        if(px_opa == 0) {
 #if LV_COLOR_DEPTH == 32
-                                map2[px_i].full = 0;
+                            map2[px_i].full = 0;
 #endif
-                                continue;
-                            }
-                        }
-                        else {
-                            mask_buf[px_i] = 0xFF;
+                            continue;
                         }
+                    }
+                    else {
+                        mask_buf[px_i] = 0xFF;
+                    }
 
 #if LV_COLOR_DEPTH == 1
-                        c.full = map_px[0];
+                    c.full = map_px[0];
 #elif LV_COLOR_DEPTH == 8
-                        c.full =  map_px[0];
+                    c.full =  map_px[0];
 #elif LV_COLOR_DEPTH == 16
-                        c.full =  map_px[0] + (map_px[1] << 8);
+                    c.full =  map_px[0] + (map_px[1] << 8);
 #elif LV_COLOR_DEPTH == 32
-                        c.full =  *((uint32_t *)map_px);
-                        c.ch.alpha = 0xFF;
+                    c.full =  *((uint32_t *)map_px);
+                    c.ch.alpha = 0xFF;
 #endif
-                        if(chroma_key) {
-                            if(c.full == chroma_keyed_color.full) {
-                                mask_buf[px_i] = LV_OPA_TRANSP;
+                    if(chroma_key) {
+                        if(c.full == chroma_keyed_color.full) {
+                            mask_buf[px_i] = LV_OPA_TRANSP;
 #if LV_COLOR_DEPTH == 32
-                                map2[px_i].full = 0;
+                            map2[px_i].full = 0;
 #endif
-                                continue;
-                            }
+                            continue;
                         }
                     }
 
@@ -639,6 +743,152 @@ LV_ATTRIBUTE_FAST_MEM static void lv_draw_map(const lv_area_t * map_area, const
     }
 }
 
+/**
+ * Tell how `lv_draw_map` can draw an image without building a color and mask buffer
+ * @param disp the display being refreshed
+ * @param draw_dsc pointer to an initialized `lv_draw_img_dsc_t` variable
+ * @param chroma_key true: the image is chroma keyed
+ * @param alpha_byte true: the image has an alpha byte for every pixel
+ * @return the way to draw the image
+ */
+static blit_mode_t get_blit_mode(const lv_disp_t * disp, const lv_draw_img_dsc_t * draw_dsc, bool chroma_key,
+                                 bool alpha_byte)
+{
+    if(lv_draw_mask_get_cnt() != 0) return BLIT_GENERIC;
+    if(draw_dsc->angle != 0 || draw_dsc->zoom != LV_IMG_ZOOM_NONE) return BLIT_GENERIC;
+    if(draw_dsc->recolor_opa != LV_OPA_TRANSP) return BLIT_GENERIC;
+
+    /*`_lv_blend_map` handles every kind of display and blend mode*/
+    if(!chroma_key && !alpha_byte) return BLIT_COPY;
+
+    /*The others write the draw buffer directly*/
+    if(draw_dsc->blend_mode != LV_BLEND_MODE_NORMAL) return BLIT_GENERIC;
+    if(disp->driver.set_px_cb) return BLIT_GENERIC;
+#if LV_COLOR_SCREEN_TRANSP
+    if(disp->driver.screen_transp) return BLIT_GENERIC;
+#endif
+
+    if(chroma_key && !alpha_byte) return BLIT_CHROMA_KEYED;
+
+    /*ARGB images are blended by the DMA2D*/
+#if LV_USE_GPU_STM32_DMA2D && LV_COLOR_DEPTH == 32
+    return BLIT_GENERIC;
+#else
+    if(alpha_byte && !chroma_key) return BLIT_ALPHA;
+    return BLIT_GENERIC;
+#endif
+}
+
+/**
+ * Copy the pixels of a chroma keyed image into the draw buffer skipping the `LV_COLOR_TRANSP` pixels
+ * @param vdb the draw buffer
+ * @param map_area coordinates of the image
+ * @param draw_area the area to draw relative to the draw buffer
+ * @param map_p pointer to the pixels of the image
+ * @param opa opacity of the image
+ */
+LV_ATTRIBUTE_FAST_MEM static void blit_chroma_keyed(lv_disp_buf_t * vdb, const lv_area_t * map_area,
+                                                    const lv_area_t * draw_area, const uint8_t * map_p, lv_opa_t opa)
+{
+    if(opa < LV_OPA_MIN) return;
+
+    const lv_area_t * disp_area = &vdb->area;
+    int32_t disp_w = lv_area_get_width(disp_area);
+    int32_t map_w = lv_area_get_width(map_area);
+    int32_t draw_area_w = lv_area_get_width(draw_area);
+    int32_t draw_area_h = lv_area_get_height(draw_area);
+
+    lv_color_t * disp_buf_first = (lv_color_t *)vdb->buf_act + disp_w * draw_area->y1 + draw_area->x1;
+    const uint8_t * map_buf_first = map_p;
+    map_buf_first += map_w * (draw_area->y1 - (map_area->y1 - disp_area->y1)) * sizeof(lv_color_t);
+    map_buf_first += (draw_area->x1 - (map_area->x1 - disp_area->x1)) * sizeof(lv_color_t);
+
+    lv_color_t chroma_keyed_color = LV_COLOR_TRANSP;
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < draw_area_h; y++) {
+        const uint8_t * map_px = map_buf_first;
+        for(x = 0; x < draw_area_w; x++, map_px += sizeof(lv_color_t)) {
+            lv_color_t c = read_color(map_px);
+            if(c.full == chroma_keyed_color.full) continue;
+
+            if(opa > LV_OPA_MAX) disp_buf_first[x] = c;
+            else disp_buf_first[x] = lv_color_mix(c, disp_buf_first[x], opa);
+        }
+        disp_buf_first += disp_w;
+        map_buf_first += map_w * sizeof(lv_color_t);
+    }
+}
+
+/**
+ * Mix the pixels of an image with alpha byte into the draw buffer.
+ * Transparent pixels are skipped and opaque pixels are copied without mixing.
+ * @param vdb the draw buffer
+ * @param map_area coordinates of the image
+ * @param draw_area the area to draw relative to the draw buffer
+ * @param map_p pointer to the pixels of the image
+ * @param opa opacity of the image
+ * @param antialias false: round the alpha bytes to transparent or opaque
+ */
+LV_ATTRIBUTE_FAST_MEM static void blit_alpha(lv_disp_buf_t * vdb, const lv_area_t * map_area,
+                                             const lv_area_t * draw_area, const uint8_t * map_p, lv_opa_t opa, bool antialias)
+{
+    if(opa < LV_OPA_MIN) return;
+
+    const lv_area_t * disp_area = &vdb->area;
+    int32_t disp_w = lv_area_get_width(disp_area);
+    int32_t map_w = lv_area_get_width(map_area);
+    int32_t draw_area_w = lv_area_get_width(draw_area);
+    int32_t draw_area_h = lv_area_get_height(draw_area);
+
+    lv_color_t * disp_buf_first = (lv_color_t *)vdb->buf_act + disp_w * draw_area->y1 + draw_area->x1;
+    const uint8_t * map_buf_first = map_p;
+    map_buf_first += map_w * (draw_area->y1 - (map_area->y1 - disp_area->y1)) * LV_IMG_PX_SIZE_ALPHA_BYTE;
+    map_buf_first += (draw_area->x1 - (map_area->x1 - disp_area->x1)) * LV_IMG_PX_SIZE_ALPHA_BYTE;
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < draw_area_h; y++) {
+        const uint8_t * map_px = map_buf_first;
+        for(x = 0; x < draw_area_w; x++, map_px += LV_IMG_PX_SIZE_ALPHA_BYTE) {
+            lv_opa_t px_opa = map_px[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
+            if(!antialias) px_opa = px_opa > 128 ? LV_OPA_COVER : LV_OPA_TRANSP;
+            if(px_opa == LV_OPA_TRANSP) continue;
+
+            lv_color_t c = read_color(map_px);
+            if(opa > LV_OPA_MAX) {
+                if(px_opa == LV_OPA_COVER) disp_buf_first[x] = c;
+                else disp_buf_first[x] = lv_color_mix(c, disp_buf_first[x], px_opa);
+            }
+            else {
+                lv_opa_t opa_tmp = px_opa >= LV_OPA_MAX ? opa : ((opa * px_opa) >> 8);
+                disp_buf_first[x] = lv_color_mix(c, disp_buf_first[x], opa_tmp);
+            }
+        }
+        disp_buf_first += disp_w;
+        map_buf_first += map_w * LV_IMG_PX_SIZE_ALPHA_BYTE;
+    }
+}
+
+/**
+ * Read a pixel's color from an image
+ * @param px pointer to the pixel
+ * @return the color of the pixel (opaque with 32 bit color depth)
+ */
+static inline lv_color_t read_color(const uint8_t * px)
+{
+    lv_color_t c;
+#if LV_COLOR_DEPTH == 8 || LV_COLOR_DEPTH == 1
+    c.full = px[0];
+#elif LV_COLOR_DEPTH == 16
+    c.full = px[0] + (px[1] << 8);
+#elif LV_COLOR_DEPTH == 32
+    c.full = *((const uint32_t *)px);
+    c.ch.alpha = 0xFF;
+#endif
+    return c;
+}
+
 static void show_error(const lv_area_t * coords, const lv_area_t * clip_area, const char * msg)
 {
     lv_draw_rect_dsc_t rect_dsc;
@@ -653,10 +903,231 @@ static void show_error(const lv_area_t * coords, const lv_area_t * clip_area, co
 
 static void draw_cleanup(lv_img_cache_entry_t * cache)
 {
-    /*Automatically close images with no caching*/
-#if LV_IMG_CACHE_DEF_SIZE == 0
-    lv_img_decoder_close(&cache->dec_dsc);
-#else
-    LV_UNUSED(cache);
+    /*Let the cache close the image. Images are closed automatically with no caching*/
+    _lv_img_cache_release(cache);
+}
+
+#if LV_USE_IMG_TRANSFORM
+/**
+ * Draw a transformed image which can be read only line-by-line
+ * @param coords the coordinates of the image
+ * @param clip_area draw only here. Should be on the transformed image.
+ * @param dec_dsc the opened image
+ * @param draw_dsc pointer to an initialized `lv_draw_img_dsc_t` variable
+ * @param chroma_keyed true: the image is chroma keyed
+ * @param alpha_byte true: the read lines contain an alpha byte for every pixel
+ * @return LV_RES_OK: drawn; LV_RES_INV: a line couldn't be read or out of memory
+ */
+static lv_res_t draw_transformed_lines(const lv_area_t * coords, const lv_area_t * clip_area,
+                                       lv_img_decoder_dsc_t * dec_dsc, const lv_draw_img_dsc_t * draw_dsc,
+                                       bool chroma_keyed, bool alpha_byte)
+{
+    transform_lines_t tl;
+    _lv_memset_00(&tl, sizeof(tl));
+    tl.coords = coords;
+    tl.draw_dsc = draw_dsc;
+    tl.dec_dsc = dec_dsc;
+    tl.chroma_keyed = chroma_keyed;
+    tl.alpha_byte = alpha_byte;
+    tl.px_size = alpha_byte ? LV_IMG_PX_SIZE_ALPHA_BYTE : LV_COLOR_SIZE >> 3;
+
+    tl.trans_dsc.cfg.angle = draw_dsc->angle;
+    tl.trans_dsc.cfg.zoom = draw_dsc->zoom;
+    tl.trans_dsc.cfg.src_w = dec_dsc->header.w;
+    tl.trans_dsc.cfg.src_h = dec_dsc->header.h;
+    tl.trans_dsc.cfg.pivot_x = draw_dsc->pivot.x;
+    tl.trans_dsc.cfg.pivot_y = draw_dsc->pivot.y;
+    _lv_img_buf_transform_init(&tl.trans_dsc);
+
+    /*Nothing is loaded yet*/
+    tl.rows = _lv_mem_buf_get(LV_IMG_TRANSFORM_ROW_CACHE_SIZE);
+    if(tl.rows == NULL) {
+        LV_LOG_WARN("draw_transformed_lines: couldn't allocate the row cache");
+        return LV_RES_INV;
+    }
+    lv_area_set(&tl.rows_area, 0, 0, -1, -1);
+
+    lv_res_t res = draw_transformed_tile(&tl, clip_area);
+
+    _lv_mem_buf_release(tl.rows);
+
+    return res;
+}
+
+/**
+ * Draw a tile of a transformed image. If its source pixels don't fit into the row cache split it.
+ * @param tl pointer to the drawing data
+ * @param tile the area to draw (absolute coordinates)
+ * @return LV_RES_OK: drawn; LV_RES_INV: a line couldn't be read
+ */
+static lv_res_t draw_transformed_tile(transform_lines_t * tl, const lv_area_t * tile)
+{
+    /* The transformation is linear so the source coordinates of the corners
+     * show from where the pixels of the tile come*/
+    int32_t xs_min = INT32_MAX;
+    int32_t xs_max = INT32_MIN;
+    int32_t ys_min = INT32_MAX;
+    int32_t ys_max = INT32_MIN;
+    uint32_t i;
+    for(i = 0; i < 4; i++) {
+        lv_coord_t x = (i & 0x1 ? tile->x2 : tile->x1) - tl->coords->x1;
+        lv_coord_t y = (i & 0x2 ? tile->y2 : tile->y1) - tl->coords->y1;
+        int32_t xs;
+        int32_t ys;
+        _lv_img_buf_transform_coords(&tl->trans_dsc, x, y, &xs, &ys);
+        xs_min = LV_MATH_MIN(xs_min, xs);
+        xs_max = LV_MATH_MAX(xs_max, xs);
+        ys_min = LV_MATH_MIN(ys_min, ys);
+        ys_max = LV_MATH_MAX(ys_max, ys);
+    }
+
+    /*Add the neighbors used by anti-aliasing*/
+    lv_area_t src_area;
+    src_area.x1 = LV_MATH_MAX((xs_min >> 8) - 1, 0);
+    src_area.y1 = LV_MATH_MAX((ys_min >> 8) - 1, 0);
+    src_area.x2 = LV_MATH_MIN((xs_max >> 8) + 1, tl->dec_dsc->header.w - 1);
+    src_area.y2 = LV_MATH_MIN((ys_max >> 8) + 1, tl->dec_dsc->header.h - 1);
+
+    /*The tile is out of the image. Nothing to draw.*/
+    if(src_area.x1 > src_area.x2 || src_area.y1 > src_area.y2) return LV_RES_OK;
+
+    /*Too many source pixels. Split the tile along its longer side.*/
+    if(lv_area_get_size(&src_area) * tl->px_size > LV_IMG_TRANSFORM_ROW_CACHE_SIZE) {
+        lv_res_t res;
+        lv_area_t sub;
+        lv_area_copy(&sub, tile);
+        if(lv_area_get_height(tile) >= lv_area_get_width(tile)) {
+            sub.y2 = tile->y1 + lv_area_get_height(tile) / 2 - 1;
+            res = draw_transformed_tile(tl, &sub);
+            if(res != LV_RES_OK) return res;
+            sub.y1 = sub.y2 + 1;
+            sub.y2 = tile->y2;
+        }
+        else {
+            sub.x2 = tile->x1 + lv_area_get_width(tile) / 2 - 1;
+            res = draw_transformed_tile(tl, &sub);
+            if(res != LV_RES_OK) return res;
+            sub.x1 = sub.x2 + 1;
+            sub.x2 = tile->x2;
+        }
+        return draw_transformed_tile(tl, &sub);
+    }
+
+    if(load_rows(tl, &src_area) != LV_RES_OK) return LV_RES_INV;
+
+    /* Draw the loaded part as if it were the whole image.
+     * Shift the pivot too to transform the pixels exactly the same way.*/
+    lv_area_t map_area;
+    map_area.x1 = tl->coords->x1 + tl->rows_area.x1;
+    map_area.y1 = tl->coords->y1 + tl->rows_area.y1;
+    map_area.x2 = tl->coords->x1 + tl->rows_area.x2;
+    map_area.y2 = tl->coords->y1 + tl->rows_area.y2;
+
+    lv_draw_img_dsc_t draw_dsc;
+    _lv_memcpy_small(&draw_dsc, tl->draw_dsc, sizeof(draw_dsc));
+    draw_dsc.pivot.x -= tl->rows_area.x1;
+    draw_dsc.pivot.y -= tl->rows_area.y1;
+
+    lv_draw_map(&map_area, tile, tl->rows, &draw_dsc, tl->chroma_keyed, tl->alpha_byte);
+
+    return LV_RES_OK;
+}
+
+/**
+ * Load an area of the image into the row cache. The already loaded rows are not read again.
+ * @param tl pointer to the drawing data
+ * @param src_area the area to load (relative to the image)
+ * @return LV_RES_OK: loaded; LV_RES_INV: a line couldn't be read
+ */
+static lv_res_t load_rows(transform_lines_t * tl, const lv_area_t * src_area)
+{
+    /*Everything is loaded already*/
+    if(_lv_area_is_in(src_area, &tl->rows_area, 0)) return LV_RES_OK;
+
+    lv_coord_t w = lv_area_get_width(src_area);
+    uint32_t stride = w * tl->px_size;
+    lv_coord_t y = src_area->y1;
+
+    /*Keep the already loaded rows which are required again. (Drawing goes from top to bottom)*/
+    if(src_area->x1 == tl->rows_area.x1 && src_area->x2 == tl->rows_area.x2 &&
+       src_area->y1 >= tl->rows_area.y1 && src_area->y1 <= tl->rows_area.y2) {
+        lv_coord_t shift = src_area->y1 - tl->rows_area.y1;
+        lv_coord_t keep = LV_MATH_MIN(tl->rows_area.y2, src_area->y2) - src_area->y1 + 1;
+        if(shift > 0) {
+            lv_coord_t i;
+            for(i = 0; i < keep; i++) {
+                _lv_memcpy(&tl->rows[i * stride], &tl->rows[(i + shift) * stride], stride);
+            }
+        }
+        y += keep;
+    }
+
+    for(; y <= src_area->y2; y++) {
+        lv_res_t res;
+        res = lv_img_decoder_read_line(tl->dec_dsc, src_area->x1, y, w, &tl->rows[(y - src_area->y1) * stride]);
+        if(res != LV_RES_OK) {
+            lv_area_set(&tl->rows_area, 0, 0, -1, -1);
+            return LV_RES_INV;
+        }
+    }
+
+    lv_area_copy(&tl->rows_area, src_area);
+
+    return LV_RES_OK;
+}
 #endif
+
+/**
+ * Get the area covered by a (transformed) image
+ * @param coords the coordinates of the image
+ * @param draw_dsc the draw descriptor of the image with the zoom and angle
+ * @param res store the result here
+ */
+static void get_draw_area(const lv_area_t * coords, const lv_draw_img_dsc_t * draw_dsc, lv_area_t * res)
+{
+    lv_area_copy(res, coords);
+    if(draw_dsc->angle || draw_dsc->zoom != LV_IMG_ZOOM_NONE) {
+        int32_t w = lv_area_get_width(coords);
+        int32_t h = lv_area_get_height(coords);
+
+        _lv_img_buf_get_transformed_area(res, w, h, draw_dsc->angle, draw_dsc->zoom, &draw_dsc->pivot);
+
+        res->x1 += coords->x1;
+        res->y1 += coords->y1;
+        res->x2 += coords->x1;
+        res->y2 += coords->y1;
+    }
 }
+
+#if LV_IMG_CACHE_ASYNC
+/**
+ * Draw the placeholder image to the center of an image being opened
+ * @param coords the coordinates of the image
+ * @param clip_area the image must be drawn only in this area
+ * @param draw_dsc the draw descriptor of the image
+ */
+static void draw_placeholder(const lv_area_t * coords, const lv_area_t * clip_area, const lv_draw_img_dsc_t * draw_dsc)
+{
+    const void * src = lv_img_cache_get_placeholder();
+    if(src == NULL) return;
+
+    lv_area_t clip_ph;
+    if(_lv_area_intersect(&clip_ph, clip_area, coords) == false) return;
+
+    lv_img_header_t header;
+    if(lv_img_decoder_get_info(src, &header) != LV_RES_OK) return;
+
+    lv_area_t coords_ph;
+    coords_ph.x1 = coords->x1 + (lv_area_get_width(coords) - header.w) / 2;
+    coords_ph.y1 = coords->y1 + (lv_area_get_height(coords) - header.h) / 2;
+    coords_ph.x2 = coords_ph.x1 + header.w - 1;
+    coords_ph.y2 = coords_ph.y1 + header.h - 1;
+
+    lv_draw_img_dsc_t dsc_ph;
+    _lv_memcpy_small(&dsc_ph, draw_dsc, sizeof(lv_draw_img_dsc_t));
+    dsc_ph.angle = 0;
+    dsc_ph.zoom = LV_IMG_ZOOM_NONE;
+
+    lv_img_draw_core(&coords_ph, &clip_ph, src, &dsc_ph);
+}
+#endif
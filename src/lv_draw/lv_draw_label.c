@@ -29,19 +29,43 @@ enum {
 };
 typedef uint8_t cmd_state_t;
 
+/*Collects the glyphs of a text line to blend them together*/
+typedef struct {
+    lv_opa_t * buf;             /*Coverage of the glyphs on `area`. A row is `area` width long*/
+    lv_area_t area;             /*The (clipped) area of the current line*/
+    lv_area_t dirty;            /*Part of `area` where glyphs were rendered since the last flush*/
+    lv_color_t color;           /*Color of the rendered glyphs*/
+    lv_blend_mode_t blend_mode;
+} line_batch_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 LV_ATTRIBUTE_FAST_MEM static void lv_draw_letter(const lv_point_t * pos_p, const lv_area_t * clip_area,
                                                  const lv_font_t * font_p,
-                                                 uint32_t letter, lv_color_t color, lv_opa_t opa, lv_blend_mode_t blend_mode);
+                                                 uint32_t letter, lv_color_t color, lv_opa_t opa, lv_blend_mode_t blend_mode,
+                                                 line_batch_t * batch);
 LV_ATTRIBUTE_FAST_MEM static void draw_letter_normal(lv_coord_t pos_x, lv_coord_t pos_y, lv_font_glyph_dsc_t * g,
                                                      const lv_area_t * clip_area,
                                                      const uint8_t * map_p, lv_color_t color, lv_opa_t opa, lv_blend_mode_t blend_mode);
+LV_ATTRIBUTE_FAST_MEM static void draw_letter_batch(lv_coord_t pos_x, lv_coord_t pos_y, lv_font_glyph_dsc_t * g,
+                                                    const uint8_t * map_p, lv_opa_t opa, line_batch_t * batch);
+static bool line_batch_init(line_batch_t * batch, const lv_area_t * clip_area, lv_coord_t line_height,
+                            lv_blend_mode_t blend_mode);
+static void line_batch_set_line(line_batch_t * batch, const lv_area_t * clip_area, lv_coord_t y, lv_coord_t line_height);
+LV_ATTRIBUTE_FAST_MEM static void line_batch_flush(line_batch_t * batch, const lv_area_t * clip_area);
+static void line_batch_deinit(line_batch_t * batch);
+static const lv_opa_t * get_bpp_opa_table(uint32_t bpp, lv_opa_t opa);
+LV_ATTRIBUTE_FAST_MEM static void glyph_row_to_opa(lv_opa_t * dst, const uint8_t * src, uint32_t bit_ofs, int32_t len,
+                                                   uint32_t bpp, const lv_opa_t * opa_table);
 static void draw_letter_subpx(lv_coord_t pos_x, lv_coord_t pos_y, lv_font_glyph_dsc_t * g, const lv_area_t * clip_area,
                               const uint8_t * map_p, lv_color_t color, lv_opa_t opa, lv_blend_mode_t blend_mode);
 
 static uint8_t hex_char_to_num(char hex);
+#if LV_USE_BIDI
+static bool bidi_cache_update(lv_draw_label_bidi_cache_t * cache, const char * txt, const lv_draw_label_dsc_t * dsc,
+                              lv_coord_t max_w, bool pos_conv);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -234,17 +258,44 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
     lv_draw_rect_dsc_init(&draw_dsc_sel);
     draw_dsc_sel.bg_color = dsc->sel_bg_color;
 
+    /*Render the glyphs of a line into a common buffer if possible*/
+    line_batch_t batch;
+    line_batch_t * batch_p = NULL;
+    if(line_batch_init(&batch, mask, line_height_font, dsc->blend_mode)) batch_p = &batch;
+
+#if LV_USE_BIDI
+    /*Use the cached visual order lines if possible*/
+    lv_draw_label_bidi_cache_t * bidi_cached = NULL;
+    if(dsc->bidi_cache) {
+        bool pos_conv = sel_start != 0xFFFF && sel_end != 0xFFFF;
+        if(bidi_cache_update(dsc->bidi_cache, txt, dsc, w, pos_conv)) bidi_cached = dsc->bidi_cache;
+    }
+#endif
+
     int32_t pos_x_start = pos.x;
     /*Write out all lines*/
     while(txt[line_start] != '\0') {
         pos.x += x_ofs;
 
+        if(batch_p) line_batch_set_line(batch_p, mask, pos.y, line_height_font);
+
         /*Write all letter of a line*/
         cmd_state = CMD_STATE_WAIT;
         i         = 0;
 #if LV_USE_BIDI
-        char * bidi_txt = _lv_mem_buf_get(line_end - line_start + 1);
-        _lv_bidi_process_paragraph(txt + line_start, bidi_txt, line_end - line_start, dsc->bidi_dir, NULL, 0);
+        const char * bidi_txt;
+        char * bidi_buf = NULL;
+        uint32_t line_char_start = 0;
+        uint32_t visual_char_pos = 0;
+        if(bidi_cached) {
+            bidi_txt = bidi_cached->bidi_txt + line_start;
+            if(bidi_cached->pos_conv) line_char_start = _lv_txt_encoded_get_char_id(txt, line_start);
+        }
+        else {
+            bidi_buf = _lv_mem_buf_get(line_end - line_start + 1);
+            _lv_bidi_process_paragraph(txt + line_start, bidi_buf, line_end - line_start, dsc->bidi_dir, NULL, 0);
+            bidi_txt = bidi_buf;
+        }
 #else
         const char * bidi_txt = txt + line_start;
 #endif
@@ -253,9 +304,14 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
             uint32_t logical_char_pos = 0;
             if(sel_start != 0xFFFF && sel_end != 0xFFFF) {
 #if LV_USE_BIDI
-                logical_char_pos = _lv_txt_encoded_get_char_id(txt, line_start);
-                uint32_t t = _lv_txt_encoded_get_char_id(bidi_txt, i);
-                logical_char_pos += _lv_bidi_get_logical_pos(bidi_txt, NULL, line_end - line_start, dsc->bidi_dir, t, NULL);
+                if(bidi_cached && bidi_cached->pos_conv) {
+                    logical_char_pos = bidi_cached->pos_conv[line_char_start + visual_char_pos];
+                }
+                else {
+                    logical_char_pos = _lv_txt_encoded_get_char_id(txt, line_start);
+                    uint32_t t = _lv_txt_encoded_get_char_id(bidi_txt, i);
+                    logical_char_pos += _lv_bidi_get_logical_pos(bidi_txt, NULL, line_end - line_start, dsc->bidi_dir, t, NULL);
+                }
 #else
                 logical_char_pos = _lv_txt_encoded_get_char_id(txt, line_start + i);
 #endif
@@ -263,6 +319,9 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
 
             uint32_t letter      = _lv_txt_encoded_next(bidi_txt, &i);
             uint32_t letter_next = _lv_txt_encoded_next(&bidi_txt[i], NULL);
+#if LV_USE_BIDI
+            visual_char_pos++;
+#endif
 
             /*Handle the re-color command*/
             if((dsc->flag & LV_TXT_FLAG_RECOLOR) != 0) {
@@ -317,18 +376,22 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
                     sel_coords.y1 = pos.y;
                     sel_coords.x2 = pos.x + letter_w + dsc->letter_space - 1;
                     sel_coords.y2 = pos.y + line_height - 1;
+                    /*The already collected letters should be below the selection's background*/
+                    if(batch_p) line_batch_flush(batch_p, mask);
                     lv_draw_rect(&sel_coords, mask, &draw_dsc_sel);
                     color = dsc->sel_color;
                 }
             }
 
-            lv_draw_letter(&pos, mask, font, letter, color, opa, dsc->blend_mode);
+            lv_draw_letter(&pos, mask, font, letter, color, opa, dsc->blend_mode, batch_p);
 
             if(letter_w > 0) {
                 pos.x += letter_w + dsc->letter_space;
             }
         }
 
+        if(batch_p) line_batch_flush(batch_p, mask);
+
         if(dsc->decor & LV_TEXT_DECOR_STRIKETHROUGH) {
             lv_point_t p1;
             lv_point_t p2;
@@ -350,8 +413,7 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
         }
 
 #if LV_USE_BIDI
-        _lv_mem_buf_release(bidi_txt);
-        bidi_txt = NULL;
+        if(bidi_buf) _lv_mem_buf_release(bidi_buf);
 #endif
         /*Go to next line*/
         line_start = line_end;
@@ -376,12 +438,26 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
         /*Go the next line position*/
         pos.y += line_height;
 
-        if(pos.y > mask->y2) return;
+        if(pos.y > mask->y2) break;
     }
 
+    if(batch_p) line_batch_deinit(batch_p);
+
     LV_ASSERT_MEM_INTEGRITY();
 }
 
+/**
+ * Free the buffers of a bidi cache and mark it as empty.
+ * Should be called when the content of the cached text changes and when the cache is not required anymore.
+ * @param cache pointer to a bidi cache
+ */
+void _lv_draw_label_bidi_cache_invalidate(lv_draw_label_bidi_cache_t * cache)
+{
+    if(cache->bidi_txt) lv_mem_free(cache->bidi_txt);
+    if(cache->pos_conv) lv_mem_free(cache->pos_conv);
+    _lv_memset_00(cache, sizeof(lv_draw_label_bidi_cache_t));
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -394,11 +470,14 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
  * @param letter a letter to draw
  * @param color color of letter
  * @param opa opacity of letter (0..255)
+ * @param blend_mode blend mode of the letter
+ * @param batch if not `NULL` collect the letter into this line batch if possible instead of drawing it directly
  */
 LV_ATTRIBUTE_FAST_MEM static void lv_draw_letter(const lv_point_t * pos_p, const lv_area_t * clip_area,
                                                  const lv_font_t * font_p,
                                                  uint32_t letter,
-                                                 lv_color_t color, lv_opa_t opa, lv_blend_mode_t blend_mode)
+                                                 lv_color_t color, lv_opa_t opa, lv_blend_mode_t blend_mode,
+                                                 line_batch_t * batch)
 {
     if(opa < LV_OPA_MIN) return;
     if(opa > LV_OPA_MAX) opa = LV_OPA_COVER;
@@ -439,6 +518,27 @@ LV_ATTRIBUTE_FAST_MEM static void lv_draw_letter(const lv_point_t * pos_p, const
         return;
     }
 
+    if(batch && !font_p->subpx) {
+        /*Collect the letter if its visible rows are inside the line*/
+        int32_t row_first = LV_MATH_MAX(pos_y, clip_area->y1);
+        int32_t row_last = LV_MATH_MIN(pos_y + g.box_h - 1, clip_area->y2);
+        if(row_first >= batch->area.y1 && row_last <= batch->area.y2) {
+            /*Overlapping letters (italic, kerning, combining marks) are blended after each other
+             *like when they are drawn one by one*/
+            int32_t col_first = LV_MATH_MAX(pos_x, batch->area.x1);
+            int32_t col_last = LV_MATH_MIN(pos_x + g.box_w - 1, batch->area.x2);
+            if(batch->color.full != color.full || (col_first <= batch->dirty.x2 && col_last >= batch->dirty.x1)) {
+                line_batch_flush(batch, clip_area);
+                batch->color = color;
+            }
+            draw_letter_batch(pos_x, pos_y, &g, map_p, opa, batch);
+            return;
+        }
+
+        /*Keep the drawing order: draw the collected letters first*/
+        line_batch_flush(batch, clip_area);
+    }
+
     if(font_p->subpx) {
         draw_letter_subpx(pos_x, pos_y, &g, clip_area, map_p, color, opa, blend_mode);
     }
@@ -451,55 +551,16 @@ LV_ATTRIBUTE_FAST_MEM static void draw_letter_normal(lv_coord_t pos_x, lv_coord_
                                                      const lv_area_t * clip_area,
                                                      const uint8_t * map_p, lv_color_t color, lv_opa_t opa, lv_blend_mode_t blend_mode)
 {
-    const uint8_t * bpp_opa_table_p;
-    uint32_t bitmask_init;
-    uint32_t bitmask;
     uint32_t bpp = g->bpp;
-    uint32_t shades;
     if(bpp == 3) bpp = 4;
 
-    switch(bpp) {
-        case 1:
-            bpp_opa_table_p = _lv_bpp1_opa_table;
-            bitmask_init  = 0x80;
-            shades = 2;
-            break;
-        case 2:
-            bpp_opa_table_p = _lv_bpp2_opa_table;
-            bitmask_init  = 0xC0;
-            shades = 4;
-            break;
-        case 4:
-            bpp_opa_table_p = _lv_bpp4_opa_table;
-            bitmask_init  = 0xF0;
-            shades = 16;
-            break;
-        case 8:
-            bpp_opa_table_p = _lv_bpp8_opa_table;
-            bitmask_init  = 0xFF;
-            shades = 256;
-            break;       /*No opa table, pixel value will be used directly*/
-        default:
-            LV_LOG_WARN("lv_draw_letter: invalid bpp");
-            return; /*Invalid bpp. Can't render the letter*/
+    const lv_opa_t * bpp_opa_table_p = get_bpp_opa_table(bpp, opa);
+    if(bpp_opa_table_p == NULL) {
+        LV_LOG_WARN("lv_draw_letter: invalid bpp");
+        return; /*Invalid bpp. Can't render the letter*/
     }
 
-    static lv_opa_t opa_table[256];
-    static lv_opa_t prev_opa = LV_OPA_TRANSP;
-    static uint32_t prev_bpp = 0;
-    if(opa < LV_OPA_MAX) {
-        if(prev_opa != opa || prev_bpp != bpp) {
-            uint32_t i;
-            for(i = 0; i < shades; i++) {
-                opa_table[i] = bpp_opa_table_p[i] == LV_OPA_COVER ? opa : ((bpp_opa_table_p[i] * opa) >> 8);
-            }
-        }
-        bpp_opa_table_p = opa_table;
-        prev_opa = opa;
-        prev_bpp = bpp;
-    }
-
-    int32_t col, row;
+    int32_t row;
     int32_t box_w = g->box_w;
     int32_t box_h = g->box_h;
     int32_t width_bit = box_w * bpp; /*Letter width in bits*/
@@ -510,14 +571,6 @@ LV_ATTRIBUTE_FAST_MEM static void draw_letter_normal(lv_coord_t pos_x, lv_coord_
     int32_t row_start = pos_y >= clip_area->y1 ? 0 : clip_area->y1 - pos_y;
     int32_t row_end   = pos_y + box_h <= clip_area->y2 ? box_h : clip_area->y2 - pos_y + 1;
 
-    /*Move on the map too*/
-    uint32_t bit_ofs = (row_start * width_bit) + (col_start * bpp);
-    map_p += bit_ofs >> 3;
-
-    uint8_t letter_px;
-    uint32_t col_bit;
-    col_bit = bit_ofs & 0x7; /* "& 0x7" equals to "% 8" just faster */
-
     lv_coord_t hor_res = lv_disp_get_hor_res(_lv_refr_get_disp_refreshing());
     uint32_t mask_buf_size = box_w * box_h > hor_res ? hor_res : box_w * box_h;
     lv_opa_t * mask_buf = _lv_mem_buf_get(mask_buf_size);
@@ -531,37 +584,14 @@ LV_ATTRIBUTE_FAST_MEM static void draw_letter_normal(lv_coord_t pos_x, lv_coord_
 
     uint8_t other_mask_cnt = lv_draw_mask_get_cnt();
 
-    uint32_t col_bit_max = 8 - bpp;
-    uint32_t col_bit_row_ofs = (box_w + col_start - col_end) * bpp;
-
     for(row = row_start ; row < row_end; row++) {
         int32_t mask_p_start = mask_p;
 
-        bitmask = bitmask_init >> col_bit;
-        for(col = col_start; col < col_end; col++) {
-            /*Load the pixel's opacity into the mask*/
-            letter_px = (*map_p & bitmask) >> (col_bit_max - col_bit);
-            if(letter_px) {
-                mask_buf[mask_p] = bpp_opa_table_p[letter_px];
-            }
-            else {
-                mask_buf[mask_p] = 0;
-            }
-
-            /*Go to the next column*/
-            if(col_bit < col_bit_max) {
-                col_bit += bpp;
-                bitmask = bitmask >> bpp;
-            }
-            else {
-                col_bit = 0;
-                bitmask = bitmask_init;
-                map_p++;
-            }
-
-            /*Next mask byte*/
-            mask_p++;
-        }
+        /*Load the pixels' opacity into the mask*/
+        uint32_t bit_ofs = (row * width_bit) + (col_start * bpp);
+        glyph_row_to_opa(mask_buf + mask_p, map_p + (bit_ofs >> 3), bit_ofs & 0x7, col_end - col_start, bpp,
+                         bpp_opa_table_p);
+        mask_p += col_end - col_start;
 
         /*Apply masks if any*/
         if(other_mask_cnt) {
@@ -584,10 +614,6 @@ LV_ATTRIBUTE_FAST_MEM static void draw_letter_normal(lv_coord_t pos_x, lv_coord_
             fill_area.y2 = fill_area.y1;
             mask_p = 0;
         }
-
-        col_bit += col_bit_row_ofs;
-        map_p += (col_bit >> 3);
-        col_bit = col_bit & 0x7;
     }
 
     /*Flush the last part*/
@@ -602,6 +628,304 @@ LV_ATTRIBUTE_FAST_MEM static void draw_letter_normal(lv_coord_t pos_x, lv_coord_
     _lv_mem_buf_release(mask_buf);
 }
 
+/**
+ * Render a letter into the coverage buffer of a line batch.
+ * The letter's visible rows should be inside `batch->area` and its columns shouldn't overlap `batch->dirty`.
+ * @param pos_x x coordinate of the letter's box
+ * @param pos_y y coordinate of the letter's box
+ * @param g glyph descriptor of the letter
+ * @param map_p bitmap of the letter
+ * @param opa opacity of letter
+ * @param batch pointer to an initialized line batch
+ */
+LV_ATTRIBUTE_FAST_MEM static void draw_letter_batch(lv_coord_t pos_x, lv_coord_t pos_y, lv_font_glyph_dsc_t * g,
+                                                    const uint8_t * map_p, lv_opa_t opa, line_batch_t * batch)
+{
+    uint32_t bpp = g->bpp;
+    if(bpp == 3) bpp = 4;
+
+    const lv_opa_t * bpp_opa_table_p = get_bpp_opa_table(bpp, opa);
+    if(bpp_opa_table_p == NULL) {
+        LV_LOG_WARN("lv_draw_letter: invalid bpp");
+        return; /*Invalid bpp. Can't render the letter*/
+    }
+
+    const lv_area_t * area = &batch->area;
+    int32_t box_w = g->box_w;
+    int32_t box_h = g->box_h;
+    int32_t width_bit = box_w * bpp; /*Letter width in bits*/
+
+    /* Calculate the col/row start/end on the map*/
+    int32_t col_start = pos_x >= area->x1 ? 0 : area->x1 - pos_x;
+    int32_t col_end   = pos_x + box_w <= area->x2 ? box_w : area->x2 - pos_x + 1;
+    int32_t row_start = pos_y >= area->y1 ? 0 : area->y1 - pos_y;
+    int32_t row_end   = pos_y + box_h <= area->y2 ? box_h : area->y2 - pos_y + 1;
+    if(col_start >= col_end || row_start >= row_end) return;
+
+    int32_t len = col_end - col_start;
+    int32_t stride = lv_area_get_width(area);
+    lv_opa_t * dest = batch->buf + (pos_y + row_start - area->y1) * stride + (pos_x + col_start - area->x1);
+
+    int32_t row;
+    for(row = row_start; row < row_end; row++) {
+        /*The area of the letter is still clear so the coverage can be written directly*/
+        uint32_t bit_ofs = (row * width_bit) + (col_start * bpp);
+        glyph_row_to_opa(dest, map_p + (bit_ofs >> 3), bit_ofs & 0x7, len, bpp, bpp_opa_table_p);
+        dest += stride;
+    }
+
+    batch->dirty.x1 = LV_MATH_MIN(batch->dirty.x1, pos_x + col_start);
+    batch->dirty.x2 = LV_MATH_MAX(batch->dirty.x2, pos_x + col_end - 1);
+    batch->dirty.y1 = LV_MATH_MIN(batch->dirty.y1, pos_y + row_start);
+    batch->dirty.y2 = LV_MATH_MAX(batch->dirty.y2, pos_y + row_end - 1);
+}
+
+/**
+ * Allocate the buffers of a line batch
+ * @param batch pointer to a line batch to initialize
+ * @param clip_area the text will be drawn only in this area
+ * @param line_height height of a line of the font
+ * @param blend_mode blend mode of the text
+ * @return true: the batch is ready to use; false: the letters should be drawn one by one
+ */
+static bool line_batch_init(line_batch_t * batch, const lv_area_t * clip_area, lv_coord_t line_height,
+                            lv_blend_mode_t blend_mode)
+{
+    uint32_t stride = lv_area_get_width(clip_area);
+    uint32_t size = stride * line_height;
+    if(size == 0 || size > LV_TXT_LINE_BATCH_BUF_SIZE) return false;
+
+    /*Fall back to drawing letter by letter instead of asserting if there is no memory for the batch*/
+    batch->buf = _lv_mem_buf_try_get(size);
+    if(batch->buf == NULL) return false;
+
+    _lv_memset_00(batch->buf, size);
+    batch->blend_mode = blend_mode;
+    batch->color = LV_COLOR_BLACK;
+    batch->area.x1 = clip_area->x1;
+    batch->area.x2 = clip_area->x2;
+    line_batch_set_line(batch, clip_area, clip_area->y1, line_height);
+
+    return true;
+}
+
+/**
+ * Prepare a line batch to collect the letters of a new line
+ * @param batch pointer to an initialized line batch
+ * @param clip_area the text will be drawn only in this area
+ * @param y the top coordinate of the line
+ * @param line_height height of a line of the font
+ */
+static void line_batch_set_line(line_batch_t * batch, const lv_area_t * clip_area, lv_coord_t y, lv_coord_t line_height)
+{
+    batch->area.y1 = LV_MATH_MAX(y, clip_area->y1);
+    batch->area.y2 = LV_MATH_MIN(y + line_height - 1, clip_area->y2);
+
+    /*Invalid area: nothing is rendered yet*/
+    batch->dirty.x1 = LV_COORD_MAX;
+    batch->dirty.y1 = LV_COORD_MAX;
+    batch->dirty.x2 = LV_COORD_MIN;
+    batch->dirty.y2 = LV_COORD_MIN;
+}
+
+/**
+ * Blend the collected letters with one call per row and clear the batch
+ * @param batch pointer to an initialized line batch
+ * @param clip_area the text will be drawn only in this area
+ */
+LV_ATTRIBUTE_FAST_MEM static void line_batch_flush(line_batch_t * batch, const lv_area_t * clip_area)
+{
+    if(batch->dirty.x1 > batch->dirty.x2) return;
+
+    int32_t stride = lv_area_get_width(&batch->area);
+    int32_t dirty_w = lv_area_get_width(&batch->dirty);
+    lv_opa_t * mask_row = batch->buf + (batch->dirty.y1 - batch->area.y1) * stride + (batch->dirty.x1 - batch->area.x1);
+    uint8_t other_mask_cnt = lv_draw_mask_get_cnt();
+
+    lv_area_t fill_area;
+    fill_area.x1 = batch->dirty.x1;
+    fill_area.x2 = batch->dirty.x2;
+
+    int32_t y;
+    for(y = batch->dirty.y1; y <= batch->dirty.y2; y++) {
+        fill_area.y1 = y;
+        fill_area.y2 = y;
+
+        lv_draw_mask_res_t mask_res = LV_DRAW_MASK_RES_CHANGED;
+        if(other_mask_cnt) {
+            mask_res = lv_draw_mask_apply(mask_row, fill_area.x1, y, dirty_w);
+        }
+
+        if(mask_res != LV_DRAW_MASK_RES_TRANSP) {
+            _lv_blend_fill(clip_area, &fill_area, batch->color, mask_row, LV_DRAW_MASK_RES_CHANGED, LV_OPA_COVER,
+                           batch->blend_mode);
+        }
+
+        /*Leave a clean buffer for the next letters*/
+        _lv_memset_00(mask_row, dirty_w);
+        mask_row += stride;
+    }
+
+    batch->dirty.x1 = LV_COORD_MAX;
+    batch->dirty.y1 = LV_COORD_MAX;
+    batch->dirty.x2 = LV_COORD_MIN;
+    batch->dirty.y2 = LV_COORD_MIN;
+}
+
+/**
+ * Release the buffers of a line batch
+ * @param batch pointer to an initialized line batch
+ */
+static void line_batch_deinit(line_batch_t * batch)
+{
+    _lv_mem_buf_release(batch->buf);
+    batch->buf = NULL;
+}
+
+/**
+ * Get a table to convert the pixel values of a glyph to opacity
+ * @param bpp bit-per-pixel of the glyph (1, 2, 4 or 8)
+ * @param opa opacity of the letter
+ * @return pointer to a table with `2^bpp` elements or `NULL` if `bpp` is invalid.
+ *         Valid until called with an other `bpp` or `opa`.
+ */
+static const lv_opa_t * get_bpp_opa_table(uint32_t bpp, lv_opa_t opa)
+{
+    const lv_opa_t * bpp_opa_table_p;
+    uint32_t shades;
+
+    switch(bpp) {
+        case 1:
+            bpp_opa_table_p = _lv_bpp1_opa_table;
+            shades = 2;
+            break;
+        case 2:
+            bpp_opa_table_p = _lv_bpp2_opa_table;
+            shades = 4;
+            break;
+        case 4:
+            bpp_opa_table_p = _lv_bpp4_opa_table;
+            shades = 16;
+            break;
+        case 8:
+            bpp_opa_table_p = _lv_bpp8_opa_table;
+            shades = 256;
+            break;
+        default:
+            return NULL;
+    }
+
+    static lv_opa_t opa_table[256];
+    static lv_opa_t prev_opa = LV_OPA_TRANSP;
+    static uint32_t prev_bpp = 0;
+    if(opa < LV_OPA_MAX) {
+        if(prev_opa != opa || prev_bpp != bpp) {
+            uint32_t i;
+            for(i = 0; i < shades; i++) {
+                opa_table[i] = bpp_opa_table_p[i] == LV_OPA_COVER ? opa : ((bpp_opa_table_p[i] * opa) >> 8);
+            }
+        }
+        bpp_opa_table_p = opa_table;
+        prev_opa = opa;
+        prev_bpp = bpp;
+    }
+
+    return bpp_opa_table_p;
+}
+
+/**
+ * Convert the pixels of a glyph's row to opacity values.
+ * Whole bytes are converted at once with an unrolled table lookup per pixel.
+ * @param dst store the opacity values here (`len` bytes)
+ * @param src pointer to the byte of the bitmap containing the first pixel
+ * @param bit_ofs offset of the first pixel in `src` in bits (0..7)
+ * @param len number of pixels to convert
+ * @param bpp bit-per-pixel of the bitmap (1, 2, 4 or 8)
+ * @param opa_table table to convert the pixel values to opacity (see `get_bpp_opa_table`)
+ */
+LV_ATTRIBUTE_FAST_MEM static void glyph_row_to_opa(lv_opa_t * dst, const uint8_t * src, uint32_t bit_ofs, int32_t len,
+                                                   uint32_t bpp, const lv_opa_t * opa_table)
+{
+    uint32_t px_mask = (1 << bpp) - 1;
+
+    /*Convert the pixels one by one until a byte boundary*/
+    while(bit_ofs != 0 && len > 0) {
+        *dst = opa_table[(*src >> (8 - bit_ofs - bpp)) & px_mask];
+        dst++;
+        len--;
+        bit_ofs += bpp;
+        if(bit_ofs >= 8) {
+            bit_ofs = 0;
+            src++;
+        }
+    }
+
+    /*Convert whole bytes*/
+    uint8_t b;
+    switch(bpp) {
+        case 1:
+            while(len >= 8) {
+                b = *src;
+                dst[0] = opa_table[(b >> 7)];
+                dst[1] = opa_table[(b >> 6) & 0x1];
+                dst[2] = opa_table[(b >> 5) & 0x1];
+                dst[3] = opa_table[(b >> 4) & 0x1];
+                dst[4] = opa_table[(b >> 3) & 0x1];
+                dst[5] = opa_table[(b >> 2) & 0x1];
+                dst[6] = opa_table[(b >> 1) & 0x1];
+                dst[7] = opa_table[b & 0x1];
+                dst += 8;
+                src++;
+                len -= 8;
+            }
+            break;
+        case 2:
+            while(len >= 4) {
+                b = *src;
+                dst[0] = opa_table[(b >> 6)];
+                dst[1] = opa_table[(b >> 4) & 0x3];
+                dst[2] = opa_table[(b >> 2) & 0x3];
+                dst[3] = opa_table[b & 0x3];
+                dst += 4;
+                src++;
+                len -= 4;
+            }
+            break;
+        case 4:
+            while(len >= 2) {
+                b = *src;
+                dst[0] = opa_table[(b >> 4)];
+                dst[1] = opa_table[b & 0xF];
+                dst += 2;
+                src++;
+                len -= 2;
+            }
+            break;
+        case 8:
+            /*With full opacity the table is an identity mapping*/
+            if(opa_table == _lv_bpp8_opa_table) {
+                _lv_memcpy(dst, src, len);
+            }
+            else {
+                int32_t i;
+                for(i = 0; i < len; i++) dst[i] = opa_table[src[i]];
+            }
+            len = 0;
+            break;
+        default:
+            return;
+    }
+
+    /*Convert the remaining pixels of the last byte*/
+    uint32_t shift = 8 - bpp;
+    while(len > 0) {
+        *dst = opa_table[(*src >> shift) & px_mask];
+        shift -= bpp;
+        dst++;
+        len--;
+    }
+}
+
 static void draw_letter_subpx(lv_coord_t pos_x, lv_coord_t pos_y, lv_font_glyph_dsc_t * g, const lv_area_t * clip_area,
                               const uint8_t * map_p, lv_color_t color, lv_opa_t opa, lv_blend_mode_t blend_mode)
 {
@@ -814,6 +1138,88 @@ static void draw_letter_subpx(lv_coord_t pos_x, lv_coord_t pos_y, lv_font_glyph_
  * @param hex Pointer to a hexadecimal character (0..9, A..F)
  * @return the numerical value of `hex` or 0 on error
  */
+#if LV_USE_BIDI
+/**
+ * Make a bidi cache hold the visual order lines of a text. Reprocess the text only if the cache is for
+ * an other text or line breaking.
+ * @param cache pointer to a bidi cache
+ * @param txt the text to draw
+ * @param dsc the draw descriptor of the text
+ * @param max_w the lines are broken at this width
+ * @param pos_conv true: the logical position of the visual characters are required too
+ * @return true: the cache is up to date; false: out of memory or the text is too long to cache
+ */
+static bool bidi_cache_update(lv_draw_label_bidi_cache_t * cache, const char * txt, const lv_draw_label_dsc_t * dsc,
+                              lv_coord_t max_w, bool pos_conv)
+{
+    uint32_t txt_len = strlen(txt);
+
+    if(cache->txt == txt && cache->txt_len == txt_len && cache->font == dsc->font && cache->max_w == max_w &&
+       cache->letter_space == dsc->letter_space && cache->base_dir == dsc->bidi_dir && cache->flag == dsc->flag &&
+       (cache->pos_conv || !pos_conv)) {
+        return true;
+    }
+
+    _lv_draw_label_bidi_cache_invalidate(cache);
+
+    uint32_t char_cnt = 0;
+    if(pos_conv) {
+        char_cnt = _lv_txt_get_encoded_length(txt);
+        /*The positions are stored on 15 bits*/
+        if(char_cnt >= 0x7FFF) return false;
+
+        cache->pos_conv = lv_mem_alloc(LV_MATH_MAX(char_cnt, 1) * sizeof(uint16_t));
+        LV_ASSERT_MEM(cache->pos_conv);
+        if(cache->pos_conv == NULL) return false;
+    }
+
+    cache->bidi_txt = lv_mem_alloc(txt_len + 1);
+    LV_ASSERT_MEM(cache->bidi_txt);
+    if(cache->bidi_txt == NULL) {
+        _lv_draw_label_bidi_cache_invalidate(cache);
+        return false;
+    }
+
+    /*Process the lines in the same way as they are drawn*/
+    uint32_t line_start = 0;
+    uint32_t line_char_start = 0;
+    while(line_start < txt_len) {
+        uint32_t line_len = _lv_txt_get_next_line(&txt[line_start], dsc->font, dsc->letter_space, max_w, dsc->flag);
+        if(line_len == 0) break;
+
+        uint16_t * line_pos_conv = NULL;
+        uint32_t line_char_cnt = 0;
+        if(pos_conv) {
+            line_char_cnt = _lv_txt_encoded_get_char_id(&txt[line_start], line_len);
+            line_pos_conv = &cache->pos_conv[line_char_start];
+        }
+
+        _lv_bidi_process_paragraph(&txt[line_start], &cache->bidi_txt[line_start], line_len, dsc->bidi_dir,
+                                   line_pos_conv, line_char_cnt);
+
+        /*Convert the line relative positions (with the RTL flag on the MSB) to text relative positions*/
+        uint32_t i;
+        for(i = 0; i < line_char_cnt; i++) {
+            line_pos_conv[i] = (line_pos_conv[i] & 0x7FFF) + line_char_start;
+        }
+
+        line_start += line_len;
+        line_char_start += line_char_cnt;
+    }
+
+    cache->bidi_txt[txt_len] = '\0';
+    cache->txt = txt;
+    cache->txt_len = txt_len;
+    cache->font = dsc->font;
+    cache->max_w = max_w;
+    cache->letter_space = dsc->letter_space;
+    cache->base_dir = dsc->bidi_dir;
+    cache->flag = dsc->flag;
+
+    return true;
+}
+#endif
+
 static uint8_t hex_char_to_num(char hex)
 {
     uint8_t result = 0;
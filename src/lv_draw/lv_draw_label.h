@@ -26,6 +26,21 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+/** Store the bidi processed (visual order) lines of a text to not process them on every redraw.
+ * The cache is updated automatically if the text, its length or the line breaking parameters change
+ * but `_lv_draw_label_bidi_cache_invalidate()` should be called if the content of the text buffer changes.*/
+typedef struct {
+    const char * txt;               /**< The text whose lines are cached. NULL: the cache is empty*/
+    char * bidi_txt;                /**< The lines of `txt` in visual order*/
+    uint16_t * pos_conv;            /**< Logical character position of each visual character. Created only if required*/
+    const lv_font_t * font;
+    uint32_t txt_len;
+    lv_coord_t max_w;
+    lv_style_int_t letter_space;
+    lv_bidi_dir_t base_dir;
+    lv_txt_flag_t flag;
+} lv_draw_label_bidi_cache_t;
+
 typedef struct {
     lv_color_t color;
     lv_color_t sel_color;
@@ -42,6 +57,7 @@ typedef struct {
     lv_txt_flag_t flag;
     lv_text_decor_t decor;
     lv_blend_mode_t blend_mode;
+    lv_draw_label_bidi_cache_t * bidi_cache; /**< Cache of the bidi processed lines. Used only with `LV_USE_BIDI`*/
 } lv_draw_label_dsc_t;
 
 /** Store some info to speed up drawing of very large texts
@@ -82,6 +98,13 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
                                          const lv_draw_label_dsc_t * dsc,
                                          const char * txt, lv_draw_label_hint_t * hint);
 
+/**
+ * Free the buffers of a bidi cache and mark it as empty.
+ * Should be called when the content of the cached text changes and when the cache is not required anymore.
+ * @param cache pointer to a bidi cache
+ */
+void _lv_draw_label_bidi_cache_invalidate(lv_draw_label_bidi_cache_t * cache);
+
 //! @endcond
 /***********************
  * GLOBAL VARIABLES
@@ -17,6 +17,8 @@
 /*********************
  *      DEFINES
  *********************/
+/*Number of pixels whose source coordinates are calculated at once in `_lv_img_buf_transform_line`*/
+#define TRANSFORM_CHUNK_SIZE    64
 
 /**********************
  *      TYPEDEFS
@@ -25,6 +27,11 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+#if LV_USE_IMG_TRANSFORM
+static void transform_chunk(lv_img_transform_dsc_t * dsc, const int32_t * xs_buf, const int32_t * ys_buf,
+                            int32_t cnt, bool safe, lv_color_t * cbuf, lv_opa_t * abuf);
+static inline bool transform_anti_alias(lv_img_transform_dsc_t * dsc, bool inner);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -457,6 +464,14 @@ void _lv_img_buf_transform_init(lv_img_transform_dsc_t * dsc)
      *  + dsc->cfg.zoom / 2 for rounding*/
     dsc->tmp.zoom_inv = (((256 * 256) << _LV_ZOOM_INV_UPSCALE) + dsc->cfg.zoom / 2) / dsc->cfg.zoom;
 
+    /*With integer upscaling every source pixel covers whole pixels. Just copy them.*/
+    if(dsc->cfg.angle == 0 && dsc->cfg.zoom > LV_IMG_ZOOM_NONE && (dsc->cfg.zoom & 0xFF) == 0) {
+        dsc->tmp.antialias = 0;
+    }
+    else {
+        dsc->tmp.antialias = dsc->cfg.antialias ? 1 : 0;
+    }
+
     dsc->res.opa = LV_OPA_COVER;
     dsc->res.color = dsc->cfg.color;
 }
@@ -556,12 +571,277 @@ void _lv_img_buf_get_transformed_area(lv_area_t * res, lv_coord_t w, lv_coord_t
 #endif
 }
 
+/**
+ * Downscale a true color image to half of its width and height.
+ * Every 2x2 pixels are averaged weighted by their opacity.
+ * @param src the pixels of the source image
+ * @param w width of the source image
+ * @param h height of the source image
+ * @param cf color format of the image. Only `LV_IMG_CF_TRUE_COLOR...` formats are supported.
+ * @param dst store the pixels of the `w / 2` x `h / 2` sized image here
+ */
+void _lv_img_buf_halve(const uint8_t * src, lv_coord_t w, lv_coord_t h, lv_img_cf_t cf, uint8_t * dst)
+{
+    bool has_alpha = lv_img_cf_has_alpha(cf);
+    bool chroma_keyed = lv_img_cf_is_chroma_keyed(cf);
+    uint8_t px_size = has_alpha ? LV_IMG_PX_SIZE_ALPHA_BYTE : LV_COLOR_SIZE >> 3;
+    uint8_t color_size = has_alpha ? px_size - 1 : px_size;
+    uint32_t stride = w * px_size;
+    lv_color_t chroma_color = LV_COLOR_TRANSP;
+
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = 0; y < h / 2; y++) {
+        const uint8_t * src_row = &src[2 * y * stride];
+        for(x = 0; x < w / 2; x++) {
+            lv_color_t c[4];
+            uint32_t a[4];
+            uint32_t i;
+            for(i = 0; i < 4; i++) {
+                const uint8_t * px = &src_row[(i >> 1) * stride + (2 * x + (i & 0x1)) * px_size];
+                c[i] = chroma_color;
+                _lv_memcpy_small(&c[i], px, color_size);
+                if(has_alpha) a[i] = px[px_size - 1];
+                else if(chroma_keyed && c[i].full == chroma_color.full) a[i] = LV_OPA_TRANSP;
+                else a[i] = LV_OPA_COVER;
+            }
+
+            /*Mix the pairs and then the pairs' results with the ratio of the opacities*/
+            uint32_t a_top = a[0] + a[1];
+            uint32_t a_bottom = a[2] + a[3];
+            lv_color_t c_top = a_top ? lv_color_mix(c[0], c[1], (a[0] * LV_OPA_COVER) / a_top) : c[0];
+            lv_color_t c_bottom = a_bottom ? lv_color_mix(c[2], c[3], (a[2] * LV_OPA_COVER) / a_bottom) : c[2];
+            uint32_t a_sum = a_top + a_bottom;
+            lv_color_t c_res = a_sum ? lv_color_mix(c_top, c_bottom, (a_top * LV_OPA_COVER) / a_sum) : c_top;
+
+            /*Chroma keyed images: be transparent if most of the pixels are transparent*/
+            if(chroma_keyed && a_sum < 2 * LV_OPA_COVER) c_res = chroma_color;
+
+            _lv_memcpy_small(dst, &c_res, color_size);
+            if(has_alpha) dst[px_size - 1] = a_sum / 4;
+            dst += px_size;
+        }
+    }
+}
+
 #if LV_USE_IMG_TRANSFORM
 /**
  * Continue transformation by taking the neighbors into account
  * @param dsc pointer to the transformation descriptor
  */
 bool _lv_img_buf_transform_anti_alias(lv_img_transform_dsc_t * dsc)
+{
+    return transform_anti_alias(dsc, false);
+}
+
+/**
+ * Get which colors and opacities would come to a horizontal line of pixels if they were rotated.
+ * It gives the same result as calling `_lv_img_buf_transform` for every pixel but
+ * it steps the source coordinates incrementally and doesn't check the bounds of the inner pixels.
+ * @param dsc a descriptor initialized by `_lv_img_buf_transform_init`
+ * @param x the x coordinate of the first pixel
+ * @param y the y coordinate of the line
+ * @param len number of pixels to transform
+ * @param cbuf store the colors here
+ * @param abuf store the opacities here. 0 where no pixel of the image comes.
+ */
+void _lv_img_buf_transform_line(lv_img_transform_dsc_t * dsc, lv_coord_t x, lv_coord_t y, lv_coord_t len,
+                                lv_color_t * cbuf, lv_opa_t * abuf)
+{
+    int32_t xs_buf[TRANSFORM_CHUNK_SIZE];
+    int32_t ys_buf[TRANSFORM_CHUNK_SIZE];
+
+    /*Get the target point relative coordinates to the pivot*/
+    int32_t xt = x - dsc->cfg.pivot_x;
+    int32_t yt = y - dsc->cfg.pivot_y;
+
+    int32_t sinma = dsc->tmp.sinma;
+    int32_t cosma = dsc->tmp.cosma;
+    int32_t pivot_x_256 = dsc->tmp.pivot_x_256;
+    int32_t pivot_y_256 = dsc->tmp.pivot_y_256;
+    uint32_t zoom_inv = dsc->tmp.zoom_inv;
+
+    /* The source coordinates change linearly along the line so step them instead of multiplying for every pixel.
+     * The same products are stepped which are calculated by `_lv_img_buf_transform` to get exactly the same result.*/
+    int32_t rot_x = cosma * xt - sinma * yt;
+    int32_t rot_y = sinma * xt + cosma * yt;
+    uint32_t zoom_x = (uint32_t)xt * zoom_inv;
+    int32_t yt_zoomed = (int32_t)((uint32_t)yt * zoom_inv) >> _LV_ZOOM_INV_UPSCALE;
+
+    /*On very small zoom the products overflow and the coordinates are not monotonic. Check every pixel then.*/
+    bool safe = true;
+    if(dsc->cfg.zoom != LV_IMG_ZOOM_NONE) {
+        uint32_t t_max = LV_MATH_ABS(xt) + LV_MATH_ABS(yt) + len + 1;
+        uint32_t prod_max = dsc->cfg.angle == 0 ? INT32_MAX : (INT32_MAX >> _LV_ZOOM_INV_UPSCALE);
+        if(zoom_inv > prod_max / t_max) safe = false;
+    }
+
+    while(len > 0) {
+        int32_t cnt = LV_MATH_MIN(len, TRANSFORM_CHUNK_SIZE);
+        int32_t i;
+        if(dsc->cfg.zoom == LV_IMG_ZOOM_NONE) {
+            for(i = 0; i < cnt; i++) {
+                xs_buf[i] = (rot_x >> (_LV_TRANSFORM_TRIGO_SHIFT - 8)) + pivot_x_256;
+                ys_buf[i] = (rot_y >> (_LV_TRANSFORM_TRIGO_SHIFT - 8)) + pivot_y_256;
+                rot_x += cosma;
+                rot_y += sinma;
+            }
+        }
+        else if(dsc->cfg.angle == 0) {
+            int32_t ys = yt_zoomed + pivot_y_256;
+            for(i = 0; i < cnt; i++) {
+                xs_buf[i] = ((int32_t)zoom_x >> _LV_ZOOM_INV_UPSCALE) + pivot_x_256;
+                ys_buf[i] = ys;
+                zoom_x += zoom_inv;
+            }
+        }
+        else {
+            int32_t row_x = -sinma * yt_zoomed;
+            int32_t row_y = cosma * yt_zoomed;
+            for(i = 0; i < cnt; i++) {
+                int32_t xt_zoomed = (int32_t)zoom_x >> _LV_ZOOM_INV_UPSCALE;
+                xs_buf[i] = ((cosma * xt_zoomed + row_x) >> _LV_TRANSFORM_TRIGO_SHIFT) + pivot_x_256;
+                ys_buf[i] = ((sinma * xt_zoomed + row_y) >> _LV_TRANSFORM_TRIGO_SHIFT) + pivot_y_256;
+                zoom_x += zoom_inv;
+            }
+        }
+
+        transform_chunk(dsc, xs_buf, ys_buf, cnt, safe, cbuf, abuf);
+
+        cbuf += cnt;
+        abuf += cnt;
+        len -= cnt;
+    }
+}
+#endif
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_USE_IMG_TRANSFORM
+/**
+ * Transform pixels whose source coordinates are already calculated
+ * @param dsc pointer to the transformation descriptor
+ * @param xs_buf x coordinates on the source image [1/256 px]
+ * @param ys_buf y coordinates on the source image [1/256 px]
+ * @param cnt number of pixels
+ * @param safe true: the coordinates are monotonic; false: check every pixel
+ * @param cbuf store the colors here
+ * @param abuf store the opacities here
+ */
+static void transform_chunk(lv_img_transform_dsc_t * dsc, const int32_t * xs_buf, const int32_t * ys_buf,
+                            int32_t cnt, bool safe, lv_color_t * cbuf, lv_opa_t * abuf)
+{
+    int32_t src_w = dsc->cfg.src_w;
+    int32_t src_h = dsc->cfg.src_h;
+
+#define ON_IMG(i) ((xs_buf[i] >> 8) >= 0 && (xs_buf[i] >> 8) < src_w && (ys_buf[i] >> 8) >= 0 && (ys_buf[i] >> 8) < src_h)
+#define INNER(i) ((xs_buf[i] >> 8) >= 1 && (xs_buf[i] >> 8) < src_w - 1 && (ys_buf[i] >> 8) >= 1 && (ys_buf[i] >> 8) < src_h - 1)
+
+    /* Both coordinates change monotonically along the line,
+     * so the pixels on the image and the inner pixels are next to each other*/
+    int32_t first = 0;
+    int32_t last = cnt - 1;
+    int32_t inner_first = 0;
+    int32_t inner_last = -1;
+    if(safe) {
+        while(first <= last && !ON_IMG(first)) {
+            abuf[first] = LV_OPA_TRANSP;
+            first++;
+        }
+        while(last >= first && !ON_IMG(last)) {
+            abuf[last] = LV_OPA_TRANSP;
+            last--;
+        }
+
+        /*Only the true color images are handled without checks*/
+        if(dsc->tmp.native_color) {
+            inner_first = first;
+            inner_last = last;
+            /*The anti-aliasing reads the neighbors too*/
+            if(dsc->tmp.antialias) {
+                while(inner_first <= inner_last && !INNER(inner_first)) inner_first++;
+                while(inner_last >= inner_first && !INNER(inner_last)) inner_last--;
+            }
+        }
+    }
+
+#undef ON_IMG
+#undef INNER
+
+    /*No inner pixels: check all the pixels*/
+    if(inner_first > inner_last) {
+        inner_first = last + 1;
+        inner_last = last;
+    }
+
+    int32_t i;
+    for(i = first; i < inner_first; i++) {
+        if(_lv_img_buf_transform_px(dsc, xs_buf[i], ys_buf[i])) {
+            cbuf[i] = dsc->res.color;
+            abuf[i] = dsc->res.opa;
+        }
+        else {
+            abuf[i] = LV_OPA_TRANSP;
+        }
+    }
+
+    const uint8_t * src_u8 = dsc->cfg.src;
+    uint8_t px_size = dsc->tmp.has_alpha ? LV_IMG_PX_SIZE_ALPHA_BYTE : LV_COLOR_SIZE >> 3;
+    lv_color_t chroma_color = LV_COLOR_TRANSP;
+    for(; i <= inner_last; i++) {
+        int32_t xs_int = xs_buf[i] >> 8;
+        int32_t ys_int = ys_buf[i] >> 8;
+        uint32_t pxi = (src_w * ys_int + xs_int) * px_size;
+        if(dsc->tmp.has_alpha) {
+            _lv_memcpy_small(&dsc->res.color, &src_u8[pxi], px_size - 1);
+            dsc->res.opa = src_u8[pxi + px_size - 1];
+        }
+        else {
+            _lv_memcpy_small(&dsc->res.color, &src_u8[pxi], px_size);
+        }
+
+        if(dsc->tmp.chroma_keyed && dsc->res.color.full == chroma_color.full) {
+            abuf[i] = LV_OPA_TRANSP;
+            continue;
+        }
+
+        if(dsc->tmp.antialias) {
+            dsc->tmp.xs = xs_buf[i];
+            dsc->tmp.ys = ys_buf[i];
+            dsc->tmp.xs_int = xs_int;
+            dsc->tmp.ys_int = ys_int;
+            dsc->tmp.pxi = pxi;
+            dsc->tmp.px_size = px_size;
+            if(transform_anti_alias(dsc, true) == false) {
+                abuf[i] = LV_OPA_TRANSP;
+                continue;
+            }
+        }
+
+        cbuf[i] = dsc->res.color;
+        abuf[i] = dsc->res.opa;
+    }
+
+    for(; i <= last; i++) {
+        if(_lv_img_buf_transform_px(dsc, xs_buf[i], ys_buf[i])) {
+            cbuf[i] = dsc->res.color;
+            abuf[i] = dsc->res.opa;
+        }
+        else {
+            abuf[i] = LV_OPA_TRANSP;
+        }
+    }
+}
+
+/**
+ * Mix the color of a source pixel with its neighbors
+ * @param dsc pointer to the transformation descriptor
+ * @param inner true: the neighbors are surely on the image
+ * @return false: the result is fully transparent
+ */
+static inline bool transform_anti_alias(lv_img_transform_dsc_t * dsc, bool inner)
 {
     const uint8_t * src_u8 = dsc->cfg.src;
 
@@ -573,12 +853,12 @@ bool _lv_img_buf_transform_anti_alias(lv_img_transform_dsc_t * dsc)
 
     if(xs_fract < 0x70) {
         xn = - 1;
-        if(dsc->tmp.xs_int + xn < 0) xn = 0;
+        if(!inner && dsc->tmp.xs_int + xn < 0) xn = 0;
         xr = xs_fract + 0x80;
     }
     else if(xs_fract > 0x90) {
         xn =  1;
-        if(dsc->tmp.xs_int + xn >= dsc->cfg.src_w) xn = 0;
+        if(!inner && dsc->tmp.xs_int + xn >= dsc->cfg.src_w) xn = 0;
         xr = (0xFF - xs_fract) + 0x80;
     }
     else {
@@ -591,13 +871,13 @@ bool _lv_img_buf_transform_anti_alias(lv_img_transform_dsc_t * dsc)
 
     if(ys_fract < 0x70) {
         yn = - 1;
-        if(dsc->tmp.ys_int + yn < 0) yn = 0;
+        if(!inner && dsc->tmp.ys_int + yn < 0) yn = 0;
 
         yr = ys_fract + 0x80;
     }
     else if(ys_fract > 0x90) {
         yn =  1;
-        if(dsc->tmp.ys_int + yn >= dsc->cfg.src_h) yn = 0;
+        if(!inner && dsc->tmp.ys_int + yn >= dsc->cfg.src_h) yn = 0;
 
         yr = (0xFF - ys_fract) + 0x80;
     }
@@ -677,6 +957,3 @@ bool _lv_img_buf_transform_anti_alias(lv_img_transform_dsc_t * dsc)
     return true;
 }
 #endif
-/**********************
- *   STATIC FUNCTIONS
- **********************/
@@ -47,6 +47,14 @@ extern "C" {
 
 #define LV_IMG_ZOOM_NONE   256
 
+/* The data of the `LV_IMG_CF_RLE_...` images:
+ * - `h + 1` little endian `uint32_t` offsets of the rows relative to the end of this table (the last is the data size)
+ * - the rows as packets. Every packet starts with a control byte:
+ *   - `LV_IMG_RLE_RUN | (n - 1)`: the next pixel is repeated `n` times
+ *   - `n - 1`: `n` pixels follow
+ * The pixels are stored as in the not compressed color format. */
+#define LV_IMG_RLE_RUN     0x80
+
 #define _LV_TRANSFORM_TRIGO_SHIFT 10
 #define _LV_ZOOM_INV_UPSCALE 5
 
@@ -79,9 +87,9 @@ enum {
     LV_IMG_CF_ALPHA_4BIT, /**< Can have one color but 16 different alpha value*/
     LV_IMG_CF_ALPHA_8BIT, /**< Can have one color but 256 different alpha value*/
 
-    LV_IMG_CF_RESERVED_15,              /**< Reserved for further use. */
-    LV_IMG_CF_RESERVED_16,              /**< Reserved for further use. */
-    LV_IMG_CF_RESERVED_17,              /**< Reserved for further use. */
+    LV_IMG_CF_RLE_TRUE_COLOR,              /**< Run-length encoded `LV_IMG_CF_TRUE_COLOR`*/
+    LV_IMG_CF_RLE_TRUE_COLOR_ALPHA,        /**< Run-length encoded `LV_IMG_CF_TRUE_COLOR_ALPHA`*/
+    LV_IMG_CF_RLE_TRUE_COLOR_CHROMA_KEYED, /**< Run-length encoded `LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED`*/
     LV_IMG_CF_RESERVED_18,              /**< Reserved for further use. */
     LV_IMG_CF_RESERVED_19,              /**< Reserved for further use. */
     LV_IMG_CF_RESERVED_20,              /**< Reserved for further use. */
@@ -170,6 +178,7 @@ typedef struct {
         uint8_t chroma_keyed : 1;
         uint8_t has_alpha : 1;
         uint8_t native_color : 1;
+        uint8_t antialias : 1;      /*Not used if the image is only upscaled with an integer factor*/
 
         uint32_t zoom_inv;
 
@@ -279,41 +288,31 @@ void _lv_img_buf_transform_init(lv_img_transform_dsc_t * dsc);
 bool _lv_img_buf_transform_anti_alias(lv_img_transform_dsc_t * dsc);
 
 /**
- * Get which color and opa would come to a pixel if it were rotated
- * @param dsc a descriptor initialized by `lv_img_buf_rotate_init`
- * @param x the coordinate which color and opa should be get
- * @param y the coordinate which color and opa should be get
- * @return true: there is valid pixel on these x/y coordinates; false: the rotated pixel was out of the image
+ * Get which colors and opacities would come to a horizontal line of pixels if they were rotated.
+ * It gives the same result as calling `_lv_img_buf_transform` for every pixel but
+ * it steps the source coordinates incrementally and doesn't check the bounds of the inner pixels.
+ * @param dsc a descriptor initialized by `_lv_img_buf_transform_init`
+ * @param x the x coordinate of the first pixel
+ * @param y the y coordinate of the line
+ * @param len number of pixels to transform
+ * @param cbuf store the colors here
+ * @param abuf store the opacities here. 0 where no pixel of the image comes.
+ */
+void _lv_img_buf_transform_line(lv_img_transform_dsc_t * dsc, lv_coord_t x, lv_coord_t y, lv_coord_t len,
+                                lv_color_t * cbuf, lv_opa_t * abuf);
+
+/**
+ * Get the color and opa of a source pixel given with 1/256 precision
+ * @param dsc a descriptor initialized by `_lv_img_buf_transform_init`
+ * @param xs the x coordinate on the source image [1/256 px]
+ * @param ys the y coordinate on the source image [1/256 px]
+ * @return true: there is valid pixel on these x/y coordinates; false: the pixel was out of the image
  * @note the result is written back to `dsc->res_color` and `dsc->res_opa`
  */
-static inline bool _lv_img_buf_transform(lv_img_transform_dsc_t * dsc, lv_coord_t x, lv_coord_t y)
+static inline bool _lv_img_buf_transform_px(lv_img_transform_dsc_t * dsc, int32_t xs, int32_t ys)
 {
     const uint8_t * src_u8 = (const uint8_t *)dsc->cfg.src;
 
-    /*Get the target point relative coordinates to the pivot*/
-    int32_t xt = x - dsc->cfg.pivot_x;
-    int32_t yt = y - dsc->cfg.pivot_y;
-
-    int32_t xs;
-    int32_t ys;
-    if(dsc->cfg.zoom == LV_IMG_ZOOM_NONE) {
-        /*Get the source pixel from the upscaled image*/
-        xs = ((dsc->tmp.cosma * xt - dsc->tmp.sinma * yt) >> (_LV_TRANSFORM_TRIGO_SHIFT - 8)) + dsc->tmp.pivot_x_256;
-        ys = ((dsc->tmp.sinma * xt + dsc->tmp.cosma * yt) >> (_LV_TRANSFORM_TRIGO_SHIFT - 8)) + dsc->tmp.pivot_y_256;
-    }
-    else if(dsc->cfg.angle == 0) {
-        xt = (int32_t)((int32_t)xt * dsc->tmp.zoom_inv) >> _LV_ZOOM_INV_UPSCALE;
-        yt = (int32_t)((int32_t)yt * dsc->tmp.zoom_inv) >> _LV_ZOOM_INV_UPSCALE;
-        xs = xt + dsc->tmp.pivot_x_256;
-        ys = yt + dsc->tmp.pivot_y_256;
-    }
-    else {
-        xt = (int32_t)((int32_t)xt * dsc->tmp.zoom_inv) >> _LV_ZOOM_INV_UPSCALE;
-        yt = (int32_t)((int32_t)yt * dsc->tmp.zoom_inv) >> _LV_ZOOM_INV_UPSCALE;
-        xs = ((dsc->tmp.cosma * xt - dsc->tmp.sinma * yt) >> (_LV_TRANSFORM_TRIGO_SHIFT)) + dsc->tmp.pivot_x_256;
-        ys = ((dsc->tmp.sinma * xt + dsc->tmp.cosma * yt) >> (_LV_TRANSFORM_TRIGO_SHIFT)) + dsc->tmp.pivot_y_256;
-    }
-
     /*Get the integer part of the source pixel*/
     int32_t xs_int = xs >> 8;
     int32_t ys_int = ys >> 8;
@@ -352,7 +351,7 @@ static inline bool _lv_img_buf_transform(lv_img_transform_dsc_t * dsc, lv_coord_
         if(dsc->res.color.full == ct.full) return false;
     }
 
-    if(dsc->cfg.antialias == false) return true;
+    if(dsc->tmp.antialias == false) return true;
 
     dsc->tmp.xs = xs;
     dsc->tmp.ys = ys;
@@ -366,6 +365,57 @@ static inline bool _lv_img_buf_transform(lv_img_transform_dsc_t * dsc, lv_coord_
 
     return ret;
 }
+
+/**
+ * Get where a pixel comes from on the source image if it were rotated
+ * @param dsc a descriptor initialized by `_lv_img_buf_transform_init`
+ * @param x the x coordinate of the pixel
+ * @param y the y coordinate of the pixel
+ * @param xs store the x coordinate on the source image here [1/256 px]
+ * @param ys store the y coordinate on the source image here [1/256 px]
+ */
+static inline void _lv_img_buf_transform_coords(const lv_img_transform_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
+                                                int32_t * xs, int32_t * ys)
+{
+    /*Get the target point relative coordinates to the pivot*/
+    int32_t xt = x - dsc->cfg.pivot_x;
+    int32_t yt = y - dsc->cfg.pivot_y;
+
+    if(dsc->cfg.zoom == LV_IMG_ZOOM_NONE) {
+        /*Get the source pixel from the upscaled image*/
+        *xs = ((dsc->tmp.cosma * xt - dsc->tmp.sinma * yt) >> (_LV_TRANSFORM_TRIGO_SHIFT - 8)) + dsc->tmp.pivot_x_256;
+        *ys = ((dsc->tmp.sinma * xt + dsc->tmp.cosma * yt) >> (_LV_TRANSFORM_TRIGO_SHIFT - 8)) + dsc->tmp.pivot_y_256;
+    }
+    else if(dsc->cfg.angle == 0) {
+        xt = (int32_t)((int32_t)xt * dsc->tmp.zoom_inv) >> _LV_ZOOM_INV_UPSCALE;
+        yt = (int32_t)((int32_t)yt * dsc->tmp.zoom_inv) >> _LV_ZOOM_INV_UPSCALE;
+        *xs = xt + dsc->tmp.pivot_x_256;
+        *ys = yt + dsc->tmp.pivot_y_256;
+    }
+    else {
+        xt = (int32_t)((int32_t)xt * dsc->tmp.zoom_inv) >> _LV_ZOOM_INV_UPSCALE;
+        yt = (int32_t)((int32_t)yt * dsc->tmp.zoom_inv) >> _LV_ZOOM_INV_UPSCALE;
+        *xs = ((dsc->tmp.cosma * xt - dsc->tmp.sinma * yt) >> (_LV_TRANSFORM_TRIGO_SHIFT)) + dsc->tmp.pivot_x_256;
+        *ys = ((dsc->tmp.sinma * xt + dsc->tmp.cosma * yt) >> (_LV_TRANSFORM_TRIGO_SHIFT)) + dsc->tmp.pivot_y_256;
+    }
+}
+
+/**
+ * Get which color and opa would come to a pixel if it were rotated
+ * @param dsc a descriptor initialized by `lv_img_buf_rotate_init`
+ * @param x the coordinate which color and opa should be get
+ * @param y the coordinate which color and opa should be get
+ * @return true: there is valid pixel on these x/y coordinates; false: the rotated pixel was out of the image
+ * @note the result is written back to `dsc->res_color` and `dsc->res_opa`
+ */
+static inline bool _lv_img_buf_transform(lv_img_transform_dsc_t * dsc, lv_coord_t x, lv_coord_t y)
+{
+    int32_t xs;
+    int32_t ys;
+    _lv_img_buf_transform_coords(dsc, x, y, &xs, &ys);
+
+    return _lv_img_buf_transform_px(dsc, xs, ys);
+}
 #endif
 /**
  * Get the area of a rectangle if its rotated and scaled
@@ -379,6 +429,17 @@ static inline bool _lv_img_buf_transform(lv_img_transform_dsc_t * dsc, lv_coord_
 void _lv_img_buf_get_transformed_area(lv_area_t * res, lv_coord_t w, lv_coord_t h, int16_t angle, uint16_t zoom,
                                       const lv_point_t * pivot);
 
+/**
+ * Downscale a true color image to half of its width and height.
+ * Every 2x2 pixels are averaged weighted by their opacity.
+ * @param src the pixels of the source image
+ * @param w width of the source image
+ * @param h height of the source image
+ * @param cf color format of the image. Only `LV_IMG_CF_TRUE_COLOR...` formats are supported.
+ * @param dst store the pixels of the `w / 2` x `h / 2` sized image here
+ */
+void _lv_img_buf_halve(const uint8_t * src, lv_coord_t w, lv_coord_t h, lv_img_cf_t cf, uint8_t * dst);
+
 /**********************
  *      MACROS
  **********************/
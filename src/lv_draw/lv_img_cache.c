@@ -12,13 +12,13 @@
 #include "lv_draw_img.h"
 #include "../lv_hal/lv_hal_tick.h"
 #include "../lv_misc/lv_gc.h"
+#if LV_IMG_CACHE_DEF_SIZE
+    #include "../lv_core/lv_refr.h"
+#endif
 
 /*********************
  *      DEFINES
  *********************/
-/*Decrement life with this value on every open*/
-#define LV_IMG_CACHE_AGING 1
-
 /*Boost life by this factor (multiply time_to_open with this value)*/
 #define LV_IMG_CACHE_LIFE_GAIN 1
 
@@ -26,19 +26,67 @@
  * "die" from very high values */
 #define LV_IMG_CACHE_LIFE_LIMIT 1000
 
+/*Marks the end of a hash bucket's list*/
+#define LV_IMG_CACHE_NONE 0xFFFF
+
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_IMG_CACHE_DEF_SIZE
+/*An image waiting to be opened by `async_task`*/
+typedef struct {
+    const void * src;       /*Copied if it's a path*/
+    lv_disp_t * disp;       /*Invalidate `inv_area` on this display. NULL: nothing to invalidate*/
+    lv_area_t inv_area;
+    lv_color_t color;
+    lv_img_cache_prio_t prio;
+    lv_img_cache_job_t * job;   /*Being opened by the worker. NULL: not started yet*/
+    uint8_t inv_all_disp : 1;   /*Drawn on more displays: invalidate the whole screens*/
+    uint8_t failed : 1;         /*Couldn't be opened. Don't try it again until it's drawn or invalidated*/
+} lv_img_cache_async_req_t;
+
+/*An image opened by the worker set by `lv_img_cache_set_worker()`*/
+struct _lv_img_cache_job_t {
+    lv_img_decoder_dsc_t dec_dsc;
+    const void * src;
+    lv_color_t color;
+    lv_res_t res;
+};
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 #if LV_IMG_CACHE_DEF_SIZE
-static bool lv_img_cache_match(const void * src1, const void * src2);
+static uint32_t lv_img_cache_hash(const void * src, lv_img_src_t src_type);
+static bool lv_img_cache_match(const void * src, lv_img_src_t src_type, const lv_img_decoder_dsc_t * dsc);
+static lv_img_cache_entry_t * lv_img_cache_find(const void * src, lv_color_t color);
+static lv_img_cache_entry_t * get_reusable_entry(bool empty_ok);
+static lv_img_cache_entry_t * entry_get_free(void);
+static void entry_add(lv_img_cache_entry_t * entry, const void * src);
+static void entry_use(lv_img_cache_entry_t * entry);
+static void entry_close(lv_img_cache_entry_t * entry);
+static void entry_invalidate(lv_img_cache_entry_t * entry);
+static void shrink_to_limit(void);
+static uint32_t get_mem_size(const lv_img_decoder_dsc_t * dsc);
+static lv_img_cache_entry_t * entry_hit(lv_img_cache_entry_t * entry);
+#if LV_IMG_CACHE_MIPMAP
+static lv_res_t mipmap_create(lv_img_cache_entry_t * entry);
+#endif
 #endif
 
-#if LV_IMG_CACHE_DEF_SIZE == 0
-    static lv_img_cache_entry_t cache_temp;
+#if LV_IMG_CACHE_DEF_SIZE
+static bool async_req_match(const lv_img_cache_async_req_t * req, const void * src, lv_img_src_t src_type);
+static lv_img_cache_async_req_t * async_req_find(const void * src, lv_color_t color);
+static lv_img_cache_async_req_t * async_req_add(const void * src, lv_color_t color, lv_img_cache_prio_t prio);
+static void async_req_drop_failed(const void * src);
+static void async_req_delete(lv_img_cache_async_req_t * req);
+#if LV_IMG_CACHE_ASYNC
+static void async_req_add_area(lv_img_cache_async_req_t * req, const lv_area_t * inv_area);
+#endif
+static void async_req_invalidate(lv_img_cache_async_req_t * req);
+static lv_img_cache_async_req_t * async_req_find_job(const lv_img_cache_job_t * job);
+static void async_task(lv_task_t * task);
 #endif
 
 /**********************
@@ -46,11 +94,26 @@ static bool lv_img_cache_match(const void * src1, const void * src2);
  **********************/
 #if LV_IMG_CACHE_DEF_SIZE
     static uint16_t entry_cnt;
+    static uint16_t bucket_mask;
+    static uint32_t use_stamp;
+#else
+    static lv_img_cache_entry_t cache_temp;
+#endif
+static lv_img_cache_stat_t cache_stat = {.mem_limit = LV_IMG_CACHE_DEF_MEM_LIMIT};
+
+#if LV_IMG_CACHE_DEF_SIZE
+    static lv_task_t * async_task_p;
+    static lv_img_cache_worker_cb_t worker_cb;
+#endif
+#if LV_IMG_CACHE_ASYNC
+    static const void * placeholder;
 #endif
 
 /**********************
  *      MACROS
  **********************/
+/*The hash buckets are allocated right after the entries*/
+#define GET_BUCKETS() ((uint16_t *)&LV_GC_ROOT(_lv_img_cache_array)[entry_cnt])
 
 /**********************
  *   GLOBAL FUNCTIONS
@@ -75,64 +138,31 @@ lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color)
         return NULL;
     }
 
-    lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+    cached_src = lv_img_cache_find(src, color);
+    if(cached_src) return entry_hit(cached_src);
 
-    /*Decrement all lifes. Make the entries older*/
-    uint16_t i;
-    for(i = 0; i < entry_cnt; i++) {
-        if(cache[i].life > INT32_MIN + LV_IMG_CACHE_AGING) {
-            cache[i].life -= LV_IMG_CACHE_AGING;
-        }
-    }
+    use_stamp++;
 
-    for(i = 0; i < entry_cnt; i++) {
-        if(color.full == cache[i].dec_dsc.color.full &&
-           lv_img_cache_match(src, cache[i].dec_dsc.src)) {
-            /* If opened increment its life.
-             * Image difficult to open should live longer to keep avoid frequent their recaching.
-             * Therefore increase `life` with `time_to_open`*/
-            cached_src = &cache[i];
-            cached_src->life += cached_src->dec_dsc.time_to_open * LV_IMG_CACHE_LIFE_GAIN;
-            if(cached_src->life > LV_IMG_CACHE_LIFE_LIMIT) cached_src->life = LV_IMG_CACHE_LIFE_LIMIT;
-            LV_LOG_TRACE("image draw: image found in the cache");
-            break;
-        }
-    }
+    cache_stat.miss_cnt++;
 
     /*The image is not cached then cache it now*/
-    if(cached_src) return cached_src;
-
-    /*Find an entry to reuse. Select the entry with the least life*/
-    cached_src = &cache[0];
-    for(i = 1; i < entry_cnt; i++) {
-        if(cache[i].life < cached_src->life) {
-            cached_src = &cache[i];
-        }
-    }
-
-    /*Close the decoder to reuse if it was opened (has a valid source)*/
-    if(cached_src->dec_dsc.src) {
-        lv_img_decoder_close(&cached_src->dec_dsc);
-        LV_LOG_INFO("image draw: cache miss, close and reuse an entry");
-    }
-    else {
-        LV_LOG_INFO("image draw: cache miss, cached to an empty entry");
-    }
+    cached_src = entry_get_free();
+    if(cached_src == NULL) return NULL;
 #else
     cached_src = &cache_temp;
+    cache_stat.miss_cnt++;
 #endif
     /*Open the image and measure the time to open*/
     uint32_t t_start  = lv_tick_get();
+    _lv_mem_tag_push(LV_MEM_TAG_IMG_CACHE);
     lv_res_t open_res = lv_img_decoder_open(&cached_src->dec_dsc, src, color);
+    _lv_mem_tag_pop();
     if(open_res == LV_RES_INV) {
         LV_LOG_WARN("Image draw cannot open the image resource");
         _lv_memset_00(cached_src, sizeof(lv_img_cache_entry_t));
-        cached_src->life = INT32_MIN; /*Make the empty entry very "weak" to force its use  */
         return NULL;
     }
 
-    cached_src->life = 0;
-
     /*If `time_to_open` was not set in the open function set it here*/
     if(cached_src->dec_dsc.time_to_open == 0) {
         cached_src->dec_dsc.time_to_open = lv_tick_elaps(t_start);
@@ -140,13 +170,157 @@ lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color)
 
     if(cached_src->dec_dsc.time_to_open == 0) cached_src->dec_dsc.time_to_open = 1;
 
+#if LV_IMG_CACHE_DEF_SIZE
+    entry_add(cached_src, src);
+#endif
+
     return cached_src;
 }
 
+/**
+ * Release an entry returned by `_lv_img_cache_open`.
+ * The entry can be closed only after all of its opens are released.
+ * @param entry pointer to a cache entry
+ */
+void _lv_img_cache_release(lv_img_cache_entry_t * entry)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    if(entry->pin_cnt > 0) entry->pin_cnt--;
+    if(entry->pin_cnt > 0) return;
+
+    /*The image was invalidated while it was pinned*/
+    if(entry->stale) entry_close(entry);
+
+    /*An image larger than the budget could be kept only while it was used*/
+    shrink_to_limit();
+#else
+    /*Automatically close images with no caching*/
+    lv_img_decoder_close(&entry->dec_dsc);
+#endif
+}
+
+#if LV_IMG_CACHE_DEF_SIZE
+/**
+ * Initialize the asynchronous opening of the images
+ */
+void _lv_img_cache_async_init(void)
+{
+    _lv_ll_init(&LV_GC_ROOT(_lv_img_cache_async_ll), sizeof(lv_img_cache_async_req_t));
+
+    /*Run only if there are images to open*/
+    async_task_p = lv_task_create(async_task, 0, LV_TASK_PRIO_OFF, NULL);
+    LV_ASSERT_MEM(async_task_p);
+}
+#endif
+
+#if LV_IMG_CACHE_ASYNC
+/**
+ * Get an image from the cache or queue it to be opened later by an `lv_task`.
+ * Only the slow images (see `_lv_img_cache_is_async_src`) are queued, the others are opened immediately.
+ * @param src source of the image. Path to file or pointer to an `lv_img_dsc_t` variable
+ * @param color the color of the image with `LV_IMG_CF_ALPHA_...`
+ * @param prio priority of the image if it needs to be queued
+ * @param inv_area the area to invalidate on the display being refreshed when the image is opened. Can be NULL.
+ * @param pending set to true if the image is queued
+ * @return pointer to the cache entry (release it with `_lv_img_cache_release`)
+ *         or NULL if the image is queued or can't be opened
+ */
+lv_img_cache_entry_t * _lv_img_cache_open_async(const void * src, lv_color_t color, lv_img_cache_prio_t prio,
+                                                const lv_area_t * inv_area, bool * pending)
+{
+    *pending = false;
+
+    if(entry_cnt == 0 || async_task_p == NULL || !_lv_img_cache_is_async_src(src)) {
+        return _lv_img_cache_open(src, color);
+    }
+
+    lv_img_cache_entry_t * entry = lv_img_cache_find(src, color);
+    if(entry) return entry_hit(entry);
+
+    lv_img_cache_async_req_t * req = async_req_find(src, color);
+    if(req && req->failed) {
+        /*Open it again now to get the error message*/
+        async_req_delete(req);
+        return _lv_img_cache_open(src, color);
+    }
+
+    req = async_req_add(src, color, prio);
+    if(req == NULL) return _lv_img_cache_open(src, color);
+
+    if(inv_area) async_req_add_area(req, inv_area);
+
+    *pending = true;
+    return NULL;
+}
+
+/**
+ * Tell whether an image is opened asynchronously.
+ * The file images and the variables with `LV_IMG_CF_RAW...` color formats are considered slow to open.
+ * @param src source of the image
+ * @return true: the image is opened asynchronously
+ */
+bool _lv_img_cache_is_async_src(const void * src)
+{
+    lv_img_src_t src_type = lv_img_src_get_type(src);
+    if(src_type == LV_IMG_SRC_FILE) return true;
+    if(src_type != LV_IMG_SRC_VARIABLE) return false;
+
+    /*The built-in color formats are drawn directly from the variable*/
+    lv_img_cf_t cf = ((const lv_img_dsc_t *)src)->header.cf;
+    return cf == LV_IMG_CF_RAW || cf == LV_IMG_CF_RAW_ALPHA || cf == LV_IMG_CF_RAW_CHROMA_KEYED;
+}
+#endif
+
+#if LV_IMG_CACHE_MIPMAP
+/**
+ * Get the pixels to draw a cached image with a given zoom.
+ * If the image is zoomed out at least to half its downscaled levels are created (once)
+ * and the smallest level which is still not smaller than the drawn image is returned.
+ * The levels are counted in the memory budget of the cache.
+ * @param entry pointer to an opened entry
+ * @param zoom the zoom to draw the image with
+ * @param level store the level here: the image is downscaled by `2^level`. 0: the original image
+ * @return the pixels of the level or `entry->dec_dsc.img_data` if the original image should be drawn
+ */
+const uint8_t * _lv_img_cache_get_mipmap(lv_img_cache_entry_t * entry, uint16_t zoom, uint8_t * level)
+{
+    const lv_img_decoder_dsc_t * dsc = &entry->dec_dsc;
+    *level = 0;
+
+    if(zoom == 0 || zoom > LV_IMG_ZOOM_NONE / 2) return dsc->img_data;
+    if(dsc->img_data == NULL) return dsc->img_data;
+
+    /*Only the true color images can be averaged. (The RLE images are decoded to true color.)*/
+    lv_img_cf_t cf = dsc->header.cf;
+    if(cf != LV_IMG_CF_TRUE_COLOR && cf != LV_IMG_CF_TRUE_COLOR_ALPHA && cf != LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED &&
+       cf != LV_IMG_CF_RLE_TRUE_COLOR && cf != LV_IMG_CF_RLE_TRUE_COLOR_ALPHA &&
+       cf != LV_IMG_CF_RLE_TRUE_COLOR_CHROMA_KEYED) {
+        return dsc->img_data;
+    }
+
+    if(entry->mipmap == NULL) {
+        if(mipmap_create(entry) != LV_RES_OK) return dsc->img_data;
+    }
+
+    /*Find the smallest level where the image is still not upscaled*/
+    uint8_t px_size = lv_img_cf_get_px_size(cf) >> 3;
+    const uint8_t * level_data = entry->mipmap;
+    uint8_t l = 1;
+    while(l < entry->mipmap_levels && (zoom << (l + 1)) <= LV_IMG_ZOOM_NONE) {
+        level_data += (dsc->header.w >> l) * (dsc->header.h >> l) * px_size;
+        l++;
+    }
+
+    *level = l;
+    return level_data;
+}
+#endif
+
 /**
  * Set the number of images to be cached.
  * More cached images mean more opened image at same time which might mean more memory usage.
  * E.g. if 20 PNG or JPG images are open in the RAM they consume memory while opened in the cache.
+ * The size can't be changed while an image is pinned.
  * @param new_entry_cnt number of image to cache
  */
 void lv_img_cache_set_size(uint16_t new_entry_cnt)
@@ -156,62 +330,795 @@ void lv_img_cache_set_size(uint16_t new_entry_cnt)
     LV_LOG_WARN("Can't change cache size because it's disabled by LV_IMG_CACHE_DEF_SIZE = 0");
 #else
     if(LV_GC_ROOT(_lv_img_cache_array) != NULL) {
+        /*The pinned entries are referenced by their users*/
+        lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+        uint16_t i;
+        for(i = 0; i < entry_cnt; i++) {
+            if(cache[i].pin_cnt) {
+                LV_LOG_WARN("lv_img_cache_set_size: can't resize the cache while an image is pinned");
+                return;
+            }
+        }
+
         /*Clean the cache before free it*/
         lv_img_cache_invalidate_src(NULL);
         lv_mem_free(LV_GC_ROOT(_lv_img_cache_array));
     }
 
+    if(new_entry_cnt >= LV_IMG_CACHE_NONE) new_entry_cnt = LV_IMG_CACHE_NONE - 1;
+
+    /*Use at least as many hash buckets as entries*/
+    uint32_t bucket_cnt = 1;
+    while(bucket_cnt < new_entry_cnt) bucket_cnt <<= 1;
+
     /*Reallocate the cache*/
-    LV_GC_ROOT(_lv_img_cache_array) = lv_mem_alloc(sizeof(lv_img_cache_entry_t) * new_entry_cnt);
+    LV_GC_ROOT(_lv_img_cache_array) = lv_mem_alloc_tag(sizeof(lv_img_cache_entry_t) * new_entry_cnt +
+                                                   sizeof(uint16_t) * bucket_cnt, LV_MEM_TAG_IMG_CACHE);
     LV_ASSERT_MEM(LV_GC_ROOT(_lv_img_cache_array));
     if(LV_GC_ROOT(_lv_img_cache_array) == NULL) {
         entry_cnt = 0;
         return;
     }
     entry_cnt = new_entry_cnt;
+    bucket_mask = bucket_cnt - 1;
 
     /*Clean the cache*/
     _lv_memset_00(LV_GC_ROOT(_lv_img_cache_array), entry_cnt * sizeof(lv_img_cache_entry_t));
+    _lv_memset_ff(GET_BUCKETS(), bucket_cnt * sizeof(uint16_t));
+    cache_stat.mem_used = 0;
 #endif
 }
 
 /**
  * Invalidate an image source in the cache.
  * Useful if the image source is updated therefore it needs to be cached again.
+ * The pinned images are kept until the last pin is released (e.g. by `lv_img_cache_unpin`) and closed then.
  * @param src an image source path to a file or pointer to an `lv_img_dsc_t` variable.
  */
 void lv_img_cache_invalidate_src(const void * src)
 {
+#if LV_IMG_CACHE_DEF_SIZE
+    /*Let the images which couldn't be opened to be queued again*/
+    async_req_drop_failed(src);
+#endif
+
+#if LV_IMG_CACHE_DEF_SIZE
+    lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+
+    if(src == NULL) {
+        uint16_t i;
+        for(i = 0; i < entry_cnt; i++) {
+            if(cache[i].dec_dsc.src != NULL) entry_invalidate(&cache[i]);
+        }
+        return;
+    }
+
+    lv_img_src_t src_type = lv_img_src_get_type(src);
+    uint32_t hash = lv_img_cache_hash(src, src_type);
+    uint16_t i = GET_BUCKETS()[hash & bucket_mask];
+    while(i != LV_IMG_CACHE_NONE) {
+        uint16_t next = cache[i].hash_next;
+        /*The entry can be cached with different colors. Close all of them.*/
+        if(cache[i].hash == hash && lv_img_cache_match(src, src_type, &cache[i].dec_dsc)) {
+            entry_invalidate(&cache[i]);
+        }
+        i = next;
+    }
+#else
+    LV_UNUSED(src);
+#endif
+}
+
+/**
+ * Set the memory budget of the cache. If the opened images keep more memory allocated
+ * the least recently used ones are closed.
+ * @param mem_limit the budget in bytes. 0: no limit, only the number of images is limited
+ */
+void lv_img_cache_set_mem_limit(uint32_t mem_limit)
+{
+    cache_stat.mem_limit = mem_limit;
+#if LV_IMG_CACHE_DEF_SIZE
+    shrink_to_limit();
+#endif
+}
+
+/**
+ * Open an image and keep it in the cache until `lv_img_cache_unpin` is called.
+ * @param src an image source path to a file or pointer to an `lv_img_dsc_t` variable.
+ * @param color the color of the image with `LV_IMG_CF_ALPHA_...`
+ * @return LV_RES_OK: the image is opened and pinned; LV_RES_INV: the image can't be opened
+ */
+lv_res_t lv_img_cache_pin(const void * src, lv_color_t color)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    /*The entry remains pinned by the open*/
+    lv_img_cache_entry_t * entry = _lv_img_cache_open(src, color);
+    return entry ? LV_RES_OK : LV_RES_INV;
+#else
+    LV_UNUSED(src);
+    LV_UNUSED(color);
+    LV_LOG_WARN("Can't pin images because caching is disabled by LV_IMG_CACHE_DEF_SIZE = 0");
+    return LV_RES_INV;
+#endif
+}
+
+/**
+ * Let a pinned image be closed again
+ * @param src an image source path to a file or pointer to an `lv_img_dsc_t` variable.
+ * @param color the color used in `lv_img_cache_pin`
+ */
+void lv_img_cache_unpin(const void * src, lv_color_t color)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    if(entry_cnt == 0) return;
+
+    lv_img_cache_entry_t * entry = lv_img_cache_find(src, color);
+    if(entry) _lv_img_cache_release(entry);
+#else
+    LV_UNUSED(src);
+    LV_UNUSED(color);
+#endif
+}
+
+/**
+ * Get statistics about the image cache
+ * @param stat store the result here
+ */
+void lv_img_cache_get_stat(lv_img_cache_stat_t * stat)
+{
+    _lv_memcpy_small(stat, &cache_stat, sizeof(lv_img_cache_stat_t));
+
 #if LV_IMG_CACHE_DEF_SIZE
     lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+    stat->entry_max = entry_cnt;
 
     uint16_t i;
     for(i = 0; i < entry_cnt; i++) {
-        if(src == NULL || lv_img_cache_match(src, cache[i].dec_dsc.src)) {
-            if(cache[i].dec_dsc.src != NULL) {
-                lv_img_decoder_close(&cache[i].dec_dsc);
-            }
+        if(cache[i].dec_dsc.src == NULL) continue;
+        stat->entry_cnt++;
+        if(cache[i].pin_cnt) stat->pinned_cnt++;
+    }
+#endif
+}
 
-            _lv_memset_00(&cache[i], sizeof(lv_img_cache_entry_t));
+/**
+ * Open the queued images (see `lv_img_cache_prefetch()` and `LV_IMG_CACHE_ASYNC`) in an other thread.
+ * By default they are opened in an `lv_task` which blocks the rendering until the image is decoded.
+ * @param cb called in the `lv_task` with a job to pass to the worker thread.
+ *           The worker should call `lv_img_cache_job_open()` and then `lv_img_cache_job_ready()`.
+ *           NULL: open the images in the `lv_task`
+ */
+void lv_img_cache_set_worker(lv_img_cache_worker_cb_t cb)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    worker_cb = cb;
+#else
+    LV_UNUSED(cb);
+    LV_LOG_WARN("Can't set the worker because caching is disabled by LV_IMG_CACHE_DEF_SIZE = 0");
+#endif
+}
+
+/**
+ * Open the image of a job. Call it in the worker thread without locking LVGL.
+ * The image decoders, the file system drivers and `lv_mem` should be usable from the worker thread
+ * (e.g. `LV_MEM_THREAD_SAFE = 1`).
+ * @param job the job given to the callback of `lv_img_cache_set_worker()`
+ */
+void lv_img_cache_job_open(lv_img_cache_job_t * job)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    uint32_t t_start = lv_tick_get();
+    _lv_mem_tag_push(LV_MEM_TAG_IMG_CACHE);
+    job->res = lv_img_decoder_open(&job->dec_dsc, job->src, job->color);
+    _lv_mem_tag_pop();
+
+    if(job->res == LV_RES_OK && job->dec_dsc.time_to_open == 0) {
+        job->dec_dsc.time_to_open = lv_tick_elaps(t_start);
+    }
+#else
+    LV_UNUSED(job);
+#endif
+}
+
+/**
+ * Add the image opened by `lv_img_cache_job_open()` to the cache and free the job.
+ * Call it from the thread of `lv_task_handler()` or with the same mutex locked.
+ * @param job the job given to the callback of `lv_img_cache_set_worker()`
+ */
+void lv_img_cache_job_ready(lv_img_cache_job_t * job)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    lv_img_cache_async_req_t * req = async_req_find_job(job);
+
+    lv_img_cache_entry_t * entry = NULL;
+    bool cached = false;
+    if(job->res == LV_RES_OK && entry_cnt) {
+        /*The image could be opened while the job was running, e.g. by `lv_img_cache_pin()`*/
+        cached = lv_img_cache_find(job->src, job->color) != NULL;
+        if(!cached) {
+            use_stamp++;
+            cache_stat.miss_cnt++;
+            entry = entry_get_free();
+        }
+    }
+
+    if(entry) {
+        /*The opened descriptor is moved to the entry*/
+        if(job->dec_dsc.time_to_open == 0) job->dec_dsc.time_to_open = 1;
+        _lv_memcpy(&entry->dec_dsc, &job->dec_dsc, sizeof(lv_img_decoder_dsc_t));
+        entry_add(entry, job->src);
+        _lv_img_cache_release(entry);
+        cached = true;
+    }
+    else if(job->res == LV_RES_OK) {
+        lv_img_decoder_close(&job->dec_dsc);
+    }
+    else {
+        LV_LOG_WARN("Image cache: the worker cannot open the image resource");
+    }
+
+    if(req) {
+        async_req_invalidate(req);
+        if(cached) {
+            async_req_delete(req);
+        }
+        else {
+            /*Keep the request to avoid queuing it again and again*/
+            req->job = NULL;
+            req->failed = 1;
         }
     }
+
+    lv_mem_free(job);
+
+    /*Continue with the next image*/
+    if(_lv_ll_get_head(&LV_GC_ROOT(_lv_img_cache_async_ll))) lv_task_set_prio(async_task_p, LV_TASK_PRIO_LOW);
+#else
+    LV_UNUSED(job);
 #endif
 }
 
+/**
+ * Open an image in advance in an `lv_task` (one image in every run) to have it in the cache when it's drawn.
+ * The image is opened in the worker thread instead if it's set by `lv_img_cache_set_worker()`.
+ * Useful to prepare the images of a screen before loading it.
+ * Note that the cache should be large enough to keep all the prefetched images.
+ * @param src an image source path to a file or pointer to an `lv_img_dsc_t` variable.
+ * @param color the color of the image with `LV_IMG_CF_ALPHA_...`
+ * @return LV_RES_OK: the image is cached or queued; LV_RES_INV: the image can't be queued or failed to open
+ */
+lv_res_t lv_img_cache_prefetch(const void * src, lv_color_t color)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    if(entry_cnt == 0 || async_task_p == NULL) return LV_RES_INV;
+    if(lv_img_cache_find(src, color)) return LV_RES_OK;
+
+    lv_img_cache_async_req_t * req = async_req_add(src, color, LV_IMG_CACHE_PRIO_PREFETCH);
+    if(req == NULL || req->failed) return LV_RES_INV;
+
+    return LV_RES_OK;
+#else
+    LV_UNUSED(src);
+    LV_UNUSED(color);
+    LV_LOG_WARN("Can't prefetch images because caching is disabled by LV_IMG_CACHE_DEF_SIZE = 0");
+    return LV_RES_INV;
+#endif
+}
+
+/**
+ * Tell whether an image is opened in the cache
+ * @param src an image source path to a file or pointer to an `lv_img_dsc_t` variable.
+ * @param color the color of the image with `LV_IMG_CF_ALPHA_...`
+ * @return true: the image is cached and can be drawn without opening it
+ */
+bool lv_img_cache_is_cached(const void * src, lv_color_t color)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    if(entry_cnt == 0) return false;
+    return lv_img_cache_find(src, color) != NULL;
+#else
+    LV_UNUSED(src);
+    LV_UNUSED(color);
+    return false;
+#endif
+}
+
+#if LV_IMG_CACHE_ASYNC
+/**
+ * Set an image to draw instead of the images being opened asynchronously.
+ * It's drawn to the center of the image's area.
+ * @param src an `lv_img_dsc_t` variable with a built-in color format or NULL to draw nothing
+ */
+void lv_img_cache_set_placeholder(const void * src)
+{
+    if(src && _lv_img_cache_is_async_src(src)) {
+        LV_LOG_WARN("lv_img_cache_set_placeholder: the placeholder can't be opened asynchronously");
+        return;
+    }
+
+    placeholder = src;
+}
+
+/**
+ * Get the image drawn instead of the images being opened asynchronously.
+ * @return the placeholder image or NULL if not set
+ */
+const void * lv_img_cache_get_placeholder(void)
+{
+    return placeholder;
+}
+#endif
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
 #if LV_IMG_CACHE_DEF_SIZE
-static bool lv_img_cache_match(const void * src1, const void * src2)
+static uint32_t lv_img_cache_hash(const void * src, lv_img_src_t src_type)
+{
+    uint32_t hash;
+    if(src_type == LV_IMG_SRC_FILE) {
+        /*FNV-1a of the path*/
+        const uint8_t * p = src;
+        hash = 2166136261u;
+        while(*p) {
+            hash ^= *p;
+            hash *= 16777619u;
+            p++;
+        }
+    }
+    else {
+        /*The address of the variable. The lower bits are usually 0 because of the alignment.*/
+        hash = (uint32_t)((lv_uintptr_t)src >> 2) * 2654435761u;
+        hash ^= hash >> 16;
+    }
+
+    return hash;
+}
+
+static bool lv_img_cache_match(const void * src, lv_img_src_t src_type, const lv_img_decoder_dsc_t * dsc)
 {
-    lv_img_src_t src_type = lv_img_src_get_type(src1);
     if(src_type == LV_IMG_SRC_VARIABLE)
-        return src1 == src2;
+        return src == dsc->src;
     if(src_type != LV_IMG_SRC_FILE)
         return false;
-    if(lv_img_src_get_type(src2) != LV_IMG_SRC_FILE)
+    if(dsc->src_type != LV_IMG_SRC_FILE || dsc->src == NULL)
         return false;
-    return strcmp(src1, src2) == 0;
+    return strcmp(src, dsc->src) == 0;
+}
+
+/**
+ * Find an opened entry in the cache
+ * @param src source of the image
+ * @param color color of the image
+ * @return pointer to the entry or NULL if the image is not cached
+ */
+static lv_img_cache_entry_t * lv_img_cache_find(const void * src, lv_color_t color)
+{
+    lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+    lv_img_src_t src_type = lv_img_src_get_type(src);
+    uint32_t hash = lv_img_cache_hash(src, src_type);
+
+    uint16_t i;
+    for(i = GET_BUCKETS()[hash & bucket_mask]; i != LV_IMG_CACHE_NONE; i = cache[i].hash_next) {
+        if(cache[i].hash == hash && color.full == cache[i].dec_dsc.color.full &&
+           lv_img_cache_match(src, src_type, &cache[i].dec_dsc)) {
+            return &cache[i];
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Use an entry found in the cache
+ * @param entry pointer to an opened entry
+ * @return `entry`
+ */
+static lv_img_cache_entry_t * entry_hit(lv_img_cache_entry_t * entry)
+{
+    use_stamp++;
+    entry_use(entry);
+    entry->pin_cnt++;
+    cache_stat.hit_cnt++;
+    LV_LOG_TRACE("image draw: image found in the cache");
+    return entry;
+}
+
+/**
+ * Select an entry to reuse. Pinned entries are skipped.
+ * @param empty_ok true: return an empty entry if there is any; false: select only from the opened entries
+ * @return an empty entry or the opened entry which was not used for the longest time
+ */
+static lv_img_cache_entry_t * get_reusable_entry(bool empty_ok)
+{
+    lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+    lv_img_cache_entry_t * oldest = NULL;
+    int32_t oldest_age = 0;
+
+    uint16_t i;
+    for(i = 0; i < entry_cnt; i++) {
+        if(cache[i].pin_cnt) continue;
+        if(cache[i].dec_dsc.src == NULL) {
+            if(empty_ok) return &cache[i];
+            continue;
+        }
+
+        int32_t age = (int32_t)(use_stamp - (uint32_t)cache[i].life);
+        if(oldest == NULL || age > oldest_age) {
+            oldest = &cache[i];
+            oldest_age = age;
+        }
+    }
+
+    return oldest;
+}
+
+/**
+ * Get an entry to open a new image in. If there is no empty entry the least recently used one is closed.
+ * @return an empty entry or NULL if all entries are pinned
+ */
+static lv_img_cache_entry_t * entry_get_free(void)
+{
+    lv_img_cache_entry_t * entry = get_reusable_entry(true);
+    if(entry == NULL) {
+        LV_LOG_WARN("lv_img_cache_open: all entries are pinned");
+        return NULL;
+    }
+
+    /*Close the decoder to reuse if it was opened (has a valid source)*/
+    if(entry->dec_dsc.src) {
+        entry_close(entry);
+        cache_stat.evict_cnt++;
+        LV_LOG_INFO("image draw: cache miss, close and reuse an entry");
+    }
+    else {
+        LV_LOG_INFO("image draw: cache miss, cached to an empty entry");
+    }
+
+    return entry;
+}
+
+/**
+ * Add an entry with an opened image to its hash bucket and pin it
+ * @param entry pointer to an entry with an opened `dec_dsc`
+ * @param src source of the image
+ */
+static void entry_add(lv_img_cache_entry_t * entry, const void * src)
+{
+    uint16_t * buckets = GET_BUCKETS();
+    uint32_t hash = lv_img_cache_hash(src, entry->dec_dsc.src_type);
+    entry->hash = hash;
+    entry->hash_next = buckets[hash & bucket_mask];
+    buckets[hash & bucket_mask] = (uint16_t)(entry - LV_GC_ROOT(_lv_img_cache_array));
+
+    entry->mem_size = get_mem_size(&entry->dec_dsc);
+    entry->pin_cnt = 1;
+    entry_use(entry);
+    cache_stat.mem_used += entry->mem_size;
+
+    /*Make place for the new image if the memory budget is exceeded*/
+    shrink_to_limit();
+}
+
+/**
+ * Mark an entry as used now.
+ * Image difficult to open should live longer to keep avoid frequent their recaching.
+ * Therefore boost `life` with `time_to_open`
+ * @param entry pointer to an opened entry
+ */
+static void entry_use(lv_img_cache_entry_t * entry)
+{
+    uint32_t boost = entry->dec_dsc.time_to_open * LV_IMG_CACHE_LIFE_GAIN;
+    if(boost > LV_IMG_CACHE_LIFE_LIMIT) boost = LV_IMG_CACHE_LIFE_LIMIT;
+    entry->life = (int32_t)(use_stamp + boost);
+}
+
+/**
+ * Close the image of an entry and remove it from its hash bucket
+ * @param entry pointer to an opened entry
+ */
+static void entry_close(lv_img_cache_entry_t * entry)
+{
+    lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+    uint16_t id = (uint16_t)(entry - cache);
+    uint16_t * i = &GET_BUCKETS()[entry->hash & bucket_mask];
+    while(*i != LV_IMG_CACHE_NONE) {
+        if(*i == id) {
+            *i = entry->hash_next;
+            break;
+        }
+        i = &cache[*i].hash_next;
+    }
+
+    cache_stat.mem_used -= entry->mem_size;
+#if LV_IMG_CACHE_MIPMAP
+    if(entry->mipmap) lv_mem_free(entry->mipmap);
+#endif
+    lv_img_decoder_close(&entry->dec_dsc);
+    _lv_memset_00(entry, sizeof(lv_img_cache_entry_t));
+}
+
+/**
+ * Close an entry or if it's pinned close it when its last pin is released
+ * @param entry pointer to an opened entry
+ */
+static void entry_invalidate(lv_img_cache_entry_t * entry)
+{
+    if(entry->pin_cnt) entry->stale = 1;
+    else entry_close(entry);
+}
+
+/**
+ * Close the least recently used images until the opened images fit into the memory budget
+ */
+static void shrink_to_limit(void)
+{
+    if(cache_stat.mem_limit == 0) return;
+
+    while(cache_stat.mem_used > cache_stat.mem_limit) {
+        lv_img_cache_entry_t * entry = get_reusable_entry(false);
+        if(entry == NULL) break;  /*The remaining images are pinned*/
+
+        entry_close(entry);
+        cache_stat.evict_cnt++;
+        LV_LOG_INFO("image cache: close an image to fit into the memory budget");
+    }
+}
+
+/**
+ * Get or estimate how many bytes an opened image keeps allocated
+ * @param dsc pointer to an opened decoder descriptor
+ * @return size in bytes
+ */
+static uint32_t get_mem_size(const lv_img_decoder_dsc_t * dsc)
+{
+    if(dsc->mem_size) return dsc->mem_size;
+
+    /*Images read line-by-line keep only a small amount of memory allocated*/
+    if(dsc->img_data == NULL) return 0;
+
+    /*Images stored in variables are drawn directly from their data*/
+    if(dsc->src_type == LV_IMG_SRC_VARIABLE && dsc->img_data == ((const lv_img_dsc_t *)dsc->src)->data) return 0;
+
+    return lv_img_buf_get_img_size(dsc->header.w, dsc->header.h, dsc->header.cf);
+}
+
+#if LV_IMG_CACHE_MIPMAP
+/**
+ * Create all the downscaled levels of an image (until its width or height is 1).
+ * The levels are counted in the memory used by the entry.
+ * @param entry pointer to an opened, pinned entry with a true color image
+ * @return LV_RES_OK: the levels are created; LV_RES_INV: too small image or out of memory
+ */
+static lv_res_t mipmap_create(lv_img_cache_entry_t * entry)
+{
+    const lv_img_header_t * header = &entry->dec_dsc.header;
+    uint8_t px_size = lv_img_cf_get_px_size(header->cf) >> 3;
+
+    uint32_t size = 0;
+    uint8_t levels = 0;
+    lv_coord_t w = header->w;
+    lv_coord_t h = header->h;
+    while(w >= 2 && h >= 2) {
+        w = w / 2;
+        h = h / 2;
+        size += w * h * px_size;
+        levels++;
+    }
+    if(levels == 0) return LV_RES_INV;
+
+    entry->mipmap = lv_mem_alloc_tag(size, LV_MEM_TAG_IMG_CACHE);
+    LV_ASSERT_MEM(entry->mipmap);
+    if(entry->mipmap == NULL) {
+        LV_LOG_WARN("image cache: couldn't allocate the downscaled levels");
+        return LV_RES_INV;
+    }
+
+    /*Create every level from the previous one*/
+    const uint8_t * src = entry->dec_dsc.img_data;
+    uint8_t * dst = entry->mipmap;
+    w = header->w;
+    h = header->h;
+    uint8_t l;
+    for(l = 0; l < levels; l++) {
+        _lv_img_buf_halve(src, w, h, header->cf, dst);
+        w = w / 2;
+        h = h / 2;
+        src = dst;
+        dst += w * h * px_size;
+    }
+    entry->mipmap_levels = levels;
+
+    entry->mem_size += size;
+    cache_stat.mem_used += size;
+
+    /*The entry is pinned so only the other images can be closed*/
+    shrink_to_limit();
+
+    return LV_RES_OK;
+}
+#endif
+#endif
+
+#if LV_IMG_CACHE_DEF_SIZE
+static bool async_req_match(const lv_img_cache_async_req_t * req, const void * src, lv_img_src_t src_type)
+{
+    if(src_type != LV_IMG_SRC_FILE) return src == req->src;
+
+    return lv_img_src_get_type(req->src) == LV_IMG_SRC_FILE && strcmp(src, req->src) == 0;
+}
+
+static lv_img_cache_async_req_t * async_req_find(const void * src, lv_color_t color)
+{
+    lv_img_src_t src_type = lv_img_src_get_type(src);
+    lv_img_cache_async_req_t * req;
+    _LV_LL_READ(LV_GC_ROOT(_lv_img_cache_async_ll), req) {
+        if(req->color.full == color.full && async_req_match(req, src, src_type)) return req;
+    }
+
+    return NULL;
+}
+
+/**
+ * Queue an image to be opened by `async_task`
+ * @param src source of the image
+ * @param color color of the image
+ * @param prio priority of the image. The priority of an already queued image is only increased.
+ * @return pointer to the new or already existing request or NULL on out of memory
+ */
+static lv_img_cache_async_req_t * async_req_add(const void * src, lv_color_t color, lv_img_cache_prio_t prio)
+{
+    lv_img_cache_async_req_t * req = async_req_find(src, color);
+    if(req == NULL) {
+        req = _lv_ll_ins_tail(&LV_GC_ROOT(_lv_img_cache_async_ll));
+        LV_ASSERT_MEM(req);
+        if(req == NULL) return NULL;
+
+        _lv_memset_00(req, sizeof(lv_img_cache_async_req_t));
+        if(lv_img_src_get_type(src) == LV_IMG_SRC_FILE) {
+            size_t len = strlen(src);
+            char * path = lv_mem_alloc_tag(len + 1, LV_MEM_TAG_IMG_CACHE);
+            LV_ASSERT_MEM(path);
+            if(path == NULL) {
+                _lv_ll_remove(&LV_GC_ROOT(_lv_img_cache_async_ll), req);
+                lv_mem_free(req);
+                return NULL;
+            }
+            _lv_memcpy(path, src, len + 1);
+            req->src = path;
+        }
+        else {
+            req->src = src;
+        }
+        req->color = color;
+        req->prio = prio;
+    }
+
+    if(prio > req->prio) req->prio = prio;
+
+    lv_task_set_prio(async_task_p, LV_TASK_PRIO_LOW);
+
+    return req;
+}
+
+/**
+ * Delete the requests which couldn't be opened
+ * @param src delete only the requests of this source. NULL: delete all failed requests
+ */
+static void async_req_drop_failed(const void * src)
+{
+    lv_img_src_t src_type = src ? lv_img_src_get_type(src) : LV_IMG_SRC_UNKNOWN;
+    lv_img_cache_async_req_t * req = _lv_ll_get_head(&LV_GC_ROOT(_lv_img_cache_async_ll));
+    while(req) {
+        lv_img_cache_async_req_t * next = _lv_ll_get_next(&LV_GC_ROOT(_lv_img_cache_async_ll), req);
+        if(req->failed && (src == NULL || async_req_match(req, src, src_type))) async_req_delete(req);
+        req = next;
+    }
+}
+
+static void async_req_delete(lv_img_cache_async_req_t * req)
+{
+    if(lv_img_src_get_type(req->src) == LV_IMG_SRC_FILE) lv_mem_free(req->src);
+
+    _lv_ll_remove(&LV_GC_ROOT(_lv_img_cache_async_ll), req);
+    lv_mem_free(req);
+}
+
+#if LV_IMG_CACHE_ASYNC
+/**
+ * Remember an area to invalidate when the image is opened
+ * @param req pointer to a request
+ * @param inv_area the area on the display being refreshed
+ */
+static void async_req_add_area(lv_img_cache_async_req_t * req, const lv_area_t * inv_area)
+{
+    lv_disp_t * disp = _lv_refr_get_disp_refreshing();
+    if(disp == NULL) disp = lv_disp_get_default();
+
+    if(req->disp == NULL) {
+        req->disp = disp;
+        lv_area_copy(&req->inv_area, inv_area);
+    }
+    else if(req->disp == disp) {
+        _lv_area_join(&req->inv_area, &req->inv_area, inv_area);
+    }
+    else {
+        req->inv_all_disp = 1;
+    }
+}
+#endif
+
+static void async_req_invalidate(lv_img_cache_async_req_t * req)
+{
+    if(req->disp == NULL) return;
+
+    /*The display might be removed since the request was added*/
+    lv_disp_t * disp = lv_disp_get_next(NULL);
+    while(disp) {
+        if(req->inv_all_disp) {
+            lv_area_t scr_area;
+            lv_area_set(&scr_area, 0, 0, lv_disp_get_hor_res(disp) - 1, lv_disp_get_ver_res(disp) - 1);
+            _lv_inv_area(disp, &scr_area);
+        }
+        else if(disp == req->disp) {
+            _lv_inv_area(disp, &req->inv_area);
+        }
+        disp = lv_disp_get_next(disp);
+    }
+}
+
+static lv_img_cache_async_req_t * async_req_find_job(const lv_img_cache_job_t * job)
+{
+    lv_img_cache_async_req_t * req;
+    _LV_LL_READ(LV_GC_ROOT(_lv_img_cache_async_ll), req) {
+        if(req->job == job) return req;
+    }
+
+    return NULL;
+}
+
+/**
+ * Open the queued image with the highest priority or pass it to the worker
+ * @param task pointer to the task
+ */
+static void async_task(lv_task_t * task)
+{
+    lv_img_cache_async_req_t * next = NULL;
+    lv_img_cache_async_req_t * req;
+    _LV_LL_READ(LV_GC_ROOT(_lv_img_cache_async_ll), req) {
+        if(req->failed || req->job) continue;
+        if(next == NULL || req->prio > next->prio) next = req;
+    }
+
+    /*`lv_img_cache_job_ready()` restarts the task*/
+    if(next == NULL) {
+        lv_task_set_prio(task, LV_TASK_PRIO_OFF);
+        return;
+    }
+
+    if(worker_cb) {
+        lv_img_cache_job_t * job = lv_mem_alloc_tag(sizeof(lv_img_cache_job_t), LV_MEM_TAG_IMG_CACHE);
+        LV_ASSERT_MEM(job);
+        if(job) {
+            _lv_memset_00(job, sizeof(lv_img_cache_job_t));
+            job->src = next->src;
+            job->color = next->color;
+            next->job = job;
+            worker_cb(job);
+            return;
+        }
+    }
+
+    lv_img_cache_entry_t * entry = _lv_img_cache_open(next->src, next->color);
+    async_req_invalidate(next);
+    if(entry) {
+        _lv_img_cache_release(entry);
+        async_req_delete(next);
+    }
+    else {
+        /*Keep the request to avoid queuing it again and again*/
+        next->failed = 1;
+    }
 }
 #endif
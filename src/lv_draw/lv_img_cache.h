@@ -18,6 +18,13 @@ extern "C" {
 /*********************
  *      DEFINES
  *********************/
+#if LV_IMG_CACHE_ASYNC && LV_IMG_CACHE_DEF_SIZE == 0
+#error "LV_IMG_CACHE_ASYNC requires LV_IMG_CACHE_DEF_SIZE > 0"
+#endif
+
+#if LV_IMG_CACHE_MIPMAP && (LV_IMG_CACHE_DEF_SIZE == 0 || LV_USE_IMG_TRANSFORM == 0)
+#error "LV_IMG_CACHE_MIPMAP requires LV_IMG_CACHE_DEF_SIZE > 0 and LV_USE_IMG_TRANSFORM = 1"
+#endif
 
 /**********************
  *      TYPEDEFS
@@ -31,12 +38,54 @@ extern "C" {
 typedef struct {
     lv_img_decoder_dsc_t dec_dsc; /**< Image information */
 
-    /** Count the cache entries's life. Add `time_to_open` to `life` when the entry is used.
-     * Decrement all lifes by one every in every ::lv_img_cache_open.
-     * If life == 0 the entry can be reused */
+    /** The time stamp of the last use boosted by `time_to_open`.
+     * The entry which was not used for the longest time (relative to its `life`) is reused first.*/
     int32_t life;
+
+    uint32_t mem_size;      /**< Bytes kept allocated by the opened image*/
+    uint32_t hash;          /**< Hash of the image source*/
+    uint16_t hash_next;     /**< Index of the next entry with the same hash bucket*/
+    uint16_t pin_cnt;       /**< Pinned entries are not closed. Set while drawing or by `lv_img_cache_pin`*/
+    uint8_t stale : 1;      /**< Invalidated while pinned: close it when the last pin is released*/
+#if LV_IMG_CACHE_MIPMAP
+    uint8_t * mipmap;       /**< The downscaled levels (1/2, 1/4, ...) after each other. NULL if not created yet*/
+    uint8_t mipmap_levels;  /**< Number of levels in `mipmap`*/
+#endif
 } lv_img_cache_entry_t;
 
+/**
+ * Priority of the images waiting to be opened asynchronously
+ */
+enum {
+    LV_IMG_CACHE_PRIO_PREFETCH,     /**< Opened in advance, not visible yet*/
+    LV_IMG_CACHE_PRIO_VISIBLE,      /**< Drawn on a screen*/
+};
+typedef uint8_t lv_img_cache_prio_t;
+
+/**
+ * An image to open in the worker thread set by `lv_img_cache_set_worker()`
+ */
+typedef struct _lv_img_cache_job_t lv_img_cache_job_t;
+
+/**
+ * Pass a job to a worker thread. Called from the `lv_task` of the image cache.
+ */
+typedef void (*lv_img_cache_worker_cb_t)(lv_img_cache_job_t * job);
+
+/**
+ * Statistics about the image cache
+ */
+typedef struct {
+    uint32_t hit_cnt;       /**< Number of opens served from the cache*/
+    uint32_t miss_cnt;      /**< Number of opens which needed to open the image with a decoder*/
+    uint32_t evict_cnt;     /**< Number of opened images closed to make place for others*/
+    uint32_t mem_used;      /**< Bytes kept allocated by the currently opened images*/
+    uint32_t mem_limit;     /**< Memory budget of the cache in bytes. 0: not limited*/
+    uint16_t entry_cnt;     /**< Number of opened images*/
+    uint16_t entry_max;     /**< Max. number of opened images*/
+    uint16_t pinned_cnt;    /**< Number of pinned images*/
+} lv_img_cache_stat_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -51,10 +100,63 @@ typedef struct {
  */
 lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color);
 
+/**
+ * Release an entry returned by `_lv_img_cache_open`.
+ * The entry can be closed only after all of its opens are released.
+ * @param entry pointer to a cache entry
+ */
+void _lv_img_cache_release(lv_img_cache_entry_t * entry);
+
+#if LV_IMG_CACHE_DEF_SIZE
+/**
+ * Initialize the asynchronous opening of the images
+ */
+void _lv_img_cache_async_init(void);
+#endif
+
+#if LV_IMG_CACHE_ASYNC
+/**
+ * Get an image from the cache or queue it to be opened later by an `lv_task`.
+ * Only the slow images (see `_lv_img_cache_is_async_src`) are queued, the others are opened immediately.
+ * @param src source of the image. Path to file or pointer to an `lv_img_dsc_t` variable
+ * @param color the color of the image with `LV_IMG_CF_ALPHA_...`
+ * @param prio priority of the image if it needs to be queued
+ * @param inv_area the area to invalidate on the display being refreshed when the image is opened. Can be NULL.
+ * @param pending set to true if the image is queued
+ * @return pointer to the cache entry (release it with `_lv_img_cache_release`)
+ *         or NULL if the image is queued or can't be opened
+ */
+lv_img_cache_entry_t * _lv_img_cache_open_async(const void * src, lv_color_t color, lv_img_cache_prio_t prio,
+                                                const lv_area_t * inv_area, bool * pending);
+
+/**
+ * Tell whether an image is opened asynchronously.
+ * The file images and the variables with `LV_IMG_CF_RAW...` color formats are considered slow to open.
+ * @param src source of the image
+ * @return true: the image is opened asynchronously
+ */
+bool _lv_img_cache_is_async_src(const void * src);
+#endif
+
+#if LV_IMG_CACHE_MIPMAP
+/**
+ * Get the pixels to draw a cached image with a given zoom.
+ * If the image is zoomed out at least to half its downscaled levels are created (once)
+ * and the smallest level which is still not smaller than the drawn image is returned.
+ * The levels are counted in the memory budget of the cache.
+ * @param entry pointer to an opened entry
+ * @param zoom the zoom to draw the image with
+ * @param level store the level here: the image is downscaled by `2^level`. 0: the original image
+ * @return the pixels of the level or `entry->dec_dsc.img_data` if the original image should be drawn
+ */
+const uint8_t * _lv_img_cache_get_mipmap(lv_img_cache_entry_t * entry, uint16_t zoom, uint8_t * level);
+#endif
+
 /**
  * Set the number of images to be cached.
  * More cached images mean more opened image at same time which might mean more memory usage.
  * E.g. if 20 PNG or JPG images are open in the RAM they consume memory while opened in the cache.
+ * The size can't be changed while an image is pinned.
  * @param new_entry_cnt number of image to cache
  */
 void lv_img_cache_set_size(uint16_t new_slot_num);
@@ -62,10 +164,97 @@ void lv_img_cache_set_size(uint16_t new_slot_num);
 /**
  * Invalidate an image source in the cache.
  * Useful if the image source is updated therefore it needs to be cached again.
+ * The pinned images are kept until the last pin is released (e.g. by `lv_img_cache_unpin`) and closed then.
  * @param src an image source path to a file or pointer to an `lv_img_dsc_t` variable.
  */
 void lv_img_cache_invalidate_src(const void * src);
 
+/**
+ * Set the memory budget of the cache. If the opened images keep more memory allocated
+ * the least recently used ones are closed.
+ * @param mem_limit the budget in bytes. 0: no limit, only the number of images is limited
+ */
+void lv_img_cache_set_mem_limit(uint32_t mem_limit);
+
+/**
+ * Open an image and keep it in the cache until `lv_img_cache_unpin` is called.
+ * @param src an image source path to a file or pointer to an `lv_img_dsc_t` variable.
+ * @param color the color of the image with `LV_IMG_CF_ALPHA_...`
+ * @return LV_RES_OK: the image is opened and pinned; LV_RES_INV: the image can't be opened
+ */
+lv_res_t lv_img_cache_pin(const void * src, lv_color_t color);
+
+/**
+ * Let a pinned image be closed again
+ * @param src an image source path to a file or pointer to an `lv_img_dsc_t` variable.
+ * @param color the color used in `lv_img_cache_pin`
+ */
+void lv_img_cache_unpin(const void * src, lv_color_t color);
+
+/**
+ * Get statistics about the image cache
+ * @param stat store the result here
+ */
+void lv_img_cache_get_stat(lv_img_cache_stat_t * stat);
+
+/**
+ * Open the queued images (see `lv_img_cache_prefetch()` and `LV_IMG_CACHE_ASYNC`) in an other thread.
+ * By default they are opened in an `lv_task` which blocks the rendering until the image is decoded.
+ * @param cb called in the `lv_task` with a job to pass to the worker thread.
+ *           The worker should call `lv_img_cache_job_open()` and then `lv_img_cache_job_ready()`.
+ *           NULL: open the images in the `lv_task`
+ */
+void lv_img_cache_set_worker(lv_img_cache_worker_cb_t cb);
+
+/**
+ * Open the image of a job. Call it in the worker thread without locking LVGL.
+ * The image decoders, the file system drivers and `lv_mem` should be usable from the worker thread
+ * (e.g. `LV_MEM_THREAD_SAFE = 1`).
+ * @param job the job given to the callback of `lv_img_cache_set_worker()`
+ */
+void lv_img_cache_job_open(lv_img_cache_job_t * job);
+
+/**
+ * Add the image opened by `lv_img_cache_job_open()` to the cache and free the job.
+ * Call it from the thread of `lv_task_handler()` or with the same mutex locked.
+ * @param job the job given to the callback of `lv_img_cache_set_worker()`
+ */
+void lv_img_cache_job_ready(lv_img_cache_job_t * job);
+
+/**
+ * Open an image in advance in an `lv_task` (one image in every run) to have it in the cache when it's drawn.
+ * The image is opened in the worker thread instead if it's set by `lv_img_cache_set_worker()`.
+ * Useful to prepare the images of a screen before loading it.
+ * Note that the cache should be large enough to keep all the prefetched images.
+ * @param src an image source path to a file or pointer to an `lv_img_dsc_t` variable.
+ * @param color the color of the image with `LV_IMG_CF_ALPHA_...`
+ * @return LV_RES_OK: the image is cached or queued; LV_RES_INV: the image can't be queued or failed to open
+ */
+lv_res_t lv_img_cache_prefetch(const void * src, lv_color_t color);
+
+/**
+ * Tell whether an image is opened in the cache
+ * @param src an image source path to a file or pointer to an `lv_img_dsc_t` variable.
+ * @param color the color of the image with `LV_IMG_CF_ALPHA_...`
+ * @return true: the image is cached and can be drawn without opening it
+ */
+bool lv_img_cache_is_cached(const void * src, lv_color_t color);
+
+#if LV_IMG_CACHE_ASYNC
+/**
+ * Set an image to draw instead of the images being opened asynchronously.
+ * It's drawn to the center of the image's area.
+ * @param src an `lv_img_dsc_t` variable with a built-in color format or NULL to draw nothing
+ */
+void lv_img_cache_set_placeholder(const void * src);
+
+/**
+ * Get the image drawn instead of the images being opened asynchronously.
+ * @return the placeholder image or NULL if not set
+ */
+const void * lv_img_cache_get_placeholder(void);
+#endif
+
 /**********************
  *      MACROS
  **********************/
@@ -16,7 +16,7 @@
  *      DEFINES
  *********************/
 #define CF_BUILT_IN_FIRST LV_IMG_CF_TRUE_COLOR
-#define CF_BUILT_IN_LAST LV_IMG_CF_ALPHA_8BIT
+#define CF_BUILT_IN_LAST LV_IMG_CF_RLE_TRUE_COLOR_CHROMA_KEYED
 
 /**********************
  *      TYPEDEFS
@@ -27,6 +27,14 @@ typedef struct {
 #endif
     lv_color_t * palette;
     lv_opa_t * opa;
+#if LV_IMG_CF_RLE
+#if LV_USE_FILESYSTEM
+    const uint8_t * rle_map;    /*The data of memory mapped RLE file images (after the header)*/
+    uint32_t rle_map_size;
+#endif
+    uint32_t * rle_rows;    /*Offsets of the rows of RLE file images*/
+    uint8_t * decoded;      /*The decoded RLE image if `LV_IMG_RLE_DECODE_FULL` is enabled*/
+#endif
 } lv_img_decoder_built_in_data_t;
 
 /**********************
@@ -38,6 +46,14 @@ static lv_res_t lv_img_decoder_built_in_line_alpha(lv_img_decoder_dsc_t * dsc, l
                                                    lv_coord_t len, uint8_t * buf);
 static lv_res_t lv_img_decoder_built_in_line_indexed(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
                                                      lv_coord_t len, uint8_t * buf);
+#if LV_IMG_CF_RLE
+static lv_res_t lv_img_decoder_built_in_open_rle(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc);
+static lv_res_t lv_img_decoder_built_in_line_rle(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
+                                                 lv_coord_t len, uint8_t * buf);
+static lv_res_t rle_decode_line(const uint8_t * in, uint32_t in_size, uint8_t px_size, lv_coord_t x, lv_coord_t len,
+                                uint8_t * buf);
+static uint32_t rle_get_u32(const uint8_t * p);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -153,6 +169,7 @@ lv_res_t lv_img_decoder_open(lv_img_decoder_dsc_t * dsc, const void * src, lv_co
         dsc->img_data  = NULL;
         dsc->user_data = NULL;
         dsc->time_to_open = 0;
+        dsc->mem_size = 0;
     }
 
     if(dsc->src_type == LV_IMG_SRC_FILE)
@@ -374,6 +391,19 @@ lv_res_t lv_img_decoder_built_in_open(lv_img_decoder_t * decoder, lv_img_decoder
             return LV_RES_OK;
         }
         else {
+#if LV_USE_FILESYSTEM
+            /*Draw directly from the memory mapped files*/
+            lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
+            const void * map;
+            uint32_t map_size;
+            uint32_t img_size = lv_img_buf_get_img_size(dsc->header.w, dsc->header.h, cf);
+            if(lv_fs_map(&user_data->f, &map, &map_size) == LV_FS_RES_OK &&
+               map_size >= sizeof(lv_img_header_t) + img_size) {
+                dsc->img_data = (const uint8_t *)map + sizeof(lv_img_header_t);
+                dsc->mem_size = sizeof(lv_img_decoder_built_in_data_t);
+                return LV_RES_OK;
+            }
+#endif
             /*If it's a file it need to be read line by line later*/
             return LV_RES_OK;
         }
@@ -450,6 +480,17 @@ lv_res_t lv_img_decoder_built_in_open(lv_img_decoder_t * decoder, lv_img_decoder
         LV_LOG_WARN("Alpha indexed images are not enabled in lv_conf.h. See LV_IMG_CF_ALPHA");
         lv_img_decoder_built_in_close(decoder, dsc);
         return LV_RES_INV;
+#endif
+    }
+    /*Run-length encoded images*/
+    else if(cf == LV_IMG_CF_RLE_TRUE_COLOR || cf == LV_IMG_CF_RLE_TRUE_COLOR_ALPHA ||
+            cf == LV_IMG_CF_RLE_TRUE_COLOR_CHROMA_KEYED) {
+#if LV_IMG_CF_RLE
+        return lv_img_decoder_built_in_open_rle(decoder, dsc);
+#else
+        LV_LOG_WARN("Run-length encoded images are not enabled in lv_conf.h. See LV_IMG_CF_RLE");
+        lv_img_decoder_built_in_close(decoder, dsc);
+        return LV_RES_INV;
 #endif
     }
     /*Unknown format. Can't decode it.*/
@@ -496,6 +537,12 @@ lv_res_t lv_img_decoder_built_in_read_line(lv_img_decoder_t * decoder, lv_img_de
             dsc->header.cf == LV_IMG_CF_INDEXED_4BIT || dsc->header.cf == LV_IMG_CF_INDEXED_8BIT) {
         res = lv_img_decoder_built_in_line_indexed(dsc, x, y, len, buf);
     }
+#if LV_IMG_CF_RLE
+    else if(dsc->header.cf == LV_IMG_CF_RLE_TRUE_COLOR || dsc->header.cf == LV_IMG_CF_RLE_TRUE_COLOR_ALPHA ||
+            dsc->header.cf == LV_IMG_CF_RLE_TRUE_COLOR_CHROMA_KEYED) {
+        res = lv_img_decoder_built_in_line_rle(dsc, x, y, len, buf);
+    }
+#endif
     else {
         LV_LOG_WARN("Built-in image decoder read not supports the color format");
         return LV_RES_INV;
@@ -521,6 +568,10 @@ void lv_img_decoder_built_in_close(lv_img_decoder_t * decoder, lv_img_decoder_ds
 #endif
         if(user_data->palette) lv_mem_free(user_data->palette);
         if(user_data->opa) lv_mem_free(user_data->opa);
+#if LV_IMG_CF_RLE
+        if(user_data->rle_rows) lv_mem_free(user_data->rle_rows);
+        if(user_data->decoded) lv_mem_free(user_data->decoded);
+#endif
 
         lv_mem_free(user_data);
         dsc->user_data = NULL;
@@ -765,3 +816,237 @@ static lv_res_t lv_img_decoder_built_in_line_indexed(lv_img_decoder_dsc_t * dsc,
     return LV_RES_INV;
 #endif
 }
+
+#if LV_IMG_CF_RLE
+/**
+ * Open a run-length encoded image. Load the row offsets of files and decode the whole image if
+ * `LV_IMG_RLE_DECODE_FULL` is enabled.
+ * @param decoder the decoder where this function belongs
+ * @param dsc pointer to decoder descriptor
+ * @return LV_RES_OK: opened; LV_RES_INV: out of memory or read error
+ */
+static lv_res_t lv_img_decoder_built_in_open_rle(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc)
+{
+    LV_UNUSED(decoder); /*Unused if only the lines of variables are decoded*/
+    LV_UNUSED(dsc);
+
+#if LV_USE_FILESYSTEM
+    if(dsc->src_type == LV_IMG_SRC_FILE) {
+        lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
+
+        /*Decode the memory mapped files directly from their data like the variables*/
+        const void * map;
+        uint32_t map_size;
+        if(lv_fs_map(&user_data->f, &map, &map_size) == LV_FS_RES_OK && map_size >= sizeof(lv_img_header_t)) {
+            user_data->rle_map = (const uint8_t *)map + sizeof(lv_img_header_t);
+            user_data->rle_map_size = map_size - sizeof(lv_img_header_t);
+        }
+        /*Else load the offsets of the rows to find any row with one seek*/
+        else {
+            uint32_t table_size = (dsc->header.h + 1) * sizeof(uint32_t);
+            user_data->rle_rows = lv_mem_alloc(table_size);
+            LV_ASSERT_MEM(user_data->rle_rows);
+            if(user_data->rle_rows == NULL) {
+                LV_LOG_ERROR("img_decoder_built_in_open: out of memory");
+                lv_img_decoder_built_in_close(decoder, dsc);
+                return LV_RES_INV;
+            }
+
+            uint32_t br = 0;
+            lv_fs_res_t res = lv_fs_seek(&user_data->f, 4); /*Skip the header*/
+            if(res == LV_FS_RES_OK) res = lv_fs_read(&user_data->f, user_data->rle_rows, table_size, &br);
+            if(res != LV_FS_RES_OK || br != table_size) {
+                LV_LOG_WARN("Built-in image decoder can't read the rows of the RLE image");
+                lv_img_decoder_built_in_close(decoder, dsc);
+                return LV_RES_INV;
+            }
+
+            /*The offsets are stored as little endian*/
+            uint32_t i;
+            for(i = 0; i <= dsc->header.h; i++) {
+                user_data->rle_rows[i] = rle_get_u32((uint8_t *)&user_data->rle_rows[i]);
+            }
+        }
+    }
+#endif
+
+#if LV_IMG_RLE_DECODE_FULL
+    /*The variables have no user data yet*/
+    if(dsc->user_data == NULL) {
+        dsc->user_data = lv_mem_alloc(sizeof(lv_img_decoder_built_in_data_t));
+        LV_ASSERT_MEM(dsc->user_data);
+        if(dsc->user_data == NULL) {
+            LV_LOG_ERROR("img_decoder_built_in_open: out of memory");
+            return LV_RES_INV;
+        }
+        _lv_memset_00(dsc->user_data, sizeof(lv_img_decoder_built_in_data_t));
+    }
+
+    lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
+    uint8_t px_size = lv_img_cf_get_px_size(dsc->header.cf) >> 3;
+    uint32_t stride = dsc->header.w * px_size;
+    user_data->decoded = lv_mem_alloc(stride * dsc->header.h);
+    LV_ASSERT_MEM(user_data->decoded);
+    if(user_data->decoded == NULL) {
+        LV_LOG_ERROR("img_decoder_built_in_open: out of memory");
+        lv_img_decoder_built_in_close(decoder, dsc);
+        return LV_RES_INV;
+    }
+
+    lv_coord_t y;
+    for(y = 0; y < dsc->header.h; y++) {
+        lv_res_t res = lv_img_decoder_built_in_line_rle(dsc, 0, y, dsc->header.w, &user_data->decoded[y * stride]);
+        if(res != LV_RES_OK) {
+            lv_img_decoder_built_in_close(decoder, dsc);
+            return LV_RES_INV;
+        }
+    }
+
+    dsc->img_data = user_data->decoded;
+    dsc->mem_size = stride * dsc->header.h;
+#endif
+
+    return LV_RES_OK;
+}
+
+static lv_res_t lv_img_decoder_built_in_line_rle(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
+                                                 lv_coord_t len, uint8_t * buf)
+{
+    uint8_t px_size = lv_img_cf_get_px_size(dsc->header.cf) >> 3;
+    uint32_t table_size = (dsc->header.h + 1) * sizeof(uint32_t);
+
+    /*Decode the variables and the memory mapped files from the memory*/
+    const uint8_t * data = NULL;
+    uint32_t data_size = 0;
+    if(dsc->src_type == LV_IMG_SRC_VARIABLE) {
+        data = ((const lv_img_dsc_t *)dsc->src)->data;
+        data_size = ((const lv_img_dsc_t *)dsc->src)->data_size;
+    }
+#if LV_USE_FILESYSTEM
+    else {
+        data = ((lv_img_decoder_built_in_data_t *)dsc->user_data)->rle_map;
+        data_size = ((lv_img_decoder_built_in_data_t *)dsc->user_data)->rle_map_size;
+    }
+#endif
+
+    if(data) {
+        if(table_size > data_size) {
+            LV_LOG_WARN("Built-in image decoder: invalid RLE row");
+            return LV_RES_INV;
+        }
+
+        uint32_t start = rle_get_u32(&data[y * sizeof(uint32_t)]);
+        uint32_t end = rle_get_u32(&data[(y + 1) * sizeof(uint32_t)]);
+        if(start > end || table_size + end > data_size) {
+            LV_LOG_WARN("Built-in image decoder: invalid RLE row");
+            return LV_RES_INV;
+        }
+
+        return rle_decode_line(&data[table_size + start], end - start, px_size, x, len, buf);
+    }
+
+#if LV_USE_FILESYSTEM
+    lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
+    uint32_t start = user_data->rle_rows[y];
+    uint32_t end = user_data->rle_rows[y + 1];
+    if(start > end) {
+        LV_LOG_WARN("Built-in image decoder: invalid RLE row");
+        return LV_RES_INV;
+    }
+
+    lv_fs_res_t res = lv_fs_seek(&user_data->f, 4 + table_size + start);
+    if(res != LV_FS_RES_OK) {
+        LV_LOG_WARN("Built-in image decoder seek failed");
+        return LV_RES_INV;
+    }
+
+    uint32_t btr = end - start;
+    uint32_t br = 0;
+    uint8_t * row = _lv_mem_buf_try_get(btr);
+    if(row == NULL) {
+        LV_LOG_WARN("Built-in image decoder: couldn't allocate the RLE row");
+        return LV_RES_INV;
+    }
+
+    res = lv_fs_read(&user_data->f, row, btr, &br);
+    if(res != LV_FS_RES_OK || btr != br) {
+        LV_LOG_WARN("Built-in image decoder read failed");
+        _lv_mem_buf_release(row);
+        return LV_RES_INV;
+    }
+
+    lv_res_t dec_res = rle_decode_line(row, btr, px_size, x, len, buf);
+    _lv_mem_buf_release(row);
+    return dec_res;
+#else
+    LV_UNUSED(x);
+    LV_UNUSED(len);
+    LV_UNUSED(buf);
+    LV_LOG_WARN("Image built-in decoder cannot read file because LV_USE_FILESYSTEM = 0");
+    return LV_RES_INV;
+#endif
+}
+
+/**
+ * Decode the pixels of an RLE row
+ * @param in the packets of the row
+ * @param in_size size of the packets in bytes
+ * @param px_size size of a pixel in bytes
+ * @param x the first pixel to decode
+ * @param len number of pixels to decode
+ * @param buf store the pixels here
+ * @return LV_RES_OK: decoded; LV_RES_INV: the row ended before `x + len` pixels
+ */
+static lv_res_t rle_decode_line(const uint8_t * in, uint32_t in_size, uint8_t px_size, lv_coord_t x, lv_coord_t len,
+                                uint8_t * buf)
+{
+    const uint8_t * in_end = in + in_size;
+
+    while(len > 0) {
+        if(in >= in_end) break;
+
+        uint8_t ctrl = *in;
+        in++;
+        lv_coord_t cnt = (ctrl & ~LV_IMG_RLE_RUN) + 1;
+        bool run = ctrl & LV_IMG_RLE_RUN ? true : false;
+        uint32_t packet_size = run ? px_size : cnt * px_size;
+        if(in + packet_size > in_end) break;
+
+        /*Skip the packets before `x`*/
+        if(x >= cnt) {
+            x -= cnt;
+            in += packet_size;
+            continue;
+        }
+
+        lv_coord_t n = LV_MATH_MIN(cnt - x, len);
+        if(run) {
+            lv_coord_t i;
+            for(i = 0; i < n; i++) {
+                _lv_memcpy_small(buf, in, px_size);
+                buf += px_size;
+            }
+        }
+        else {
+            _lv_memcpy(buf, in + x * px_size, n * px_size);
+            buf += n * px_size;
+        }
+
+        in += packet_size;
+        len -= n;
+        x = 0;
+    }
+
+    if(len > 0) {
+        LV_LOG_WARN("Built-in image decoder: the RLE row is too short");
+        return LV_RES_INV;
+    }
+
+    return LV_RES_OK;
+}
+
+static uint32_t rle_get_u32(const uint8_t * p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+#endif
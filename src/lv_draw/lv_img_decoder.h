@@ -120,6 +120,10 @@ typedef struct _lv_img_decoder_dsc {
      *  If not set `lv_img_cache` will measure and set the time to open*/
     uint32_t time_to_open;
 
+    /** How many bytes are kept allocated while the image is open (e.g. the decoded pixels).
+     *  If not set `lv_img_cache` will estimate it from `img_data` and `header`*/
+    uint32_t mem_size;
+
     /**A text to display instead of the image when the image can't be opened.
      * Can be set in `open` function or set NULL. */
     const char * error_msg;
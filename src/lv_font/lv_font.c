@@ -10,6 +10,7 @@
 #include "lv_font.h"
 #include "../lv_misc/lv_utils.h"
 #include "../lv_misc/lv_log.h"
+#include "../lv_misc/lv_txt.h"
 
 /*********************
  *      DEFINES
@@ -19,14 +20,29 @@
  *      TYPEDEFS
  **********************/
 
+#if LV_FONT_FALLBACK_CACHE_SIZE
+/*A letter resolved in the fallback chain of a font*/
+typedef struct {
+    const lv_font_t * font;         /*The first font of the chain. NULL: unused entry*/
+    const lv_font_t * resolved;     /*The font containing the letter or NULL if none of them*/
+    uint32_t letter;
+} fallback_cache_entry_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 
+static const lv_font_t * search_fallback(const lv_font_t * font, uint32_t letter);
+
 /**********************
  *  STATIC VARIABLES
  **********************/
 
+#if LV_FONT_FALLBACK_CACHE_SIZE
+static fallback_cache_entry_t fallback_cache[LV_FONT_FALLBACK_CACHE_SIZE];
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -47,6 +63,11 @@
  */
 const uint8_t * lv_font_get_glyph_bitmap(const lv_font_t * font_p, uint32_t letter)
 {
+    if(font_p->fallback) {
+        font_p = lv_font_get_font_of_letter(font_p, letter);
+        if(font_p == NULL) return NULL;
+    }
+
     return font_p->get_glyph_bitmap(font_p, letter);
 }
 
@@ -61,6 +82,18 @@ const uint8_t * lv_font_get_glyph_bitmap(const lv_font_t * font_p, uint32_t lett
 bool lv_font_get_glyph_dsc(const lv_font_t * font_p, lv_font_glyph_dsc_t * dsc_out, uint32_t letter,
                            uint32_t letter_next)
 {
+    if(font_p->fallback) {
+        const lv_font_t * font_letter = lv_font_get_font_of_letter(font_p, letter);
+        if(font_letter == NULL) return false;
+
+        /*No kerning between the letters of different fonts*/
+        if(letter_next != '\0' && lv_font_get_font_of_letter(font_p, letter_next) != font_letter) {
+            letter_next = '\0';
+        }
+
+        font_p = font_letter;
+    }
+
     return font_p->get_glyph_dsc(font_p, dsc_out, letter, letter_next);
 }
 
@@ -80,6 +113,83 @@ uint16_t lv_font_get_glyph_width(const lv_font_t * font, uint32_t letter, uint32
     else return 0;
 }
 
+/**
+ * Get the font of `font`'s fallback chain which contains a letter
+ * @param font pointer to a font
+ * @param letter an UNICODE letter
+ * @return `font` or one of its fallback fonts; NULL if none of them contains `letter`
+ */
+const lv_font_t * lv_font_get_font_of_letter(const lv_font_t * font, uint32_t letter)
+{
+    if(font->fallback == NULL) return search_fallback(font, letter);
+
+#if LV_FONT_FALLBACK_CACHE_SIZE
+    uint32_t i = (letter ^ ((lv_uintptr_t)font >> 4)) % LV_FONT_FALLBACK_CACHE_SIZE;
+    fallback_cache_entry_t * e = &fallback_cache[i];
+    if(e->font == font && e->letter == letter) return e->resolved;
+
+    e->font = font;
+    e->letter = letter;
+    e->resolved = search_fallback(font, letter);
+    return e->resolved;
+#else
+    return search_fallback(font, letter);
+#endif
+}
+
+/**
+ * Remove the resolved letters of a font from the fallback cache and the cached widths of its letters.
+ * The fonts using `font` as a fallback are removed too.
+ * Should be called if the glyphs or the `fallback` of a font were changed or the font was deleted.
+ * @param font pointer to a font, or NULL to clear the whole cache
+ */
+void lv_font_fallback_cache_invalidate(const lv_font_t * font)
+{
+#if LV_FONT_FALLBACK_CACHE_SIZE
+    uint32_t i;
+    for(i = 0; i < LV_FONT_FALLBACK_CACHE_SIZE; i++) {
+        fallback_cache_entry_t * e = &fallback_cache[i];
+        if(e->font && (font == NULL || _lv_font_uses_font(e->font, font))) e->font = NULL;
+    }
+#endif
+
+    /*The width of the letters might come from an other font now*/
+    _lv_txt_ascii_width_cache_invalidate(font);
+}
+
+/**
+ * Tell whether a font is an other font or has it in its fallback chain
+ * @param font pointer to a font
+ * @param other pointer to an other font
+ * @return true: the letters of `font` might come from `other`
+ */
+bool _lv_font_uses_font(const lv_font_t * font, const lv_font_t * other)
+{
+    while(font) {
+        if(font == other) return true;
+        font = font->fallback;
+    }
+
+    return false;
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
+
+/**
+ * Search the first font in a fallback chain which contains a letter
+ * @param font the first font of the chain
+ * @param letter an UNICODE letter
+ * @return the font containing `letter` or NULL if not found
+ */
+static const lv_font_t * search_fallback(const lv_font_t * font, uint32_t letter)
+{
+    lv_font_glyph_dsc_t g;
+    while(font) {
+        if(font->get_glyph_dsc(font, &g, letter, '\0')) return font;
+        font = font->fallback;
+    }
+
+    return NULL;
+}
@@ -70,6 +70,10 @@ typedef struct _lv_font_struct {
     int8_t underline_thickness;     /**< Thickness of the underline*/
 
     void * dsc;                     /**< Store implementation specific or run_time data or caching here*/
+
+    /** Search the letters not found in this font in this font (and in its fallback fonts).
+     * The fallback fonts should have the same `subpx` setting and they must not form a loop.*/
+    const struct _lv_font_struct * fallback;
 #if LV_USE_USER_DATA
     lv_font_user_data_t user_data;  /**< Custom user data for font. */
 #endif
@@ -108,6 +112,30 @@ bool lv_font_get_glyph_dsc(const lv_font_t * font_p, lv_font_glyph_dsc_t * dsc_o
  */
 uint16_t lv_font_get_glyph_width(const lv_font_t * font, uint32_t letter, uint32_t letter_next);
 
+/**
+ * Get the font of `font`'s fallback chain which contains a letter
+ * @param font pointer to a font
+ * @param letter an UNICODE letter
+ * @return `font` or one of its fallback fonts; NULL if none of them contains `letter`
+ */
+const lv_font_t * lv_font_get_font_of_letter(const lv_font_t * font, uint32_t letter);
+
+/**
+ * Remove the resolved letters of a font from the fallback cache and the cached widths of its letters.
+ * The fonts using `font` as a fallback are removed too.
+ * Should be called if the glyphs or the `fallback` of a font were changed or the font was deleted.
+ * @param font pointer to a font, or NULL to clear the whole cache
+ */
+void lv_font_fallback_cache_invalidate(const lv_font_t * font);
+
+/**
+ * Tell whether a font is an other font or has it in its fallback chain
+ * @param font pointer to a font
+ * @param other pointer to an other font
+ * @return true: the letters of `font` might come from `other`
+ */
+bool _lv_font_uses_font(const lv_font_t * font, const lv_font_t * other);
+
 /**
  * Get the line height of a font. All characters fit into this height
  * @param font_p pointer to a font
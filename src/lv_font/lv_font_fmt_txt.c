@@ -91,41 +91,9 @@ const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t unic
     }
     /*Handle compressed bitmap*/
     else {
-#if LV_USE_FONT_COMPRESSED
-        uint32_t gsize = gdsc->box_w * gdsc->box_h;
-        if(gsize == 0) return NULL;
-
-        uint32_t buf_size = gsize;
-        /*Compute memory size needed to hold decompressed glyph, rounding up*/
-        switch(fdsc->bpp) {
-            case 1:
-                buf_size = (gsize + 7) >> 3;
-                break;
-            case 2:
-                buf_size = (gsize + 3) >> 2;
-                break;
-            case 3:
-                buf_size = (gsize + 1) >> 1;
-                break;
-            case 4:
-                buf_size = (gsize + 1) >> 1;
-                break;
-        }
-
-        if(_lv_mem_get_size(LV_GC_ROOT(_lv_font_decompr_buf)) < buf_size) {
-            uint8_t * tmp = lv_mem_realloc(LV_GC_ROOT(_lv_font_decompr_buf), buf_size);
-            LV_ASSERT_MEM(tmp);
-            if(tmp == NULL) return NULL;
-            LV_GC_ROOT(_lv_font_decompr_buf) = tmp;
-        }
-
         bool prefilter = fdsc->bitmap_format == LV_FONT_FMT_TXT_COMPRESSED ? true : false;
-        decompress(&fdsc->glyph_bitmap[gdsc->bitmap_index], LV_GC_ROOT(_lv_font_decompr_buf), gdsc->box_w, gdsc->box_h,
-                   (uint8_t)fdsc->bpp, prefilter);
-        return LV_GC_ROOT(_lv_font_decompr_buf);
-#else /* !LV_USE_FONT_COMPRESSED */
-        return NULL;
-#endif
+        return _lv_font_fmt_txt_decompress(&fdsc->glyph_bitmap[gdsc->bitmap_index], gdsc->box_w, gdsc->box_h,
+                                           (uint8_t)fdsc->bpp, prefilter);
     }
 
     /*If not returned earlier then the letter is not found in this font*/
@@ -183,6 +151,58 @@ bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t *
     return true;
 }
 
+/**
+ * Decompress the bitmap of a glyph into a buffer shared by all fonts
+ * @param in the compressed bitmap
+ * @param box_w width of the glyph
+ * @param box_h height of the glyph
+ * @param bpp bit per pixel of the font
+ * @param prefilter true: the lines are XORed
+ * @return pointer to the decompressed bitmap (valid until the next decompression) or NULL on error
+ */
+const uint8_t * _lv_font_fmt_txt_decompress(const uint8_t * in, uint32_t box_w, uint32_t box_h, uint8_t bpp,
+                                            bool prefilter)
+{
+#if LV_USE_FONT_COMPRESSED
+    uint32_t gsize = box_w * box_h;
+    if(gsize == 0) return NULL;
+
+    uint32_t buf_size = gsize;
+    /*Compute memory size needed to hold decompressed glyph, rounding up*/
+    switch(bpp) {
+        case 1:
+            buf_size = (gsize + 7) >> 3;
+            break;
+        case 2:
+            buf_size = (gsize + 3) >> 2;
+            break;
+        case 3:
+            buf_size = (gsize + 1) >> 1;
+            break;
+        case 4:
+            buf_size = (gsize + 1) >> 1;
+            break;
+    }
+
+    if(_lv_mem_get_size(LV_GC_ROOT(_lv_font_decompr_buf)) < buf_size) {
+        uint8_t * tmp = lv_mem_realloc(LV_GC_ROOT(_lv_font_decompr_buf), buf_size);
+        LV_ASSERT_MEM(tmp);
+        if(tmp == NULL) return NULL;
+        LV_GC_ROOT(_lv_font_decompr_buf) = tmp;
+    }
+
+    decompress(in, LV_GC_ROOT(_lv_font_decompr_buf), box_w, box_h, bpp, prefilter);
+    return LV_GC_ROOT(_lv_font_decompr_buf);
+#else /* !LV_USE_FONT_COMPRESSED */
+    LV_UNUSED(in);
+    LV_UNUSED(box_w);
+    LV_UNUSED(box_h);
+    LV_UNUSED(bpp);
+    LV_UNUSED(prefilter);
+    return NULL;
+#endif
+}
+
 /**
  * Free the allocated memories.
  */
@@ -215,6 +215,18 @@ const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t lett
 bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t unicode_letter,
                                    uint32_t unicode_letter_next);
 
+/**
+ * Decompress the bitmap of a glyph into a buffer shared by all fonts
+ * @param in the compressed bitmap
+ * @param box_w width of the glyph
+ * @param box_h height of the glyph
+ * @param bpp bit per pixel of the font
+ * @param prefilter true: the lines are XORed
+ * @return pointer to the decompressed bitmap (valid until the next decompression) or NULL on error
+ */
+const uint8_t * _lv_font_fmt_txt_decompress(const uint8_t * in, uint32_t box_w, uint32_t box_h, uint8_t bpp,
+                                            bool prefilter);
+
 /**
  * Free the allocated memories.
  */
@@ -16,6 +16,13 @@
 
 #if LV_USE_FILESYSTEM
 
+/*********************
+ *      DEFINES
+ *********************/
+/*The glyphs of the lazy loaded fonts are cached in sets of `LAZY_CACHE_WAY_CNT` entries
+ *so that a letter and the next letter can be cached at the same time*/
+#define LAZY_CACHE_WAY_CNT  2
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -62,6 +69,69 @@ typedef struct cmap_table_bin {
     uint8_t padding;
 } cmap_table_bin_t;
 
+/*Where the data of a lazy loaded font can be read from*/
+typedef struct {
+    lv_fs_file_t file;          /*Used if `mem == NULL`. Kept open if `mem` is a mapped file*/
+    const uint8_t * mem;        /*The whole font file in memory*/
+    uint32_t mem_size;
+} font_src_t;
+
+/*A character map of a lazy loaded font. The lists are not loaded only their position is stored*/
+typedef struct {
+    uint32_t range_start;
+    uint16_t range_length;
+    uint16_t glyph_id_start;
+    uint16_t list_length;
+    lv_font_fmt_txt_cmap_type_t type;
+    uint32_t unicode_list_pos;      /*Position of `unicode_list` in the source*/
+    uint32_t glyph_id_ofs_list_pos; /*Position of `glyph_id_ofs_list` in the source*/
+} lazy_cmap_t;
+
+/*A glyph in the cache of a lazy loaded font*/
+typedef struct {
+    uint32_t letter;                    /*The cached letter. 0: unused entry*/
+    uint32_t gid;                       /*Glyph id of the letter. 0: the letter is not in the font*/
+    lv_font_fmt_txt_glyph_dsc_t dsc;    /*`bitmap_index` is the position of the bitmap in the source*/
+    const uint8_t * bitmap;             /*The bitmap if it was already read, else NULL*/
+    uint32_t bitmap_size;               /*Size of the (compressed) bitmap in the source*/
+    uint8_t bitmap_shift;               /*The bitmap is in the source from the `bitmap_shift`th bit*/
+    uint8_t bitmap_alloc : 1;           /*1: `bitmap` was allocated and should be freed*/
+    uint8_t left_class;                 /*Kerning classes of the glyph*/
+    uint8_t right_class;
+    uint32_t last_used;                 /*`cache_tick` when the entry was used last time*/
+} lazy_glyph_t;
+
+enum {
+    LAZY_KERN_NONE,
+    LAZY_KERN_PAIRS,
+    LAZY_KERN_CLASSES,
+};
+
+/*Descriptor of a lazy loaded font, stored in `font->dsc`*/
+typedef struct {
+    font_src_t src;
+    font_header_bin_t header;
+    lazy_cmap_t * cmaps;
+    uint32_t loca_pos;              /*Position of the glyph offsets*/
+    uint32_t loca_count;
+    uint32_t glyf_start;            /*Start of the "glyf" table*/
+    uint32_t glyf_length;
+    uint32_t kern_pair_cnt;
+    uint32_t kern_ids_pos;          /*Position of the glyph id pairs of the kerning pairs*/
+    uint32_t kern_values_pos;       /*Position of the kern values of the pairs*/
+    uint32_t kern_left_pos;         /*Position of the left class mapping*/
+    uint32_t kern_right_pos;        /*Position of the right class mapping*/
+    const int8_t * kern_class_values;
+    lazy_glyph_t * cache;
+    uint32_t cache_size;            /*Number of entries in `cache`. A multiple of `LAZY_CACHE_WAY_CNT`*/
+    uint32_t cache_tick;
+    uint16_t cmap_num;
+    uint8_t kern_type;
+    uint8_t kern_rows;
+    uint8_t kern_cols;
+    uint8_t kern_values_alloc : 1;  /*1: `kern_class_values` was allocated and should be freed*/
+} lazy_font_dsc_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -72,6 +142,21 @@ int32_t load_kern(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc, uint8_t f
 static int read_bits_signed(bit_iterator_t * it, int n_bits, lv_fs_res_t * res);
 static unsigned int read_bits(bit_iterator_t * it, int n_bits, lv_fs_res_t * res);
 
+static lv_font_t * lazy_load(lazy_font_dsc_t * dsc, uint16_t cache_size);
+static bool lazy_load_tables(lv_font_t * font, lazy_font_dsc_t * dsc);
+static void lazy_free(lv_font_t * font);
+static bool lazy_get_glyph_dsc(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t letter,
+                               uint32_t letter_next);
+static const uint8_t * lazy_get_glyph_bitmap(const lv_font_t * font, uint32_t letter);
+static lazy_glyph_t * lazy_get_glyph(lazy_font_dsc_t * dsc, uint32_t letter);
+static uint32_t lazy_get_glyph_id(lazy_font_dsc_t * dsc, uint32_t letter);
+static bool lazy_read_glyph(lazy_font_dsc_t * dsc, lazy_glyph_t * g);
+static int8_t lazy_get_kern_value(lazy_font_dsc_t * dsc, const lazy_glyph_t * g_left, const lazy_glyph_t * g_right);
+static bool src_read(font_src_t * src, uint32_t pos, void * buf, uint32_t len);
+static int32_t src_read_label(font_src_t * src, uint32_t pos, const char * label);
+static uint32_t get_bits(const uint8_t * in, uint32_t bit_pos, uint32_t len);
+static int32_t get_bits_signed(const uint8_t * in, uint32_t bit_pos, uint32_t len);
+
 /**********************
  *      MACROS
  **********************/
@@ -89,6 +174,7 @@ lv_font_t * lv_font_load(const char * font_name)
 {
     bool success = false;
 
+    _lv_mem_tag_push(LV_MEM_TAG_FONT);
     lv_font_t * font = lv_mem_alloc(sizeof(lv_font_t));
     memset(font, 0, sizeof(lv_font_t));
 
@@ -111,6 +197,72 @@ lv_font_t * lv_font_load(const char * font_name)
 
         lv_fs_close(&file);
     }
+    _lv_mem_tag_pop();
+
+    return font;
+}
+
+/**
+ * Load a font from a binary font file lazily.
+ * Only the header and the position of the tables are read on load.
+ * The glyphs are read from the file when they are used and the recently used glyphs are cached.
+ * The file remains opened until `lv_font_free()` is called.
+ * If the driver can map the file (see `lv_fs_map()`) the tables and bitmaps are referenced
+ * from the mapped data as with `lv_font_load_lazy_from_mem()`.
+ * @param font_name filename where the font file is located
+ * @param cache_size number of glyphs to keep in RAM (>= 1). Rounded up to a multiple of 2.
+ * @return a pointer to the font or NULL in case of error
+ */
+lv_font_t * lv_font_load_lazy(const char * font_name, uint16_t cache_size)
+{
+    lazy_font_dsc_t * dsc = lv_mem_alloc_tag(sizeof(lazy_font_dsc_t), LV_MEM_TAG_FONT);
+    LV_ASSERT_MEM(dsc);
+    if(dsc == NULL) return NULL;
+    _lv_memset_00(dsc, sizeof(lazy_font_dsc_t));
+
+    lv_fs_res_t res = lv_fs_open(&dsc->src.file, font_name, LV_FS_MODE_RD);
+    if(res != LV_FS_RES_OK) {
+        lv_mem_free(dsc);
+        return NULL;
+    }
+
+    const void * map;
+    if(lv_fs_map(&dsc->src.file, &map, &dsc->src.mem_size) == LV_FS_RES_OK) dsc->src.mem = map;
+
+    _lv_mem_tag_push(LV_MEM_TAG_FONT);
+    lv_font_t * font = lazy_load(dsc, cache_size);
+    _lv_mem_tag_pop();
+    if(font == NULL) {
+        LV_LOG_WARN("Error loading font file: %s\n", font_name);
+    }
+
+    return font;
+}
+
+/**
+ * Load a font lazily from a binary font file stored in memory (e.g. in memory mapped flash).
+ * The tables and bitmaps are referenced from `data` where possible instead of copying them.
+ * @param data pointer to the content of the font file. Should be kept valid until `lv_font_free()`.
+ * @param size size of `data` in bytes
+ * @param cache_size number of glyphs to keep in RAM (>= 1). Rounded up to a multiple of 2.
+ * @return a pointer to the font or NULL in case of error
+ */
+lv_font_t * lv_font_load_lazy_from_mem(const void * data, uint32_t size, uint16_t cache_size)
+{
+    lazy_font_dsc_t * dsc = lv_mem_alloc_tag(sizeof(lazy_font_dsc_t), LV_MEM_TAG_FONT);
+    LV_ASSERT_MEM(dsc);
+    if(dsc == NULL) return NULL;
+    _lv_memset_00(dsc, sizeof(lazy_font_dsc_t));
+
+    dsc->src.mem = data;
+    dsc->src.mem_size = size;
+
+    _lv_mem_tag_push(LV_MEM_TAG_FONT);
+    lv_font_t * font = lazy_load(dsc, cache_size);
+    _lv_mem_tag_pop();
+    if(font == NULL) {
+        LV_LOG_WARN("Error loading font from memory");
+    }
 
     return font;
 }
@@ -121,6 +273,13 @@ lv_font_t * lv_font_load(const char * font_name)
  */
 void lv_font_free(lv_font_t * font)
 {
+    if(NULL != font) lv_font_fallback_cache_invalidate(font);
+
+    if(NULL != font && font->get_glyph_dsc == lazy_get_glyph_dsc) {
+        lazy_free(font);
+        return;
+    }
+
     if(NULL != font) {
         lv_font_fmt_txt_dsc_t * dsc = (lv_font_fmt_txt_dsc_t *) font->dsc;
 
@@ -681,4 +840,609 @@ int32_t load_kern(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc, uint8_t f
     return kern_length;
 }
 
+
+/**
+ * Create a lazy loaded font from a descriptor having its source set
+ * @param dsc pointer to an allocated and zeroed descriptor. Freed on error.
+ * @param cache_size number of glyphs to cache. Rounded up to a multiple of `LAZY_CACHE_WAY_CNT`.
+ * @return the created font or NULL on error
+ */
+static lv_font_t * lazy_load(lazy_font_dsc_t * dsc, uint16_t cache_size)
+{
+    lv_font_t * font = lv_mem_alloc(sizeof(lv_font_t));
+    LV_ASSERT_MEM(font);
+    if(font == NULL) {
+        if(dsc->src.file.drv) lv_fs_close(&dsc->src.file);
+        lv_mem_free(dsc);
+        return NULL;
+    }
+
+    _lv_memset_00(font, sizeof(lv_font_t));
+    font->dsc = dsc;
+    font->get_glyph_dsc = lazy_get_glyph_dsc;
+    font->get_glyph_bitmap = lazy_get_glyph_bitmap;
+
+    if(cache_size == 0) cache_size = 1;
+    dsc->cache_size = ((cache_size + LAZY_CACHE_WAY_CNT - 1) / LAZY_CACHE_WAY_CNT) * LAZY_CACHE_WAY_CNT;
+    dsc->cache = lv_mem_alloc(sizeof(lazy_glyph_t) * dsc->cache_size);
+    LV_ASSERT_MEM(dsc->cache);
+    if(dsc->cache) _lv_memset_00(dsc->cache, sizeof(lazy_glyph_t) * dsc->cache_size);
+
+    if(dsc->cache == NULL || !lazy_load_tables(font, dsc)) {
+        lazy_free(font);
+        return NULL;
+    }
+
+    return font;
+}
+
+/**
+ * Read the header of a lazy loaded font and save the position of its tables
+ * @param font pointer to the font
+ * @param dsc the descriptor of `font`
+ * @return true: success; false: invalid font file
+ */
+static bool lazy_load_tables(lv_font_t * font, lazy_font_dsc_t * dsc)
+{
+    font_src_t * src = &dsc->src;
+    font_header_bin_t * header = &dsc->header;
+
+    /* header */
+    int32_t header_length = src_read_label(src, 0, "head");
+    if(header_length < 0) return false;
+    if(!src_read(src, 8, header, sizeof(font_header_bin_t))) return false;
+
+    font->base_line = -header->descent;
+    font->line_height = header->ascent - header->descent;
+    font->subpx = header->subpixels_mode;
+    font->underline_position = header->underline_position;
+    font->underline_thickness = header->underline_thickness;
+
+    /* cmaps */
+    uint32_t cmaps_start = header_length;
+    int32_t cmaps_length = src_read_label(src, cmaps_start, "cmap");
+    if(cmaps_length < 0) return false;
+
+    uint32_t cmap_num;
+    if(!src_read(src, cmaps_start + 8, &cmap_num, sizeof(uint32_t))) return false;
+
+    dsc->cmaps = lv_mem_alloc(sizeof(lazy_cmap_t) * cmap_num);
+    LV_ASSERT_MEM(dsc->cmaps);
+    if(dsc->cmaps == NULL) return false;
+    dsc->cmap_num = cmap_num;
+
+    uint32_t i;
+    for(i = 0; i < cmap_num; i++) {
+        cmap_table_bin_t cmap_table;
+        if(!src_read(src, cmaps_start + 12 + i * sizeof(cmap_table_bin_t), &cmap_table, sizeof(cmap_table_bin_t))) {
+            return false;
+        }
+
+        lazy_cmap_t * cmap = &dsc->cmaps[i];
+        cmap->range_start = cmap_table.range_start;
+        cmap->range_length = cmap_table.range_length;
+        cmap->glyph_id_start = cmap_table.glyph_id_start;
+        cmap->type = cmap_table.format_type;
+        cmap->list_length = cmap_table.data_entries_count;
+
+        uint32_t data_pos = cmaps_start + cmap_table.data_offset;
+        switch(cmap->type) {
+            case LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL:
+                cmap->glyph_id_ofs_list_pos = data_pos;
+                break;
+            case LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY:
+                break;
+            case LV_FONT_FMT_TXT_CMAP_SPARSE_FULL:
+                cmap->unicode_list_pos = data_pos;
+                cmap->glyph_id_ofs_list_pos = data_pos + sizeof(uint16_t) * cmap->list_length;
+                break;
+            case LV_FONT_FMT_TXT_CMAP_SPARSE_TINY:
+                cmap->unicode_list_pos = data_pos;
+                break;
+            default:
+                LV_LOG_WARN("Unknown cmaps format type %d.", cmap->type);
+                return false;
+        }
+    }
+
+    /* loca */
+    uint32_t loca_start = cmaps_start + cmaps_length;
+    int32_t loca_length = src_read_label(src, loca_start, "loca");
+    if(loca_length < 0) return false;
+    if(!src_read(src, loca_start + 8, &dsc->loca_count, sizeof(uint32_t))) return false;
+    dsc->loca_pos = loca_start + 12;
+
+    if(header->index_to_loc_format > 1) {
+        LV_LOG_WARN("Unknown index_to_loc_format: %d.", header->index_to_loc_format);
+        return false;
+    }
+
+    /* glyph */
+    dsc->glyf_start = loca_start + loca_length;
+    int32_t glyf_length = src_read_label(src, dsc->glyf_start, "glyf");
+    if(glyf_length < 0) return false;
+    dsc->glyf_length = glyf_length;
+
+    /* kern */
+    dsc->kern_type = LAZY_KERN_NONE;
+    if(header->tables_count < 4) return true;
+
+    uint32_t kern_start = dsc->glyf_start + glyf_length;
+    if(src_read_label(src, kern_start, "kern") < 0) return false;
+
+    uint8_t kern_format_type;
+    if(!src_read(src, kern_start + 8, &kern_format_type, sizeof(uint8_t))) return false;
+
+    if(kern_format_type == 0) {     /* sorted pairs */
+        uint32_t pair_cnt;
+        if(!src_read(src, kern_start + 12, &pair_cnt, sizeof(uint32_t))) return false;
+
+        uint32_t ids_size = (header->glyph_id_format == 0 ? sizeof(uint8_t) : sizeof(uint16_t)) * 2 * pair_cnt;
+        dsc->kern_type = LAZY_KERN_PAIRS;
+        dsc->kern_pair_cnt = pair_cnt;
+        dsc->kern_ids_pos = kern_start + 16;
+        dsc->kern_values_pos = dsc->kern_ids_pos + ids_size;
+    }
+    else if(kern_format_type == 3) {    /* array M*N of classes */
+        uint16_t mapping_length;
+        if(!src_read(src, kern_start + 12, &mapping_length, sizeof(uint16_t)) ||
+           !src_read(src, kern_start + 14, &dsc->kern_rows, sizeof(uint8_t)) ||
+           !src_read(src, kern_start + 15, &dsc->kern_cols, sizeof(uint8_t))) {
+            return false;
+        }
+
+        dsc->kern_type = LAZY_KERN_CLASSES;
+        dsc->kern_left_pos = kern_start + 16;
+        dsc->kern_right_pos = dsc->kern_left_pos + mapping_length;
+
+        /*The class pair values are small and used with every letter so keep them in RAM*/
+        uint32_t values_pos = dsc->kern_right_pos + mapping_length;
+        uint32_t values_size = dsc->kern_rows * dsc->kern_cols;
+        if(src->mem) {
+            if(values_pos + values_size > src->mem_size) return false;
+            dsc->kern_class_values = (const int8_t *)&src->mem[values_pos];
+        }
+        else {
+            int8_t * values = lv_mem_alloc(values_size);
+            LV_ASSERT_MEM(values);
+            if(values == NULL) return false;
+            dsc->kern_class_values = values;
+            dsc->kern_values_alloc = 1;
+            if(!src_read(src, values_pos, values, values_size)) return false;
+        }
+    }
+    else {
+        LV_LOG_WARN("Unknown kern_format_type: %d", kern_format_type);
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Free a lazy loaded font and close its file
+ * @param font pointer to a lazy loaded font
+ */
+static void lazy_free(lv_font_t * font)
+{
+    lazy_font_dsc_t * dsc = font->dsc;
+
+    if(dsc->cache) {
+        uint32_t i;
+        for(i = 0; i < dsc->cache_size; i++) {
+            if(dsc->cache[i].bitmap_alloc) lv_mem_free(dsc->cache[i].bitmap);
+        }
+        lv_mem_free(dsc->cache);
+    }
+
+    if(dsc->kern_values_alloc) lv_mem_free(dsc->kern_class_values);
+    if(dsc->cmaps) lv_mem_free(dsc->cmaps);
+    if(dsc->src.file.drv) lv_fs_close(&dsc->src.file);
+
+    lv_mem_free(dsc);
+    lv_mem_free(font);
+}
+
+/**
+ * `get_glyph_dsc` callback of the lazy loaded fonts
+ * @param font pointer to font
+ * @param dsc_out store the result descriptor here
+ * @param letter an UNICODE letter code
+ * @param letter_next the next letter. Used for kerning.
+ * @return true: descriptor is successfully loaded into `dsc_out`.
+ *         false: the letter was not found, no data is loaded to `dsc_out`
+ */
+static bool lazy_get_glyph_dsc(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t letter,
+                               uint32_t letter_next)
+{
+    lazy_font_dsc_t * dsc = font->dsc;
+
+    bool is_tab = false;
+    if(letter == '\t') {
+        letter = ' ';
+        is_tab = true;
+    }
+
+    lazy_glyph_t * g = lazy_get_glyph(dsc, letter);
+    if(g == NULL) return false;
+
+    /*Save the required data because getting the next letter might reuse the cache entry*/
+    lazy_glyph_t g_left = *g;
+    const lv_font_fmt_txt_glyph_dsc_t * gdsc = &g_left.dsc;
+
+    int8_t kvalue = 0;
+    if(dsc->kern_type != LAZY_KERN_NONE && letter_next != '\0') {
+        lazy_glyph_t * g_next = lazy_get_glyph(dsc, letter_next);
+        if(g_next) kvalue = lazy_get_kern_value(dsc, &g_left, g_next);
+    }
+
+    int32_t kv = ((int32_t)((int32_t)kvalue * dsc->header.kerning_scale) >> 4);
+
+    uint32_t adv_w = gdsc->adv_w;
+    if(is_tab) adv_w *= 2;
+
+    adv_w += kv;
+    adv_w  = (adv_w + (1 << 3)) >> 4;
+
+    dsc_out->adv_w = adv_w;
+    dsc_out->box_h = gdsc->box_h;
+    dsc_out->box_w = gdsc->box_w;
+    dsc_out->ofs_x = gdsc->ofs_x;
+    dsc_out->ofs_y = gdsc->ofs_y;
+    dsc_out->bpp   = dsc->header.bits_per_pixel;
+
+    if(is_tab) dsc_out->box_w = dsc_out->box_w * 2;
+
+    return true;
+}
+
+/**
+ * `get_glyph_bitmap` callback of the lazy loaded fonts
+ * @param font pointer to font
+ * @param letter an unicode letter which bitmap should be get
+ * @return pointer to the bitmap or NULL if not found
+ */
+static const uint8_t * lazy_get_glyph_bitmap(const lv_font_t * font, uint32_t letter)
+{
+    lazy_font_dsc_t * dsc = font->dsc;
+
+    if(letter == '\t') letter = ' ';
+
+    lazy_glyph_t * g = lazy_get_glyph(dsc, letter);
+    if(g == NULL) return NULL;
+    if(g->dsc.box_w * g->dsc.box_h == 0 || g->bitmap_size == 0) return NULL;
+
+    if(g->bitmap == NULL) {
+        uint32_t pos = dsc->glyf_start + g->dsc.bitmap_index;
+        /*Reference aligned bitmaps in place if the font is in memory*/
+        if(dsc->src.mem && g->bitmap_shift == 0) {
+            if(pos + g->bitmap_size > dsc->src.mem_size) return NULL;
+            g->bitmap = &dsc->src.mem[pos];
+        }
+        else {
+            uint8_t * bmp = lv_mem_alloc_tag(g->bitmap_size, LV_MEM_TAG_FONT);
+            LV_ASSERT_MEM(bmp);
+            if(bmp == NULL) return NULL;
+
+            if(!src_read(&dsc->src, pos, bmp, g->bitmap_size)) {
+                lv_mem_free(bmp);
+                return NULL;
+            }
+
+            /*Remove the bits of the glyph's header from the beginning*/
+            if(g->bitmap_shift) {
+                uint32_t i;
+                uint8_t shift = g->bitmap_shift;
+                for(i = 0; i < g->bitmap_size - 1; i++) {
+                    bmp[i] = (bmp[i] << shift) | (bmp[i + 1] >> (8 - shift));
+                }
+                bmp[i] = bmp[i] << shift;
+            }
+
+            g->bitmap = bmp;
+            g->bitmap_alloc = 1;
+        }
+    }
+
+    if(dsc->header.compression_id == LV_FONT_FMT_TXT_PLAIN) return g->bitmap;
+
+    bool prefilter = dsc->header.compression_id == LV_FONT_FMT_TXT_COMPRESSED ? true : false;
+    return _lv_font_fmt_txt_decompress(g->bitmap, g->dsc.box_w, g->dsc.box_h, dsc->header.bits_per_pixel, prefilter);
+}
+
+/**
+ * Get a glyph from the cache of a lazy loaded font. Read it from the source if not cached.
+ * The least recently used glyph of the set is replaced, so the previously got glyph remains cached.
+ * @param dsc descriptor of the font
+ * @param letter an UNICODE letter
+ * @return pointer to cache entry of the glyph (valid until the next call) or NULL if the letter is not found
+ */
+static lazy_glyph_t * lazy_get_glyph(lazy_font_dsc_t * dsc, uint32_t letter)
+{
+    if(letter == '\0') return NULL;
+
+    uint32_t set_cnt = dsc->cache_size / LAZY_CACHE_WAY_CNT;
+    lazy_glyph_t * set = &dsc->cache[(letter % set_cnt) * LAZY_CACHE_WAY_CNT];
+    dsc->cache_tick++;
+
+    lazy_glyph_t * g = &set[0];
+    uint32_t i;
+    for(i = 0; i < LAZY_CACHE_WAY_CNT; i++) {
+        if(set[i].letter == letter) {
+            set[i].last_used = dsc->cache_tick;
+            return set[i].gid ? &set[i] : NULL;
+        }
+
+        /*Prefer the unused entries, else the one not used for the longest time*/
+        if(g->letter == 0) continue;
+        if(set[i].letter == 0 || dsc->cache_tick - set[i].last_used > dsc->cache_tick - g->last_used) g = &set[i];
+    }
+
+    if(g->bitmap_alloc) lv_mem_free(g->bitmap);
+    _lv_memset_00(g, sizeof(lazy_glyph_t));
+
+    g->gid = lazy_get_glyph_id(dsc, letter);
+    if(g->gid != 0 && !lazy_read_glyph(dsc, g)) g->gid = 0;
+
+    /*Cache the result even if the letter was not found to not search it again*/
+    g->letter = letter;
+    g->last_used = dsc->cache_tick;
+
+    return g->gid ? g : NULL;
+}
+
+/**
+ * Search the glyph id of a letter in the character maps of a lazy loaded font
+ * @param dsc descriptor of the font
+ * @param letter an UNICODE letter
+ * @return the glyph id or 0 if not found
+ */
+static uint32_t lazy_get_glyph_id(lazy_font_dsc_t * dsc, uint32_t letter)
+{
+    uint16_t i;
+    for(i = 0; i < dsc->cmap_num; i++) {
+        const lazy_cmap_t * cmap = &dsc->cmaps[i];
+
+        /*Relative code point*/
+        uint32_t rcp = letter - cmap->range_start;
+        if(rcp >= cmap->range_length) continue;
+
+        if(cmap->type == LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY) {
+            return cmap->glyph_id_start + rcp;
+        }
+        else if(cmap->type == LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL) {
+            uint8_t ofs;
+            if(!src_read(&dsc->src, cmap->glyph_id_ofs_list_pos + rcp, &ofs, sizeof(ofs))) return 0;
+            return cmap->glyph_id_start + ofs;
+        }
+
+        /*Binary search in the sparse unicode list*/
+        int32_t first = 0;
+        int32_t last = (int32_t)cmap->list_length - 1;
+        while(first <= last) {
+            int32_t middle = (first + last) / 2;
+            uint16_t value;
+            if(!src_read(&dsc->src, cmap->unicode_list_pos + middle * sizeof(uint16_t), &value, sizeof(value))) return 0;
+
+            if(value < rcp) first = middle + 1;
+            else if(value > rcp) last = middle - 1;
+            else {
+                if(cmap->type == LV_FONT_FMT_TXT_CMAP_SPARSE_TINY) return cmap->glyph_id_start + middle;
+
+                uint16_t ofs;
+                if(!src_read(&dsc->src, cmap->glyph_id_ofs_list_pos + middle * sizeof(uint16_t), &ofs, sizeof(ofs))) {
+                    return 0;
+                }
+                return cmap->glyph_id_start + ofs;
+            }
+        }
+
+        return 0;
+    }
+
+    return 0;
+}
+
+/**
+ * Read the descriptor of a glyph of a lazy loaded font. The bitmap is read only when it's required.
+ * @param dsc descriptor of the font
+ * @param g cache entry with `gid` set
+ * @return true: success; false: read error
+ */
+static bool lazy_read_glyph(lazy_font_dsc_t * dsc, lazy_glyph_t * g)
+{
+    font_header_bin_t * header = &dsc->header;
+    if(g->gid >= dsc->loca_count) return false;
+
+    /*Get the position of the glyph and the next glyph*/
+    uint32_t ofs[2] = {0, dsc->glyf_length};
+    uint32_t ofs_cnt = g->gid + 1 < dsc->loca_count ? 2 : 1;
+    if(header->index_to_loc_format == 0) {
+        uint16_t ofs16[2];
+        if(!src_read(&dsc->src, dsc->loca_pos + g->gid * sizeof(uint16_t), ofs16, ofs_cnt * sizeof(uint16_t))) {
+            return false;
+        }
+        ofs[0] = ofs16[0];
+        if(ofs_cnt == 2) ofs[1] = ofs16[1];
+    }
+    else {
+        if(!src_read(&dsc->src, dsc->loca_pos + g->gid * sizeof(uint32_t), ofs, ofs_cnt * sizeof(uint32_t))) {
+            return false;
+        }
+    }
+
+    uint32_t nbits = header->advance_width_bits + 2 * header->xy_bits + 2 * header->wh_bits;
+    uint8_t buf[16];
+    uint32_t header_size = (nbits + 7) / 8;
+    if(header_size > sizeof(buf) || ofs[1] < ofs[0] + nbits / 8) return false;
+    if(header_size > 0 && !src_read(&dsc->src, dsc->glyf_start + ofs[0], buf, header_size)) return false;
+
+    lv_font_fmt_txt_glyph_dsc_t * gdsc = &g->dsc;
+    uint32_t bit_pos = 0;
+    if(header->advance_width_bits == 0) {
+        gdsc->adv_w = header->default_advance_width;
+    }
+    else {
+        gdsc->adv_w = get_bits(buf, bit_pos, header->advance_width_bits);
+        bit_pos += header->advance_width_bits;
+    }
+
+    if(header->advance_width_format == 0) {
+        gdsc->adv_w *= 16;
+    }
+
+    gdsc->ofs_x = get_bits_signed(buf, bit_pos, header->xy_bits);
+    bit_pos += header->xy_bits;
+    gdsc->ofs_y = get_bits_signed(buf, bit_pos, header->xy_bits);
+    bit_pos += header->xy_bits;
+    gdsc->box_w = get_bits(buf, bit_pos, header->wh_bits);
+    bit_pos += header->wh_bits;
+    gdsc->box_h = get_bits(buf, bit_pos, header->wh_bits);
+
+    gdsc->bitmap_index = ofs[0] + nbits / 8;
+    g->bitmap_size = ofs[1] - ofs[0] - nbits / 8;
+    g->bitmap_shift = nbits % 8;
+
+    if(dsc->kern_type == LAZY_KERN_CLASSES) {
+        if(!src_read(&dsc->src, dsc->kern_left_pos + g->gid, &g->left_class, sizeof(uint8_t)) ||
+           !src_read(&dsc->src, dsc->kern_right_pos + g->gid, &g->right_class, sizeof(uint8_t))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Get the kerning value between two glyphs of a lazy loaded font
+ * @param dsc descriptor of the font
+ * @param g_left the left glyph
+ * @param g_right the right glyph
+ * @return the kerning value
+ */
+static int8_t lazy_get_kern_value(lazy_font_dsc_t * dsc, const lazy_glyph_t * g_left, const lazy_glyph_t * g_right)
+{
+    int8_t value = 0;
+
+    if(dsc->kern_type == LAZY_KERN_CLASSES) {
+        /* If class = 0, kerning not exist for that glyph
+         * else got the value form `class_pair_values` 2D array*/
+        if(g_left->left_class > 0 && g_right->right_class > 0) {
+            value = dsc->kern_class_values[(g_left->left_class - 1) * dsc->kern_cols + (g_right->right_class - 1)];
+        }
+    }
+    else if(dsc->kern_type == LAZY_KERN_PAIRS) {
+        /* Use binary search to find the kern value.
+         * The pairs are ordered left_id first, then right_id secondly. */
+        uint32_t id_size = dsc->header.glyph_id_format == 0 ? sizeof(uint8_t) : sizeof(uint16_t);
+        int32_t first = 0;
+        int32_t last = (int32_t)dsc->kern_pair_cnt - 1;
+        while(first <= last) {
+            int32_t middle = (first + last) / 2;
+            uint32_t left;
+            uint32_t right;
+            if(id_size == sizeof(uint8_t)) {
+                uint8_t ids[2];
+                if(!src_read(&dsc->src, dsc->kern_ids_pos + middle * 2 * id_size, ids, sizeof(ids))) return 0;
+                left = ids[0];
+                right = ids[1];
+            }
+            else {
+                uint16_t ids[2];
+                if(!src_read(&dsc->src, dsc->kern_ids_pos + middle * 2 * id_size, ids, sizeof(ids))) return 0;
+                left = ids[0];
+                right = ids[1];
+            }
+
+            if(left < g_left->gid || (left == g_left->gid && right < g_right->gid)) first = middle + 1;
+            else if(left > g_left->gid || right > g_right->gid) last = middle - 1;
+            else {
+                if(!src_read(&dsc->src, dsc->kern_values_pos + middle, &value, sizeof(value))) return 0;
+                break;
+            }
+        }
+    }
+
+    return value;
+}
+
+/**
+ * Read data from the source of a lazy loaded font
+ * @param src pointer to the source
+ * @param pos read from this position
+ * @param buf store the data here
+ * @param len number of bytes to read
+ * @return true: success; false: read error
+ */
+static bool src_read(font_src_t * src, uint32_t pos, void * buf, uint32_t len)
+{
+    if(src->mem) {
+        if(pos + len > src->mem_size) return false;
+        _lv_memcpy(buf, &src->mem[pos], len);
+        return true;
+    }
+
+    if(lv_fs_seek(&src->file, pos) != LV_FS_RES_OK) return false;
+
+    uint32_t br;
+    if(lv_fs_read(&src->file, buf, len, &br) != LV_FS_RES_OK) return false;
+
+    return br == len;
+}
+
+/**
+ * Read and check the label of a table from the source of a lazy loaded font
+ * @param src pointer to the source
+ * @param pos start of the table
+ * @param label the expected label
+ * @return length of the table or -1 on error
+ */
+static int32_t src_read_label(font_src_t * src, uint32_t pos, const char * label)
+{
+    uint32_t length;
+    char buf[4];
+
+    if(!src_read(src, pos, &length, 4) || !src_read(src, pos + 4, buf, 4) || memcmp(label, buf, 4) != 0) {
+        LV_LOG_WARN("Error reading '%s' label.", label);
+        return -1;
+    }
+
+    return length;
+}
+
+/**
+ * Read bits from a buffer. The bits are read from the MSB of the bytes.
+ * @param in the input buffer to read from
+ * @param bit_pos index of the first bit to read
+ * @param len number of bits to read (<= 32)
+ * @return the read value
+ */
+static uint32_t get_bits(const uint8_t * in, uint32_t bit_pos, uint32_t len)
+{
+    uint32_t value = 0;
+    uint32_t i;
+    for(i = 0; i < len; i++) {
+        uint32_t bit = (in[(bit_pos + i) >> 3] >> (7 - ((bit_pos + i) & 0x7))) & 0x1;
+        value = (value << 1) | bit;
+    }
+
+    return value;
+}
+
+/**
+ * Read a signed value from a buffer. The bits are read from the MSB of the bytes.
+ * @param in the input buffer to read from
+ * @param bit_pos index of the first bit to read
+ * @param len number of bits to read (<= 32)
+ * @return the read value
+ */
+static int32_t get_bits_signed(const uint8_t * in, uint32_t bit_pos, uint32_t len)
+{
+    uint32_t value = get_bits(in, bit_pos, len);
+    if(len > 0 && len < 32 && (value & (1 << (len - 1)))) {
+        value |= ~0u << len;
+    }
+    return value;
+}
+
 #endif /*LV_USE_FILESYSTEM*/
@@ -29,6 +29,28 @@ extern "C" {
 #if LV_USE_FILESYSTEM
 
 lv_font_t * lv_font_load(const char * fontName);
+
+/**
+ * Load a font from a binary font file lazily.
+ * Only the header and the position of the tables are read on load.
+ * The glyphs are read from the file when they are used and the recently used glyphs are cached.
+ * The file remains opened until `lv_font_free()` is called.
+ * @param font_name filename where the font file is located
+ * @param cache_size number of glyphs to keep in RAM (>= 1). Rounded up to a multiple of 2.
+ * @return a pointer to the font or NULL in case of error
+ */
+lv_font_t * lv_font_load_lazy(const char * font_name, uint16_t cache_size);
+
+/**
+ * Load a font lazily from a binary font file stored in memory (e.g. in memory mapped flash).
+ * The tables and bitmaps are referenced from `data` where possible instead of copying them.
+ * @param data pointer to the content of the font file. Should be kept valid until `lv_font_free()`.
+ * @param size size of `data` in bytes
+ * @param cache_size number of glyphs to keep in RAM (>= 1). Rounded up to a multiple of 2.
+ * @return a pointer to the font or NULL in case of error
+ */
+lv_font_t * lv_font_load_lazy_from_mem(const void * data, uint32_t size, uint16_t cache_size);
+
 void lv_font_free(lv_font_t * font);
 
 #endif
@@ -97,7 +97,9 @@ void lv_anim_start(lv_anim_t * a)
     }
 
     /*Add the new animation to the animation linked list*/
+    _lv_mem_tag_push(LV_MEM_TAG_ANIM);
     lv_anim_t * new_anim = _lv_ll_ins_head(&LV_GC_ROOT(_lv_anim_ll));
+    _lv_mem_tag_pop();
     LV_ASSERT_MEM(new_anim);
     if(new_anim == NULL) return;
 
@@ -149,6 +151,38 @@ bool lv_anim_del(void * var, lv_anim_exec_xcb_t exec_cb)
     return del;
 }
 
+/**
+ * Delete all the animations whose variable is in a memory range in one pass.
+ * Used to delete the animations of many objects at once, e.g. of a screen with arena.
+ * @param start start address of the range
+ * @param end the first address after the range
+ * @return true: at least 1 animation is deleted, false: no animation is deleted
+ */
+bool _lv_anim_del_range(const void * start, const void * end)
+{
+    lv_anim_t * a;
+    lv_anim_t * a_next;
+    bool del = false;
+    a        = _lv_ll_get_head(&LV_GC_ROOT(_lv_anim_ll));
+    while(a != NULL) {
+        /*'a' might be deleted, so get the next object while 'a' is valid*/
+        a_next = _lv_ll_get_next(&LV_GC_ROOT(_lv_anim_ll), a);
+
+        const uint8_t * var = a->var;
+        if(var >= (const uint8_t *)start && var < (const uint8_t *)end) {
+            _lv_ll_remove(&LV_GC_ROOT(_lv_anim_ll), a);
+            lv_mem_free(a);
+            anim_mark_list_change(); /*Read by `anim_task`. It need to know if a delete occurred in
+                                         the linked list*/
+            del = true;
+        }
+
+        a = a_next;
+    }
+
+    return del;
+}
+
 /**
  * Get the animation of a variable and its `exec_cb`.
  * @param var pointer to variable
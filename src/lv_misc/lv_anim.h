@@ -312,6 +312,15 @@ static inline uint32_t lv_anim_get_delay(lv_anim_t * a)
  */
 bool lv_anim_del(void * var, lv_anim_exec_xcb_t exec_cb);
 
+/**
+ * Delete all the animations whose variable is in a memory range in one pass.
+ * Used to delete the animations of many objects at once, e.g. of a screen with arena.
+ * @param start start address of the range
+ * @param end the first address after the range
+ * @return true: at least 1 animation is deleted, false: no animation is deleted
+ */
+bool _lv_anim_del_range(const void * start, const void * end);
+
 /**
  * Get the animation of a variable and its `exec_cb`.
  * @param var pointer to variable
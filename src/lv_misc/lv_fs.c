@@ -29,11 +29,38 @@
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_FS_CACHE
+typedef struct {
+    uint32_t pos;   /*Position of the block in the file. Always a multiple of the block size*/
+    uint32_t size;  /*Number of valid bytes. Less than the block size at the end of the file. 0: empty*/
+    uint32_t life;  /*Time of the last use to find the least recently used block*/
+} lv_fs_cache_block_t;
+
+typedef struct _lv_fs_cache_t {
+    uint32_t pos;       /*Position of the read pointer seen by the user*/
+    uint32_t drv_pos;   /*Position of the driver's read pointer to skip the not required seeks*/
+    uint32_t seq_pos;   /*End of the last loaded blocks. Loading from here means sequential reading.*/
+    uint32_t life;      /*Incremented on every use of a block*/
+    uint16_t block_size;
+    uint8_t block_cnt;
+    lv_fs_cache_block_t * blocks;
+    uint8_t * data;     /*The blocks are contiguous to read ahead more blocks with one driver call*/
+} lv_fs_cache_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static const char * lv_fs_get_real_path(const char * path);
+#if LV_FS_CACHE
+static void cache_create(lv_fs_file_t * file_p);
+static lv_fs_res_t cache_read(lv_fs_file_t * file_p, uint8_t * buf, uint32_t btr, uint32_t * br);
+static lv_fs_res_t cache_load(lv_fs_file_t * file_p, uint32_t block_pos, lv_fs_cache_block_t ** block);
+static lv_fs_cache_block_t * cache_find(lv_fs_cache_t * cache, uint32_t block_pos);
+static lv_fs_res_t drv_read_at(lv_fs_file_t * file_p, uint32_t pos, void * buf, uint32_t btr, uint32_t * br);
+static lv_fs_res_t drv_read(lv_fs_file_t * file_p, void * buf, uint32_t btr, uint32_t * br);
+static lv_fs_res_t drv_seek(lv_fs_file_t * file_p, uint32_t pos);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -83,6 +110,9 @@ lv_fs_res_t lv_fs_open(lv_fs_file_t * file_p, const char * path, lv_fs_mode_t mo
 {
     file_p->drv    = NULL;
     file_p->file_d = NULL;
+#if LV_FS_CACHE
+    file_p->cache  = NULL;
+#endif
 
     if(path == NULL) return LV_FS_RES_INV_PARAM;
 
@@ -110,10 +140,14 @@ lv_fs_res_t lv_fs_open(lv_fs_file_t * file_p, const char * path, lv_fs_mode_t mo
 
     if(file_p->drv->file_size == 0) {  /*Is file_d zero size?*/
         /*Pass file_d's address to open_cb, so the implementor can allocate memory byself*/
-        return file_p->drv->open_cb(file_p->drv, &file_p->file_d, real_path, mode);
+        lv_fs_res_t res = file_p->drv->open_cb(file_p->drv, &file_p->file_d, real_path, mode);
+#if LV_FS_CACHE
+        if(res == LV_FS_RES_OK && mode == LV_FS_MODE_RD) cache_create(file_p);
+#endif
+        return res;
     }
 
-    file_p->file_d = lv_mem_alloc(file_p->drv->file_size);
+    file_p->file_d = lv_mem_alloc_tag(file_p->drv->file_size, LV_MEM_TAG_FS);
     LV_ASSERT_MEM(file_p->file_d);
     if(file_p->file_d == NULL) {
         file_p->drv = NULL;
@@ -127,6 +161,12 @@ lv_fs_res_t lv_fs_open(lv_fs_file_t * file_p, const char * path, lv_fs_mode_t mo
         file_p->file_d = NULL;
         file_p->drv    = NULL;
     }
+#if LV_FS_CACHE
+    /*Only the read only files are cached to not care about the written data*/
+    else if(mode == LV_FS_MODE_RD) {
+        cache_create(file_p);
+    }
+#endif
 
     return res;
 }
@@ -152,6 +192,13 @@ lv_fs_res_t lv_fs_close(lv_fs_file_t * file_p)
     file_p->file_d = NULL;
     file_p->drv    = NULL;
 
+#if LV_FS_CACHE
+    if(file_p->cache) {
+        lv_mem_free(file_p->cache);
+        file_p->cache = NULL;
+    }
+#endif
+
     return res;
 }
 
@@ -195,7 +242,20 @@ lv_fs_res_t lv_fs_read(lv_fs_file_t * file_p, void * buf, uint32_t btr, uint32_t
     if(file_p->drv->read_cb == NULL) return LV_FS_RES_NOT_IMP;
 
     uint32_t br_tmp = 0;
+#if LV_FS_CACHE
+    lv_fs_res_t res;
+    if(file_p->cache) {
+        res = cache_read(file_p, buf, btr, &br_tmp);
+    }
+    else {
+        res = drv_read(file_p, buf, btr, &br_tmp);
+        file_p->drv->stat.miss_cnt++;
+    }
+    file_p->drv->stat.read_cnt++;
+    file_p->drv->stat.read_bytes += br_tmp;
+#else
     lv_fs_res_t res = file_p->drv->read_cb(file_p->drv, file_p->file_d, buf, btr, &br_tmp);
+#endif
     if(br != NULL) *br = br_tmp;
 
     return res;
@@ -244,7 +304,19 @@ lv_fs_res_t lv_fs_seek(lv_fs_file_t * file_p, uint32_t pos)
         return LV_FS_RES_NOT_IMP;
     }
 
+#if LV_FS_CACHE
+    file_p->drv->stat.seek_cnt++;
+
+    /*Only move the read pointer. The driver will seek if the data is not in the cache*/
+    if(file_p->cache) {
+        file_p->cache->pos = pos;
+        return LV_FS_RES_OK;
+    }
+
+    lv_fs_res_t res = drv_seek(file_p, pos);
+#else
     lv_fs_res_t res = file_p->drv->seek_cb(file_p->drv, file_p->file_d, pos);
+#endif
 
     return res;
 }
@@ -262,6 +334,13 @@ lv_fs_res_t lv_fs_tell(lv_fs_file_t * file_p, uint32_t * pos)
         return LV_FS_RES_INV_PARAM;
     }
 
+#if LV_FS_CACHE
+    if(file_p->cache) {
+        *pos = file_p->cache->pos;
+        return LV_FS_RES_OK;
+    }
+#endif
+
     if(file_p->drv->tell_cb == NULL) {
         *pos = 0;
         return LV_FS_RES_NOT_IMP;
@@ -313,6 +392,34 @@ lv_fs_res_t lv_fs_size(lv_fs_file_t * file_p, uint32_t * size)
     return res;
 }
 
+/**
+ * Get a pointer to the whole content of a file if the driver can provide it (e.g. memory mapped files).
+ * The data can be used directly instead of reading (copying) it.
+ * @param file_p pointer to a lv_fs_file_t variable
+ * @param ptr store the pointer to the content here. It's valid until the file is closed.
+ * @param size store the size of the file here
+ * @return LV_FS_RES_OK or LV_FS_RES_NOT_IMP if the driver can't give a pointer to the file
+ */
+lv_fs_res_t lv_fs_map(lv_fs_file_t * file_p, const void ** ptr, uint32_t * size)
+{
+    *ptr = NULL;
+    *size = 0;
+
+    if(file_p->drv == NULL) {
+        return LV_FS_RES_INV_PARAM;
+    }
+
+    if(file_p->drv->map_cb == NULL) return LV_FS_RES_NOT_IMP;
+
+    lv_fs_res_t res = file_p->drv->map_cb(file_p->drv, file_p->file_d, ptr, size);
+    if(res != LV_FS_RES_OK) {
+        *ptr = NULL;
+        *size = 0;
+    }
+
+    return res;
+}
+
 /**
  * Rename a file
  * @param oldname path to the file
@@ -387,7 +494,7 @@ lv_fs_res_t lv_fs_dir_open(lv_fs_dir_t * rddir_p, const char * path)
         return rddir_p->drv->dir_open_cb(rddir_p->drv, &rddir_p->dir_d, real_path);
     }
 
-    rddir_p->dir_d = lv_mem_alloc(rddir_p->drv->rddir_size);
+    rddir_p->dir_d = lv_mem_alloc_tag(rddir_p->drv->rddir_size, LV_MEM_TAG_FS);
     LV_ASSERT_MEM(rddir_p->dir_d);
     if(rddir_p->dir_d == NULL) {
         rddir_p->drv = NULL;
@@ -497,6 +604,11 @@ lv_fs_res_t lv_fs_free_space(char letter, uint32_t * total_p, uint32_t * free_p)
 void lv_fs_drv_init(lv_fs_drv_t * drv)
 {
     _lv_memset_00(drv, sizeof(lv_fs_drv_t));
+
+#if LV_FS_CACHE
+    drv->cache_block_size = LV_FS_CACHE_BLOCK_SIZE;
+    drv->cache_block_cnt  = LV_FS_CACHE_BLOCK_CNT;
+#endif
 }
 
 /**
@@ -532,6 +644,36 @@ lv_fs_drv_t * lv_fs_get_drv(char letter)
 
     return NULL;
 }
+#if LV_FS_CACHE
+/**
+ * Get the statistics of a drive
+ * @param letter the driver letter
+ * @param stat store the statistics here
+ * @return LV_FS_RES_OK or LV_FS_RES_NOT_EX if there is no driver with this letter
+ */
+lv_fs_res_t lv_fs_get_stat(char letter, lv_fs_stat_t * stat)
+{
+    lv_fs_drv_t * drv = lv_fs_get_drv(letter);
+    if(drv == NULL) {
+        _lv_memset_00(stat, sizeof(lv_fs_stat_t));
+        return LV_FS_RES_NOT_EX;
+    }
+
+    _lv_memcpy_small(stat, &drv->stat, sizeof(lv_fs_stat_t));
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Clear the statistics of a drive
+ * @param letter the driver letter
+ */
+void lv_fs_reset_stat(char letter)
+{
+    lv_fs_drv_t * drv = lv_fs_get_drv(letter);
+    if(drv) _lv_memset_00(&drv->stat, sizeof(lv_fs_stat_t));
+}
+#endif
+
 /**
  * Fill a buffer with the letters of existing drivers
  * @param buf buffer to store the letters ('\0' added after the last letter)
@@ -661,4 +803,190 @@ static const char * lv_fs_get_real_path(const char * path)
     return path;
 }
 
+#if LV_FS_CACHE
+/**
+ * Allocate the cache of a file opened for reading.
+ * If there is not enough memory the file is used without cache.
+ * @param file_p pointer to an opened file
+ */
+static void cache_create(lv_fs_file_t * file_p)
+{
+    lv_fs_drv_t * drv = file_p->drv;
+    if(drv->cache_block_cnt == 0 || drv->cache_block_size == 0 || drv->seek_cb == NULL) return;
+
+    uint32_t blocks_size = drv->cache_block_cnt * sizeof(lv_fs_cache_block_t);
+    uint32_t data_size = (uint32_t)drv->cache_block_cnt * drv->cache_block_size;
+    lv_fs_cache_t * cache = lv_mem_alloc_tag(sizeof(lv_fs_cache_t) + blocks_size + data_size, LV_MEM_TAG_FS);
+    if(cache == NULL) {
+        LV_LOG_WARN("lv_fs_open: not enough memory to cache the file");
+        return;
+    }
+
+    _lv_memset_00(cache, sizeof(lv_fs_cache_t) + blocks_size);
+    cache->blocks = (lv_fs_cache_block_t *)(cache + 1);
+    cache->data = (uint8_t *)cache->blocks + blocks_size;
+    cache->block_size = drv->cache_block_size;
+    cache->block_cnt = drv->cache_block_cnt;
+
+    file_p->cache = cache;
+}
+
+/**
+ * Read from a cached file. Copy the data from the blocks and load the missing blocks.
+ * The reads larger than a block which are not in the cache bypass it.
+ * @param file_p pointer to a cached file
+ * @param buf store the data here
+ * @param btr bytes to read
+ * @param br store the number of read bytes here
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum if nothing was read
+ */
+static lv_fs_res_t cache_read(lv_fs_file_t * file_p, uint8_t * buf, uint32_t btr, uint32_t * br)
+{
+    lv_fs_cache_t * cache = file_p->cache;
+    lv_fs_res_t res = LV_FS_RES_OK;
+    bool miss = false;
+
+    while(btr > 0) {
+        uint32_t block_pos = cache->pos - (cache->pos % cache->block_size);
+        lv_fs_cache_block_t * block = cache_find(cache, block_pos);
+        if(block == NULL) {
+            miss = true;
+
+            /*Don't evict the blocks for large reads*/
+            if(btr >= cache->block_size) {
+                uint32_t br_tmp = 0;
+                res = drv_read_at(file_p, cache->pos, buf, btr, &br_tmp);
+                cache->pos += br_tmp;
+                *br += br_tmp;
+                break;
+            }
+
+            res = cache_load(file_p, block_pos, &block);
+            if(block == NULL) break;
+        }
+
+        /*A not full block is the end of the file*/
+        uint32_t ofs = cache->pos - block->pos;
+        if(ofs >= block->size) break;
+
+        uint32_t n = LV_MATH_MIN(btr, block->size - ofs);
+        _lv_memcpy(buf, &cache->data[(block - cache->blocks) * cache->block_size + ofs], n);
+        cache->life++;
+        block->life = cache->life;
+
+        buf += n;
+        btr -= n;
+        cache->pos += n;
+        *br += n;
+    }
+
+    if(miss) file_p->drv->stat.miss_cnt++;
+    else file_p->drv->stat.hit_cnt++;
+
+    /*Report only that the data ended like the drivers do*/
+    return *br > 0 ? LV_FS_RES_OK : res;
+}
+
+/**
+ * Load a block into the place of the least recently used block.
+ * If the file is read sequentially load the next blocks too with the same driver call.
+ * @param file_p pointer to a cached file
+ * @param block_pos position of the block in the file
+ * @param block store the loaded block here. NULL on error or at the end of the file
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t cache_load(lv_fs_file_t * file_p, uint32_t block_pos, lv_fs_cache_block_t ** block)
+{
+    lv_fs_cache_t * cache = file_p->cache;
+    *block = NULL;
+
+    uint32_t cnt = 1;
+    if(block_pos == cache->seq_pos && LV_FS_CACHE_READAHEAD > 1) {
+        cnt = LV_MATH_MIN(LV_FS_CACHE_READAHEAD, cache->block_cnt);
+    }
+
+    uint32_t i;
+    uint32_t lru = 0;
+    for(i = 1; i < cache->block_cnt; i++) {
+        if(cache->blocks[i].life < cache->blocks[lru].life) lru = i;
+    }
+
+    /*The blocks read ahead need to be contiguous*/
+    if(lru + cnt > cache->block_cnt) lru = cache->block_cnt - cnt;
+
+    uint32_t size = cnt * cache->block_size;
+    uint32_t br = 0;
+    lv_fs_res_t res = drv_read_at(file_p, block_pos, &cache->data[lru * cache->block_size], size, &br);
+    if(res != LV_FS_RES_OK) br = 0;
+
+    /*Drop the other copies of the loaded blocks*/
+    for(i = 0; i < cache->block_cnt; i++) {
+        if(i >= lru && i < lru + cnt) continue;
+        if(cache->blocks[i].pos >= block_pos && cache->blocks[i].pos < block_pos + size) cache->blocks[i].size = 0;
+    }
+
+    cache->life++;
+    for(i = 0; i < cnt; i++) {
+        lv_fs_cache_block_t * b = &cache->blocks[lru + i];
+        uint32_t ofs = i * cache->block_size;
+        b->pos = block_pos + ofs;
+        b->size = br > ofs ? LV_MATH_MIN(br - ofs, cache->block_size) : 0;
+        b->life = cache->life;
+    }
+
+    cache->seq_pos = block_pos + size;
+
+    if(cache->blocks[lru].size > 0) *block = &cache->blocks[lru];
+    return res;
+}
+
+static lv_fs_cache_block_t * cache_find(lv_fs_cache_t * cache, uint32_t block_pos)
+{
+    uint32_t i;
+    for(i = 0; i < cache->block_cnt; i++) {
+        if(cache->blocks[i].size > 0 && cache->blocks[i].pos == block_pos) return &cache->blocks[i];
+    }
+
+    return NULL;
+}
+
+/**
+ * Read from a given position of a cached file. Seek only if the driver is not there yet.
+ */
+static lv_fs_res_t drv_read_at(lv_fs_file_t * file_p, uint32_t pos, void * buf, uint32_t btr, uint32_t * br)
+{
+    lv_fs_cache_t * cache = file_p->cache;
+    lv_fs_res_t res;
+    if(cache->drv_pos != pos) {
+        res = drv_seek(file_p, pos);
+        if(res != LV_FS_RES_OK) return res;
+        cache->drv_pos = pos;
+    }
+
+    res = drv_read(file_p, buf, btr, br);
+    if(res == LV_FS_RES_OK) cache->drv_pos += *br;
+    else cache->drv_pos = UINT32_MAX; /*Unknown position*/
+
+    return res;
+}
+
+static lv_fs_res_t drv_read(lv_fs_file_t * file_p, void * buf, uint32_t btr, uint32_t * br)
+{
+    lv_fs_drv_t * drv = file_p->drv;
+    lv_fs_res_t res = drv->read_cb(drv, file_p->file_d, buf, btr, br);
+    drv->stat.drv_read_cnt++;
+    drv->stat.drv_read_bytes += *br;
+
+    return res;
+}
+
+static lv_fs_res_t drv_seek(lv_fs_file_t * file_p, uint32_t pos)
+{
+    lv_fs_drv_t * drv = file_p->drv;
+    drv->stat.drv_seek_cnt++;
+
+    return drv->seek_cb(drv, file_p->file_d, pos);
+}
+#endif
+
 #endif /*LV_USE_FILESYSTEM*/
@@ -60,6 +60,24 @@ enum {
 };
 typedef uint8_t lv_fs_mode_t;
 
+#if LV_FS_CACHE
+/**
+ * Statistics of the accesses of a drive
+ */
+typedef struct {
+    uint32_t read_cnt;       /**< Number of `lv_fs_read` calls*/
+    uint32_t read_bytes;     /**< Bytes read by `lv_fs_read`*/
+    uint32_t seek_cnt;       /**< Number of `lv_fs_seek` calls*/
+    uint32_t hit_cnt;        /**< `lv_fs_read` calls served entirely from the cache*/
+    uint32_t miss_cnt;       /**< `lv_fs_read` calls which needed the driver*/
+    uint32_t drv_read_cnt;   /**< Number of `read_cb` calls*/
+    uint32_t drv_read_bytes; /**< Bytes read by `read_cb`*/
+    uint32_t drv_seek_cnt;   /**< Number of `seek_cb` calls*/
+} lv_fs_stat_t;
+
+struct _lv_fs_cache_t;
+#endif
+
 typedef struct _lv_fs_drv_t {
     char letter;
     uint16_t file_size;
@@ -75,6 +93,8 @@ typedef struct _lv_fs_drv_t {
     lv_fs_res_t (*tell_cb)(struct _lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p);
     lv_fs_res_t (*trunc_cb)(struct _lv_fs_drv_t * drv, void * file_p);
     lv_fs_res_t (*size_cb)(struct _lv_fs_drv_t * drv, void * file_p, uint32_t * size_p);
+    /*Optional. Give a pointer to the whole content of the file which remains valid until the file is closed*/
+    lv_fs_res_t (*map_cb)(struct _lv_fs_drv_t * drv, void * file_p, const void ** ptr, uint32_t * size_p);
     lv_fs_res_t (*rename_cb)(struct _lv_fs_drv_t * drv, const char * oldname, const char * newname);
     lv_fs_res_t (*free_space_cb)(struct _lv_fs_drv_t * drv, uint32_t * total_p, uint32_t * free_p);
 
@@ -82,6 +102,12 @@ typedef struct _lv_fs_drv_t {
     lv_fs_res_t (*dir_read_cb)(struct _lv_fs_drv_t * drv, void * rddir_p, char * fn);
     lv_fs_res_t (*dir_close_cb)(struct _lv_fs_drv_t * drv, void * rddir_p);
 
+#if LV_FS_CACHE
+    uint16_t cache_block_size; /**< Size of the cache blocks. Default: `LV_FS_CACHE_BLOCK_SIZE`*/
+    uint8_t cache_block_cnt;   /**< Number of cache blocks per file. 0: no caching. Default: `LV_FS_CACHE_BLOCK_CNT`*/
+    lv_fs_stat_t stat;         /**< Statistics of the accesses. Updated by `lv_fs`*/
+#endif
+
 #if LV_USE_USER_DATA
     lv_fs_drv_user_data_t user_data; /**< Custom file user data */
 #endif
@@ -90,6 +116,9 @@ typedef struct _lv_fs_drv_t {
 typedef struct {
     void * file_d;
     lv_fs_drv_t * drv;
+#if LV_FS_CACHE
+    struct _lv_fs_cache_t * cache; /*NULL if the file is not cached*/
+#endif
 } lv_fs_file_t;
 
 typedef struct {
@@ -211,6 +240,16 @@ lv_fs_res_t lv_fs_trunc(lv_fs_file_t * file_p);
  */
 lv_fs_res_t lv_fs_size(lv_fs_file_t * file_p, uint32_t * size);
 
+/**
+ * Get a pointer to the whole content of a file if the driver can provide it (e.g. memory mapped files).
+ * The data can be used directly instead of reading (copying) it.
+ * @param file_p pointer to a lv_fs_file_t variable
+ * @param ptr store the pointer to the content here. It's valid until the file is closed.
+ * @param size store the size of the file here
+ * @return LV_FS_RES_OK or LV_FS_RES_NOT_IMP if the driver can't give a pointer to the file
+ */
+lv_fs_res_t lv_fs_map(lv_fs_file_t * file_p, const void ** ptr, uint32_t * size);
+
 /**
  * Rename a file
  * @param oldname path to the file
@@ -252,6 +291,22 @@ lv_fs_res_t lv_fs_dir_close(lv_fs_dir_t * rddir_p);
  */
 lv_fs_res_t lv_fs_free_space(char letter, uint32_t * total_p, uint32_t * free_p);
 
+#if LV_FS_CACHE
+/**
+ * Get the statistics of a drive
+ * @param letter the driver letter
+ * @param stat store the statistics here
+ * @return LV_FS_RES_OK or LV_FS_RES_NOT_EX if there is no driver with this letter
+ */
+lv_fs_res_t lv_fs_get_stat(char letter, lv_fs_stat_t * stat);
+
+/**
+ * Clear the statistics of a drive
+ * @param letter the driver letter
+ */
+void lv_fs_reset_stat(char letter);
+#endif
+
 /**
  * Fill a buffer with the letters of existing drivers
  * @param buf buffer to store the letters ('\0' added after the last letter)
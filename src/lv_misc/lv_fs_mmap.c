@@ -0,0 +1,191 @@
+/**
+ * @file lv_fs_mmap.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_fs_mmap.h"
+#if LV_USE_FILESYSTEM && LV_USE_FS_MMAP
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "lv_printf.h"
+#include "lv_math.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    const uint8_t * data;   /*The mapped file. NULL for empty files*/
+    uint32_t size;
+    uint32_t pos;
+} lv_fs_mmap_file_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static lv_fs_res_t open_cb(lv_fs_drv_t * drv, void * file_p, const char * path, lv_fs_mode_t mode);
+static lv_fs_res_t close_cb(lv_fs_drv_t * drv, void * file_p);
+static lv_fs_res_t read_cb(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_t btr, uint32_t * br);
+static lv_fs_res_t seek_cb(lv_fs_drv_t * drv, void * file_p, uint32_t pos);
+static lv_fs_res_t tell_cb(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p);
+static lv_fs_res_t size_cb(lv_fs_drv_t * drv, void * file_p, uint32_t * size_p);
+static lv_fs_res_t map_cb(lv_fs_drv_t * drv, void * file_p, const void ** ptr, uint32_t * size_p);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Register the memory mapped drive with the `LV_FS_MMAP_LETTER` letter.
+ * Called by `lv_init()`.
+ */
+void _lv_fs_mmap_init(void)
+{
+    lv_fs_drv_t drv;
+    lv_fs_drv_init(&drv);
+
+    drv.letter = LV_FS_MMAP_LETTER;
+    drv.file_size = sizeof(lv_fs_mmap_file_t);
+    drv.open_cb = open_cb;
+    drv.close_cb = close_cb;
+    drv.read_cb = read_cb;
+    drv.seek_cb = seek_cb;
+    drv.tell_cb = tell_cb;
+    drv.size_cb = size_cb;
+    drv.map_cb = map_cb;
+
+#if LV_FS_CACHE
+    /*The files are already in memory*/
+    drv.cache_block_cnt = 0;
+#endif
+
+    lv_fs_drv_register(&drv);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static lv_fs_res_t open_cb(lv_fs_drv_t * drv, void * file_p, const char * path, lv_fs_mode_t mode)
+{
+    LV_UNUSED(drv);
+
+    if(mode != LV_FS_MODE_RD) return LV_FS_RES_DENIED;
+
+    char buf[LV_FS_MAX_PATH_LENGTH];
+    lv_snprintf(buf, sizeof(buf), "%s%s", LV_FS_MMAP_PATH, path);
+
+    int fd = open(buf, O_RDONLY);
+    if(fd < 0) return LV_FS_RES_NOT_EX;
+
+    struct stat st;
+    if(fstat(fd, &st) != 0 || st.st_size > (off_t)UINT32_MAX) {
+        close(fd);
+        return LV_FS_RES_FS_ERR;
+    }
+
+    lv_fs_mmap_file_t * file = file_p;
+    file->data = NULL;
+    file->size = (uint32_t)st.st_size;
+    file->pos = 0;
+
+    /*Empty files can't be mapped*/
+    if(file->size > 0) {
+        void * data = mmap(NULL, file->size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(data == MAP_FAILED) {
+            close(fd);
+            return LV_FS_RES_FS_ERR;
+        }
+        file->data = data;
+    }
+
+    /*The mapping remains valid without the file descriptor*/
+    close(fd);
+
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t close_cb(lv_fs_drv_t * drv, void * file_p)
+{
+    LV_UNUSED(drv);
+
+    lv_fs_mmap_file_t * file = file_p;
+    if(file->data) munmap((void *)file->data, file->size);
+    file->data = NULL;
+
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t read_cb(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_t btr, uint32_t * br)
+{
+    LV_UNUSED(drv);
+
+    lv_fs_mmap_file_t * file = file_p;
+    *br = file->pos < file->size ? LV_MATH_MIN(btr, file->size - file->pos) : 0;
+    if(*br > 0) _lv_memcpy(buf, &file->data[file->pos], *br);
+    file->pos += *br;
+
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t seek_cb(lv_fs_drv_t * drv, void * file_p, uint32_t pos)
+{
+    LV_UNUSED(drv);
+
+    lv_fs_mmap_file_t * file = file_p;
+    file->pos = pos;
+
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t tell_cb(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p)
+{
+    LV_UNUSED(drv);
+
+    lv_fs_mmap_file_t * file = file_p;
+    *pos_p = file->pos;
+
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t size_cb(lv_fs_drv_t * drv, void * file_p, uint32_t * size_p)
+{
+    LV_UNUSED(drv);
+
+    lv_fs_mmap_file_t * file = file_p;
+    *size_p = file->size;
+
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t map_cb(lv_fs_drv_t * drv, void * file_p, const void ** ptr, uint32_t * size_p)
+{
+    LV_UNUSED(drv);
+
+    lv_fs_mmap_file_t * file = file_p;
+    if(file->data == NULL) return LV_FS_RES_NOT_IMP;
+
+    *ptr = file->data;
+    *size_p = file->size;
+
+    return LV_FS_RES_OK;
+}
+
+#endif /*LV_USE_FILESYSTEM && LV_USE_FS_MMAP*/
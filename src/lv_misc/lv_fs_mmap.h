@@ -0,0 +1,50 @@
+/**
+ * @file lv_fs_mmap.h
+ * A POSIX file system driver which memory maps the files
+ */
+
+#ifndef LV_FS_MMAP_H
+#define LV_FS_MMAP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+
+#if LV_USE_FILESYSTEM && LV_USE_FS_MMAP
+
+#include "lv_fs.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Register the memory mapped drive with the `LV_FS_MMAP_LETTER` letter.
+ * Called by `lv_init()`.
+ */
+void _lv_fs_mmap_init(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_FILESYSTEM && LV_USE_FS_MMAP*/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_FS_MMAP_H*/
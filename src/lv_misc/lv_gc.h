@@ -36,6 +36,7 @@ extern "C" {
     f(lv_ll_t, _lv_img_defoder_ll)                                 \
     f(lv_ll_t, _lv_obj_style_trans_ll)                             \
     f(lv_img_cache_entry_t*, _lv_img_cache_array)                  \
+    f(lv_ll_t, _lv_img_cache_async_ll)                             \
     f(lv_task_t*, _lv_task_act)                                    \
     f(lv_mem_buf_arr_t , _lv_mem_buf)                              \
     f(_lv_draw_mask_saved_arr_t , _lv_draw_mask_list)              \
@@ -44,6 +45,7 @@ extern "C" {
     f(void * , _lv_theme_mono_styles)                              \
     f(void * , _lv_theme_empty_styles)                             \
     f(uint8_t *, _lv_font_decompr_buf)                             \
+    f(struct _lv_obj_t **, _lv_obj_valid_tbl)                      \
 
 #define LV_DEFINE_ROOT(root_type, root_name) root_type root_name;
 #define LV_ROOTS LV_ITERATE_ROOTS(LV_DEFINE_ROOT)
@@ -11,12 +11,19 @@
 #include "lv_math.h"
 #include "lv_gc.h"
 #include "lv_debug.h"
+#include "lv_tlsf.h"
+#include "lv_slab.h"
+#include "lv_task.h"
 #include <string.h>
 
 #if LV_MEM_CUSTOM != 0
     #include LV_MEM_CUSTOM_INCLUDE
 #endif
 
+#if LV_MEM_THREAD_SAFE && LV_MEM_LOCK_CUSTOM
+    #include LV_MEM_LOCK_CUSTOM_INCLUDE
+#endif
+
 /*********************
  *      DEFINES
  *********************/
@@ -35,6 +42,40 @@
     #define MEM_UNIT uint32_t
 #endif
 
+#if LV_MEM_THREAD_SAFE
+    #if LV_ENABLE_GC
+        #error "LV_MEM_THREAD_SAFE can't be used with LV_ENABLE_GC"
+    #endif
+
+    #define MT_CLASS_CNT    4
+    #define MT_CLASS_NONE   0xFF
+    #define MEM_THREAD_LOCAL LV_MEM_THREAD_LOCAL
+
+    #if LV_MEM_LOCK_CUSTOM
+        #define MEM_LOCK()      LV_MEM_LOCK_CUSTOM_LOCK()
+        #define MEM_UNLOCK()    LV_MEM_LOCK_CUSTOM_UNLOCK()
+    #elif defined(__GNUC__)
+        /*The heap is locked only for short times so spinning is cheaper than sleeping*/
+        #define MEM_LOCK()      while(__atomic_test_and_set(&mem_lock_flag, __ATOMIC_ACQUIRE)) {}
+        #define MEM_UNLOCK()    __atomic_clear(&mem_lock_flag, __ATOMIC_RELEASE)
+    #else
+        #error "LV_MEM_THREAD_SAFE needs LV_MEM_LOCK_CUSTOM with this compiler"
+    #endif
+
+    /*`mt_gen` is read without locking the heap*/
+    #if defined(__GNUC__)
+        #define MT_GEN_GET()    __atomic_load_n(&mt_gen, __ATOMIC_ACQUIRE)
+        #define MT_GEN_SET(v)   __atomic_store_n(&mt_gen, v, __ATOMIC_RELEASE)
+    #else
+        #define MT_GEN_GET()    (*(volatile uint32_t *)&mt_gen)
+        #define MT_GEN_SET(v)   (*(volatile uint32_t *)&mt_gen = (v))
+    #endif
+#else
+    #define MEM_LOCK()
+    #define MEM_UNLOCK()
+    #define MEM_THREAD_LOCAL
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -57,6 +98,42 @@ typedef struct {
 
 #endif /* LV_ENABLE_GC */
 
+#if LV_MEM_BUF_ARENA || LV_MEM_ARENA_CNT
+/*Stored before every allocation in an arena*/
+typedef struct {
+    uint32_t size;      /*Size of the allocation with this header. The lowest bit is `ARENA_USED_BIT`*/
+    uint32_t prev;      /*Offset of the previous allocation's header or `ARENA_NONE`*/
+} mem_arena_hdr_t;
+#endif
+
+#if LV_MEM_PROFILER
+/*Stored before every allocation if the profiler is enabled*/
+typedef struct _mem_prof_hdr_t {
+    struct _mem_prof_hdr_t * prev;  /*The live allocations are linked to find the leaks*/
+    struct _mem_prof_hdr_t * next;
+#if LV_MEM_PROFILER_CALLER
+    const void * caller;
+#endif
+    uint32_t size;                  /*The requested size*/
+    uint32_t seq;                   /*Sequence number of the allocation to compare with the snapshots*/
+    lv_mem_tag_t tag;
+} mem_prof_hdr_t;
+#endif
+
+#if LV_MEM_THREAD_SAFE
+/*Stored before every allocation if the heap is thread safe*/
+typedef struct {
+    size_t size;                    /*Size of the data. Exactly the size of a class for the small blocks.*/
+} mem_mt_hdr_t;
+
+/*The freed small blocks kept by a thread*/
+typedef struct {
+    void * head[MT_CLASS_CNT];      /*The blocks of a class linked through their first bytes*/
+    uint8_t cnt[MT_CLASS_CNT];
+    uint32_t gen;                   /*`mt_gen` when the blocks were cached*/
+} mem_mt_cache_t;
+#endif
+
 #ifdef LV_ARCH_64
     #define ALIGN_MASK 0x7
 #else
@@ -65,13 +142,117 @@ typedef struct {
 
 #define MEM_BUF_SMALL_SIZE 16
 
+#if LV_MEM_PROFILER
+    #if LV_ENABLE_GC
+        #error "LV_MEM_PROFILER can't be used with LV_ENABLE_GC"
+    #endif
+
+    #define PROF_TAG_STACK_SIZE 8
+
+    #if LV_MEM_PROFILER_CALLER && defined(__GNUC__)
+        #define PROF_CALLER()   __builtin_return_address(0)
+    #else
+        #define PROF_CALLER()   NULL
+    #endif
+#endif
+
+#if LV_MEM_PAUSE_HIST
+    #include LV_MEM_PAUSE_HIST_INCLUDE
+
+    /*Measure the time between them and add it to the histogram. Used once in a function.*/
+    #define PAUSE_START()   uint32_t pause_start = LV_MEM_PAUSE_HIST_TIME_EXPR
+    #define PAUSE_END()     pause_add(LV_MEM_PAUSE_HIST_TIME_EXPR - pause_start)
+#else
+    #define PAUSE_START()
+    #define PAUSE_END()
+#endif
+
+#if LV_MEM_ARENA_CNT && LV_ENABLE_GC
+    #error "LV_MEM_ARENA_CNT can't be used with LV_ENABLE_GC"
+#endif
+
+#if LV_MEM_BUF_ARENA || LV_MEM_ARENA_CNT
+    #define ARENA_ALIGN_MASK    (sizeof(void *) - 1)
+    #define ARENA_USED_BIT      0x1
+    #define ARENA_NONE          UINT32_MAX
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
-#if LV_MEM_CUSTOM == 0
+#if LV_MEM_PROFILER || LV_MEM_THREAD_SAFE
+    /*The allocator is wrapped by the thread caches and/or the profiler which add a header to every allocation*/
+    static void * mem_alloc(size_t size);
+    static void mem_free(const void * data);
+    static void * mem_realloc(void * data_p, size_t new_size);
+    #if LV_MEM_ADD_JUNK || !(LV_MEM_CUSTOM == 0 && LV_MEM_TLSF)
+        static uint32_t mem_get_size(const void * data);
+    #endif
+#else
+    #define mem_alloc       lv_mem_alloc
+    #define mem_free        lv_mem_free
+    #define mem_realloc     lv_mem_realloc
+    #define mem_get_size    _lv_mem_get_size
+#endif
+#if LV_MEM_THREAD_SAFE
+    #if LV_MEM_PROFILER
+        static void * mt_alloc(size_t size);
+        static void mt_free(const void * data);
+        static void * mt_realloc(void * data_p, size_t new_size);
+    #else
+        #define mt_alloc        lv_mem_alloc
+        #define mt_free         lv_mem_free
+        #define mt_realloc      lv_mem_realloc
+        #define mt_get_size     _lv_mem_get_size
+    #endif
+    static uint8_t mt_get_class(size_t size);
+    static inline void mt_cache_validate(void);
+    static void buf_free_released(void);
+#endif
+static void mem_defrag(void);
+static lv_res_t mem_test(void);
+static void * mem_buf_get(uint32_t size, bool assert_en);
+#if LV_MEM_PROFILER
+    #if LV_MEM_THREAD_SAFE
+        #define PROF_ALLOC      mt_alloc
+        #define PROF_FREE       mt_free
+        #define PROF_REALLOC    mt_realloc
+    #else
+        #define PROF_ALLOC      mem_alloc
+        #define PROF_FREE       mem_free
+        #define PROF_REALLOC    mem_realloc
+    #endif
+    static void * prof_alloc(size_t size, lv_mem_tag_t tag, const void * caller);
+    static void prof_free(const void * data);
+    static void * prof_realloc(void * data_p, size_t new_size, lv_mem_tag_t tag, const void * caller);
+    static void prof_link(mem_prof_hdr_t * hdr);
+    static void prof_unlink(mem_prof_hdr_t * hdr);
+    static lv_mem_tag_t prof_get_act_tag(void);
+#endif
+#if LV_MEM_BUF_ARENA || LV_MEM_ARENA_CNT
+    static void * arena_get(lv_mem_arena_t * arena, uint32_t size);
+    static bool arena_release(lv_mem_arena_t * arena, const void * p);
+    static inline bool arena_has(const lv_mem_arena_t * arena, const void * p);
+#endif
+#if LV_MEM_ARENA_CNT
+    static lv_mem_arena_t * arena_find(const void * p);
+#endif
+#if LV_MEM_SLAB
+    static void * slab_realloc(void * data_p, size_t new_size);
+#endif
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF == 0
     static lv_mem_ent_t * ent_get_next(lv_mem_ent_t * act_e);
     static void * ent_alloc(lv_mem_ent_t * e, size_t size);
     static void ent_trunc(lv_mem_ent_t * e, size_t size);
+    static uint32_t ent_join_next(lv_mem_ent_t * e, uint32_t max_cnt);
+    #if LV_MEM_DEFRAG_INCREMENTAL
+        static void ent_join_next_step(lv_mem_ent_t * e);
+        static bool defrag_step(uint32_t max_cnt);
+        static void defrag_task_cb(lv_task_t * task);
+    #endif
+#endif
+#if LV_MEM_PAUSE_HIST
+    static void pause_add(uint32_t t);
 #endif
 
 /**********************
@@ -83,8 +264,16 @@ typedef struct {
 
 static uint32_t zero_mem; /*Give the address of this variable if 0 byte should be allocated*/
 
-#if LV_MEM_CUSTOM == 0
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF == 0
     static uint32_t mem_max_size; /*Tracks the maximum total size of memory ever used from the internal heap*/
+    #if LV_MEM_DEFRAG_INCREMENTAL
+        static lv_mem_ent_t * defrag_cursor;    /*The next defrag. step continues from here. NULL: start a new round*/
+        static bool defrag_dirty;               /*A cell was freed since the last round of the defrag. started*/
+    #endif
+#endif
+
+#if LV_MEM_PAUSE_HIST
+    static lv_mem_pause_stat_t pause_stat;
 #endif
 
 static uint8_t mem_buf1_32[MEM_BUF_SMALL_SIZE];
@@ -94,6 +283,37 @@ static lv_mem_buf_t mem_buf_small[] = {{.p = mem_buf1_32, .size = MEM_BUF_SMALL_
     {.p = mem_buf2_32, .size = MEM_BUF_SMALL_SIZE, .used = 0}
 };
 
+#if LV_MEM_BUF_ARENA
+    static lv_uintptr_t buf_arena_mem[(LV_MEM_BUF_ARENA_SIZE + sizeof(lv_uintptr_t) - 1) / sizeof(lv_uintptr_t)];
+    static lv_mem_arena_t buf_arena = {
+        .buf = (uint8_t *)buf_arena_mem, .size = sizeof(buf_arena_mem), .last = ARENA_NONE
+    };
+#endif
+
+#if LV_MEM_ARENA_CNT
+    static lv_mem_arena_t * arenas[LV_MEM_ARENA_CNT];
+#endif
+
+#if LV_MEM_PROFILER
+    static mem_prof_hdr_t * prof_head;
+    static uint32_t prof_seq;
+    static lv_mem_prof_stat_t prof_stat[_LV_MEM_TAG_LAST];
+    static MEM_THREAD_LOCAL lv_mem_tag_t prof_tag_stack[PROF_TAG_STACK_SIZE];
+    static MEM_THREAD_LOCAL uint8_t prof_tag_depth;
+    static const char * const prof_tag_names[_LV_MEM_TAG_LAST] = {
+        "other", "obj", "style", "text", "img_cache", "font", "draw", "fs", "anim", "task", "user"
+    };
+#endif
+
+#if LV_MEM_THREAD_SAFE
+    #if LV_MEM_LOCK_CUSTOM == 0
+        static bool mem_lock_flag;
+    #endif
+    static MEM_THREAD_LOCAL mem_mt_cache_t mt_cache;
+    static uint32_t mt_gen;     /*Incremented when the heap is reinitialized to drop the blocks of every cache*/
+    static const uint8_t mt_class_size[MT_CLASS_CNT] = {16, 32, 64, 128};
+#endif
+
 /**********************
  *      MACROS
  **********************/
@@ -113,6 +333,10 @@ static lv_mem_buf_t mem_buf_small[] = {{.p = mem_buf1_32, .size = MEM_BUF_SMALL_
  */
 void _lv_mem_init(void)
 {
+#if LV_MEM_SLAB
+    _lv_slab_init();
+#endif
+
 #if LV_MEM_CUSTOM == 0
 
 #if LV_MEM_ADR == 0
@@ -123,25 +347,82 @@ void _lv_mem_init(void)
     work_mem = (uint8_t *)LV_MEM_ADR;
 #endif
 
+#if LV_MEM_TLSF
+    _lv_tlsf_init();
+    _lv_tlsf_add_pool(work_mem, LV_MEM_SIZE);
+#else
     lv_mem_ent_t * full = (lv_mem_ent_t *)work_mem;
     full->header.s.used = 0;
     /*The total mem size reduced by the first header and the close patterns */
     full->header.s.d_size = LV_MEM_SIZE - sizeof(lv_mem_header_t);
 #endif
+#endif
+}
+
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF
+/**
+ * Add a memory area to `lv_mem_alloc` beside the `LV_MEM_SIZE` sized work memory.
+ * The pools can't be removed. `_lv_mem_deinit()` drops all of them.
+ * @param mem pointer to a memory area. It must be kept valid while used by `lv_mem`.
+ * @param bytes size of the memory area in bytes
+ * @return LV_RES_OK: the pool is added; LV_RES_INV: the memory area is too small
+ */
+lv_res_t lv_mem_add_pool(void * mem, size_t bytes)
+{
+    MEM_LOCK();
+    bool added = _lv_tlsf_add_pool(mem, bytes);
+    MEM_UNLOCK();
+    return added ? LV_RES_OK : LV_RES_INV;
 }
+#endif
 
 /**
  * Clean up the memory buffer which frees all the allocated memories.
+ * With `LV_MEM_THREAD_SAFE` the blocks cached by the threads are dropped too.
+ * The other threads shouldn't use `lv_mem` while it runs.
  * @note It work only if `LV_MEM_CUSTOM == 0`
  */
 void _lv_mem_deinit(void)
 {
-#if LV_MEM_CUSTOM == 0
+    MEM_LOCK();
+
+#if LV_MEM_THREAD_SAFE
+    /*The other threads drop their cached blocks when they use `lv_mem` next time*/
+    MT_GEN_SET(mt_gen + 1);
+    _lv_memset_00(&mt_cache, sizeof(mt_cache));
+    mt_cache.gen = mt_gen;
+#endif
+
+#if LV_MEM_SLAB
+    _lv_slab_init();
+#endif
+
+#if LV_MEM_ARENA_CNT
+    _lv_memset_00(arenas, sizeof(arenas));
+#endif
+
+#if LV_MEM_PROFILER
+    /*All the allocations are dropped*/
+    prof_head = NULL;
+    prof_tag_depth = 0;
+    _lv_memset_00(prof_stat, sizeof(prof_stat));
+#endif
+
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF
+    _lv_tlsf_init();
+    _lv_tlsf_add_pool(work_mem, LV_MEM_SIZE);
+#elif LV_MEM_CUSTOM == 0
     lv_mem_ent_t * full = (lv_mem_ent_t *)work_mem;
     full->header.s.used = 0;
     /*The total mem size reduced by the first header and the close patterns */
     full->header.s.d_size = LV_MEM_SIZE - sizeof(lv_mem_header_t);
+#if LV_MEM_DEFRAG_INCREMENTAL
+    defrag_cursor = NULL;
+    defrag_dirty = false;
 #endif
+#endif
+
+    MEM_UNLOCK();
 }
 
 /**
@@ -149,7 +430,7 @@ void _lv_mem_deinit(void)
  * @param size size of the memory to allocate in bytes
  * @return pointer to the allocated memory
  */
-void * lv_mem_alloc(size_t size)
+void * mem_alloc(size_t size)
 {
     if(size == 0) {
         return &zero_mem;
@@ -159,7 +440,24 @@ void * lv_mem_alloc(size_t size)
     size = (size + ALIGN_MASK) & (~ALIGN_MASK);
     void * alloc = NULL;
 
-#if LV_MEM_CUSTOM == 0
+    PAUSE_START();
+
+#if LV_MEM_SLAB
+    /*Serve the small allocations from the fixed size pools to keep the heap unfragmented*/
+    alloc = _lv_slab_alloc(size);
+    if(alloc != NULL) {
+#if LV_MEM_ADD_JUNK
+        _lv_memset(alloc, 0xaa, size);
+#endif
+        PAUSE_END();
+        return alloc;
+    }
+#endif
+
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF
+    /*Find a large enough block in constant time*/
+    alloc = _lv_tlsf_malloc(size);
+#elif LV_MEM_CUSTOM == 0
     /*Use the built-in allocators*/
     lv_mem_ent_t * e = NULL;
 
@@ -170,11 +468,27 @@ void * lv_mem_alloc(size_t size)
 
         /*If there is next entry then try to allocate there*/
         if(e != NULL) {
+#if LV_MEM_DEFRAG_INCREMENTAL
+            /*Join the free entries on the way. It's not more work than passing them one by one.*/
+            if(e->header.s.used == 0) ent_join_next_step(e);
+#endif
             alloc = ent_alloc(e, size);
         }
         /* End if there is not next entry OR the alloc. is successful*/
     } while(e != NULL && alloc == NULL);
 
+#if LV_MEM_DEFRAG_INCREMENTAL
+    /* Some free entries might be not joined yet because the joins are limited.
+     * Defrag. the whole memory and search again instead of failing.*/
+    if(alloc == NULL && (defrag_dirty || defrag_cursor != NULL)) {
+        mem_defrag();
+        do {
+            e = ent_get_next(e);
+            if(e != NULL) alloc = ent_alloc(e, size);
+        } while(e != NULL && alloc == NULL);
+    }
+#endif
+
 #else
     /*Use custom, user defined malloc function*/
 #if LV_ENABLE_GC == 1 /*gc must not include header*/
@@ -195,11 +509,13 @@ void * lv_mem_alloc(size_t size)
     if(alloc != NULL) _lv_memset(alloc, 0xaa, size);
 #endif
 
+    PAUSE_END();
+
     if(alloc == NULL) {
         LV_LOG_WARN("Couldn't allocate memory");
     }
     else {
-#if LV_MEM_CUSTOM == 0
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF == 0
         /* just a safety check, should always be true */
         if((uintptr_t) alloc > (uintptr_t) work_mem) {
             if((((uintptr_t) alloc - (uintptr_t) work_mem) + size) > mem_max_size) {
@@ -216,15 +532,29 @@ void * lv_mem_alloc(size_t size)
  * Free an allocated data
  * @param data pointer to an allocated memory
  */
-void lv_mem_free(const void * data)
+void mem_free(const void * data)
 {
     if(data == &zero_mem) return;
     if(data == NULL) return;
 
+    PAUSE_START();
+
 #if LV_MEM_ADD_JUNK
-    _lv_memset((void *)data, 0xbb, _lv_mem_get_size(data));
+    _lv_memset((void *)data, 0xbb, mem_get_size(data));
+#endif
+
+#if LV_MEM_SLAB
+    if(_lv_slab_is_slab(data)) {
+        _lv_slab_free((void *)data);
+        PAUSE_END();
+        return;
+    }
 #endif
 
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF
+    /*The adjacent free blocks are joined immediately*/
+    _lv_tlsf_free((void *)data);
+#else
 #if LV_ENABLE_GC == 0
     /*e points to the header*/
     lv_mem_ent_t * e = (lv_mem_ent_t *)((uint8_t *)data - sizeof(lv_mem_header_t));
@@ -232,27 +562,22 @@ void lv_mem_free(const void * data)
 #endif
 
 #if LV_MEM_CUSTOM == 0
-#if LV_MEM_AUTO_DEFRAG
+#if LV_MEM_DEFRAG_INCREMENTAL
+    /* Join some of the following free entries now.
+     * The others and the preceding free entries are joined on allocation or by the defrag. task*/
+    ent_join_next_step(e);
+    defrag_dirty = true;
+#elif LV_MEM_AUTO_DEFRAG
     static uint16_t full_defrag_cnt = 0;
     full_defrag_cnt++;
     if(full_defrag_cnt < LV_MEM_FULL_DEFRAG_CNT) {
         /* Make a simple defrag.
          * Join the following free entries after this*/
-        lv_mem_ent_t * e_next;
-        e_next = ent_get_next(e);
-        while(e_next != NULL) {
-            if(e_next->header.s.used == 0) {
-                e->header.s.d_size += e_next->header.s.d_size + sizeof(e->header);
-            }
-            else {
-                break;
-            }
-            e_next = ent_get_next(e_next);
-        }
+        ent_join_next(e, UINT32_MAX);
     }
     else {
         full_defrag_cnt = 0;
-        lv_mem_defrag();
+        mem_defrag();
 
     }
 #endif /*LV_MEM_AUTO_DEFRAG*/
@@ -263,6 +588,9 @@ void lv_mem_free(const void * data)
     LV_MEM_CUSTOM_FREE((void *)data);
 #endif /*LV_ENABLE_GC*/
 #endif
+#endif /*LV_MEM_TLSF*/
+
+    PAUSE_END();
 }
 
 /**
@@ -273,13 +601,48 @@ void lv_mem_free(const void * data)
  * @return pointer to the new memory
  */
 
-#if LV_ENABLE_GC == 0
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF
 
-void * lv_mem_realloc(void * data_p, size_t new_size)
+void * mem_realloc(void * data_p, size_t new_size)
+{
+    if(data_p == &zero_mem) data_p = NULL;
+
+#if LV_MEM_SLAB
+    if(_lv_slab_is_slab(data_p)) return slab_realloc(data_p, new_size);
+#endif
+
+    /*data_p could be previously freed pointer (in this case it is invalid)*/
+    if(data_p != NULL && _lv_tlsf_is_free(data_p)) data_p = NULL;
+
+    if(new_size == 0) {
+        mem_free(data_p);
+        return &zero_mem;
+    }
+
+    /*Let `lv_mem_alloc` choose from where to allocate*/
+    if(data_p == NULL) return mem_alloc(new_size);
+
+    /*Grow or shrink in place if possible*/
+    PAUSE_START();
+    void * new_p = _lv_tlsf_realloc(data_p, new_size);
+    PAUSE_END();
+    if(new_p == NULL) {
+        LV_LOG_WARN("Couldn't allocate memory");
+    }
+    return new_p;
+}
+
+#elif LV_ENABLE_GC == 0
+
+void * mem_realloc(void * data_p, size_t new_size)
 {
     /*Round the size up to ALIGN_MASK*/
     new_size = (new_size + ALIGN_MASK) & (~ALIGN_MASK);
 
+#if LV_MEM_SLAB
+    if(_lv_slab_is_slab(data_p)) return slab_realloc(data_p, new_size);
+#endif
+
     /*data_p could be previously freed pointer (in this case it is invalid)*/
     if(data_p != NULL) {
         lv_mem_ent_t * e = (lv_mem_ent_t *)((uint8_t *)data_p - sizeof(lv_mem_header_t));
@@ -288,7 +651,7 @@ void * lv_mem_realloc(void * data_p, size_t new_size)
         }
     }
 
-    uint32_t old_size = _lv_mem_get_size(data_p);
+    uint32_t old_size = mem_get_size(data_p);
     if(old_size == new_size) return data_p; /*Also avoid reallocating the same memory*/
 
 #if LV_MEM_CUSTOM == 0
@@ -301,7 +664,7 @@ void * lv_mem_realloc(void * data_p, size_t new_size)
 #endif
 
     void * new_p;
-    new_p = lv_mem_alloc(new_size);
+    new_p = mem_alloc(new_size);
     if(new_p == NULL) {
         LV_LOG_WARN("Couldn't allocate memory");
         return NULL;
@@ -312,7 +675,7 @@ void * lv_mem_realloc(void * data_p, size_t new_size)
         if(old_size != 0 && new_size != 0) {
             _lv_memcpy(new_p, data_p, LV_MATH_MIN(new_size, old_size));
         }
-        lv_mem_free(data_p);
+        mem_free(data_p);
     }
 
     return new_p;
@@ -320,7 +683,7 @@ void * lv_mem_realloc(void * data_p, size_t new_size)
 
 #else /* LV_ENABLE_GC */
 
-void * lv_mem_realloc(void * data_p, size_t new_size)
+void * mem_realloc(void * data_p, size_t new_size)
 {
     void * new_p = LV_MEM_CUSTOM_REALLOC(data_p, new_size);
     if(new_p == NULL) LV_LOG_WARN("Couldn't allocate memory");
@@ -334,62 +697,76 @@ void * lv_mem_realloc(void * data_p, size_t new_size)
  */
 void lv_mem_defrag(void)
 {
-#if LV_MEM_CUSTOM == 0
-    lv_mem_ent_t * e_free;
-    lv_mem_ent_t * e_next;
-    e_free = ent_get_next(NULL);
-
-    while(1) {
-        /*Search the next free entry*/
-        while(e_free != NULL) {
-            if(e_free->header.s.used != 0) {
-                e_free = ent_get_next(e_free);
-            }
-            else {
-                break;
-            }
-        }
-
-        if(e_free == NULL) return;
+    MEM_LOCK();
+    PAUSE_START();
+    mem_defrag();
+    PAUSE_END();
+    MEM_UNLOCK();
+}
 
-        /*Joint the following free entries to the free*/
-        e_next = ent_get_next(e_free);
-        while(e_next != NULL) {
-            if(e_next->header.s.used == 0) {
-                e_free->header.s.d_size += e_next->header.s.d_size + sizeof(e_next->header);
-            }
-            else {
-                break;
-            }
+#if LV_MEM_CUSTOM == 0 && LV_MEM_DEFRAG_INCREMENTAL
+/**
+ * Create the `lv_task` which defrags the memory in small steps
+ */
+void _lv_mem_defrag_task_init(void)
+{
+    /*Nothing to do with TLSF and the custom allocators*/
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF == 0
+    lv_task_create(defrag_task_cb, LV_MEM_DEFRAG_PERIOD, LV_TASK_PRIO_LOWEST, NULL);
+#endif
+}
 
-            e_next = ent_get_next(e_next);
-        }
+/**
+ * Join the free memory blocks in a part of the memory and continue from there in the next call.
+ * Called periodically by an `lv_task` but can be called when the application is idle too.
+ * @param max_cnt check at most this many blocks to keep the pause short
+ * @return true: all the free blocks are joined; false: there are more blocks to check
+ */
+bool lv_mem_defrag_step(uint32_t max_cnt)
+{
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF == 0
+    MEM_LOCK();
+    PAUSE_START();
+    bool done = defrag_step(max_cnt);
+    PAUSE_END();
+    MEM_UNLOCK();
+    return done;
+#else
+    LV_UNUSED(max_cnt);
+    return true;
+#endif
+}
+#endif
 
-        if(e_next == NULL) return;
+#if LV_MEM_PAUSE_HIST
+/**
+ * Get the histogram of the durations of the memory manager calls
+ * @param stat store the result here
+ */
+void lv_mem_pause_get_stat(lv_mem_pause_stat_t * stat)
+{
+    MEM_LOCK();
+    *stat = pause_stat;
+    MEM_UNLOCK();
+}
 
-        /*Continue from the lastly checked entry*/
-        e_free = e_next;
-    }
-#endif
+/**
+ * Clear the histogram of the durations of the memory manager calls
+ */
+void lv_mem_pause_reset_stat(void)
+{
+    MEM_LOCK();
+    _lv_memset_00(&pause_stat, sizeof(pause_stat));
+    MEM_UNLOCK();
 }
+#endif
 
 lv_res_t lv_mem_test(void)
 {
-#if LV_MEM_CUSTOM == 0
-    lv_mem_ent_t * e;
-    e = ent_get_next(NULL);
-    while(e) {
-        if(e->header.s.d_size > LV_MEM_SIZE) {
-            return LV_RES_INV;
-        }
-        uint8_t * e8 = (uint8_t *) e;
-        if(e8 + e->header.s.d_size > work_mem + LV_MEM_SIZE) {
-            return LV_RES_INV;
-        }
-        e = ent_get_next(e);
-    }
-#endif
-    return LV_RES_OK;
+    MEM_LOCK();
+    lv_res_t res = mem_test();
+    MEM_UNLOCK();
+    return res;
 }
 
 /**
@@ -401,7 +778,17 @@ void lv_mem_monitor(lv_mem_monitor_t * mon_p)
 {
     /*Init the data*/
     _lv_memset(mon_p, 0, sizeof(lv_mem_monitor_t));
-#if LV_MEM_CUSTOM == 0
+    MEM_LOCK();
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF
+    lv_tlsf_stat_t stat;
+    _lv_tlsf_get_stat(&stat);
+    mon_p->total_size = stat.total_size;
+    mon_p->free_cnt = stat.free_cnt;
+    mon_p->free_size = stat.free_size;
+    mon_p->free_biggest_size = stat.free_biggest_size;
+    mon_p->used_cnt = stat.used_cnt;
+    mon_p->max_used = stat.max_used;
+#elif LV_MEM_CUSTOM == 0
     lv_mem_ent_t * e;
 
     e = ent_get_next(NULL);
@@ -422,6 +809,9 @@ void lv_mem_monitor(lv_mem_monitor_t * mon_p)
     }
     mon_p->total_size = LV_MEM_SIZE;
     mon_p->max_used = mem_max_size;
+#endif
+    MEM_UNLOCK();
+#if LV_MEM_CUSTOM == 0
     mon_p->used_pct = 100 - (100U * mon_p->free_size) / mon_p->total_size;
     if(mon_p->free_size > 0) {
         mon_p->frag_pct = mon_p->free_biggest_size * 100U / mon_p->free_size;
@@ -439,12 +829,29 @@ void lv_mem_monitor(lv_mem_monitor_t * mon_p)
  * @return the size of data memory in bytes
  */
 
-#if LV_ENABLE_GC == 0
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF
 
-uint32_t _lv_mem_get_size(const void * data)
+/*With the headers of the profiler or the thread caches only the junk filling needs the size of the raw blocks*/
+#if (LV_MEM_PROFILER == 0 && LV_MEM_THREAD_SAFE == 0) || LV_MEM_ADD_JUNK
+uint32_t mem_get_size(const void * data)
+{
+    if(data == &zero_mem) return 0;
+#if LV_MEM_SLAB
+    if(_lv_slab_is_slab(data)) return _lv_slab_block_size(data);
+#endif
+    return (uint32_t)_lv_tlsf_block_size(data);
+}
+#endif
+
+#elif LV_ENABLE_GC == 0
+
+uint32_t mem_get_size(const void * data)
 {
     if(data == NULL) return 0;
     if(data == &zero_mem) return 0;
+#if LV_MEM_SLAB
+    if(_lv_slab_is_slab(data)) return _lv_slab_block_size(data);
+#endif
 
     lv_mem_ent_t * e = (lv_mem_ent_t *)((uint8_t *)data - sizeof(lv_mem_header_t));
 
@@ -453,311 +860,1303 @@ uint32_t _lv_mem_get_size(const void * data)
 
 #else /* LV_ENABLE_GC */
 
-uint32_t _lv_mem_get_size(const void * data)
+uint32_t mem_get_size(const void * data)
 {
     return LV_MEM_CUSTOM_GET_SIZE(data);
 }
 
 #endif /*LV_ENABLE_GC*/
 
+#if LV_MEM_THREAD_SAFE
 /**
- * Get a temporal buffer with the given size.
- * @param size the required size
+ * Allocate a memory dynamically. The small blocks are taken from the calling thread's cache if possible.
+ * @param size size of the memory to allocate in bytes
+ * @return pointer to the allocated memory
  */
-void * _lv_mem_buf_get(uint32_t size)
+void * mt_alloc(size_t size)
 {
-    if(size == 0) return NULL;
-
-    /*Try small static buffers first*/
-    uint8_t i;
-    if(size <= MEM_BUF_SMALL_SIZE) {
-        for(i = 0; i < sizeof(mem_buf_small) / sizeof(mem_buf_small[0]); i++) {
-            if(mem_buf_small[i].used == 0) {
-                mem_buf_small[i].used = 1;
-                return mem_buf_small[i].p;
-            }
-        }
-    }
-
-    /*Try to find a free buffer with suitable size */
-    int8_t i_guess = -1;
-    for(i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
-        if(LV_GC_ROOT(_lv_mem_buf[i]).used == 0 && LV_GC_ROOT(_lv_mem_buf[i]).size >= size) {
-            if(LV_GC_ROOT(_lv_mem_buf[i]).size == size) {
-                LV_GC_ROOT(_lv_mem_buf[i]).used = 1;
-                return LV_GC_ROOT(_lv_mem_buf[i]).p;
-            }
-            else if(i_guess < 0) {
-                i_guess = i;
-            }
-            /*If size of `i` is closer to `size` prefer it*/
-            else if(LV_GC_ROOT(_lv_mem_buf[i]).size < LV_GC_ROOT(_lv_mem_buf[i_guess]).size) {
-                i_guess = i;
-            }
+    if(size == 0) return &zero_mem;
+
+    mt_cache_validate();
+
+    mem_mt_hdr_t * hdr;
+    uint8_t cls = mt_get_class(size);
+    if(cls != MT_CLASS_NONE) {
+        size = mt_class_size[cls];
+        hdr = mt_cache.head[cls];
+        if(hdr) {
+            mt_cache.head[cls] = *((void **)(hdr + 1));
+            mt_cache.cnt[cls]--;
+#if LV_MEM_ADD_JUNK
+            _lv_memset(hdr + 1, 0xaa, size);
+#endif
+            return hdr + 1;
         }
     }
-
-    if(i_guess >= 0) {
-        LV_GC_ROOT(_lv_mem_buf[i_guess]).used = 1;
-        return LV_GC_ROOT(_lv_mem_buf[i_guess]).p;
+    else {
+        /*Round the size up to ALIGN_MASK*/
+        size = (size + ALIGN_MASK) & (~ALIGN_MASK);
     }
 
-    /*Reallocate a free buffer*/
-    for(i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
-        if(LV_GC_ROOT(_lv_mem_buf[i]).used == 0) {
-            /*if this fails you probably need to increase your LV_MEM_SIZE/heap size*/
-            void * buf = lv_mem_realloc(LV_GC_ROOT(_lv_mem_buf[i]).p, size);
-            if(buf == NULL) {
-                LV_DEBUG_ASSERT(false, "Out of memory, can't allocate a new buffer (increase your LV_MEM_SIZE/heap size)", 0x00);
-                return NULL;
-            }
-            LV_GC_ROOT(_lv_mem_buf[i]).used = 1;
-            LV_GC_ROOT(_lv_mem_buf[i]).size = size;
-            LV_GC_ROOT(_lv_mem_buf[i]).p    = buf;
-            return LV_GC_ROOT(_lv_mem_buf[i]).p;
-        }
-    }
+    MEM_LOCK();
+    hdr = mem_alloc(size + sizeof(mem_mt_hdr_t));
+    MEM_UNLOCK();
+    if(hdr == NULL) return NULL;
 
-    LV_DEBUG_ASSERT(false, "No free buffer. Increase LV_MEM_BUF_MAX_NUM.", 0x00);
-    return NULL;
+    hdr->size = size;
+    return hdr + 1;
 }
 
 /**
- * Release a memory buffer
- * @param p buffer to release
+ * Free an allocated data. The small blocks are kept in the calling thread's cache if it's not full.
+ * @param data pointer to an allocated memory
  */
-void _lv_mem_buf_release(void * p)
+void mt_free(const void * data)
 {
-    uint8_t i;
-
-    /*Try small static buffers first*/
-    for(i = 0; i < sizeof(mem_buf_small) / sizeof(mem_buf_small[0]); i++) {
-        if(mem_buf_small[i].p == p) {
-            mem_buf_small[i].used = 0;
-            return;
-        }
-    }
+    if(data == NULL || data == &zero_mem) return;
 
-    for(i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
-        if(LV_GC_ROOT(_lv_mem_buf[i]).p == p) {
-            LV_GC_ROOT(_lv_mem_buf[i]).used = 0;
-            return;
-        }
+    mem_mt_hdr_t * hdr = (mem_mt_hdr_t *)data - 1;
+#if LV_MEM_THREAD_CACHE_CNT > 0
+    mt_cache_validate();
+    uint8_t cls = mt_get_class(hdr->size);
+    if(cls != MT_CLASS_NONE && mt_cache.cnt[cls] < LV_MEM_THREAD_CACHE_CNT) {
+#if LV_MEM_ADD_JUNK
+        _lv_memset(hdr + 1, 0xbb, hdr->size);
+#endif
+        *((void **)(hdr + 1)) = mt_cache.head[cls];
+        mt_cache.head[cls] = hdr;
+        mt_cache.cnt[cls]++;
+        return;
     }
+#endif
 
-    LV_LOG_ERROR("lv_mem_buf_release: p is not a known buffer")
+    MEM_LOCK();
+    mem_free(hdr);
+    MEM_UNLOCK();
 }
 
 /**
- * Free all memory buffers
- */
+ * Reallocate a memory with a new size. The old content will be kept.
+ * @param data_p pointer to an allocated memory.
+ * Its content will be copied to the new memory block and freed
+ * @param new_size the desired new size in byte
+ * @return pointer to the new memory
+ */
+void * mt_realloc(void * data_p, size_t new_size)
+{
+    if(data_p == NULL || data_p == &zero_mem) return mt_alloc(new_size);
+
+    if(new_size == 0) {
+        mt_free(data_p);
+        return &zero_mem;
+    }
+
+    mem_mt_hdr_t * hdr = (mem_mt_hdr_t *)data_p - 1;
+    uint8_t cls = mt_get_class(hdr->size);
+    uint8_t new_cls = mt_get_class(new_size);
+
+    /*The large blocks are resized by the allocator, possibly in place*/
+    if(cls == MT_CLASS_NONE && new_cls == MT_CLASS_NONE) {
+        new_size = (new_size + ALIGN_MASK) & (~ALIGN_MASK);
+        MEM_LOCK();
+        mem_mt_hdr_t * new_hdr = mem_realloc(hdr, new_size + sizeof(mem_mt_hdr_t));
+        MEM_UNLOCK();
+        if(new_hdr == NULL) return NULL;
+
+        new_hdr->size = new_size;
+        return new_hdr + 1;
+    }
+
+    /*The small blocks stay in their class or are moved to keep the blocks of the caches equal sized*/
+    if(cls == new_cls) return data_p;
+
+    void * new_p = mt_alloc(new_size);
+    if(new_p == NULL) return NULL;
+
+    _lv_memcpy(new_p, data_p, LV_MATH_MIN(new_size, hdr->size));
+    mt_free(data_p);
+    return new_p;
+}
+
+#if LV_MEM_PROFILER == 0
+/**
+ * Give the size of an allocated memory
+ * @param data pointer to an allocated memory
+ * @return the size of data memory in bytes
+ */
+uint32_t mt_get_size(const void * data)
+{
+    if(data == NULL || data == &zero_mem) return 0;
+    return ((const mem_mt_hdr_t *)data - 1)->size;
+}
+#endif
+
+/**
+ * Give back the freed blocks cached by the calling thread to the heap.
+ * Call it before a thread which used `lv_mem` exits.
+ */
+void lv_mem_thread_flush(void)
+{
+    mt_cache_validate();
+
+    uint8_t cls;
+    MEM_LOCK();
+    for(cls = 0; cls < MT_CLASS_CNT; cls++) {
+        while(mt_cache.head[cls]) {
+            mem_mt_hdr_t * hdr = mt_cache.head[cls];
+            mt_cache.head[cls] = *((void **)(hdr + 1));
+            mem_free(hdr);
+        }
+        mt_cache.cnt[cls] = 0;
+    }
+    MEM_UNLOCK();
+}
+#endif
+
+#if LV_MEM_PROFILER
+/**
+ * Allocate a memory dynamically and account it to the owner set by `_lv_mem_tag_push()`
+ * @param size size of the memory to allocate in bytes
+ * @return pointer to the allocated memory
+ */
+void * lv_mem_alloc(size_t size)
+{
+    return prof_alloc(size, prof_get_act_tag(), PROF_CALLER());
+}
+
+/**
+ * Allocate a memory and account it to an owner in the memory profiler
+ * @param size size of the memory to allocate in bytes
+ * @param tag the owner of the memory, `LV_MEM_TAG_...`
+ * @return pointer to the allocated memory
+ */
+void * lv_mem_alloc_tag(size_t size, lv_mem_tag_t tag)
+{
+    return prof_alloc(size, tag, PROF_CALLER());
+}
+
+/**
+ * Free an allocated data
+ * @param data pointer to an allocated memory
+ */
+void lv_mem_free(const void * data)
+{
+    prof_free(data);
+}
+
+/**
+ * Reallocate a memory with a new size. The old content will be kept.
+ * A new allocation is accounted to the owner set by `_lv_mem_tag_push()`.
+ * @param data_p pointer to an allocated memory.
+ * Its content will be copied to the new memory block and freed
+ * @param new_size the desired new size in byte
+ * @return pointer to the new memory
+ */
+void * lv_mem_realloc(void * data_p, size_t new_size)
+{
+    return prof_realloc(data_p, new_size, prof_get_act_tag(), PROF_CALLER());
+}
+
+/**
+ * Reallocate a memory and account it to an owner in the memory profiler if it's a new allocation.
+ * @param data_p pointer to an allocated memory or NULL
+ * @param new_size the desired new size in byte
+ * @param tag the owner of the memory, `LV_MEM_TAG_...`
+ * @return pointer to the new memory
+ */
+void * lv_mem_realloc_tag(void * data_p, size_t new_size, lv_mem_tag_t tag)
+{
+    return prof_realloc(data_p, new_size, tag, PROF_CALLER());
+}
+
+/**
+ * Give the requested size of an allocated memory
+ * @param data pointer to an allocated memory
+ * @return the size of data memory in bytes
+ */
+uint32_t _lv_mem_get_size(const void * data)
+{
+    if(data == NULL || data == &zero_mem) return 0;
+    return ((const mem_prof_hdr_t *)data - 1)->size;
+}
+
+/**
+ * Account the not tagged allocations to an owner until `_lv_mem_tag_pop()`.
+ * Used when the allocation is indirect, e.g. a new node of a linked list.
+ * @param tag the owner of the memory, `LV_MEM_TAG_...`
+ */
+void _lv_mem_tag_push(lv_mem_tag_t tag)
+{
+    /*Count the depth even if the stack is full to pop correctly*/
+    if(prof_tag_depth < PROF_TAG_STACK_SIZE) prof_tag_stack[prof_tag_depth] = tag;
+    if(prof_tag_depth < UINT8_MAX) prof_tag_depth++;
+}
+
+/**
+ * Restore the owner of the not tagged allocations which was active before the last `_lv_mem_tag_push()`
+ */
+void _lv_mem_tag_pop(void)
+{
+    if(prof_tag_depth > 0) prof_tag_depth--;
+}
+
+/**
+ * Get the memory usage of an owner
+ * @param tag the owner, `LV_MEM_TAG_...`
+ * @param stat store the result here
+ */
+void lv_mem_prof_get_stat(lv_mem_tag_t tag, lv_mem_prof_stat_t * stat)
+{
+    if(tag >= _LV_MEM_TAG_LAST) {
+        _lv_memset_00(stat, sizeof(lv_mem_prof_stat_t));
+        return;
+    }
+
+    MEM_LOCK();
+    *stat = prof_stat[tag];
+    MEM_UNLOCK();
+}
+
+/**
+ * Get the name of an owner
+ * @param tag the owner, `LV_MEM_TAG_...`
+ * @return name of the owner, e.g. "style"
+ */
+const char * lv_mem_prof_get_tag_name(lv_mem_tag_t tag)
+{
+    if(tag >= _LV_MEM_TAG_LAST) return "";
+    return prof_tag_names[tag];
+}
+
+/**
+ * Save the current state of the profiler
+ * @param snap store the state here
+ */
+void lv_mem_prof_take_snapshot(lv_mem_prof_snapshot_t * snap)
+{
+    MEM_LOCK();
+    snap->seq = prof_seq;
+    _lv_memcpy(snap->tags, prof_stat, sizeof(prof_stat));
+    MEM_UNLOCK();
+}
+
+/**
+ * Find the allocations which were made between two snapshots and are still not freed.
+ * @param from the earlier snapshot
+ * @param to the later snapshot or NULL to check until now
+ * @param leak_cb called with every leaked allocation. Can be NULL.
+ * @return number of leaked allocations
+ */
+uint32_t lv_mem_prof_get_leaks(const lv_mem_prof_snapshot_t * from, const lv_mem_prof_snapshot_t * to,
+                               lv_mem_prof_leak_cb_t leak_cb)
+{
+    MEM_LOCK();
+    uint32_t seq_end = to ? to->seq : prof_seq;
+    uint32_t cnt = 0;
+    mem_prof_hdr_t * hdr;
+    for(hdr = prof_head; hdr != NULL; hdr = hdr->next) {
+        if(hdr->seq < from->seq || hdr->seq >= seq_end) continue;
+
+        cnt++;
+        if(leak_cb) {
+            lv_mem_prof_block_t block;
+            block.p = hdr + 1;
+            block.size = hdr->size;
+            block.tag = hdr->tag;
+#if LV_MEM_PROFILER_CALLER
+            block.caller = hdr->caller;
+#else
+            block.caller = NULL;
+#endif
+            leak_cb(&block);
+        }
+    }
+    MEM_UNLOCK();
+
+    return cnt;
+}
+
+/**
+ * Log the memory usage and the high-water mark of every owner with `LV_LOG_USER`.
+ * Use `lv_obj_mem_prof_dump()` to see the memory usage per object type.
+ */
+void lv_mem_prof_dump(void)
+{
+    lv_mem_prof_snapshot_t snap;
+    lv_mem_prof_take_snapshot(&snap);
+
+    lv_mem_tag_t tag;
+    for(tag = 0; tag < _LV_MEM_TAG_LAST; tag++) {
+        LV_LOG_USER("%s: %d bytes in %d blocks, max. %d bytes", prof_tag_names[tag], snap.tags[tag].size,
+                    snap.tags[tag].cnt, snap.tags[tag].max_size);
+    }
+}
+#endif
+
+/**
+ * Get a temporal buffer with the given size.
+ * @param size the required size
+ */
+void * _lv_mem_buf_get(uint32_t size)
+{
+    return mem_buf_get(size, true);
+}
+
+/**
+ * Get a temporal buffer with the given size but don't assert if there is no free buffer or memory.
+ * Useful for optional buffers when the caller can work without the buffer too.
+ * @param size the required size
+ * @return the buffer or NULL if it couldn't be allocated
+ */
+void * _lv_mem_buf_try_get(uint32_t size)
+{
+    return mem_buf_get(size, false);
+}
+
+/**
+ * Release a memory buffer
+ * @param p buffer to release
+ */
+void _lv_mem_buf_release(void * p)
+{
+    MEM_LOCK();
+
+#if LV_MEM_BUF_ARENA
+    if(arena_release(&buf_arena, p)) {
+        MEM_UNLOCK();
+        return;
+    }
+#endif
+
+    uint8_t i;
+
+    /*Try small static buffers first*/
+    for(i = 0; i < sizeof(mem_buf_small) / sizeof(mem_buf_small[0]); i++) {
+        if(mem_buf_small[i].p == p) {
+            mem_buf_small[i].used = 0;
+            MEM_UNLOCK();
+            return;
+        }
+    }
+
+    for(i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
+        if(LV_GC_ROOT(_lv_mem_buf[i]).p == p) {
+            LV_GC_ROOT(_lv_mem_buf[i]).used = 0;
+            MEM_UNLOCK();
+            return;
+        }
+    }
+
+    MEM_UNLOCK();
+
+    LV_LOG_ERROR("lv_mem_buf_release: p is not a known buffer")
+}
+
+/**
+ * Free all memory buffers
+ */
 void _lv_mem_buf_free_all(void)
 {
-    uint8_t i;
-    for(i = 0; i < sizeof(mem_buf_small) / sizeof(mem_buf_small[0]); i++) {
-        mem_buf_small[i].used = 0;
+#if LV_MEM_THREAD_SAFE
+    /*Other threads might use their buffers now*/
+    buf_free_released();
+#else
+#if LV_MEM_BUF_ARENA
+    /*Drop every buffer of the arena at once*/
+    buf_arena.top = 0;
+    buf_arena.last = ARENA_NONE;
+#endif
+
+    uint8_t i;
+    for(i = 0; i < sizeof(mem_buf_small) / sizeof(mem_buf_small[0]); i++) {
+        mem_buf_small[i].used = 0;
+    }
+
+    for(i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
+        if(LV_GC_ROOT(_lv_mem_buf[i]).p) {
+            lv_mem_free(LV_GC_ROOT(_lv_mem_buf[i]).p);
+            LV_GC_ROOT(_lv_mem_buf[i]).p = NULL;
+            LV_GC_ROOT(_lv_mem_buf[i]).used = 0;
+            LV_GC_ROOT(_lv_mem_buf[i]).size = 0;
+        }
+    }
+#endif
+}
+
+#if LV_MEM_BUF_ARENA
+/**
+ * Get the usage of the arena of the temporary buffers
+ * @param stat store the result here
+ */
+void lv_mem_buf_get_stat(lv_mem_buf_stat_t * stat)
+{
+    MEM_LOCK();
+    stat->size = buf_arena.size;
+    stat->used = buf_arena.top;
+    stat->max_used = buf_arena.max_used;
+    stat->fallback_cnt = buf_arena.fallback_cnt;
+    MEM_UNLOCK();
+}
+
+/**
+ * Reset the high-water mark and the fallback counter of the arena
+ */
+void lv_mem_buf_reset_stat(void)
+{
+    MEM_LOCK();
+    buf_arena.max_used = buf_arena.top;
+    buf_arena.fallback_cnt = 0;
+    MEM_UNLOCK();
+}
+#endif
+
+#if LV_MEM_ARENA_CNT
+/**
+ * Create an arena: one block of `lv_mem_alloc` from which memories are allocated by bumping a pointer.
+ * The memories can be released one by one but the arena gives back their space only from its top.
+ * Everything in the arena is freed at once by `_lv_mem_arena_del()`.
+ * @param size size of the arena in bytes
+ * @param owner an arbitrary pointer to find the arena with `_lv_mem_arena_get_by_owner()`
+ * @return pointer to the new arena or NULL if there are already `LV_MEM_ARENA_CNT` arenas or out of memory
+ */
+lv_mem_arena_t * _lv_mem_arena_create(uint32_t size, const void * owner)
+{
+    /*The descriptor is stored before the memory of the arena*/
+    size = (size + ARENA_ALIGN_MASK) & ~ARENA_ALIGN_MASK;
+    lv_mem_arena_t * arena = lv_mem_alloc_tag(sizeof(lv_mem_arena_t) + size, LV_MEM_TAG_OBJ);
+    if(arena == NULL) return NULL;
+
+    _lv_memset_00(arena, sizeof(lv_mem_arena_t));
+    arena->buf = (uint8_t *)(arena + 1);
+    arena->size = size;
+    arena->last = ARENA_NONE;
+    arena->owner = owner;
+
+    MEM_LOCK();
+    uint32_t i;
+    for(i = 0; i < LV_MEM_ARENA_CNT; i++) {
+        if(arenas[i] == NULL) {
+            arenas[i] = arena;
+            MEM_UNLOCK();
+            return arena;
+        }
+    }
+    MEM_UNLOCK();
+
+    LV_LOG_WARN("_lv_mem_arena_create: no free arena, increase LV_MEM_ARENA_CNT");
+    lv_mem_free(arena);
+    return NULL;
+}
+
+/**
+ * Free an arena with all the memories in it
+ * @param arena pointer to an arena created by `_lv_mem_arena_create()`
+ */
+void _lv_mem_arena_del(lv_mem_arena_t * arena)
+{
+    MEM_LOCK();
+    uint32_t i;
+    for(i = 0; i < LV_MEM_ARENA_CNT; i++) {
+        if(arenas[i] == arena) {
+            arenas[i] = NULL;
+            MEM_UNLOCK();
+            lv_mem_free(arena);
+            return;
+        }
+    }
+    MEM_UNLOCK();
+
+    LV_LOG_WARN("_lv_mem_arena_del: not an arena");
+}
+
+/**
+ * Find the arena of a memory
+ * @param p any pointer
+ * @return the arena into which `p` points or NULL if it's not in an arena
+ */
+lv_mem_arena_t * _lv_mem_arena_find(const void * p)
+{
+    MEM_LOCK();
+    lv_mem_arena_t * arena = arena_find(p);
+    MEM_UNLOCK();
+
+    return arena;
+}
+
+/**
+ * Find an arena by its owner
+ * @param owner the `owner` given to `_lv_mem_arena_create()`
+ * @return the arena or NULL if `owner` has no arena
+ */
+lv_mem_arena_t * _lv_mem_arena_get_by_owner(const void * owner)
+{
+    lv_mem_arena_t * arena = NULL;
+
+    MEM_LOCK();
+    uint32_t i;
+    for(i = 0; i < LV_MEM_ARENA_CNT; i++) {
+        if(arenas[i] && arenas[i]->owner == owner) {
+            arena = arenas[i];
+            break;
+        }
+    }
+    MEM_UNLOCK();
+
+    return arena;
+}
+
+/**
+ * Reallocate a memory which might be in an arena. The old content will be kept.
+ * A memory in an arena stays in its arena while it has space, a memory on the heap stays on the heap
+ * and a new memory is allocated from `arena`. Uses the heap if the arena is full.
+ * @param arena allocate a new memory (`data_p == NULL`) from this arena. NULL: use the heap.
+ * @param data_p pointer to a memory of an arena or of `lv_mem_alloc` or NULL
+ * @param new_size the desired new size in byte
+ * @param tag the owner of the memory if it goes to the heap, `LV_MEM_TAG_...`
+ * @return pointer to the new memory or NULL if out of memory
+ */
+void * _lv_mem_arena_realloc(lv_mem_arena_t * arena, void * data_p, size_t new_size, lv_mem_tag_t tag)
+{
+    LV_UNUSED(tag); /*Used only by the profiler*/
+
+    /*The heap is locked only while the arenas are used because `lv_mem_...` functions lock it too*/
+    void * new_p = NULL;
+    if(data_p == NULL) {
+        if(arena && new_size) {
+            MEM_LOCK();
+            new_p = arena_get(arena, new_size);
+            MEM_UNLOCK();
+        }
+        return new_p ? new_p : lv_mem_alloc_tag(new_size, tag);
+    }
+
+    MEM_LOCK();
+    arena = arena_find(data_p);
+    if(arena == NULL) {
+        MEM_UNLOCK();
+        return lv_mem_realloc_tag(data_p, new_size, tag);
+    }
+
+    mem_arena_hdr_t * hdr = (mem_arena_hdr_t *)data_p - 1;
+    uint32_t old_size = (hdr->size & ~ARENA_USED_BIT) - sizeof(mem_arena_hdr_t);
+    if(new_size <= old_size) {
+        MEM_UNLOCK();
+        return data_p;
+    }
+
+    /*Grow on the top without moving*/
+    if((uint8_t *)hdr == arena->buf + arena->last) {
+        uint32_t full_size = ((new_size + ARENA_ALIGN_MASK) & ~ARENA_ALIGN_MASK) + sizeof(mem_arena_hdr_t);
+        if(full_size <= arena->size - arena->last) {
+            hdr->size = full_size | ARENA_USED_BIT;
+            arena->top = arena->last + full_size;
+            if(arena->top > arena->max_used) arena->max_used = arena->top;
+            MEM_UNLOCK();
+            return data_p;
+        }
+    }
+
+    new_p = arena_get(arena, new_size);
+    MEM_UNLOCK();
+
+    if(new_p == NULL) new_p = lv_mem_alloc_tag(new_size, tag);
+    if(new_p == NULL) return NULL;
+
+    _lv_memcpy(new_p, data_p, old_size);
+
+    MEM_LOCK();
+    arena_release(arena, data_p);
+    MEM_UNLOCK();
+
+    return new_p;
+}
+
+/**
+ * Free a memory of an arena or of `lv_mem_alloc`
+ * @param data pointer to a memory
+ */
+void _lv_mem_arena_free(const void * data)
+{
+    MEM_LOCK();
+    lv_mem_arena_t * arena = arena_find(data);
+    if(arena) arena_release(arena, data);
+    MEM_UNLOCK();
+
+    if(arena == NULL) lv_mem_free(data);
+}
+
+/**
+ * Give the usable size of a memory of an arena or of `lv_mem_alloc`
+ * @param data pointer to a memory
+ * @return the size of data memory in bytes
+ */
+uint32_t _lv_mem_arena_get_size(const void * data)
+{
+    if(_lv_mem_arena_find(data) == NULL) return _lv_mem_get_size(data);
+
+    const mem_arena_hdr_t * hdr = (const mem_arena_hdr_t *)data - 1;
+    return (hdr->size & ~ARENA_USED_BIT) - sizeof(mem_arena_hdr_t);
+}
+#endif
+
+#if LV_MEM_SLAB
+/**
+ * Get the number of fixed size pools
+ * @return number of pools
+ */
+uint8_t lv_mem_slab_get_pool_cnt(void)
+{
+    return _lv_slab_get_pool_cnt();
+}
+
+/**
+ * Get the usage of a fixed size pool
+ * @param pool_id index of a pool, `0 ... lv_mem_slab_get_pool_cnt() - 1`
+ * @param stat store the result here
+ */
+void lv_mem_slab_get_stat(uint8_t pool_id, lv_mem_slab_stat_t * stat)
+{
+    MEM_LOCK();
+    _lv_slab_get_stat(pool_id, stat);
+    MEM_UNLOCK();
+}
+#endif
+
+#if LV_MEMCPY_MEMSET_STD == 0
+/**
+ * Same as `memcpy` but optimized for 4 byte operation.
+ * @param dst pointer to the destination buffer
+ * @param src pointer to the source buffer
+ * @param len number of byte to copy
+ */
+LV_ATTRIBUTE_FAST_MEM void * _lv_memcpy(void * dst, const void * src, size_t len)
+{
+    uint8_t * d8 = dst;
+    const uint8_t * s8 = src;
+
+    lv_uintptr_t d_align = (lv_uintptr_t)d8 & ALIGN_MASK;
+    lv_uintptr_t s_align = (lv_uintptr_t)s8 & ALIGN_MASK;
+
+    /*Byte copy for unaligned memories*/
+    if(s_align != d_align) {
+        while(len > 32) {
+            REPEAT8(COPY8);
+            REPEAT8(COPY8);
+            REPEAT8(COPY8);
+            REPEAT8(COPY8);
+            len -= 32;
+        }
+        while(len) {
+            COPY8
+            len--;
+        }
+        return dst;
+    }
+
+    /*Make the memories aligned*/
+    if(d_align) {
+        d_align = ALIGN_MASK + 1 - d_align;
+        while(d_align && len) {
+            COPY8;
+            d_align--;
+            len--;
+        }
+    }
+
+    uint32_t * d32 = (uint32_t *)d8;
+    const uint32_t * s32 = (uint32_t *)s8;
+    while(len > 32) {
+        REPEAT8(COPY32)
+        len -= 32;
+    }
+
+    while(len > 4) {
+        COPY32;
+        len -= 4;
+    }
+
+    d8 = (uint8_t *)d32;
+    s8 = (const uint8_t *)s32;
+    while(len) {
+        COPY8
+        len--;
+    }
+
+    return dst;
+}
+
+/**
+ * Same as `memset` but optimized for 4 byte operation.
+ * @param dst pointer to the destination buffer
+ * @param v value to set [0..255]
+ * @param len number of byte to set
+ */
+LV_ATTRIBUTE_FAST_MEM void _lv_memset(void * dst, uint8_t v, size_t len)
+{
+
+    uint8_t * d8 = (uint8_t *) dst;
+
+    uintptr_t d_align = (lv_uintptr_t) d8 & ALIGN_MASK;
+
+    /*Make the address aligned*/
+    if(d_align) {
+        d_align = ALIGN_MASK + 1 - d_align;
+        while(d_align && len) {
+            SET8(v);
+            len--;
+            d_align--;
+        }
+    }
+
+    uint32_t v32 = v + (v << 8) + (v << 16) + (v << 24);
+
+    uint32_t * d32 = (uint32_t *)d8;
+
+    while(len > 32) {
+        REPEAT8(SET32(v32));
+        len -= 32;
+    }
+
+    while(len > 4) {
+        SET32(v32);
+        len -= 4;
+    }
+
+    d8 = (uint8_t *)d32;
+    while(len) {
+        SET8(v);
+        len--;
+    }
+}
+
+/**
+ * Same as `memset(dst, 0x00, len)` but optimized for 4 byte operation.
+ * @param dst pointer to the destination buffer
+ * @param len number of byte to set
+ */
+LV_ATTRIBUTE_FAST_MEM void _lv_memset_00(void * dst, size_t len)
+{
+    uint8_t * d8 = (uint8_t *) dst;
+    uintptr_t d_align = (lv_uintptr_t) d8 & ALIGN_MASK;
+
+    /*Make the address aligned*/
+    if(d_align) {
+        d_align = ALIGN_MASK + 1 - d_align;
+        while(d_align && len) {
+            SET8(0);
+            len--;
+            d_align--;
+        }
+    }
+
+    uint32_t * d32 = (uint32_t *)d8;
+    while(len > 32) {
+        REPEAT8(SET32(0));
+        len -= 32;
+    }
+
+    while(len > 4) {
+        SET32(0);
+        len -= 4;
+    }
+
+    d8 = (uint8_t *)d32;
+    while(len) {
+        SET8(0);
+        len--;
+    }
+}
+
+/**
+ * Same as `memset(dst, 0xFF, len)` but optimized for 4 byte operation.
+ * @param dst pointer to the destination buffer
+ * @param len number of byte to set
+ */
+LV_ATTRIBUTE_FAST_MEM void _lv_memset_ff(void * dst, size_t len)
+{
+    uint8_t * d8 = (uint8_t *) dst;
+    uintptr_t d_align = (lv_uintptr_t) d8 & ALIGN_MASK;
+
+    /*Make the address aligned*/
+    if(d_align) {
+        d_align = ALIGN_MASK + 1 - d_align;
+        while(d_align && len) {
+            SET8(0xFF);
+            len--;
+            d_align--;
+        }
+    }
+
+    uint32_t * d32 = (uint32_t *)d8;
+    while(len > 32) {
+        REPEAT8(SET32(0xFFFFFFFF));
+        len -= 32;
+    }
+
+    while(len > 4) {
+        SET32(0xFFFFFFFF);
+        len -= 4;
+    }
+
+    d8 = (uint8_t *)d32;
+    while(len) {
+        SET8(0xFF);
+        len--;
+    }
+}
+
+#endif /*LV_MEMCPY_MEMSET_STD*/
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Join the adjacent free memory blocks without locking the heap
+ */
+static void mem_defrag(void)
+{
+    /*Nothing to do with TLSF: the free blocks are joined immediately*/
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF == 0
+    lv_mem_ent_t * e = ent_get_next(NULL);
+    while(e != NULL) {
+        /*Joint the following free entries to the free*/
+        if(e->header.s.used == 0) ent_join_next(e, UINT32_MAX);
+        e = ent_get_next(e);
+    }
+
+#if LV_MEM_DEFRAG_INCREMENTAL
+    /*The defrag. task has nothing to do*/
+    defrag_cursor = NULL;
+    defrag_dirty = false;
+#endif
+#endif
+}
+
+/**
+ * Get a temporal buffer with the given size.
+ * @param size the required size
+ * @param assert_en true: assert if the buffer couldn't be allocated
+ * @return the buffer or NULL on error
+ */
+static void * mem_buf_get(uint32_t size, bool assert_en)
+{
+    if(size == 0) return NULL;
+
+    MEM_LOCK();
+
+#if LV_MEM_BUF_ARENA
+    void * arena_buf = arena_get(&buf_arena, size);
+    if(arena_buf) {
+        MEM_UNLOCK();
+        return arena_buf;
+    }
+#endif
+
+    /*Try small static buffers first*/
+    uint8_t i;
+    if(size <= MEM_BUF_SMALL_SIZE) {
+        for(i = 0; i < sizeof(mem_buf_small) / sizeof(mem_buf_small[0]); i++) {
+            if(mem_buf_small[i].used == 0) {
+                mem_buf_small[i].used = 1;
+                MEM_UNLOCK();
+                return mem_buf_small[i].p;
+            }
+        }
+    }
+
+    /*Try to find a free buffer with suitable size */
+    int8_t i_guess = -1;
+    for(i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
+        if(LV_GC_ROOT(_lv_mem_buf[i]).used == 0 && LV_GC_ROOT(_lv_mem_buf[i]).size >= size) {
+            if(LV_GC_ROOT(_lv_mem_buf[i]).size == size) {
+                LV_GC_ROOT(_lv_mem_buf[i]).used = 1;
+                MEM_UNLOCK();
+                return LV_GC_ROOT(_lv_mem_buf[i]).p;
+            }
+            else if(i_guess < 0) {
+                i_guess = i;
+            }
+            /*If size of `i` is closer to `size` prefer it*/
+            else if(LV_GC_ROOT(_lv_mem_buf[i]).size < LV_GC_ROOT(_lv_mem_buf[i_guess]).size) {
+                i_guess = i;
+            }
+        }
+    }
+
+    if(i_guess >= 0) {
+        LV_GC_ROOT(_lv_mem_buf[i_guess]).used = 1;
+        MEM_UNLOCK();
+        return LV_GC_ROOT(_lv_mem_buf[i_guess]).p;
+    }
+
+    /*Reallocate a free buffer*/
+    for(i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
+        if(LV_GC_ROOT(_lv_mem_buf[i]).used == 0) {
+            /*Reserve the buffer because the heap is locked again while reallocating*/
+            LV_GC_ROOT(_lv_mem_buf[i]).used = 1;
+            void * old_p = LV_GC_ROOT(_lv_mem_buf[i]).p;
+            MEM_UNLOCK();
+
+            /*if this fails you probably need to increase your LV_MEM_SIZE/heap size*/
+            void * buf = lv_mem_realloc_tag(old_p, size, LV_MEM_TAG_DRAW);
+            MEM_LOCK();
+            if(buf == NULL) {
+                LV_GC_ROOT(_lv_mem_buf[i]).used = 0;
+                MEM_UNLOCK();
+                if(assert_en) {
+                    LV_DEBUG_ASSERT(false, "Out of memory, can't allocate a new buffer (increase your LV_MEM_SIZE/heap size)",
+                                    0x00);
+                }
+                return NULL;
+            }
+            LV_GC_ROOT(_lv_mem_buf[i]).size = size;
+            LV_GC_ROOT(_lv_mem_buf[i]).p    = buf;
+            MEM_UNLOCK();
+            return buf;
+        }
+    }
+
+    MEM_UNLOCK();
+    if(assert_en) {
+        LV_DEBUG_ASSERT(false, "No free buffer. Increase LV_MEM_BUF_MAX_NUM.", 0x00);
+    }
+    return NULL;
+}
+
+/**
+ * Check the integrity of the heap without locking it
+ * @return LV_RES_OK: no error found
+ */
+static lv_res_t mem_test(void)
+{
+#if LV_MEM_SLAB
+    if(!_lv_slab_check()) return LV_RES_INV;
+#endif
+
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF
+    if(!_lv_tlsf_check()) return LV_RES_INV;
+#elif LV_MEM_CUSTOM == 0
+    lv_mem_ent_t * e;
+    e = ent_get_next(NULL);
+    while(e) {
+        if(e->header.s.d_size > LV_MEM_SIZE) {
+            return LV_RES_INV;
+        }
+        uint8_t * e8 = (uint8_t *) e;
+        if(e8 + e->header.s.d_size > work_mem + LV_MEM_SIZE) {
+            return LV_RES_INV;
+        }
+        e = ent_get_next(e);
+    }
+#endif
+    return LV_RES_OK;
+}
+
+#if LV_MEM_PAUSE_HIST
+/**
+ * Add the duration of a call to the histogram. The heap has to be locked.
+ * @param t the duration in the unit of `LV_MEM_PAUSE_HIST_TIME_EXPR`
+ */
+static void pause_add(uint32_t t)
+{
+    /*The index is the number of bits of the duration*/
+    uint32_t i = 0;
+    uint32_t v = t;
+    while(v && i < LV_MEM_PAUSE_HIST_CNT - 1) {
+        v >>= 1;
+        i++;
+    }
+
+    pause_stat.hist[i]++;
+    pause_stat.cnt++;
+    if(t > pause_stat.max) pause_stat.max = t;
+}
+#endif
+
+#if LV_MEM_THREAD_SAFE
+/**
+ * Get the size class of the thread caches
+ * @param size size of the data in bytes
+ * @return index of the smallest class where `size` fits or `MT_CLASS_NONE` if it's too large
+ */
+static uint8_t mt_get_class(size_t size)
+{
+    uint8_t cls;
+    for(cls = 0; cls < MT_CLASS_CNT; cls++) {
+        if(size <= mt_class_size[cls]) return cls;
+    }
+
+    return MT_CLASS_NONE;
+}
+
+/**
+ * Drop the blocks of the calling thread's cache if they were cached before the heap was reinitialized.
+ * These blocks are not on the heap anymore.
+ */
+static inline void mt_cache_validate(void)
+{
+    uint32_t gen = MT_GEN_GET();
+    if(mt_cache.gen != gen) {
+        _lv_memset_00(mt_cache.head, sizeof(mt_cache.head));
+        _lv_memset_00(mt_cache.cnt, sizeof(mt_cache.cnt));
+        mt_cache.gen = gen;
     }
+}
 
+/**
+ * Free the released temporary buffers from the heap and keep the ones in use
+ */
+static void buf_free_released(void)
+{
+    /*The released buffers of the arena are already dropped from its top*/
+    uint8_t i;
     for(i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
-        if(LV_GC_ROOT(_lv_mem_buf[i]).p) {
-            lv_mem_free(LV_GC_ROOT(_lv_mem_buf[i]).p);
+        void * p = NULL;
+        MEM_LOCK();
+        if(LV_GC_ROOT(_lv_mem_buf[i]).used == 0) {
+            p = LV_GC_ROOT(_lv_mem_buf[i]).p;
             LV_GC_ROOT(_lv_mem_buf[i]).p = NULL;
-            LV_GC_ROOT(_lv_mem_buf[i]).used = 0;
             LV_GC_ROOT(_lv_mem_buf[i]).size = 0;
         }
+        MEM_UNLOCK();
+
+        if(p) lv_mem_free(p);
     }
 }
+#endif
 
-#if LV_MEMCPY_MEMSET_STD == 0
+#if LV_MEM_PROFILER
 /**
- * Same as `memcpy` but optimized for 4 byte operation.
- * @param dst pointer to the destination buffer
- * @param src pointer to the source buffer
- * @param len number of byte to copy
+ * Allocate a memory with a profiler header before it
+ * @param size size of the memory to allocate in bytes
+ * @param tag the owner of the memory
+ * @param caller address of the caller of `lv_mem_alloc` or NULL
+ * @return pointer to the allocated memory (after the header)
  */
-LV_ATTRIBUTE_FAST_MEM void * _lv_memcpy(void * dst, const void * src, size_t len)
+static void * prof_alloc(size_t size, lv_mem_tag_t tag, const void * caller)
 {
-    uint8_t * d8 = dst;
-    const uint8_t * s8 = src;
+    if(size == 0) return &zero_mem;
 
-    lv_uintptr_t d_align = (lv_uintptr_t)d8 & ALIGN_MASK;
-    lv_uintptr_t s_align = (lv_uintptr_t)s8 & ALIGN_MASK;
+    mem_prof_hdr_t * hdr = PROF_ALLOC(size + sizeof(mem_prof_hdr_t));
+    if(hdr == NULL) return NULL;
 
-    /*Byte copy for unaligned memories*/
-    if(s_align != d_align) {
-        while(len > 32) {
-            REPEAT8(COPY8);
-            REPEAT8(COPY8);
-            REPEAT8(COPY8);
-            REPEAT8(COPY8);
-            len -= 32;
-        }
-        while(len) {
-            COPY8
-            len--;
-        }
-        return dst;
-    }
+    hdr->size = size;
+    hdr->tag = tag < _LV_MEM_TAG_LAST ? tag : LV_MEM_TAG_OTHER;
+#if LV_MEM_PROFILER_CALLER
+    hdr->caller = caller;
+#else
+    LV_UNUSED(caller);
+#endif
+    MEM_LOCK();
+    hdr->seq = prof_seq;
+    prof_seq++;
+    prof_link(hdr);
+    MEM_UNLOCK();
 
-    /*Make the memories aligned*/
-    if(d_align) {
-        d_align = ALIGN_MASK + 1 - d_align;
-        while(d_align && len) {
-            COPY8;
-            d_align--;
-            len--;
-        }
-    }
+    return hdr + 1;
+}
 
-    uint32_t * d32 = (uint32_t *)d8;
-    const uint32_t * s32 = (uint32_t *)s8;
-    while(len > 32) {
-        REPEAT8(COPY32)
-        len -= 32;
-    }
+static void prof_free(const void * data)
+{
+    if(data == NULL || data == &zero_mem) return;
 
-    while(len > 4) {
-        COPY32;
-        len -= 4;
+    mem_prof_hdr_t * hdr = (mem_prof_hdr_t *)data - 1;
+    MEM_LOCK();
+    prof_unlink(hdr);
+    MEM_UNLOCK();
+    PROF_FREE(hdr);
+}
+
+/**
+ * Reallocate a memory allocated by `prof_alloc`. The owner, the sequence number and the caller are kept.
+ * @param data_p pointer to an allocated memory
+ * @param new_size the desired new size in byte
+ * @param tag the owner of the memory if it's a new allocation
+ * @param caller address of the caller of `lv_mem_realloc` or NULL
+ * @return pointer to the new memory
+ */
+static void * prof_realloc(void * data_p, size_t new_size, lv_mem_tag_t tag, const void * caller)
+{
+    if(data_p == NULL || data_p == &zero_mem) return prof_alloc(new_size, tag, caller);
+
+    if(new_size == 0) {
+        prof_free(data_p);
+        return &zero_mem;
     }
 
-    d8 = (uint8_t *)d32;
-    s8 = (const uint8_t *)s32;
-    while(len) {
-        COPY8
-        len--;
+    mem_prof_hdr_t * hdr = (mem_prof_hdr_t *)data_p - 1;
+    MEM_LOCK();
+    prof_unlink(hdr);
+    MEM_UNLOCK();
+
+    mem_prof_hdr_t * new_hdr = PROF_REALLOC(hdr, new_size + sizeof(mem_prof_hdr_t));
+    MEM_LOCK();
+    if(new_hdr == NULL) {
+        /*The old memory is kept*/
+        prof_link(hdr);
+        MEM_UNLOCK();
+        return NULL;
     }
 
-    return dst;
+    new_hdr->size = new_size;
+    prof_link(new_hdr);
+    MEM_UNLOCK();
+
+    return new_hdr + 1;
 }
 
 /**
- * Same as `memset` but optimized for 4 byte operation.
- * @param dst pointer to the destination buffer
- * @param v value to set [0..255]
- * @param len number of byte to set
+ * Add an allocation to the list of live allocations and to the usage of its owner
+ * @param hdr pointer to the header of the allocation
  */
-LV_ATTRIBUTE_FAST_MEM void _lv_memset(void * dst, uint8_t v, size_t len)
+static void prof_link(mem_prof_hdr_t * hdr)
 {
+    hdr->prev = NULL;
+    hdr->next = prof_head;
+    if(prof_head) prof_head->prev = hdr;
+    prof_head = hdr;
+
+    lv_mem_prof_stat_t * stat = &prof_stat[hdr->tag];
+    stat->size += hdr->size;
+    stat->cnt++;
+    if(stat->size > stat->max_size) stat->max_size = stat->size;
+}
 
-    uint8_t * d8 = (uint8_t *) dst;
-
-    uintptr_t d_align = (lv_uintptr_t) d8 & ALIGN_MASK;
-
-    /*Make the address aligned*/
-    if(d_align) {
-        d_align = ALIGN_MASK + 1 - d_align;
-        while(d_align && len) {
-            SET8(v);
-            len--;
-            d_align--;
-        }
-    }
+/**
+ * Remove an allocation from the list of live allocations and from the usage of its owner
+ * @param hdr pointer to the header of the allocation
+ */
+static void prof_unlink(mem_prof_hdr_t * hdr)
+{
+    if(hdr->prev) hdr->prev->next = hdr->next;
+    else prof_head = hdr->next;
+    if(hdr->next) hdr->next->prev = hdr->prev;
 
-    uint32_t v32 = v + (v << 8) + (v << 16) + (v << 24);
+    lv_mem_prof_stat_t * stat = &prof_stat[hdr->tag];
+    stat->size -= hdr->size;
+    stat->cnt--;
+}
 
-    uint32_t * d32 = (uint32_t *)d8;
+static lv_mem_tag_t prof_get_act_tag(void)
+{
+    if(prof_tag_depth == 0) return LV_MEM_TAG_OTHER;
+    if(prof_tag_depth > PROF_TAG_STACK_SIZE) return prof_tag_stack[PROF_TAG_STACK_SIZE - 1];
+    return prof_tag_stack[prof_tag_depth - 1];
+}
+#endif
 
-    while(len > 32) {
-        REPEAT8(SET32(v32));
-        len -= 32;
+#if LV_MEM_SLAB
+/**
+ * Reallocate a block of the fixed size pools
+ * @param data_p pointer to a block of the pools
+ * @param new_size the desired new size in byte
+ * @return pointer to the new memory
+ */
+static void * slab_realloc(void * data_p, size_t new_size)
+{
+    if(new_size == 0) {
+        mem_free(data_p);
+        return &zero_mem;
     }
 
-    while(len > 4) {
-        SET32(v32);
-        len -= 4;
-    }
+    /*Stay in place while the data fits into the block*/
+    uint32_t old_size = _lv_slab_block_size(data_p);
+    if(new_size <= old_size) return data_p;
 
-    d8 = (uint8_t *)d32;
-    while(len) {
-        SET8(v);
-        len--;
+    void * new_p = mem_alloc(new_size);
+    if(new_p == NULL) {
+        LV_LOG_WARN("Couldn't allocate memory");
+        return NULL;
     }
+
+    _lv_memcpy(new_p, data_p, old_size);
+    mem_free(data_p);
+    return new_p;
 }
+#endif
 
+#if LV_MEM_BUF_ARENA || LV_MEM_ARENA_CNT
 /**
- * Same as `memset(dst, 0x00, len)` but optimized for 4 byte operation.
- * @param dst pointer to the destination buffer
- * @param len number of byte to set
+ * Get a memory from the top of an arena
+ * @param arena pointer to an arena
+ * @param size the required size
+ * @return pointer to the memory or NULL if it doesn't fit (counted in `fallback_cnt`)
  */
-LV_ATTRIBUTE_FAST_MEM void _lv_memset_00(void * dst, size_t len)
+static void * arena_get(lv_mem_arena_t * arena, uint32_t size)
 {
-    uint8_t * d8 = (uint8_t *) dst;
-    uintptr_t d_align = (lv_uintptr_t) d8 & ALIGN_MASK;
-
-    /*Make the address aligned*/
-    if(d_align) {
-        d_align = ALIGN_MASK + 1 - d_align;
-        while(d_align && len) {
-            SET8(0);
-            len--;
-            d_align--;
-        }
+    uint32_t full_size = ((size + ARENA_ALIGN_MASK) & ~ARENA_ALIGN_MASK) + sizeof(mem_arena_hdr_t);
+    if(full_size > arena->size - arena->top) {
+        arena->fallback_cnt++;
+        return NULL;
     }
 
-    uint32_t * d32 = (uint32_t *)d8;
-    while(len > 32) {
-        REPEAT8(SET32(0));
-        len -= 32;
-    }
+    mem_arena_hdr_t * hdr = (mem_arena_hdr_t *)(arena->buf + arena->top);
+    hdr->size = full_size | ARENA_USED_BIT;
+    hdr->prev = arena->last;
+    arena->last = arena->top;
+    arena->top += full_size;
 
-    while(len > 4) {
-        SET32(0);
-        len -= 4;
-    }
+    if(arena->top > arena->max_used) arena->max_used = arena->top;
 
-    d8 = (uint8_t *)d32;
-    while(len) {
-        SET8(0);
-        len--;
-    }
+    return hdr + 1;
 }
 
 /**
- * Same as `memset(dst, 0xFF, len)` but optimized for 4 byte operation.
- * @param dst pointer to the destination buffer
- * @param len number of byte to set
+ * Release a memory of an arena. If it's on the top, give back the space of it
+ * and the already released memories below it.
+ * @param arena pointer to an arena
+ * @param p pointer to a memory
+ * @return true: `p` was in the arena; false: `p` is not in the arena
  */
-LV_ATTRIBUTE_FAST_MEM void _lv_memset_ff(void * dst, size_t len)
+static bool arena_release(lv_mem_arena_t * arena, const void * p)
 {
-    uint8_t * d8 = (uint8_t *) dst;
-    uintptr_t d_align = (lv_uintptr_t) d8 & ALIGN_MASK;
+    if(!arena_has(arena, p)) return false;
 
-    /*Make the address aligned*/
-    if(d_align) {
-        d_align = ALIGN_MASK + 1 - d_align;
-        while(d_align && len) {
-            SET8(0xFF);
-            len--;
-            d_align--;
-        }
-    }
+    mem_arena_hdr_t * hdr = (mem_arena_hdr_t *)p - 1;
+    hdr->size &= ~ARENA_USED_BIT;
 
-    uint32_t * d32 = (uint32_t *)d8;
-    while(len > 32) {
-        REPEAT8(SET32(0xFFFFFFFF));
-        len -= 32;
+    while(arena->last != ARENA_NONE) {
+        hdr = (mem_arena_hdr_t *)(arena->buf + arena->last);
+        if(hdr->size & ARENA_USED_BIT) break;
+        arena->top = arena->last;
+        arena->last = hdr->prev;
     }
 
-    while(len > 4) {
-        SET32(0xFFFFFFFF);
-        len -= 4;
-    }
+    return true;
+}
 
-    d8 = (uint8_t *)d32;
-    while(len) {
-        SET8(0xFF);
-        len--;
-    }
+/**
+ * Tell whether a pointer points into an arena
+ * @param arena pointer to an arena
+ * @param p any pointer
+ * @return true: `p` is in the arena
+ */
+static inline bool arena_has(const lv_mem_arena_t * arena, const void * p)
+{
+    const uint8_t * p8 = p;
+    return p8 >= arena->buf && p8 < arena->buf + arena->size;
 }
+#endif
 
-#endif /*LV_MEMCPY_MEMSET_STD*/
+#if LV_MEM_ARENA_CNT
+/**
+ * Find the arena of a memory. The heap has to be locked.
+ * @param p any pointer
+ * @return the arena into which `p` points or NULL if it's not in an arena
+ */
+static lv_mem_arena_t * arena_find(const void * p)
+{
+    uint32_t i;
+    for(i = 0; i < LV_MEM_ARENA_CNT; i++) {
+        if(arenas[i] && arena_has(arenas[i], p)) return arenas[i];
+    }
 
-/**********************
- *   STATIC FUNCTIONS
- **********************/
+    return NULL;
+}
+#endif
 
-#if LV_MEM_CUSTOM == 0
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF == 0
 /**
  * Give the next entry after 'act_e'
  * @param act_e pointer to an entry
@@ -826,7 +2225,88 @@ static void ent_trunc(lv_mem_ent_t * e, size_t size)
 
         /* Set the new size for the original entry */
         e->header.s.d_size = (uint32_t)size;
+
+#if LV_MEM_DEFRAG_INCREMENTAL
+        /*The new free entry can be followed by a free entry, e.g. when a memory is shrunk by `lv_mem_realloc`*/
+        ent_join_next_step(after_new_e);
+#endif
     }
 }
 
+/**
+ * Join the free entries following a free entry to it
+ * @param e pointer to a free entry
+ * @param max_cnt join at most this many entries
+ * @return number of joined entries
+ */
+static uint32_t ent_join_next(lv_mem_ent_t * e, uint32_t max_cnt)
+{
+    uint32_t cnt = 0;
+    lv_mem_ent_t * e_next = ent_get_next(e);
+    while(e_next != NULL && e_next->header.s.used == 0 && cnt < max_cnt) {
+        e->header.s.d_size += e_next->header.s.d_size + sizeof(e->header);
+#if LV_MEM_DEFRAG_INCREMENTAL
+        /*Don't let the defrag. continue from the middle of an entry*/
+        if(e_next == defrag_cursor) defrag_cursor = e;
+#endif
+        cnt++;
+        e_next = ent_get_next(e);
+    }
+
+    return cnt;
+}
+
+#if LV_MEM_DEFRAG_INCREMENTAL
+/**
+ * Join at most `LV_MEM_DEFRAG_STEP` free entries to a free entry to keep the pause short.
+ * If free entries are left after it, let the defrag. task join them.
+ * @param e pointer to a free entry
+ */
+static void ent_join_next_step(lv_mem_ent_t * e)
+{
+    ent_join_next(e, LV_MEM_DEFRAG_STEP);
+
+    lv_mem_ent_t * e_next = ent_get_next(e);
+    if(e_next != NULL && e_next->header.s.used == 0) defrag_dirty = true;
+}
+
+/**
+ * Join the free entries in a part of the memory and save where to continue.
+ * A new round is started only if an entry was freed since the last round started.
+ * @param max_cnt check at most this many entries
+ * @return true: the round is finished and nothing was freed since it started
+ */
+static bool defrag_step(uint32_t max_cnt)
+{
+    if(defrag_cursor == NULL) {
+        if(defrag_dirty == false) return true;
+
+        /*The entries freed from now on need an other round*/
+        defrag_dirty = false;
+        defrag_cursor = ent_get_next(NULL);
+    }
+
+    uint32_t cnt = 0;
+    lv_mem_ent_t * e = defrag_cursor;
+    while(e != NULL && cnt < max_cnt) {
+        if(e->header.s.used == 0) {
+            cnt += ent_join_next(e, max_cnt - cnt);
+            /*Continue joining to this entry in the next step*/
+            if(cnt >= max_cnt) break;
+        }
+        e = ent_get_next(e);
+        cnt++;
+    }
+
+    defrag_cursor = e;
+    return defrag_cursor == NULL && defrag_dirty == false;
+}
+
+static void defrag_task_cb(lv_task_t * task)
+{
+    LV_UNUSED(task);
+    lv_mem_defrag_step(LV_MEM_DEFRAG_STEP);
+}
+#endif
+
 #endif
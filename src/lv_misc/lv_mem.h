@@ -17,6 +17,7 @@ extern "C" {
 
 #include <stdint.h>
 #include <stddef.h>
+#include <stdbool.h>
 #include "lv_log.h"
 #include "lv_types.h"
 
@@ -59,6 +60,111 @@ typedef struct {
 typedef lv_mem_buf_t lv_mem_buf_arr_t[LV_MEM_BUF_MAX_NUM];
 extern lv_mem_buf_arr_t _lv_mem_buf;
 
+#if LV_MEM_BUF_ARENA
+/**
+ * Usage of the arena of the temporary buffers
+ */
+typedef struct {
+    uint32_t size;          /**< Size of the arena*/
+    uint32_t used;          /**< Currently used bytes (with the headers of the buffers)*/
+    uint32_t max_used;      /**< The most bytes used at the same time*/
+    uint32_t fallback_cnt;  /**< Number of buffers which didn't fit and were allocated with `lv_mem_alloc`*/
+} lv_mem_buf_stat_t;
+#endif
+
+#if LV_MEM_BUF_ARENA || LV_MEM_ARENA_CNT
+/**
+ * An arena allocating by bumping a pointer. Used for the temporary buffers (`LV_MEM_BUF_ARENA`)
+ * and for the screens created by `lv_obj_create_scr_arena()` (`LV_MEM_ARENA_CNT`).
+ */
+typedef struct {
+    uint8_t * buf;          /**< Memory of the arena*/
+    uint32_t size;          /**< Size of `buf`*/
+    uint32_t top;           /**< Offset of the first free byte, i.e. the currently used bytes (with the headers)*/
+    uint32_t last;          /**< Offset of the last allocation's header*/
+    uint32_t max_used;      /**< The most bytes used at the same time*/
+    uint32_t fallback_cnt;  /**< Number of allocations which didn't fit and were allocated with `lv_mem_alloc`*/
+    const void * owner;
+} lv_mem_arena_t;
+#endif
+
+#if LV_MEM_SLAB
+/**
+ * Usage of a fixed size pool
+ */
+typedef struct {
+    uint16_t block_size;    /**< Size of the blocks in the pool*/
+    uint16_t page_cnt;      /**< Number of pages used by the pool*/
+    uint32_t used_cnt;      /**< Number of allocated blocks*/
+    uint32_t max_used_cnt;  /**< The most blocks allocated at the same time*/
+    uint32_t fallback_cnt;  /**< Number of allocations which went to the heap because there was no free page*/
+} lv_mem_slab_stat_t;
+#endif
+
+#if LV_MEM_PAUSE_HIST
+#define LV_MEM_PAUSE_HIST_CNT   24
+
+/**
+ * Histogram of the durations of the memory manager calls in the unit of `LV_MEM_PAUSE_HIST_TIME_EXPR`
+ */
+typedef struct {
+    uint32_t hist[LV_MEM_PAUSE_HIST_CNT];   /**< `hist[0]`: calls shorter than 1 unit, `hist[i]`: calls of
+                                                 `2^(i-1) .. 2^i - 1` units. The last one counts the longer calls too.*/
+    uint32_t cnt;                           /**< Number of measured calls*/
+    uint32_t max;                           /**< Duration of the longest call*/
+} lv_mem_pause_stat_t;
+#endif
+
+/**
+ * Owners of the allocations to group them in the memory profiler (`LV_MEM_PROFILER`)
+ */
+enum {
+    LV_MEM_TAG_OTHER,       /**< Not tagged allocations*/
+    LV_MEM_TAG_OBJ,         /**< Objects and their `ext_attr`*/
+    LV_MEM_TAG_STYLE,       /**< Styles, style lists and transitions*/
+    LV_MEM_TAG_TEXT,        /**< Texts of the labels*/
+    LV_MEM_TAG_IMG_CACHE,   /**< Image cache entries and decoded images*/
+    LV_MEM_TAG_FONT,        /**< Loaded fonts and their glyph caches*/
+    LV_MEM_TAG_DRAW,        /**< Temporary buffers of drawing*/
+    LV_MEM_TAG_FS,          /**< Open files and their caches*/
+    LV_MEM_TAG_ANIM,        /**< Animations*/
+    LV_MEM_TAG_TASK,        /**< Tasks*/
+    LV_MEM_TAG_USER,        /**< Free to use by the application*/
+    _LV_MEM_TAG_LAST,
+};
+typedef uint8_t lv_mem_tag_t;
+
+#if LV_MEM_PROFILER
+/**
+ * Memory usage of an owner
+ */
+typedef struct {
+    uint32_t size;      /**< Currently allocated bytes*/
+    uint32_t cnt;       /**< Number of allocated blocks*/
+    uint32_t max_size;  /**< The most bytes allocated at the same time*/
+} lv_mem_prof_stat_t;
+
+/**
+ * The state of the profiler at a moment. See `lv_mem_prof_take_snapshot()`
+ */
+typedef struct {
+    uint32_t seq;                                   /**< Sequence number of the next allocation*/
+    lv_mem_prof_stat_t tags[_LV_MEM_TAG_LAST];      /**< Usage of the owners*/
+} lv_mem_prof_snapshot_t;
+
+/**
+ * Describes a live allocation
+ */
+typedef struct {
+    const void * p;         /**< Pointer to the allocated memory*/
+    uint32_t size;          /**< Requested size*/
+    lv_mem_tag_t tag;       /**< Owner of the allocation*/
+    const void * caller;    /**< Address of the caller of `lv_mem_alloc` or NULL*/
+} lv_mem_prof_block_t;
+
+typedef void (*lv_mem_prof_leak_cb_t)(const lv_mem_prof_block_t * block);
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -70,10 +176,31 @@ void _lv_mem_init(void);
 
 /**
  * Clean up the memory buffer which frees all the allocated memories.
+ * With `LV_MEM_THREAD_SAFE` the blocks cached by the threads are dropped too.
+ * The other threads shouldn't use `lv_mem` while it runs.
  * @note It work only if `LV_MEM_CUSTOM == 0`
  */
 void _lv_mem_deinit(void);
 
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF
+/**
+ * Add a memory area to `lv_mem_alloc` beside the `LV_MEM_SIZE` sized work memory.
+ * The pools can't be removed. `_lv_mem_deinit()` drops all of them.
+ * @param mem pointer to a memory area. It must be kept valid while used by `lv_mem`.
+ * @param bytes size of the memory area in bytes
+ * @return LV_RES_OK: the pool is added; LV_RES_INV: the memory area is too small
+ */
+lv_res_t lv_mem_add_pool(void * mem, size_t bytes);
+#endif
+
+#if LV_MEM_THREAD_SAFE
+/**
+ * Give back the freed blocks cached by the calling thread to the heap.
+ * Call it before a thread which used `lv_mem` exits.
+ */
+void lv_mem_thread_flush(void);
+#endif
+
 /**
  * Allocate a memory dynamically
  * @param size size of the memory to allocate in bytes
@@ -96,11 +223,113 @@ void lv_mem_free(const void * data);
  */
 void * lv_mem_realloc(void * data_p, size_t new_size);
 
+#if LV_MEM_PROFILER
+/**
+ * Allocate a memory and account it to an owner in the memory profiler
+ * @param size size of the memory to allocate in bytes
+ * @param tag the owner of the memory, `LV_MEM_TAG_...`
+ * @return pointer to the allocated memory
+ */
+void * lv_mem_alloc_tag(size_t size, lv_mem_tag_t tag);
+
+/**
+ * Reallocate a memory and account it to an owner in the memory profiler if it's a new allocation.
+ * @param data_p pointer to an allocated memory or NULL
+ * @param new_size the desired new size in byte
+ * @param tag the owner of the memory, `LV_MEM_TAG_...`
+ * @return pointer to the new memory
+ */
+void * lv_mem_realloc_tag(void * data_p, size_t new_size, lv_mem_tag_t tag);
+
+/**
+ * Account the not tagged allocations to an owner until `_lv_mem_tag_pop()`.
+ * Used when the allocation is indirect, e.g. a new node of a linked list.
+ * @param tag the owner of the memory, `LV_MEM_TAG_...`
+ */
+void _lv_mem_tag_push(lv_mem_tag_t tag);
+
+/**
+ * Restore the owner of the not tagged allocations which was active before the last `_lv_mem_tag_push()`
+ */
+void _lv_mem_tag_pop(void);
+
+/**
+ * Get the memory usage of an owner
+ * @param tag the owner, `LV_MEM_TAG_...`
+ * @param stat store the result here
+ */
+void lv_mem_prof_get_stat(lv_mem_tag_t tag, lv_mem_prof_stat_t * stat);
+
+/**
+ * Get the name of an owner
+ * @param tag the owner, `LV_MEM_TAG_...`
+ * @return name of the owner, e.g. "style"
+ */
+const char * lv_mem_prof_get_tag_name(lv_mem_tag_t tag);
+
+/**
+ * Save the current state of the profiler
+ * @param snap store the state here
+ */
+void lv_mem_prof_take_snapshot(lv_mem_prof_snapshot_t * snap);
+
+/**
+ * Find the allocations which were made between two snapshots and are still not freed.
+ * @param from the earlier snapshot
+ * @param to the later snapshot or NULL to check until now
+ * @param leak_cb called with every leaked allocation. Can be NULL.
+ * With `LV_MEM_THREAD_SAFE` the heap is locked while it's called, so it must not allocate.
+ * @return number of leaked allocations
+ */
+uint32_t lv_mem_prof_get_leaks(const lv_mem_prof_snapshot_t * from, const lv_mem_prof_snapshot_t * to,
+                               lv_mem_prof_leak_cb_t leak_cb);
+
+/**
+ * Log the memory usage and the high-water mark of every owner with `LV_LOG_USER`.
+ * Use `lv_obj_mem_prof_dump()` to see the memory usage per object type.
+ */
+void lv_mem_prof_dump(void);
+
+#else
+#define lv_mem_alloc_tag(size, tag)             lv_mem_alloc(size)
+#define lv_mem_realloc_tag(data_p, size, tag)   lv_mem_realloc(data_p, size)
+#define _lv_mem_tag_push(tag)
+#define _lv_mem_tag_pop()
+#endif
+
 /**
  * Join the adjacent free memory blocks
  */
 void lv_mem_defrag(void);
 
+#if LV_MEM_CUSTOM == 0 && LV_MEM_DEFRAG_INCREMENTAL
+/**
+ * Create the `lv_task` which defrags the memory in small steps
+ */
+void _lv_mem_defrag_task_init(void);
+
+/**
+ * Join the free memory blocks in a part of the memory and continue from there in the next call.
+ * Called periodically by an `lv_task` but can be called when the application is idle too.
+ * @param max_cnt check at most this many blocks to keep the pause short
+ * @return true: all the free blocks are joined; false: there are more blocks to check
+ */
+bool lv_mem_defrag_step(uint32_t max_cnt);
+#endif
+
+#if LV_MEM_PAUSE_HIST
+/**
+ * Get the histogram of the durations of the memory manager calls
+ * @param stat store the result here
+ */
+void lv_mem_pause_get_stat(lv_mem_pause_stat_t * stat);
+
+/**
+ * Clear the histogram of the durations of the memory manager calls
+ */
+void lv_mem_pause_reset_stat(void);
+#endif
+
 /**
  *
  * @return
@@ -127,6 +356,14 @@ uint32_t _lv_mem_get_size(const void * data);
  */
 void * _lv_mem_buf_get(uint32_t size);
 
+/**
+ * Get a temporal buffer with the given size but don't assert if there is no free buffer or memory.
+ * Useful for optional buffers when the caller can work without the buffer too.
+ * @param size the required size
+ * @return the buffer or NULL if it couldn't be allocated
+ */
+void * _lv_mem_buf_try_get(uint32_t size);
+
 /**
  * Release a memory buffer
  * @param p buffer to release
@@ -135,9 +372,102 @@ void _lv_mem_buf_release(void * p);
 
 /**
  * Free all memory buffers
+ * @note with `LV_MEM_THREAD_SAFE` the buffers still in use (e.g. by other threads) are kept
  */
 void _lv_mem_buf_free_all(void);
 
+#if LV_MEM_BUF_ARENA
+/**
+ * Get the usage of the arena of the temporary buffers
+ * @param stat store the result here
+ */
+void lv_mem_buf_get_stat(lv_mem_buf_stat_t * stat);
+
+/**
+ * Reset the high-water mark and the fallback counter of the arena
+ */
+void lv_mem_buf_reset_stat(void);
+#endif
+
+#if LV_MEM_ARENA_CNT
+/**
+ * Create an arena: one block of `lv_mem_alloc` from which memories are allocated by bumping a pointer.
+ * The memories can be released one by one but the arena gives back their space only from its top.
+ * Everything in the arena is freed at once by `_lv_mem_arena_del()`.
+ * With `LV_MEM_THREAD_SAFE` the arenas are locked like the heap but an arena shouldn't be deleted while in use.
+ * @param size size of the arena in bytes
+ * @param owner an arbitrary pointer to find the arena with `_lv_mem_arena_get_by_owner()`
+ * @return pointer to the new arena or NULL if there are already `LV_MEM_ARENA_CNT` arenas or out of memory
+ */
+lv_mem_arena_t * _lv_mem_arena_create(uint32_t size, const void * owner);
+
+/**
+ * Free an arena with all the memories in it
+ * @param arena pointer to an arena created by `_lv_mem_arena_create()`
+ */
+void _lv_mem_arena_del(lv_mem_arena_t * arena);
+
+/**
+ * Find the arena of a memory
+ * @param p any pointer
+ * @return the arena into which `p` points or NULL if it's not in an arena
+ */
+lv_mem_arena_t * _lv_mem_arena_find(const void * p);
+
+/**
+ * Find an arena by its owner
+ * @param owner the `owner` given to `_lv_mem_arena_create()`
+ * @return the arena or NULL if `owner` has no arena
+ */
+lv_mem_arena_t * _lv_mem_arena_get_by_owner(const void * owner);
+
+/**
+ * Reallocate a memory which might be in an arena. The old content will be kept.
+ * A memory in an arena stays in its arena while it has space, a memory on the heap stays on the heap
+ * and a new memory is allocated from `arena`. Uses the heap if the arena is full.
+ * @param arena allocate a new memory (`data_p == NULL`) from this arena. NULL: use the heap.
+ * @param data_p pointer to a memory of an arena or of `lv_mem_alloc` or NULL
+ * @param new_size the desired new size in byte
+ * @param tag the owner of the memory if it goes to the heap, `LV_MEM_TAG_...`
+ * @return pointer to the new memory or NULL if out of memory
+ */
+void * _lv_mem_arena_realloc(lv_mem_arena_t * arena, void * data_p, size_t new_size, lv_mem_tag_t tag);
+
+/**
+ * Free a memory of an arena or of `lv_mem_alloc`
+ * @param data pointer to a memory
+ */
+void _lv_mem_arena_free(const void * data);
+
+/**
+ * Give the usable size of a memory of an arena or of `lv_mem_alloc`
+ * @param data pointer to a memory
+ * @return the size of data memory in bytes
+ */
+uint32_t _lv_mem_arena_get_size(const void * data);
+
+#else
+#define _lv_mem_arena_find(p)                           ((void)(p), NULL)
+#define _lv_mem_arena_realloc(arena, data_p, size, tag) ((void)(arena), lv_mem_realloc_tag(data_p, size, tag))
+#define _lv_mem_arena_free(data)                        lv_mem_free(data)
+#define _lv_mem_arena_get_size(data)                    _lv_mem_get_size(data)
+#endif
+
+#if LV_MEM_SLAB
+/**
+ * Get the number of fixed size pools
+ * @return number of pools
+ */
+uint8_t lv_mem_slab_get_pool_cnt(void);
+
+/**
+ * Get the usage of a fixed size pool
+ * @param pool_id index of a pool, `0 ... lv_mem_slab_get_pool_cnt() - 1`
+ * @param stat store the result here
+ */
+void lv_mem_slab_get_stat(uint8_t pool_id, lv_mem_slab_stat_t * stat);
+#endif
+
 //! @cond Doxygen_Suppress
 
 #if LV_MEMCPY_MEMSET_STD
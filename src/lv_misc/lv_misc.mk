@@ -1,8 +1,11 @@
 CSRCS += lv_area.c
 CSRCS += lv_task.c
 CSRCS += lv_fs.c
+CSRCS += lv_fs_mmap.c
 CSRCS += lv_anim.c
 CSRCS += lv_mem.c
+CSRCS += lv_tlsf.c
+CSRCS += lv_slab.c
 CSRCS += lv_ll.c
 CSRCS += lv_color.c
 CSRCS += lv_txt.c
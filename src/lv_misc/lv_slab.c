@@ -0,0 +1,313 @@
+/**
+ * @file lv_slab.c
+ * Fixed size pools (slabs) for the small allocations of `lv_mem`.
+ * The memory area is divided into equal pages. An empty page is assigned to a pool when the pool runs out of
+ * free blocks and given back when all of its blocks are freed, so the pools share the area.
+ * The page of a block is found from its address, so allocating and freeing are constant time.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_slab.h"
+#if LV_MEM_SLAB
+
+#include "lv_math.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define SLAB_PAGE_SIZE  512
+#define PAGE_CNT        (LV_MEM_SLAB_SIZE / SLAB_PAGE_SIZE)
+#define PAGE_NONE       0xFFFF
+#define POOL_NONE       0xFF
+
+/*The block sizes are the multiple of `BLOCK_SIZE_STEP` and at least a pointer is required to store the free blocks*/
+#define BLOCK_SIZE_STEP 16
+#define BLOCK_SIZE_MAX  160
+#define POOL_CNT        (sizeof(pool_block_size) / sizeof(pool_block_size[0]))
+
+#if PAGE_CNT == 0
+#error "LV_MEM_SLAB_SIZE is too small. It should be at least 512 bytes"
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    void * free_list;   /*The freed blocks of the page linked through their first bytes*/
+    uint16_t used_cnt;  /*Number of allocated blocks*/
+    uint16_t carved;    /*Number of blocks ever allocated from the page. The rest of the page is untouched*/
+    uint16_t prev;      /*Neighbor pages in the list of the pool's not full pages or in the list of empty pages*/
+    uint16_t next;
+    uint8_t pool_id;    /*`POOL_NONE` if the page is empty*/
+} slab_page_t;
+
+typedef struct {
+    uint16_t partial;   /*First page with free block*/
+    lv_mem_slab_stat_t stat;
+} slab_pool_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static inline uint8_t * page_to_ptr(uint16_t page_id);
+static inline uint16_t page_from_ptr(const void * ptr);
+static inline uint16_t page_block_cnt(uint8_t pool_id);
+static void list_insert(uint16_t * head, uint16_t page_id);
+static void list_remove(uint16_t * head, uint16_t page_id);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static const uint16_t pool_block_size[] = {16, 32, 48, 64, 96, 128, 160};
+
+/*Index of the pool for every `BLOCK_SIZE_STEP` sized step*/
+static const uint8_t size_to_pool[BLOCK_SIZE_MAX / BLOCK_SIZE_STEP] = {0, 1, 2, 3, 4, 4, 5, 5, 6, 6};
+
+static lv_uintptr_t slab_mem[LV_MEM_SLAB_SIZE / sizeof(lv_uintptr_t)];
+static slab_page_t pages[PAGE_CNT];
+static slab_pool_t pools[POOL_CNT];
+static uint16_t empty_pages;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Initialize the pools. All the pages become empty.
+ */
+void _lv_slab_init(void)
+{
+    uint32_t i;
+    empty_pages = PAGE_NONE;
+    for(i = 0; i < PAGE_CNT; i++) {
+        pages[i].pool_id = POOL_NONE;
+        list_insert(&empty_pages, i);
+    }
+
+    for(i = 0; i < POOL_CNT; i++) {
+        _lv_memset_00(&pools[i], sizeof(slab_pool_t));
+        pools[i].partial = PAGE_NONE;
+        pools[i].stat.block_size = pool_block_size[i];
+    }
+}
+
+/**
+ * Allocate a block from the pool of the smallest suitable block size
+ * @param size size of the memory to allocate in bytes
+ * @return pointer to the block or NULL if `size` is too large or there is no free page
+ */
+void * _lv_slab_alloc(size_t size)
+{
+    if(size == 0 || size > BLOCK_SIZE_MAX) return NULL;
+
+    uint8_t pool_id = size_to_pool[(size - 1) / BLOCK_SIZE_STEP];
+    slab_pool_t * pool = &pools[pool_id];
+
+    uint16_t page_id = pool->partial;
+    if(page_id == PAGE_NONE) {
+        page_id = empty_pages;
+        if(page_id == PAGE_NONE) {
+            pool->stat.fallback_cnt++;
+            return NULL;
+        }
+
+        list_remove(&empty_pages, page_id);
+        pages[page_id].pool_id = pool_id;
+        pages[page_id].free_list = NULL;
+        pages[page_id].used_cnt = 0;
+        pages[page_id].carved = 0;
+        list_insert(&pool->partial, page_id);
+        pool->stat.page_cnt++;
+    }
+
+    slab_page_t * page = &pages[page_id];
+    void * p;
+    if(page->free_list) {
+        p = page->free_list;
+        page->free_list = *((void **)p);
+    }
+    else {
+        p = page_to_ptr(page_id) + page->carved * pool_block_size[pool_id];
+        page->carved++;
+    }
+
+    page->used_cnt++;
+    if(page->used_cnt == page_block_cnt(pool_id)) list_remove(&pool->partial, page_id);
+
+    pool->stat.used_cnt++;
+    if(pool->stat.used_cnt > pool->stat.max_used_cnt) pool->stat.max_used_cnt = pool->stat.used_cnt;
+
+    return p;
+}
+
+/**
+ * Give back a block to its pool. The page is released if all of its blocks are free.
+ * @param ptr pointer to a block allocated by `_lv_slab_alloc`
+ */
+void _lv_slab_free(void * ptr)
+{
+    uint16_t page_id = page_from_ptr(ptr);
+    slab_page_t * page = &pages[page_id];
+    slab_pool_t * pool = &pools[page->pool_id];
+
+    /*A full page gets free block now*/
+    if(page->used_cnt == page_block_cnt(page->pool_id)) list_insert(&pool->partial, page_id);
+
+    *((void **)ptr) = page->free_list;
+    page->free_list = ptr;
+    page->used_cnt--;
+    pool->stat.used_cnt--;
+
+    /*Let the other pools use the page too*/
+    if(page->used_cnt == 0) {
+        list_remove(&pool->partial, page_id);
+        page->pool_id = POOL_NONE;
+        list_insert(&empty_pages, page_id);
+        pool->stat.page_cnt--;
+    }
+}
+
+/**
+ * Tell whether a pointer points into the memory area of the pools
+ * @param ptr any pointer
+ * @return true: `ptr` was allocated by `_lv_slab_alloc`
+ */
+bool _lv_slab_is_slab(const void * ptr)
+{
+    const uint8_t * p8 = ptr;
+    return p8 >= (uint8_t *)slab_mem && p8 < (uint8_t *)slab_mem + PAGE_CNT * SLAB_PAGE_SIZE;
+}
+
+/**
+ * Get the usable size of a block
+ * @param ptr pointer to a block allocated by `_lv_slab_alloc`
+ * @return the block size of its pool
+ */
+uint32_t _lv_slab_block_size(const void * ptr)
+{
+    return pool_block_size[pages[page_from_ptr(ptr)].pool_id];
+}
+
+/**
+ * Check the pages and the free lists of the pools
+ * @return true: no error found
+ */
+bool _lv_slab_check(void)
+{
+    uint32_t used_cnt[POOL_CNT];
+    uint16_t page_cnt[POOL_CNT];
+    _lv_memset_00(used_cnt, sizeof(used_cnt));
+    _lv_memset_00(page_cnt, sizeof(page_cnt));
+
+    uint32_t i;
+    for(i = 0; i < PAGE_CNT; i++) {
+        slab_page_t * page = &pages[i];
+        if(page->pool_id == POOL_NONE) continue;
+        if(page->pool_id >= POOL_CNT) return false;
+
+        uint16_t block_size = pool_block_size[page->pool_id];
+        if(page->carved > page_block_cnt(page->pool_id)) return false;
+        if(page->used_cnt == 0 || page->used_cnt > page->carved) return false;
+
+        /*The free blocks have to be carved blocks of this page*/
+        uint8_t * page_start = page_to_ptr(i);
+        uint32_t free_cnt = 0;
+        uint8_t * p = page->free_list;
+        while(p) {
+            if(p < page_start || p >= page_start + page->carved * block_size) return false;
+            if((p - page_start) % block_size) return false;
+            free_cnt++;
+            if(free_cnt > page->carved) return false;
+            p = *((void **)p);
+        }
+        if(free_cnt + page->used_cnt != page->carved) return false;
+
+        used_cnt[page->pool_id] += page->used_cnt;
+        page_cnt[page->pool_id]++;
+    }
+
+    for(i = 0; i < POOL_CNT; i++) {
+        if(used_cnt[i] != pools[i].stat.used_cnt) return false;
+        if(page_cnt[i] != pools[i].stat.page_cnt) return false;
+    }
+
+    return true;
+}
+
+/**
+ * Get the number of pools
+ * @return number of pools
+ */
+uint8_t _lv_slab_get_pool_cnt(void)
+{
+    return POOL_CNT;
+}
+
+/**
+ * Get the usage of a pool
+ * @param pool_id index of a pool, `0 ... _lv_slab_get_pool_cnt() - 1`
+ * @param stat store the result here
+ */
+void _lv_slab_get_stat(uint8_t pool_id, lv_mem_slab_stat_t * stat)
+{
+    if(pool_id >= POOL_CNT) {
+        _lv_memset_00(stat, sizeof(lv_mem_slab_stat_t));
+        return;
+    }
+
+    *stat = pools[pool_id].stat;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static inline uint8_t * page_to_ptr(uint16_t page_id)
+{
+    return (uint8_t *)slab_mem + (uint32_t)page_id * SLAB_PAGE_SIZE;
+}
+
+static inline uint16_t page_from_ptr(const void * ptr)
+{
+    return (uint16_t)(((const uint8_t *)ptr - (uint8_t *)slab_mem) / SLAB_PAGE_SIZE);
+}
+
+static inline uint16_t page_block_cnt(uint8_t pool_id)
+{
+    return SLAB_PAGE_SIZE / pool_block_size[pool_id];
+}
+
+/**
+ * Add a page to the beginning of a list
+ * @param head pointer to the first page's index of the list
+ * @param page_id index of the page to add
+ */
+static void list_insert(uint16_t * head, uint16_t page_id)
+{
+    pages[page_id].prev = PAGE_NONE;
+    pages[page_id].next = *head;
+    if(*head != PAGE_NONE) pages[*head].prev = page_id;
+    *head = page_id;
+}
+
+/**
+ * Remove a page from a list
+ * @param head pointer to the first page's index of the list
+ * @param page_id index of the page to remove
+ */
+static void list_remove(uint16_t * head, uint16_t page_id)
+{
+    slab_page_t * page = &pages[page_id];
+    if(page->prev != PAGE_NONE) pages[page->prev].next = page->next;
+    else *head = page->next;
+
+    if(page->next != PAGE_NONE) pages[page->next].prev = page->prev;
+}
+
+#endif /*LV_MEM_SLAB*/
@@ -0,0 +1,102 @@
+/**
+ * @file lv_slab.h
+ * Fixed size pools for the small allocations of `lv_mem` if `LV_MEM_SLAB` is enabled
+ */
+
+#ifndef LV_SLAB_H
+#define LV_SLAB_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+
+#if LV_MEM_SLAB
+
+#if LV_ENABLE_GC
+#error "LV_MEM_SLAB can't be used with LV_ENABLE_GC"
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "lv_mem.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize the pools. All the pages become empty.
+ */
+void _lv_slab_init(void);
+
+/**
+ * Allocate a block from the pool of the smallest suitable block size
+ * @param size size of the memory to allocate in bytes
+ * @return pointer to the block or NULL if `size` is too large or there is no free page
+ */
+void * _lv_slab_alloc(size_t size);
+
+/**
+ * Give back a block to its pool. The page is released if all of its blocks are free.
+ * @param ptr pointer to a block allocated by `_lv_slab_alloc`
+ */
+void _lv_slab_free(void * ptr);
+
+/**
+ * Tell whether a pointer points into the memory area of the pools
+ * @param ptr any pointer
+ * @return true: `ptr` was allocated by `_lv_slab_alloc`
+ */
+bool _lv_slab_is_slab(const void * ptr);
+
+/**
+ * Get the usable size of a block
+ * @param ptr pointer to a block allocated by `_lv_slab_alloc`
+ * @return the block size of its pool
+ */
+uint32_t _lv_slab_block_size(const void * ptr);
+
+/**
+ * Check the pages and the free lists of the pools
+ * @return true: no error found
+ */
+bool _lv_slab_check(void);
+
+/**
+ * Get the number of pools
+ * @return number of pools
+ */
+uint8_t _lv_slab_get_pool_cnt(void);
+
+/**
+ * Get the usage of a pool
+ * @param pool_id index of a pool, `0 ... _lv_slab_get_pool_cnt() - 1`
+ * @param stat store the result here
+ */
+void _lv_slab_get_stat(uint8_t pool_id, lv_mem_slab_stat_t * stat);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_MEM_SLAB*/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_SLAB_H*/
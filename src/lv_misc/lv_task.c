@@ -210,7 +210,9 @@ lv_task_t * lv_task_create(lv_task_cb_t task_xcb, uint32_t period, lv_task_prio_
 
     /*It's the first task*/
     if(NULL == tmp) {
+        _lv_mem_tag_push(LV_MEM_TAG_TASK);
         new_task = _lv_ll_ins_head(&LV_GC_ROOT(_lv_task_ll));
+        _lv_mem_tag_pop();
         LV_ASSERT_MEM(new_task);
         if(new_task == NULL) return NULL;
     }
@@ -218,7 +220,9 @@ lv_task_t * lv_task_create(lv_task_cb_t task_xcb, uint32_t period, lv_task_prio_
     else {
         do {
             if(tmp->prio <= prio) {
+                _lv_mem_tag_push(LV_MEM_TAG_TASK);
                 new_task = _lv_ll_ins_prev(&LV_GC_ROOT(_lv_task_ll), tmp);
+                _lv_mem_tag_pop();
                 LV_ASSERT_MEM(new_task);
                 if(new_task == NULL) return NULL;
                 break;
@@ -228,7 +232,9 @@ lv_task_t * lv_task_create(lv_task_cb_t task_xcb, uint32_t period, lv_task_prio_
 
         /*Only too high priority tasks were found. Add the task to the end*/
         if(tmp == NULL) {
+            _lv_mem_tag_push(LV_MEM_TAG_TASK);
             new_task = _lv_ll_ins_tail(&LV_GC_ROOT(_lv_task_ll));
+            _lv_mem_tag_pop();
             LV_ASSERT_MEM(new_task);
             if(new_task == NULL) return NULL;
         }
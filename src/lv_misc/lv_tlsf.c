@@ -0,0 +1,659 @@
+/**
+ * @file lv_tlsf.c
+ * Two-level segregated fit (TLSF) allocator.
+ * The free blocks are stored in lists by size classes: the first level is the power of 2 range of the size,
+ * the second level divides the range linearly. Bitmaps tell which lists are not empty so
+ * a large enough free block can be found with a few bit operations, independently of the number of blocks.
+ * The freed blocks are joined with the adjacent free blocks immediately.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_tlsf.h"
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF
+
+#include "lv_mem.h"
+#include "lv_math.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+/*Every block and size is aligned to the size of a pointer*/
+#define ALIGN_SIZE              sizeof(void *)
+
+/*Number of linear subdivisions of the power of 2 ranges*/
+#define SL_INDEX_COUNT_LOG2     4
+#define SL_INDEX_COUNT          (1 << SL_INDEX_COUNT_LOG2)
+
+/*The blocks smaller than `SMALL_BLOCK_SIZE` are all in the first level divided by `ALIGN_SIZE`*/
+#define ALIGN_SIZE_LOG2         (ALIGN_SIZE == 8 ? 3 : 2)
+#define FL_INDEX_SHIFT          (SL_INDEX_COUNT_LOG2 + ALIGN_SIZE_LOG2)
+#define FL_INDEX_MAX            (ALIGN_SIZE == 8 ? 32 : 30)
+#define FL_INDEX_COUNT          (FL_INDEX_MAX - FL_INDEX_SHIFT + 1)
+#define SMALL_BLOCK_SIZE        ((size_t)1 << FL_INDEX_SHIFT)
+
+#define BLOCK_FREE_BIT          ((size_t)1 << 0)
+#define BLOCK_PREV_FREE_BIT     ((size_t)1 << 1)
+#define BLOCK_FLAGS             (BLOCK_FREE_BIT | BLOCK_PREV_FREE_BIT)
+
+/*Only the `size` field is stored for the used blocks, `prev_phys` is in the end of the previous block*/
+#define BLOCK_OVERHEAD          sizeof(size_t)
+#define BLOCK_START_OFFSET      (offsetof(tlsf_block_t, size) + sizeof(size_t))
+
+/*A free block needs to store `next_free` and `prev_free` and the `prev_phys` of the next block*/
+#define BLOCK_SIZE_MIN          (sizeof(tlsf_block_t) - sizeof(tlsf_block_t *))
+#define BLOCK_SIZE_MAX          ((size_t)1 << FL_INDEX_MAX)
+
+/*The pool header, the header of the first block and the zero sized sentinel block in the end*/
+#define POOL_OVERHEAD           (sizeof(tlsf_pool_t) + BLOCK_START_OFFSET + BLOCK_OVERHEAD)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct _tlsf_block_t {
+    struct _tlsf_block_t * prev_phys;   /*The previous block in the memory. Valid only if it's free*/
+    size_t size;                        /*Size of the data with `BLOCK_FLAGS` in the lowest bits*/
+    struct _tlsf_block_t * next_free;   /*The free blocks of the same size class. Valid only if the block is free*/
+    struct _tlsf_block_t * prev_free;
+} tlsf_block_t;
+
+typedef struct _tlsf_pool_t {
+    struct _tlsf_pool_t * next;
+    size_t size;                        /*Size of the whole pool in bytes*/
+} tlsf_pool_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static inline size_t block_size(const tlsf_block_t * block);
+static inline bool block_is_free(const tlsf_block_t * block);
+static inline bool block_is_prev_free(const tlsf_block_t * block);
+static inline void * block_to_ptr(const tlsf_block_t * block);
+static inline tlsf_block_t * block_from_ptr(const void * ptr);
+static inline tlsf_block_t * block_next(const tlsf_block_t * block);
+static inline tlsf_block_t * block_link_next(tlsf_block_t * block);
+static void block_mark_as_free(tlsf_block_t * block);
+static void block_mark_as_used(tlsf_block_t * block);
+static int fls_size(size_t x);
+static int ffs_u32(uint32_t x);
+static void mapping_insert(size_t size, int * fl, int * sl);
+static void mapping_search(size_t size, int * fl, int * sl);
+static size_t adjust_request_size(size_t size);
+static tlsf_block_t * find_suitable_block(int * fl, int * sl);
+static void remove_free_block(tlsf_block_t * block, int fl, int sl);
+static void insert_free_block(tlsf_block_t * block, int fl, int sl);
+static void block_remove(tlsf_block_t * block);
+static void block_insert(tlsf_block_t * block);
+static tlsf_block_t * block_split(tlsf_block_t * block, size_t size);
+static tlsf_block_t * block_absorb(tlsf_block_t * prev, tlsf_block_t * block);
+static tlsf_block_t * block_merge_prev(tlsf_block_t * block);
+static tlsf_block_t * block_merge_next(tlsf_block_t * block);
+static void block_trim_free(tlsf_block_t * block, size_t size);
+static void block_trim_used(tlsf_block_t * block, size_t size);
+static tlsf_block_t * pool_first_block(const tlsf_pool_t * pool);
+static void used_add(size_t size);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static uint32_t fl_bitmap;
+static uint32_t sl_bitmap[FL_INDEX_COUNT];
+static tlsf_block_t * blocks[FL_INDEX_COUNT][SL_INDEX_COUNT];
+static tlsf_pool_t * pools;
+static size_t used_size;
+static size_t max_used;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Initialize the allocator without any pools
+ */
+void _lv_tlsf_init(void)
+{
+    fl_bitmap = 0;
+    _lv_memset_00(sl_bitmap, sizeof(sl_bitmap));
+    _lv_memset_00(blocks, sizeof(blocks));
+    pools = NULL;
+    used_size = 0;
+    max_used = 0;
+}
+
+/**
+ * Add a memory area to allocate from
+ * @param mem pointer to the memory area
+ * @param bytes size of the memory area
+ * @return true: the pool is added; false: the memory area is too small
+ */
+bool _lv_tlsf_add_pool(void * mem, size_t bytes)
+{
+    /*Align the start and the size of the pool*/
+    lv_uintptr_t start = ((lv_uintptr_t)mem + ALIGN_SIZE - 1) & ~((lv_uintptr_t)ALIGN_SIZE - 1);
+    size_t skip = start - (lv_uintptr_t)mem;
+    if(bytes < skip + POOL_OVERHEAD + BLOCK_SIZE_MIN) return false;
+    bytes = (bytes - skip) & ~(ALIGN_SIZE - 1);
+
+    size_t size = bytes - POOL_OVERHEAD;
+    if(size >= BLOCK_SIZE_MAX) size = BLOCK_SIZE_MAX - ALIGN_SIZE;
+
+    tlsf_pool_t * pool = (tlsf_pool_t *)start;
+    pool->size = bytes;
+    pool->next = pools;
+    pools = pool;
+
+    /*The whole pool is one free block*/
+    tlsf_block_t * block = pool_first_block(pool);
+    block->size = size | BLOCK_FREE_BIT;
+    block_insert(block);
+
+    /*Close the pool with a used, zero sized block*/
+    tlsf_block_t * sentinel = block_link_next(block);
+    sentinel->size = BLOCK_PREV_FREE_BIT;
+
+    return true;
+}
+
+/**
+ * Allocate memory in constant time
+ * @param size size of the memory to allocate in bytes
+ * @return pointer to the allocated memory or NULL if there is not large enough free block
+ */
+void * _lv_tlsf_malloc(size_t size)
+{
+    size_t adjust = adjust_request_size(size);
+    if(adjust == 0) return NULL;
+
+    int fl;
+    int sl;
+    mapping_search(adjust, &fl, &sl);
+    tlsf_block_t * block = find_suitable_block(&fl, &sl);
+    if(block == NULL) return NULL;
+
+    remove_free_block(block, fl, sl);
+    block_trim_free(block, adjust);
+    block_mark_as_used(block);
+    used_add(block_size(block) + BLOCK_OVERHEAD);
+
+    return block_to_ptr(block);
+}
+
+/**
+ * Free a memory and join it with the adjacent free blocks
+ * @param ptr pointer to a memory allocated by `_lv_tlsf_malloc`
+ */
+void _lv_tlsf_free(void * ptr)
+{
+    if(ptr == NULL) return;
+
+    tlsf_block_t * block = block_from_ptr(ptr);
+    used_size -= block_size(block) + BLOCK_OVERHEAD;
+
+    block_mark_as_free(block);
+    block = block_merge_prev(block);
+    block = block_merge_next(block);
+    block_insert(block);
+}
+
+/**
+ * Change the size of an allocated memory. Grow or shrink it in place if possible.
+ * @param ptr pointer to a memory allocated by `_lv_tlsf_malloc` or NULL
+ * @param size the new size in bytes
+ * @return pointer to the reallocated memory or NULL if there is not enough memory (`ptr` is kept then)
+ */
+void * _lv_tlsf_realloc(void * ptr, size_t size)
+{
+    if(ptr == NULL) return _lv_tlsf_malloc(size);
+
+    size_t adjust = adjust_request_size(size);
+    if(adjust == 0) return NULL;
+
+    tlsf_block_t * block = block_from_ptr(ptr);
+    tlsf_block_t * next = block_next(block);
+    size_t cur_size = block_size(block);
+    size_t combined = cur_size + block_size(next) + BLOCK_OVERHEAD;
+
+    /*Can't grow in place: move the data*/
+    if(adjust > cur_size && (!block_is_free(next) || adjust > combined)) {
+        void * new_p = _lv_tlsf_malloc(size);
+        if(new_p) {
+            _lv_memcpy(new_p, ptr, LV_MATH_MIN(cur_size, size));
+            _lv_tlsf_free(ptr);
+        }
+        return new_p;
+    }
+
+    used_size -= cur_size;
+    if(adjust > cur_size) {
+        block_merge_next(block);
+        block_mark_as_used(block);
+    }
+
+    /*Give back the end of the block if it's large enough*/
+    block_trim_used(block, adjust);
+    used_add(block_size(block));
+
+    return ptr;
+}
+
+/**
+ * Get the usable size of an allocated memory
+ * @param ptr pointer to a memory allocated by `_lv_tlsf_malloc`
+ * @return the size in bytes. It can be larger than the requested size.
+ */
+size_t _lv_tlsf_block_size(const void * ptr)
+{
+    if(ptr == NULL) return 0;
+    return block_size(block_from_ptr(ptr));
+}
+
+/**
+ * Tell whether a pointer points to a free block
+ * @param ptr pointer to a memory allocated by `_lv_tlsf_malloc`
+ * @return true: the memory is already freed
+ */
+bool _lv_tlsf_is_free(const void * ptr)
+{
+    return block_is_free(block_from_ptr(ptr));
+}
+
+/**
+ * Check the blocks of the pools and the free lists
+ * @return true: no error found
+ */
+bool _lv_tlsf_check(void)
+{
+    /*Walk the blocks of the pools*/
+    uint32_t free_cnt = 0;
+    tlsf_pool_t * pool;
+    for(pool = pools; pool; pool = pool->next) {
+        const uint8_t * pool_end = (const uint8_t *)pool + pool->size;
+        tlsf_block_t * block = pool_first_block(pool);
+        bool prev_free = false;
+        while(block_size(block) != 0) {
+            if((const uint8_t *)block_to_ptr(block) + block_size(block) + BLOCK_OVERHEAD > pool_end) return false;
+            if(block_is_prev_free(block) != prev_free) return false;
+            if(block_is_free(block)) {
+                /*Adjacent free blocks should have been joined*/
+                if(prev_free) return false;
+                free_cnt++;
+            }
+            prev_free = block_is_free(block);
+            block = block_next(block);
+        }
+
+        if(block_is_prev_free(block) != prev_free) return false;
+    }
+
+    /*Every free block should be in the list of its size class*/
+    uint32_t list_cnt = 0;
+    int fl;
+    int sl;
+    for(fl = 0; fl < FL_INDEX_COUNT; fl++) {
+        if(((fl_bitmap & (1U << fl)) != 0) != (sl_bitmap[fl] != 0)) return false;
+        for(sl = 0; sl < SL_INDEX_COUNT; sl++) {
+            if(((sl_bitmap[fl] & (1U << sl)) != 0) != (blocks[fl][sl] != NULL)) return false;
+
+            tlsf_block_t * block;
+            for(block = blocks[fl][sl]; block; block = block->next_free) {
+                if(!block_is_free(block)) return false;
+                int fl_act;
+                int sl_act;
+                mapping_insert(block_size(block), &fl_act, &sl_act);
+                if(fl_act != fl || sl_act != sl) return false;
+
+                list_cnt++;
+                if(list_cnt > free_cnt) return false;   /*Also stops on a looped list*/
+            }
+        }
+    }
+
+    return list_cnt == free_cnt;
+}
+
+/**
+ * Collect statistics about the pools
+ * @param stat store the result here
+ */
+void _lv_tlsf_get_stat(lv_tlsf_stat_t * stat)
+{
+    _lv_memset_00(stat, sizeof(lv_tlsf_stat_t));
+
+    tlsf_pool_t * pool;
+    for(pool = pools; pool; pool = pool->next) {
+        stat->total_size += pool->size;
+        tlsf_block_t * block = pool_first_block(pool);
+        while(block_size(block) != 0) {
+            if(block_is_free(block)) {
+                stat->free_cnt++;
+                stat->free_size += block_size(block);
+                if(block_size(block) > stat->free_biggest_size) stat->free_biggest_size = block_size(block);
+            }
+            else {
+                stat->used_cnt++;
+            }
+            block = block_next(block);
+        }
+    }
+
+    stat->max_used = max_used;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static inline size_t block_size(const tlsf_block_t * block)
+{
+    return block->size & ~BLOCK_FLAGS;
+}
+
+static inline bool block_is_free(const tlsf_block_t * block)
+{
+    return (block->size & BLOCK_FREE_BIT) ? true : false;
+}
+
+static inline bool block_is_prev_free(const tlsf_block_t * block)
+{
+    return (block->size & BLOCK_PREV_FREE_BIT) ? true : false;
+}
+
+static inline void * block_to_ptr(const tlsf_block_t * block)
+{
+    return (uint8_t *)block + BLOCK_START_OFFSET;
+}
+
+static inline tlsf_block_t * block_from_ptr(const void * ptr)
+{
+    return (tlsf_block_t *)((uint8_t *)ptr - BLOCK_START_OFFSET);
+}
+
+/**
+ * Get the next block in the memory. Its `prev_phys` overlaps with the end of this block's data.
+ */
+static inline tlsf_block_t * block_next(const tlsf_block_t * block)
+{
+    return (tlsf_block_t *)((uint8_t *)block_to_ptr(block) + block_size(block) - BLOCK_OVERHEAD);
+}
+
+/**
+ * Store the block in the next block's `prev_phys`
+ * @return the next block
+ */
+static inline tlsf_block_t * block_link_next(tlsf_block_t * block)
+{
+    tlsf_block_t * next = block_next(block);
+    next->prev_phys = block;
+    return next;
+}
+
+static void block_mark_as_free(tlsf_block_t * block)
+{
+    tlsf_block_t * next = block_link_next(block);
+    next->size |= BLOCK_PREV_FREE_BIT;
+    block->size |= BLOCK_FREE_BIT;
+}
+
+static void block_mark_as_used(tlsf_block_t * block)
+{
+    tlsf_block_t * next = block_next(block);
+    next->size &= ~BLOCK_PREV_FREE_BIT;
+    block->size &= ~BLOCK_FREE_BIT;
+}
+
+/**
+ * Find the last (most significant) set bit
+ * @param x a value
+ * @return index of the bit or -1 if `x` is 0
+ */
+static int fls_size(size_t x)
+{
+    if(x == 0) return -1;
+#if defined(__GNUC__)
+    return (int)(sizeof(unsigned long long) * 8 - 1) - __builtin_clzll((unsigned long long)x);
+#else
+    int bit = 0;
+    if(sizeof(size_t) > 4 && (x >> 16 >> 16)) {
+        x = x >> 16 >> 16;
+        bit += 32;
+    }
+    if(x & 0xFFFF0000) {
+        x >>= 16;
+        bit += 16;
+    }
+    if(x & 0xFF00) {
+        x >>= 8;
+        bit += 8;
+    }
+    if(x & 0xF0) {
+        x >>= 4;
+        bit += 4;
+    }
+    if(x & 0xC) {
+        x >>= 2;
+        bit += 2;
+    }
+    if(x & 0x2) bit += 1;
+    return bit;
+#endif
+}
+
+/**
+ * Find the first (least significant) set bit
+ * @param x a non-zero value
+ * @return index of the bit
+ */
+static int ffs_u32(uint32_t x)
+{
+#if defined(__GNUC__)
+    return __builtin_ctz(x);
+#else
+    return fls_size(x & (~x + 1));
+#endif
+}
+
+/**
+ * Get the size class of a block
+ * @param size size of the block
+ * @param fl store the first level index here
+ * @param sl store the second level index here
+ */
+static void mapping_insert(size_t size, int * fl, int * sl)
+{
+    if(size < SMALL_BLOCK_SIZE) {
+        *fl = 0;
+        *sl = (int)(size / (SMALL_BLOCK_SIZE / SL_INDEX_COUNT));
+    }
+    else {
+        int f = fls_size(size);
+        *sl = (int)(size >> (f - SL_INDEX_COUNT_LOG2)) ^ SL_INDEX_COUNT;
+        *fl = f - (FL_INDEX_SHIFT - 1);
+    }
+}
+
+/**
+ * Get the smallest size class whose every block is at least `size` large
+ * @param size the required size
+ * @param fl store the first level index here
+ * @param sl store the second level index here
+ */
+static void mapping_search(size_t size, int * fl, int * sl)
+{
+    if(size >= SMALL_BLOCK_SIZE) {
+        size += ((size_t)1 << (fls_size(size) - SL_INDEX_COUNT_LOG2)) - 1;
+    }
+    mapping_insert(size, fl, sl);
+}
+
+/**
+ * Align the requested size and make it large enough to be freed later
+ * @param size the requested size
+ * @return the size of the block to allocate or 0 if `size` is 0 or too large
+ */
+static size_t adjust_request_size(size_t size)
+{
+    if(size == 0 || size >= BLOCK_SIZE_MAX) return 0;
+
+    size = (size + ALIGN_SIZE - 1) & ~(ALIGN_SIZE - 1);
+    return size < BLOCK_SIZE_MIN ? BLOCK_SIZE_MIN : size;
+}
+
+/**
+ * Find a free block in the given or in a larger size class
+ * @param fl the first level index. Updated to the class of the found block.
+ * @param sl the second level index. Updated to the class of the found block.
+ * @return a free block or NULL if there is no large enough free block
+ */
+static tlsf_block_t * find_suitable_block(int * fl, int * sl)
+{
+    if(*fl >= FL_INDEX_COUNT) return NULL;
+
+    uint32_t sl_map = sl_bitmap[*fl] & (~0U << *sl);
+    if(sl_map == 0) {
+        /*Use a block from a larger first level class*/
+        uint32_t fl_map = fl_bitmap & (~0U << (*fl + 1));
+        if(fl_map == 0) return NULL;
+
+        *fl = ffs_u32(fl_map);
+        sl_map = sl_bitmap[*fl];
+    }
+
+    *sl = ffs_u32(sl_map);
+    return blocks[*fl][*sl];
+}
+
+static void remove_free_block(tlsf_block_t * block, int fl, int sl)
+{
+    tlsf_block_t * prev = block->prev_free;
+    tlsf_block_t * next = block->next_free;
+    if(next) next->prev_free = prev;
+    if(prev) prev->next_free = next;
+
+    if(blocks[fl][sl] == block) {
+        blocks[fl][sl] = next;
+        if(next == NULL) {
+            sl_bitmap[fl] &= ~(1U << sl);
+            if(sl_bitmap[fl] == 0) fl_bitmap &= ~(1U << fl);
+        }
+    }
+}
+
+static void insert_free_block(tlsf_block_t * block, int fl, int sl)
+{
+    tlsf_block_t * cur = blocks[fl][sl];
+    block->next_free = cur;
+    block->prev_free = NULL;
+    if(cur) cur->prev_free = block;
+
+    blocks[fl][sl] = block;
+    fl_bitmap |= 1U << fl;
+    sl_bitmap[fl] |= 1U << sl;
+}
+
+static void block_remove(tlsf_block_t * block)
+{
+    int fl;
+    int sl;
+    mapping_insert(block_size(block), &fl, &sl);
+    remove_free_block(block, fl, sl);
+}
+
+static void block_insert(tlsf_block_t * block)
+{
+    int fl;
+    int sl;
+    mapping_insert(block_size(block), &fl, &sl);
+    insert_free_block(block, fl, sl);
+}
+
+/**
+ * Split a block to `size` and a free remaining block
+ * @param block the block to split. It must be larger than `size + sizeof(tlsf_block_t)`
+ * @param size the new size of `block`
+ * @return the remaining block
+ */
+static tlsf_block_t * block_split(tlsf_block_t * block, size_t size)
+{
+    tlsf_block_t * remaining = (tlsf_block_t *)((uint8_t *)block_to_ptr(block) + size - BLOCK_OVERHEAD);
+    remaining->size = block_size(block) - (size + BLOCK_OVERHEAD);
+    block->size = size | (block->size & BLOCK_FLAGS);
+    block_mark_as_free(remaining);
+
+    return remaining;
+}
+
+/**
+ * Join a block to the previous block
+ * @return the joined block
+ */
+static tlsf_block_t * block_absorb(tlsf_block_t * prev, tlsf_block_t * block)
+{
+    prev->size += block_size(block) + BLOCK_OVERHEAD;
+    block_link_next(prev);
+    return prev;
+}
+
+static tlsf_block_t * block_merge_prev(tlsf_block_t * block)
+{
+    if(block_is_prev_free(block)) {
+        tlsf_block_t * prev = block->prev_phys;
+        block_remove(prev);
+        block = block_absorb(prev, block);
+    }
+
+    return block;
+}
+
+static tlsf_block_t * block_merge_next(tlsf_block_t * block)
+{
+    tlsf_block_t * next = block_next(block);
+    if(block_is_free(next)) {
+        block_remove(next);
+        block = block_absorb(block, next);
+    }
+
+    return block;
+}
+
+/**
+ * Give back the end of a free block which is not in a free list
+ */
+static void block_trim_free(tlsf_block_t * block, size_t size)
+{
+    if(block_size(block) >= sizeof(tlsf_block_t) + size) {
+        tlsf_block_t * remaining = block_split(block, size);
+        block_link_next(block);
+        remaining->size |= BLOCK_PREV_FREE_BIT;
+        block_insert(remaining);
+    }
+}
+
+/**
+ * Give back the end of a used block
+ */
+static void block_trim_used(tlsf_block_t * block, size_t size)
+{
+    if(block_size(block) >= sizeof(tlsf_block_t) + size) {
+        tlsf_block_t * remaining = block_split(block, size);
+        remaining = block_merge_next(remaining);
+        block_insert(remaining);
+    }
+}
+
+static tlsf_block_t * pool_first_block(const tlsf_pool_t * pool)
+{
+    return (tlsf_block_t *)((uint8_t *)pool + sizeof(tlsf_pool_t));
+}
+
+static void used_add(size_t size)
+{
+    used_size += size;
+    if(used_size > max_used) max_used = used_size;
+}
+
+#endif /*LV_MEM_CUSTOM == 0 && LV_MEM_TLSF*/
@@ -0,0 +1,118 @@
+/**
+ * @file lv_tlsf.h
+ * Two-level segregated fit (TLSF) allocator used by `lv_mem` if `LV_MEM_TLSF` is enabled
+ */
+
+#ifndef LV_TLSF_H
+#define LV_TLSF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * Statistics of the blocks in all pools
+ */
+typedef struct {
+    uint32_t total_size;        /**< Size of all pools*/
+    uint32_t free_cnt;
+    uint32_t free_size;
+    uint32_t free_biggest_size;
+    uint32_t used_cnt;
+    uint32_t max_used;          /**< The most bytes ever allocated at the same time (with the block headers)*/
+} lv_tlsf_stat_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize the allocator without any pools
+ */
+void _lv_tlsf_init(void);
+
+/**
+ * Add a memory area to allocate from
+ * @param mem pointer to the memory area
+ * @param bytes size of the memory area
+ * @return true: the pool is added; false: the memory area is too small
+ */
+bool _lv_tlsf_add_pool(void * mem, size_t bytes);
+
+/**
+ * Allocate memory in constant time
+ * @param size size of the memory to allocate in bytes
+ * @return pointer to the allocated memory or NULL if there is not large enough free block
+ */
+void * _lv_tlsf_malloc(size_t size);
+
+/**
+ * Free a memory and join it with the adjacent free blocks
+ * @param ptr pointer to a memory allocated by `_lv_tlsf_malloc`
+ */
+void _lv_tlsf_free(void * ptr);
+
+/**
+ * Change the size of an allocated memory. Grow or shrink it in place if possible.
+ * @param ptr pointer to a memory allocated by `_lv_tlsf_malloc` or NULL
+ * @param size the new size in bytes
+ * @return pointer to the reallocated memory or NULL if there is not enough memory (`ptr` is kept then)
+ */
+void * _lv_tlsf_realloc(void * ptr, size_t size);
+
+/**
+ * Get the usable size of an allocated memory
+ * @param ptr pointer to a memory allocated by `_lv_tlsf_malloc`
+ * @return the size in bytes. It can be larger than the requested size.
+ */
+size_t _lv_tlsf_block_size(const void * ptr);
+
+/**
+ * Tell whether a pointer points to a free block
+ * @param ptr pointer to a memory allocated by `_lv_tlsf_malloc`
+ * @return true: the memory is already freed
+ */
+bool _lv_tlsf_is_free(const void * ptr);
+
+/**
+ * Check the blocks of the pools and the free lists
+ * @return true: no error found
+ */
+bool _lv_tlsf_check(void);
+
+/**
+ * Collect statistics about the pools
+ * @param stat store the result here
+ */
+void _lv_tlsf_get_stat(lv_tlsf_stat_t * stat);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_MEM_CUSTOM == 0 && LV_MEM_TLSF*/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_TLSF_H*/
@@ -18,14 +18,44 @@
  *********************/
 #define NO_BREAK_FOUND UINT32_MAX
 
+#define ASCII_FIRST     0x20
+#define ASCII_CNT       (0x7E - ASCII_FIRST + 1)
+#define ASCII_W_UNKNOWN 0xFF    /*The width of the letter is not measured yet*/
+#define ASCII_W_INV     0xFE    /*The letter is too wide to store its width*/
+
+/*The fonts are cached in sets of `ASCII_WAY_CNT` entries selected by the address of the font*/
+#define ASCII_WAY_CNT   (LV_TXT_ASCII_WIDTH_CACHE_SIZE < 4 ? LV_TXT_ASCII_WIDTH_CACHE_SIZE : 4)
+#define ASCII_SET_CNT   ((LV_TXT_ASCII_WIDTH_CACHE_SIZE + ASCII_WAY_CNT - 1) / ASCII_WAY_CNT)
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+#if LV_TXT_ASCII_WIDTH_CACHE_SIZE
+/*The advance width of the printable ASCII letters of a font*/
+typedef struct {
+    const lv_font_t * font;                     /*NULL: unused entry*/
+    uint32_t last_used;                         /*`ascii_width_tick` when the entry was used last time*/
+    uint8_t adv_w[ASCII_CNT];                   /*Width without kerning, `ASCII_W_UNKNOWN` or `ASCII_W_INV`*/
+    uint8_t kern_checked[(ASCII_CNT + 7) / 8];  /*1: the kerning pairs of the letter on the left are checked*/
+    uint8_t kern_has[(ASCII_CNT + 7) / 8];      /*1: the letter on the left has kerning with an ASCII letter*/
+} ascii_width_t;
+#else
+typedef void ascii_width_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static inline bool is_break_char(uint32_t letter);
+static inline uint32_t txt_next(const char * txt, uint32_t * i);
+static inline uint32_t txt_peek(const char * txt);
+static inline lv_coord_t get_glyph_width(ascii_width_t * aw, const lv_font_t * font, uint32_t letter,
+                                         uint32_t letter_next);
+#if LV_TXT_ASCII_WIDTH_CACHE_SIZE
+    static ascii_width_t * get_ascii_width(const lv_font_t * font);
+    static bool ascii_has_kerning(ascii_width_t * aw, uint32_t letter);
+#endif
 
 #if LV_TXT_ENC == LV_TXT_ENC_UTF8
     static uint8_t lv_txt_utf8_size(const char * str);
@@ -49,6 +79,10 @@ static inline bool is_break_char(uint32_t letter);
 /**********************
  *  STATIC VARIABLES
  **********************/
+#if LV_TXT_ASCII_WIDTH_CACHE_SIZE
+    static ascii_width_t ascii_width_cache[ASCII_SET_CNT][ASCII_WAY_CNT];
+    static uint32_t ascii_width_tick;
+#endif
 
 /**********************
  *  GLOBAL VARIABLES
@@ -190,12 +224,18 @@ static uint32_t lv_txt_get_next_word(const char * txt, const lv_font_t * font,
     uint32_t break_index = NO_BREAK_FOUND; /* only used for "long" words */
     uint32_t break_letter_count = 0; /* Number of characters up to the long word break point */
 
-    letter = _lv_txt_encoded_next(txt, &i_next);
+#if LV_TXT_ASCII_WIDTH_CACHE_SIZE
+    ascii_width_t * aw = get_ascii_width(font);
+#else
+    ascii_width_t * aw = NULL;
+#endif
+
+    letter = txt_next(txt, &i_next);
     i_next_next = i_next;
 
     /* Obtain the full word, regardless if it fits or not in max_width */
     while(txt[i] != '\0') {
-        letter_next = _lv_txt_encoded_next(txt, &i_next_next);
+        letter_next = txt_next(txt, &i_next_next);
         word_len++;
 
         /*Handle the recolor command*/
@@ -208,7 +248,7 @@ static uint32_t lv_txt_get_next_word(const char * txt, const lv_font_t * font,
             }
         }
 
-        letter_w = lv_font_get_glyph_width(font, letter, letter_next);
+        letter_w = get_glyph_width(aw, font, letter, letter_next);
         cur_w += letter_w;
 
         if(letter_w > 0) {
@@ -363,17 +403,23 @@ lv_coord_t _lv_txt_get_width(const char * txt, uint32_t length, const lv_font_t
     lv_coord_t width             = 0;
     lv_txt_cmd_state_t cmd_state = LV_TXT_CMD_STATE_WAIT;
 
+#if LV_TXT_ASCII_WIDTH_CACHE_SIZE
+    ascii_width_t * aw = get_ascii_width(font);
+#else
+    ascii_width_t * aw = NULL;
+#endif
+
     if(length != 0) {
         while(i < length) {
-            uint32_t letter      = _lv_txt_encoded_next(txt, &i);
-            uint32_t letter_next = _lv_txt_encoded_next(&txt[i], NULL);
+            uint32_t letter      = txt_next(txt, &i);
+            uint32_t letter_next = txt_peek(&txt[i]);
             if((flag & LV_TXT_FLAG_RECOLOR) != 0) {
                 if(_lv_txt_is_cmd(&cmd_state, letter) != false) {
                     continue;
                 }
             }
 
-            lv_coord_t char_width = lv_font_get_glyph_width(font, letter, letter_next);
+            lv_coord_t char_width = get_glyph_width(aw, font, letter, letter_next);
             if(char_width > 0) {
                 width += char_width;
                 width += letter_space;
@@ -389,6 +435,24 @@ lv_coord_t _lv_txt_get_width(const char * txt, uint32_t length, const lv_font_t
     return width;
 }
 
+/**
+ * Remove a font and the fonts using it as a fallback from the cache of the ASCII letter widths.
+ * Should be called if the glyphs or the `fallback` of a font were changed or the font was deleted.
+ * @param font pointer to a font, or NULL to clear the whole cache
+ */
+void _lv_txt_ascii_width_cache_invalidate(const lv_font_t * font)
+{
+#if LV_TXT_ASCII_WIDTH_CACHE_SIZE
+    ascii_width_t * aw = &ascii_width_cache[0][0];
+    uint32_t i;
+    for(i = 0; i < ASCII_SET_CNT * ASCII_WAY_CNT; i++) {
+        if(aw[i].font && (font == NULL || _lv_font_uses_font(aw[i].font, font))) aw[i].font = NULL;
+    }
+#else
+    LV_UNUSED(font);
+#endif
+}
+
 /**
  * Check next character in a string and decide if the character is part of the command or not
  * @param state pointer to a txt_cmd_state_t variable which stores the current state of command
@@ -910,3 +974,125 @@ static inline bool is_break_char(uint32_t letter)
 
     return ret;
 }
+
+/**
+ * Get the next letter of a text. ASCII characters are read directly, without the decoder.
+ * @param txt a text
+ * @param i start index in `txt`. Will point to the next letter after the call.
+ * @return the letter
+ */
+static inline uint32_t txt_next(const char * txt, uint32_t * i)
+{
+    uint8_t c = txt[*i];
+    if(c < 0x80) {
+        (*i)++;
+        return c;
+    }
+
+    return _lv_txt_encoded_next(txt, i);
+}
+
+/**
+ * Get the first letter of a text without moving forward in it
+ * @param txt a text
+ * @return the letter
+ */
+static inline uint32_t txt_peek(const char * txt)
+{
+    uint8_t c = txt[0];
+    if(c < 0x80) return c;
+
+    return _lv_txt_encoded_next(txt, NULL);
+}
+
+/**
+ * Get the width of a glyph with kerning. Use the cached width of the ASCII letters if possible.
+ * @param aw the cached widths of `font` or NULL
+ * @param font pointer to a font
+ * @param letter an UNICODE letter
+ * @param letter_next the next letter after `letter`. Used for kerning
+ * @return the width of the glyph
+ */
+static inline lv_coord_t get_glyph_width(ascii_width_t * aw, const lv_font_t * font, uint32_t letter,
+                                         uint32_t letter_next)
+{
+#if LV_TXT_ASCII_WIDTH_CACHE_SIZE
+    uint32_t id = letter - ASCII_FIRST;
+    if(aw && id < ASCII_CNT && aw->adv_w[id] == ASCII_W_UNKNOWN) {
+        /*Measure the letters only when they are first used*/
+        uint16_t w = lv_font_get_glyph_width(font, letter, '\0');
+        aw->adv_w[id] = w < ASCII_W_INV ? w : ASCII_W_INV;
+    }
+
+    if(aw && id < ASCII_CNT && aw->adv_w[id] != ASCII_W_INV) {
+        /*The cached width is measured without a next letter, so it's valid if there is no kerning*/
+        if(letter_next == '\0') return aw->adv_w[id];
+        if(letter_next - ASCII_FIRST < ASCII_CNT && !ascii_has_kerning(aw, letter)) return aw->adv_w[id];
+    }
+#else
+    LV_UNUSED(aw);
+#endif
+
+    return lv_font_get_glyph_width(font, letter, letter_next);
+}
+
+#if LV_TXT_ASCII_WIDTH_CACHE_SIZE
+/**
+ * Get the cached ASCII letter widths of a font. Add the font to the cache if it's not cached yet.
+ * The least recently used font of the set is replaced. The letters are measured later when first used.
+ * @param font pointer to a font
+ * @return the cached widths of the font or NULL if it was just added.
+ *         Measuring the letters pays off only if the font is used again.
+ */
+static ascii_width_t * get_ascii_width(const lv_font_t * font)
+{
+    ascii_width_t * set = ascii_width_cache[((lv_uintptr_t)font >> 4) % ASCII_SET_CNT];
+    ascii_width_tick++;
+
+    ascii_width_t * aw = &set[0];
+    uint32_t i;
+    for(i = 0; i < ASCII_WAY_CNT; i++) {
+        if(set[i].font == font) {
+            set[i].last_used = ascii_width_tick;
+            return &set[i];
+        }
+
+        /*Prefer the unused entries, else the one not used for the longest time*/
+        if(aw->font == NULL) continue;
+        if(set[i].font == NULL || ascii_width_tick - set[i].last_used > ascii_width_tick - aw->last_used) aw = &set[i];
+    }
+
+    _lv_memset_ff(aw->adv_w, sizeof(aw->adv_w));
+    _lv_memset_00(aw->kern_checked, sizeof(aw->kern_checked));
+    _lv_memset_00(aw->kern_has, sizeof(aw->kern_has));
+    aw->font = font;
+    aw->last_used = ascii_width_tick;
+
+    return NULL;
+}
+
+/**
+ * Tell whether an ASCII letter has kerning with any ASCII letter after it.
+ * The kerning pairs of a letter are checked only when it's first required.
+ * @param aw the cached widths of a font
+ * @param letter a printable ASCII letter
+ * @return true: the letter has kerning
+ */
+static bool ascii_has_kerning(ascii_width_t * aw, uint32_t letter)
+{
+    uint32_t id = letter - ASCII_FIRST;
+    uint8_t mask = 1 << (id & 0x7);
+    if(aw->kern_checked[id >> 3] & mask) return (aw->kern_has[id >> 3] & mask) ? true : false;
+
+    uint32_t i;
+    for(i = 0; i < ASCII_CNT; i++) {
+        if(lv_font_get_glyph_width(aw->font, letter, ASCII_FIRST + i) != aw->adv_w[id]) {
+            aw->kern_has[id >> 3] |= mask;
+            break;
+        }
+    }
+
+    aw->kern_checked[id >> 3] |= mask;
+    return (aw->kern_has[id >> 3] & mask) ? true : false;
+}
+#endif
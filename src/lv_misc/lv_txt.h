@@ -101,6 +101,13 @@ uint32_t _lv_txt_get_next_line(const char * txt, const lv_font_t * font, lv_coor
 lv_coord_t _lv_txt_get_width(const char * txt, uint32_t length, const lv_font_t * font, lv_coord_t letter_space,
                              lv_txt_flag_t flag);
 
+/**
+ * Remove a font and the fonts using it as a fallback from the cache of the ASCII letter widths.
+ * Should be called if the glyphs or the `fallback` of a font were changed or the font was deleted.
+ * @param font pointer to a font, or NULL to clear the whole cache
+ */
+void _lv_txt_ascii_width_cache_invalidate(const lv_font_t * font);
+
 /**
  * Check next character in a string and decide if the character is part of the command or not
  * @param state pointer to a txt_cmd_state_t variable which stores the current state of command
@@ -17,10 +17,14 @@
 #include "../lv_misc/lv_debug.h"
 #include "../lv_themes/lv_theme.h"
 #include "../lv_draw/lv_img_decoder.h"
+#include "../lv_draw/lv_img_cache.h"
 #include "../lv_misc/lv_fs.h"
 #include "../lv_misc/lv_txt.h"
 #include "../lv_misc/lv_math.h"
 #include "../lv_misc/lv_log.h"
+#if LV_USE_IMGBTN
+    #include "lv_imgbtn.h"
+#endif
 
 /*********************
  *      DEFINES
@@ -30,6 +34,8 @@
 /**********************
  *      TYPEDEFS
  **********************/
+/*Called with the images of an object tree. Return false to stop*/
+typedef bool (*tree_img_cb_t)(const void * src, lv_color_t color);
 
 /**********************
  *  STATIC PROTOTYPES
@@ -37,6 +43,9 @@
 static lv_design_res_t lv_img_design(lv_obj_t * img, const lv_area_t * clip_area, lv_design_mode_t mode);
 static lv_res_t lv_img_signal(lv_obj_t * img, lv_signal_t sign, void * param);
 static lv_style_list_t * lv_img_get_style(lv_obj_t * img, uint8_t type);
+static bool tree_img_foreach(lv_obj_t * obj, tree_img_cb_t cb);
+static bool tree_img_call(tree_img_cb_t cb, const void * src, lv_color_t color);
+static bool prefetch_cb(const void * src, lv_color_t color);
 
 /**********************
  *  STATIC VARIABLES
@@ -554,6 +563,35 @@ bool lv_img_get_antialias(lv_obj_t * img)
     return ext->antialias ? true : false;
 }
 
+/*=====================
+ * Other functions
+ *====================*/
+
+/**
+ * Prefetch the images of an object and its children into the image cache.
+ * The images of `lv_img`, `lv_imgbtn` and the background patterns are opened in an `lv_task`.
+ * Call it e.g. before loading a screen to not open the images during the screen load animation.
+ * @param obj pointer to an object, e.g. a screen
+ */
+void lv_img_prefetch_tree(lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, "");
+
+    tree_img_foreach(obj, prefetch_cb);
+}
+
+/**
+ * Tell whether the images of an object and its children are opened in the image cache
+ * @param obj pointer to an object, e.g. a screen
+ * @return true: all the images can be drawn without opening them
+ */
+bool lv_img_tree_is_cached(lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, "");
+
+    return tree_img_foreach(obj, lv_img_cache_is_cached);
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -884,4 +922,71 @@ static lv_style_list_t * lv_img_get_style(lv_obj_t * img, uint8_t type)
     return style_dsc_p;
 }
 
+/**
+ * Call a callback with the images of an object and its children
+ * @param obj pointer to an object
+ * @param cb the callback
+ * @return false: `cb` returned false and the iteration was stopped
+ */
+static bool tree_img_foreach(lv_obj_t * obj, tree_img_cb_t cb)
+{
+    /*Use the same colors as the drawing to find the same cache entries*/
+    lv_color_t color = LV_COLOR_BLACK;
+    if(lv_obj_get_style_pattern_recolor_opa(obj, LV_OBJ_PART_MAIN) > LV_OPA_MIN) {
+        color = lv_obj_get_style_pattern_recolor(obj, LV_OBJ_PART_MAIN);
+    }
+    if(tree_img_call(cb, lv_obj_get_style_pattern_image(obj, LV_OBJ_PART_MAIN), color) == false) return false;
+
+    lv_obj_type_t type;
+    lv_obj_get_type(obj, &type);
+    if(strcmp(type.type[0], LV_OBJX_NAME) == 0) {
+        color = LV_COLOR_BLACK;
+        if(lv_obj_get_style_image_recolor_opa(obj, LV_IMG_PART_MAIN) > 0) {
+            color = lv_obj_get_style_image_recolor(obj, LV_IMG_PART_MAIN);
+        }
+        if(tree_img_call(cb, lv_img_get_src(obj), color) == false) return false;
+    }
+#if LV_USE_IMGBTN
+    else if(strcmp(type.type[0], "lv_imgbtn") == 0) {
+        color = LV_COLOR_BLACK;
+        if(lv_obj_get_style_image_recolor_opa(obj, LV_IMGBTN_PART_MAIN) > 0) {
+            color = lv_obj_get_style_image_recolor(obj, LV_IMGBTN_PART_MAIN);
+        }
+        lv_btn_state_t state = lv_imgbtn_get_state(obj);
+#if LV_IMGBTN_TILED
+        if(tree_img_call(cb, lv_imgbtn_get_src_left(obj, state), color) == false) return false;
+        if(tree_img_call(cb, lv_imgbtn_get_src_middle(obj, state), color) == false) return false;
+        if(tree_img_call(cb, lv_imgbtn_get_src_right(obj, state), color) == false) return false;
+#else
+        if(tree_img_call(cb, lv_imgbtn_get_src(obj, state), color) == false) return false;
+#endif
+    }
+#endif
+
+    lv_obj_t * child = lv_obj_get_child(obj, NULL);
+    while(child) {
+        if(tree_img_foreach(child, cb) == false) return false;
+        child = lv_obj_get_child(obj, child);
+    }
+
+    return true;
+}
+
+static bool tree_img_call(tree_img_cb_t cb, const void * src, lv_color_t color)
+{
+    if(src == NULL) return true;
+
+    /*Symbols are drawn as texts*/
+    lv_img_src_t src_type = lv_img_src_get_type(src);
+    if(src_type != LV_IMG_SRC_FILE && src_type != LV_IMG_SRC_VARIABLE) return true;
+
+    return cb(src, color);
+}
+
+static bool prefetch_cb(const void * src, lv_color_t color)
+{
+    lv_img_cache_prefetch(src, color);
+    return true;
+}
+
 #endif
@@ -202,6 +202,25 @@ uint16_t lv_img_get_zoom(lv_obj_t * img);
  */
 bool lv_img_get_antialias(lv_obj_t * img);
 
+/*=====================
+ * Other functions
+ *====================*/
+
+/**
+ * Prefetch the images of an object and its children into the image cache.
+ * The images of `lv_img`, `lv_imgbtn` and the background patterns are opened in an `lv_task`.
+ * Call it e.g. before loading a screen to not open the images during the screen load animation.
+ * @param obj pointer to an object, e.g. a screen
+ */
+void lv_img_prefetch_tree(lv_obj_t * obj);
+
+/**
+ * Tell whether the images of an object and its children are opened in the image cache
+ * @param obj pointer to an object, e.g. a screen
+ * @return true: all the images can be drawn without opening them
+ */
+bool lv_img_tree_is_cached(lv_obj_t * obj);
+
 /**********************
  *      MACROS
  **********************/
@@ -420,7 +420,7 @@ void lv_keyboard_def_event_cb(lv_obj_t * kb, lv_event_t event)
         return;
     }
     else if(strcmp(txt, LV_SYMBOL_CLOSE) == 0) {
-        if(kb->event_cb != lv_keyboard_def_event_cb) {
+        if(lv_obj_get_event_cb(kb) != lv_keyboard_def_event_cb) {
             lv_res_t res = lv_event_send(kb, LV_EVENT_CANCEL, NULL);
             if(res != LV_RES_OK) return;
         }
@@ -432,7 +432,7 @@ void lv_keyboard_def_event_cb(lv_obj_t * kb, lv_event_t event)
         return;
     }
     else if(strcmp(txt, LV_SYMBOL_OK) == 0) {
-        if(kb->event_cb != lv_keyboard_def_event_cb) {
+        if(lv_obj_get_event_cb(kb) != lv_keyboard_def_event_cb) {
             lv_res_t res = lv_event_send(kb, LV_EVENT_APPLY, NULL);
             if(res != LV_RES_OK) return;
         }
@@ -115,6 +115,9 @@ lv_obj_t * lv_label_create(lv_obj_t * par, const lv_obj_t * copy)
 #if LV_LABEL_TEXT_SEL
     ext->sel_start = LV_DRAW_LABEL_NO_TXT_SEL;
     ext->sel_end   = LV_DRAW_LABEL_NO_TXT_SEL;
+#endif
+#if LV_USE_BIDI
+    _lv_memset_00(&ext->bidi_cache, sizeof(ext->bidi_cache));
 #endif
     ext->dot.tmp_ptr   = NULL;
     ext->dot_tmp_alloc = 0;
@@ -142,7 +145,7 @@ lv_obj_t * lv_label_create(lv_obj_t * par, const lv_obj_t * copy)
 
         /*In DOT mode save the text byte-to-byte because a '\0' can be in the middle*/
         if(copy_ext->long_mode == LV_LABEL_LONG_DOT) {
-            ext->text = lv_mem_realloc(ext->text, _lv_mem_get_size(copy_ext->text));
+            ext->text = lv_mem_realloc_tag(ext->text, _lv_mem_get_size(copy_ext->text), LV_MEM_TAG_TEXT);
             LV_ASSERT_MEM(ext->text);
             if(ext->text == NULL) return NULL;
             _lv_memcpy(ext->text, copy_ext->text, _lv_mem_get_size(copy_ext->text));
@@ -195,13 +198,13 @@ void lv_label_set_text(lv_obj_t * label, const char * text)
         /*Get the size of the text and process it*/
         size_t len = _lv_txt_ap_calc_bytes_cnt(text);
 
-        ext->text = lv_mem_realloc(ext->text, len);
+        ext->text = lv_mem_realloc_tag(ext->text, len, LV_MEM_TAG_TEXT);
         LV_ASSERT_MEM(ext->text);
         if(ext->text == NULL) return;
 
         _lv_txt_ap_proc(ext->text, ext->text);
 #else
-        ext->text = lv_mem_realloc(ext->text, strlen(ext->text) + 1);
+        ext->text = lv_mem_realloc_tag(ext->text, strlen(ext->text) + 1, LV_MEM_TAG_TEXT);
 #endif
 
         LV_ASSERT_MEM(ext->text);
@@ -218,7 +221,7 @@ void lv_label_set_text(lv_obj_t * label, const char * text)
         /*Get the size of the text and process it*/
         size_t len = _lv_txt_ap_calc_bytes_cnt(text);
 
-        ext->text = lv_mem_alloc(len);
+        ext->text = lv_mem_alloc_tag(len, LV_MEM_TAG_TEXT);
         LV_ASSERT_MEM(ext->text);
         if(ext->text == NULL) return;
 
@@ -228,7 +231,7 @@ void lv_label_set_text(lv_obj_t * label, const char * text)
         size_t len = strlen(text) + 1;
 
         /*Allocate space for the new text*/
-        ext->text = lv_mem_alloc(len);
+        ext->text = lv_mem_alloc_tag(len, LV_MEM_TAG_TEXT);
         LV_ASSERT_MEM(ext->text);
         if(ext->text == NULL) return;
         strcpy(ext->text, text);
@@ -937,7 +940,7 @@ void lv_label_ins_text(lv_obj_t * label, uint32_t pos, const char * txt)
     size_t old_len = strlen(ext->text);
     size_t ins_len = strlen(txt);
     size_t new_len = ins_len + old_len;
-    ext->text        = lv_mem_realloc(ext->text, new_len + 1);
+    ext->text        = lv_mem_realloc_tag(ext->text, new_len + 1, LV_MEM_TAG_TEXT);
     LV_ASSERT_MEM(ext->text);
     if(ext->text == NULL) return;
 
@@ -998,6 +1001,9 @@ void lv_label_refr_text(lv_obj_t * label)
 #if LV_LABEL_LONG_TXT_HINT
     ext->hint.line_start = -1; /*The hint is invalid if the text changes*/
 #endif
+#if LV_USE_BIDI
+    _lv_draw_label_bidi_cache_invalidate(&ext->bidi_cache);
+#endif
 
     lv_area_t txt_coords;
     get_txt_coords(label, &txt_coords);
@@ -1321,6 +1327,9 @@ static lv_design_res_t lv_label_design(lv_obj_t * label, const lv_area_t * clip_
         label_draw_dsc.ofs_y = ext->offset.y;
         label_draw_dsc.flag = flag;
         lv_obj_init_draw_label_dsc(label, LV_LABEL_PART_MAIN, &label_draw_dsc);
+#if LV_USE_BIDI
+        label_draw_dsc.bidi_cache = &ext->bidi_cache;
+#endif
 
         /* In SROLL and SROLL_CIRC mode the CENTER and RIGHT are pointless so remove them.
          * (In addition they will result misalignment is this case)*/
@@ -1403,6 +1412,9 @@ static lv_res_t lv_label_signal(lv_obj_t * label, lv_signal_t sign, void * param
             ext->text = NULL;
         }
         lv_label_dot_tmp_free(label);
+#if LV_USE_BIDI
+        _lv_draw_label_bidi_cache_invalidate(&ext->bidi_cache);
+#endif
     }
     else if(sign == LV_SIGNAL_STYLE_CHG) {
         /*Revert dots for proper refresh*/
@@ -1484,7 +1496,7 @@ static bool lv_label_set_dot_tmp(lv_obj_t * label, char * data, uint32_t len)
     if(len > sizeof(char *)) {
         /* Memory needs to be allocated. Allocates an additional byte
          * for a NULL-terminator so it can be copied. */
-        ext->dot.tmp_ptr = lv_mem_alloc(len + 1);
+        ext->dot.tmp_ptr = lv_mem_alloc_tag(len + 1, LV_MEM_TAG_TEXT);
         if(ext->dot.tmp_ptr == NULL) {
             LV_LOG_ERROR("Failed to allocate memory for dot_tmp_ptr");
             return false;
@@ -89,6 +89,10 @@ typedef struct {
     uint32_t sel_end;
 #endif
 
+#if LV_USE_BIDI
+    lv_draw_label_bidi_cache_t bidi_cache; /*The lines in visual order to not process them on every redraw*/
+#endif
+
     lv_label_long_mode_t long_mode : 3; /*Determinate what to do with the long texts*/
     uint8_t static_txt : 1;             /*Flag to indicate the text is static*/
     uint8_t align : 2;                  /*Align type from 'lv_label_align_t'*/
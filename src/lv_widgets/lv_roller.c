@@ -93,6 +93,9 @@ lv_obj_t * lv_roller_create(lv_obj_t * par, const lv_obj_t * copy)
     ext->sel_opt_id = 0;
     ext->sel_opt_id_ori = 0;
     ext->auto_fit = 1;
+#if LV_USE_BIDI
+    _lv_memset_00(&ext->bidi_cache, sizeof(ext->bidi_cache));
+#endif
     lv_style_list_init(&ext->style_sel);
 
     /*The signal and design functions are not copied so set them here*/
@@ -163,6 +166,10 @@ void lv_roller_set_options(lv_obj_t * roller, const char * options, lv_roller_mo
     ext->sel_opt_id     = 0;
     ext->sel_opt_id_ori = 0;
 
+#if LV_USE_BIDI
+    _lv_draw_label_bidi_cache_invalidate(&ext->bidi_cache);
+#endif
+
     /*Count the '\n'-s to determine the number of options*/
     ext->option_cnt = 0;
     uint32_t cnt;
@@ -498,6 +505,10 @@ static lv_design_res_t lv_roller_design(lv_obj_t * roller, const lv_area_t * cli
             label_sel_area.y2 = label_sel_area.y1 + res_p.y;
 
             label_dsc.flag |= LV_TXT_FLAG_EXPAND;
+#if LV_USE_BIDI
+            lv_roller_ext_t * ext = lv_obj_get_ext_attr(roller);
+            label_dsc.bidi_cache = &ext->bidi_cache;
+#endif
             lv_draw_label(&label_sel_area, &mask_sel, &label_dsc, lv_label_get_text(label), NULL);
         }
     }
@@ -668,6 +679,9 @@ static lv_res_t lv_roller_signal(lv_obj_t * roller, lv_signal_t sign, void * par
     }
     else if(sign == LV_SIGNAL_CLEANUP) {
         lv_obj_clean_style_list(roller, LV_ROLLER_PART_SELECTED);
+#if LV_USE_BIDI
+        _lv_draw_label_bidi_cache_invalidate(&ext->bidi_cache);
+#endif
     }
     return res;
 }
@@ -51,6 +51,9 @@ typedef struct {
     uint16_t option_cnt;          /*Number of options*/
     uint16_t sel_opt_id;          /*Index of the current option*/
     uint16_t sel_opt_id_ori;      /*Store the original index on focus*/
+#if LV_USE_BIDI
+    lv_draw_label_bidi_cache_t bidi_cache; /*The options in visual order for the selected area*/
+#endif
     lv_roller_mode_t mode : 1;
     uint8_t auto_fit : 1;         /*1: Automatically set the width*/
 } lv_roller_ext_t;
@@ -37,6 +37,9 @@ static lv_coord_t get_row_height(lv_obj_t * table, uint16_t row_id, const lv_fon
                                  lv_style_int_t * letter_space, lv_style_int_t * line_space,
                                  lv_style_int_t * cell_left, lv_style_int_t * cell_right, lv_style_int_t * cell_top, lv_style_int_t * cell_bottom);
 static void refr_size(lv_obj_t * table);
+#if LV_USE_BIDI
+static void bidi_cache_free(lv_obj_t * table);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -80,6 +83,9 @@ lv_obj_t * lv_table_create(lv_obj_t * par, const lv_obj_t * copy)
 
     /*Initialize the allocated 'ext' */
     ext->cell_data     = NULL;
+#if LV_USE_BIDI
+    ext->bidi_cache    = NULL;
+#endif
     ext->col_cnt       = 0;
     ext->row_cnt       = 0;
     ext->row_h         = NULL;
@@ -188,6 +194,9 @@ void lv_table_set_cell_value(lv_obj_t * table, uint16_t row, uint16_t col, const
 #endif
 
     ext->cell_data[cell][0] = format.format_byte;
+#if LV_USE_BIDI
+    if(ext->bidi_cache) _lv_draw_label_bidi_cache_invalidate(&ext->bidi_cache[cell]);
+#endif
     refr_size(table);
 }
 
@@ -283,6 +292,9 @@ void lv_table_set_cell_value_fmt(lv_obj_t * table, uint16_t row, uint16_t col, c
     va_end(ap2);
 
     ext->cell_data[cell][0] = format.format_byte;
+#if LV_USE_BIDI
+    if(ext->bidi_cache) _lv_draw_label_bidi_cache_invalidate(&ext->bidi_cache[cell]);
+#endif
     refr_size(table);
 }
 
@@ -296,6 +308,12 @@ void lv_table_set_row_cnt(lv_obj_t * table, uint16_t row_cnt)
     LV_ASSERT_OBJ(table, LV_OBJX_NAME);
 
     lv_table_ext_t * ext = lv_obj_get_ext_attr(table);
+
+#if LV_USE_BIDI
+    /*The cell indices change so drop the cached texts*/
+    bidi_cache_free(table);
+#endif
+
     uint16_t old_row_cnt = ext->row_cnt;
     ext->row_cnt         = row_cnt;
 
@@ -344,6 +362,12 @@ void lv_table_set_col_cnt(lv_obj_t * table, uint16_t col_cnt)
     }
 
     lv_table_ext_t * ext = lv_obj_get_ext_attr(table);
+
+#if LV_USE_BIDI
+    /*The cell indices change so drop the cached texts*/
+    bidi_cache_free(table);
+#endif
+
     uint16_t old_col_cnt = ext->col_cnt;
     ext->col_cnt         = col_cnt;
 
@@ -828,6 +852,15 @@ static lv_design_res_t lv_table_design(lv_obj_t * table, const lv_area_t * clip_
         lv_style_int_t cell_top[LV_TABLE_CELL_STYLE_CNT];
         lv_style_int_t cell_bottom[LV_TABLE_CELL_STYLE_CNT];
 
+#if LV_USE_BIDI
+        if(ext->bidi_cache == NULL && ext->cell_data) {
+            uint32_t cache_size = ext->row_cnt * ext->col_cnt * sizeof(lv_draw_label_bidi_cache_t);
+            ext->bidi_cache = lv_mem_alloc(cache_size);
+            LV_ASSERT_MEM(ext->bidi_cache);
+            if(ext->bidi_cache) _lv_memset_00(ext->bidi_cache, cache_size);
+        }
+#endif
+
         uint16_t i;
         for(i = 0; i < LV_TABLE_CELL_STYLE_CNT; i++) {
             if((ext->cell_types & (1 << i)) == 0) continue; /*Skip unused cell types*/
@@ -970,6 +1003,9 @@ static lv_design_res_t lv_table_design(lv_obj_t * table, const lv_area_t * clip_
                     bool label_mask_ok;
                     label_mask_ok = _lv_area_intersect(&label_mask, clip_area, &cell_area);
                     if(label_mask_ok) {
+#if LV_USE_BIDI
+                        label_dsc[cell_type].bidi_cache = ext->bidi_cache ? &ext->bidi_cache[cell] : NULL;
+#endif
                         lv_draw_label(&txt_area, &label_mask, &label_dsc[cell_type], ext->cell_data[cell] + 1, NULL);
                     }
 
@@ -1042,6 +1078,9 @@ static lv_res_t lv_table_signal(lv_obj_t * table, lv_signal_t sign, void * param
 
         if(ext->cell_data) lv_mem_free(ext->cell_data);
         if(ext->row_h) lv_mem_free(ext->row_h);
+#if LV_USE_BIDI
+        bidi_cache_free(table);
+#endif
 
         for(i = 0; i < LV_TABLE_CELL_STYLE_CNT; i++) {
             lv_obj_clean_style_list(table, LV_TABLE_PART_CELL1 + i);
@@ -1188,4 +1227,24 @@ static lv_coord_t get_row_height(lv_obj_t * table, uint16_t row_id, const lv_fon
     return h_max;
 }
 
+#if LV_USE_BIDI
+/**
+ * Free the cached visual order texts of the cells
+ * @param table pointer to a table object
+ */
+static void bidi_cache_free(lv_obj_t * table)
+{
+    lv_table_ext_t * ext = lv_obj_get_ext_attr(table);
+    if(ext->bidi_cache == NULL) return;
+
+    uint32_t i;
+    for(i = 0; i < (uint32_t)ext->row_cnt * ext->col_cnt; i++) {
+        _lv_draw_label_bidi_cache_invalidate(&ext->bidi_cache[i]);
+    }
+
+    lv_mem_free(ext->bidi_cache);
+    ext->bidi_cache = NULL;
+}
+#endif
+
 #endif
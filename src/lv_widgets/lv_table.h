@@ -68,6 +68,9 @@ typedef struct {
     uint16_t col_cnt;
     uint16_t row_cnt;
     char ** cell_data;
+#if LV_USE_BIDI
+    lv_draw_label_bidi_cache_t * bidi_cache; /*The cell texts in visual order. Allocated on the first draw*/
+#endif
     lv_coord_t * row_h;
     lv_style_list_t cell_style[LV_TABLE_CELL_STYLE_CNT];
     lv_coord_t col_w[LV_TABLE_COL_MAX];
@@ -131,6 +131,8 @@ minimal_monochrome = {
 all_obj_minimal_features = {
   "LV_DPI":60,
   "LV_MEM_SIZE":12*1024,
+  "LV_MEM_DEFRAG_INCREMENTAL":1,
+  "LV_MEM_PAUSE_HIST":1,
   "LV_HOR_RES_MAX":320,
   "LV_VER_RES_MAX":240,
   "LV_COLOR_DEPTH":8,
@@ -207,6 +209,14 @@ all_obj_minimal_features = {
 all_obj_all_features = {
   "LV_DPI":100,
   "LV_MEM_SIZE":32*1024,
+  "LV_MEM_TLSF":1,
+  "LV_MEM_BUF_ARENA":1,
+  "LV_MEM_SLAB":1,
+  "LV_MEM_SLAB_SIZE":16*1024,
+  "LV_MEM_THREAD_SAFE":1,
+  "LV_OBJ_SIDE_TABLE":1,
+  "LV_MEM_ARENA_CNT":2,
+  "LV_MEM_PAUSE_HIST":1,
   "LV_HOR_RES_MAX":480,
   "LV_VER_RES_MAX":320,
   "LV_COLOR_DEPTH":32,
@@ -216,6 +226,8 @@ all_obj_all_features = {
   "LV_ANTIALIAS":1,
   "LV_GPU":1,
   "LV_USE_FILESYSTEM":1,
+  "LV_FS_CACHE":1,
+  "LV_USE_FS_MMAP":1,
   "LV_USE_IMG_TRANSFORM":1,
   "LV_USE_API_EXTENSION_V6":1,
   "LV_USE_USER_DATA":1,
@@ -300,6 +312,19 @@ advanced_features = {
   "LV_USE_API_EXTENSION_V6":1,
   "LV_USE_USER_DATA":1,
   "LV_IMG_CACHE_DEF_SIZE":32,
+  "LV_IMG_CACHE_ASYNC":1,
+  "LV_IMG_CACHE_MIPMAP":1,
+  "LV_IMG_RLE_DECODE_FULL":1,
+  "LV_FS_CACHE":1,
+  "LV_USE_FS_MMAP":1,
+  "LV_MEM_BUF_ARENA":1,
+  "LV_MEM_SLAB":1,
+  "LV_MEM_PROFILER":1,
+  "LV_MEM_PROFILER_CALLER":1,
+  "LV_MEM_THREAD_SAFE":1,
+  "LV_MEM_ARENA_CNT":2,
+  "LV_FS_CACHE_BLOCK_SIZE":256,
+  "LV_FS_CACHE_READAHEAD":4,
   "LV_USE_LOG":1,
   "LV_USE_THEME_MATERIAL":1,
   "LV_USE_THEME_EMPTY":1,
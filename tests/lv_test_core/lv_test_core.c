@@ -13,6 +13,12 @@
 #include "lv_test_obj.h"
 #include "lv_test_style.h"
 #include "lv_test_font_loader.h"
+#include "lv_test_img_cache.h"
+#include "lv_test_img_transform.h"
+#include "lv_test_img_rle.h"
+#include "lv_test_img_blit.h"
+#include "lv_test_mem.h"
+#include "lv_test_fs.h"
 
 /*********************
  *      DEFINES
@@ -48,6 +54,12 @@ void lv_test_core(void)
     lv_test_obj();
     lv_test_style();
     lv_test_font_loader();
+    lv_test_img_cache();
+    lv_test_img_transform();
+    lv_test_img_rle();
+    lv_test_img_blit();
+    lv_test_fs();
+    lv_test_mem();
 }
 
 /**********************
@@ -31,13 +31,23 @@
  *  STATIC PROTOTYPES
  **********************/
 
+static void test_fallback(void);
+static void test_txt_width(void);
+static void test_txt_width_fallback(void);
+static bool glyph_dsc_none(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t letter,
+                           uint32_t letter_next);
+static bool glyph_dsc_count(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t letter,
+                            uint32_t letter_next);
 #if LV_USE_FILESYSTEM
 static int compare_fonts(lv_font_t * f1, lv_font_t * f2);
+static void compare_lazy_font(lv_font_t * f1, lv_font_t * f2);
+static void compare_glyph(lv_font_t * f1, lv_font_t * f2, uint32_t letter, uint32_t letter_next);
 #endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+static uint32_t glyph_dsc_cnt;
 
 /**********************
  *      MACROS
@@ -53,12 +63,16 @@ extern lv_font_t font_3;
 
 void lv_test_font_loader(void)
 {
-#if LV_USE_FILESYSTEM
     lv_test_print("");
     lv_test_print("===================");
     lv_test_print("Start lv_font tests");
     lv_test_print("===================");
 
+    test_fallback();
+    test_txt_width();
+    test_txt_width_fallback();
+
+#if LV_USE_FILESYSTEM
     lv_font_t * font_1_bin = lv_font_load("f:font_1.fnt");
     lv_font_t * font_2_bin = lv_font_load("f:font_2.fnt");
     lv_font_t * font_3_bin = lv_font_load("f:font_3.fnt");
@@ -70,11 +84,202 @@ void lv_test_font_loader(void)
     lv_font_free(font_1_bin);
     lv_font_free(font_2_bin);
     lv_font_free(font_3_bin);
+
+    /*Use a small cache to test the reloading of the glyphs too*/
+    lv_font_t * font_1_lazy = lv_font_load_lazy("f:font_1.fnt", 7);
+    lv_font_t * font_2_lazy = lv_font_load_lazy("f:font_2.fnt", 7);
+    lv_font_t * font_3_lazy = lv_font_load_lazy("f:font_3.fnt", 1);
+
+    compare_lazy_font(&font_1, font_1_lazy);
+    compare_lazy_font(&font_2, font_2_lazy);
+    compare_lazy_font(&font_3, font_3_lazy);
+
+    lv_font_free(font_1_lazy);
+    lv_font_free(font_2_lazy);
+    lv_font_free(font_3_lazy);
+
+    /*Load a plain and a compressed font from memory*/
+    uint32_t font_size;
+    lv_fs_file_t f;
+    static uint8_t font_data[8 * 1024];
+    lv_test_assert_int_eq(LV_FS_RES_OK, lv_fs_open(&f, "f:font_2.fnt", LV_FS_MODE_RD), "open font_2.fnt");
+    lv_fs_read(&f, font_data, sizeof(font_data), &font_size);
+    lv_fs_close(&f);
+
+    lv_font_t * font_2_mem = lv_font_load_lazy_from_mem(font_data, font_size, 16);
+    compare_lazy_font(&font_2, font_2_mem);
+    lv_font_free(font_2_mem);
+
+    /*A letter and the next letter should remain cached together even if they are in the same set*/
+    lv_font_t * font_2_small = lv_font_load_lazy_from_mem(font_data, font_size, 2);
+    lv_font_glyph_dsc_t g_a;
+    lv_font_glyph_dsc_t g_c;
+    lv_font_glyph_dsc_t g;
+    lv_test_assert_true(lv_font_get_glyph_dsc(font_2_small, &g_a, 'A', 'C'), "get 'A' before 'C'");
+    lv_test_assert_true(lv_font_get_glyph_dsc(font_2_small, &g_c, 'C', 'A'), "get 'C' before 'A'");
+
+    /*Clear the source to be sure the glyphs are not read again*/
+    _lv_memset_00(font_data, font_size);
+    lv_test_assert_true(lv_font_get_glyph_dsc(font_2_small, &g, 'A', '\0'), "'A' is cached");
+    lv_test_assert_int_eq(g_a.box_w, g.box_w, "box_w of the cached 'A'");
+    lv_test_assert_true(lv_font_get_glyph_dsc(font_2_small, &g, 'C', '\0'), "'C' is cached");
+    lv_test_assert_int_eq(g_c.box_w, g.box_w, "box_w of the cached 'C'");
+    lv_font_free(font_2_small);
+
+    lv_test_assert_int_eq(LV_FS_RES_OK, lv_fs_open(&f, "f:font_3.fnt", LV_FS_MODE_RD), "open font_3.fnt");
+    lv_fs_read(&f, font_data, sizeof(font_data), &font_size);
+    lv_fs_close(&f);
+
+    lv_font_t * font_3_mem = lv_font_load_lazy_from_mem(font_data, font_size, 16);
+    compare_lazy_font(&font_3, font_3_mem);
+    lv_font_free(font_3_mem);
+
+#if LV_USE_FS_MMAP
+    /*Reference the data of a memory mapped file*/
+    lv_font_t * font_2_mmap = lv_font_load_lazy("M:font_2.fnt", 16);
+    compare_lazy_font(&font_2, font_2_mmap);
+    lv_font_free(font_2_mmap);
+#endif
 #else
     lv_test_print("SKIP: font load test because it requires LV_USE_FILESYSTEM 1 and LV_FONT_FMT_TXT_LARGE 0");
 #endif
 }
 
+static void test_fallback(void)
+{
+    lv_test_print("");
+    lv_test_print("Fallback fonts:");
+
+    /*font_3 has only ASCII letters, font_1 has symbols too*/
+    lv_font_t main_font = font_3;
+    main_font.fallback = &font_1;
+
+    lv_font_fmt_txt_dsc_t * dsc1 = (lv_font_fmt_txt_dsc_t *) font_1.dsc;
+    uint32_t symbol = dsc1->cmaps[1].range_start + dsc1->cmaps[1].unicode_list[0];
+
+    lv_font_glyph_dsc_t g1;
+    lv_font_glyph_dsc_t g2;
+
+    /*Try twice to get the letters from the cache too*/
+    for(int i = 0; i < 2; i++) {
+        lv_test_assert_ptr_eq(&main_font, lv_font_get_font_of_letter(&main_font, 'A'), "'A' is in the main font");
+        lv_test_assert_ptr_eq(&font_1, lv_font_get_font_of_letter(&main_font, symbol), "symbol is in the fallback font");
+        lv_test_assert_ptr_eq(NULL, lv_font_get_font_of_letter(&main_font, 0x10), "0x10 is in none of the fonts");
+
+        lv_test_assert_true(lv_font_get_glyph_dsc(&main_font, &g1, symbol, '\0'), "get the symbol from the fallback");
+        lv_test_assert_true(lv_font_get_glyph_dsc(&font_1, &g2, symbol, '\0'), "get the symbol directly");
+        lv_test_assert_int_eq(g2.adv_w, g1.adv_w, "adv_w of the symbol");
+        lv_test_assert_int_eq(g2.box_w, g1.box_w, "box_w of the symbol");
+        lv_test_assert_int_eq(false, lv_font_get_glyph_dsc(&main_font, &g1, 0x10, '\0'), "no glyph for 0x10");
+
+        /*No kerning with the letter of the other font*/
+        lv_test_assert_true(lv_font_get_glyph_dsc(&main_font, &g1, 'A', symbol), "get 'A' before the symbol");
+        lv_test_assert_true(lv_font_get_glyph_dsc(&font_3, &g2, 'A', '\0'), "get 'A' without kerning");
+        lv_test_assert_int_eq(g2.adv_w, g1.adv_w, "adv_w of 'A'");
+    }
+
+    lv_font_fallback_cache_invalidate(&main_font);
+}
+
+static void test_txt_width(void)
+{
+    lv_test_print("");
+    lv_test_print("Text width with kerning:");
+
+    /*font_1 and font_2 have kerning*/
+    const char * txt = "AVATAR Ty, To. We \"Yo\" LT\xC2\xB0" "C 12";
+    lv_font_t * fonts[] = {&font_1, &font_2, &font_3};
+    for(int f = 0; f < 3; f++) {
+        /*Measure twice to use the cached widths too*/
+        for(int k = 0; k < 2; k++) {
+            lv_coord_t w_ref = 0;
+            uint32_t i = 0;
+            while(txt[i] != '\0') {
+                uint32_t letter = _lv_txt_encoded_next(txt, &i);
+                uint32_t letter_next = _lv_txt_encoded_next(&txt[i], NULL);
+                lv_coord_t letter_w = lv_font_get_glyph_width(fonts[f], letter, letter_next);
+                if(letter_w > 0) w_ref += letter_w + 1;
+            }
+            w_ref -= 1;
+
+            lv_test_assert_int_eq(w_ref, _lv_txt_get_width(txt, strlen(txt), fonts[f], 1, LV_TXT_FLAG_NONE), "text width");
+        }
+    }
+}
+
+static void test_txt_width_fallback(void)
+{
+    lv_test_print("");
+    lv_test_print("Text width with cached fonts:");
+
+    const char * txt = "AVATAR";
+    lv_coord_t w1 = _lv_txt_get_width(txt, strlen(txt), &font_1, 0, LV_TXT_FLAG_NONE);
+    lv_coord_t w2 = _lv_txt_get_width(txt, strlen(txt), &font_3, 0, LV_TXT_FLAG_NONE);
+    lv_test_assert_true(w1 != w2, "the fonts have different widths");
+
+    /*More fonts than the size of the cache to replace some of them*/
+    lv_font_t fonts[LV_TXT_ASCII_WIDTH_CACHE_SIZE + 2];
+    uint32_t i;
+    for(i = 0; i < sizeof(fonts) / sizeof(fonts[0]); i++) fonts[i] = i & 0x1 ? font_3 : font_1;
+    for(int k = 0; k < 2; k++) {
+        for(i = 0; i < sizeof(fonts) / sizeof(fonts[0]); i++) {
+            lv_test_assert_int_eq(i & 0x1 ? w2 : w1, _lv_txt_get_width(txt, strlen(txt), &fonts[i], 0, LV_TXT_FLAG_NONE),
+                                  "text width");
+        }
+    }
+
+    for(i = 0; i < sizeof(fonts) / sizeof(fonts[0]); i++) lv_font_fallback_cache_invalidate(&fonts[i]);
+
+    /*Using more fonts than the cache can keep shouldn't be slower than measuring without the cache*/
+    lv_font_t counted_fonts[2 * LV_TXT_ASCII_WIDTH_CACHE_SIZE + 1];
+    for(i = 0; i < sizeof(counted_fonts) / sizeof(counted_fonts[0]); i++) {
+        counted_fonts[i] = font_1;
+        counted_fonts[i].get_glyph_dsc = glyph_dsc_count;
+    }
+    for(int k = 0; k < 2; k++) {
+        for(i = 0; i < sizeof(counted_fonts) / sizeof(counted_fonts[0]); i++) {
+            glyph_dsc_cnt = 0;
+            _lv_txt_get_width(txt, strlen(txt), &counted_fonts[i], 0, LV_TXT_FLAG_NONE);
+            lv_test_assert_true(glyph_dsc_cnt <= strlen(txt), "one glyph lookup per letter on a cache miss");
+        }
+    }
+
+    for(i = 0; i < sizeof(counted_fonts) / sizeof(counted_fonts[0]); i++) {
+        lv_font_fallback_cache_invalidate(&counted_fonts[i]);
+    }
+
+    /*All letters come from the fallback font*/
+    lv_font_t fallback = font_1;
+    lv_font_t main_font = font_1;
+    main_font.get_glyph_dsc = glyph_dsc_none;
+    main_font.fallback = &fallback;
+    lv_test_assert_int_eq(w1, _lv_txt_get_width(txt, strlen(txt), &main_font, 0, LV_TXT_FLAG_NONE), "width from font_1");
+
+    /*The cached widths of the main font are dropped when its fallback changes*/
+    fallback = font_3;
+    lv_font_fallback_cache_invalidate(&fallback);
+    lv_test_assert_int_eq(w2, _lv_txt_get_width(txt, strlen(txt), &main_font, 0, LV_TXT_FLAG_NONE), "width from font_3");
+
+    lv_font_fallback_cache_invalidate(&fallback);
+}
+
+static bool glyph_dsc_none(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t letter,
+                           uint32_t letter_next)
+{
+    LV_UNUSED(font);
+    LV_UNUSED(dsc_out);
+    LV_UNUSED(letter);
+    LV_UNUSED(letter_next);
+    return false;
+}
+
+static bool glyph_dsc_count(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t letter,
+                            uint32_t letter_next)
+{
+    glyph_dsc_cnt++;
+    return font_1.get_glyph_dsc(font, dsc_out, letter, letter_next);
+}
+
 #if LV_USE_FILESYSTEM
 static int compare_fonts(lv_font_t * f1, lv_font_t * f2)
 {
@@ -213,6 +418,71 @@ static int compare_fonts(lv_font_t * f1, lv_font_t * f2)
     LV_LOG_INFO("No differences found!");
     return 0;
 }
+
+static void compare_lazy_font(lv_font_t * f1, lv_font_t * f2)
+{
+    lv_test_assert_true(f1 != NULL && f2 != NULL, "font not null");
+
+    lv_test_assert_int_eq(f1->line_height, f2->line_height, "line_height");
+    lv_test_assert_int_eq(f1->base_line, f2->base_line, "base_line");
+    lv_test_assert_int_eq(f1->subpx, f2->subpx, "subpx");
+
+    /*Check every letter of the font twice to get them from the cache too*/
+    lv_font_fmt_txt_dsc_t * dsc1 = (lv_font_fmt_txt_dsc_t *) f1->dsc;
+    for(int k = 0; k < 2; k++) {
+        for(int i = 0; i < dsc1->cmap_num; i++) {
+            const lv_font_fmt_txt_cmap_t * cmap = &dsc1->cmaps[i];
+            if(cmap->unicode_list) {
+                for(int j = 0; j < cmap->list_length; j++) {
+                    uint32_t letter = cmap->range_start + cmap->unicode_list[j];
+                    compare_glyph(f1, f2, letter, 'A');
+                }
+            }
+            else {
+                for(uint32_t letter = cmap->range_start; letter < cmap->range_start + cmap->range_length; letter++) {
+                    compare_glyph(f1, f2, letter, letter + 1);
+                }
+            }
+        }
+    }
+
+    compare_glyph(f1, f2, '\t', 'A');
+    compare_glyph(f1, f2, 0x10, 'A');
+
+    LV_LOG_INFO("No differences found!");
+}
+
+static void compare_glyph(lv_font_t * f1, lv_font_t * f2, uint32_t letter, uint32_t letter_next)
+{
+    lv_font_glyph_dsc_t g1;
+    lv_font_glyph_dsc_t g2;
+    bool found1 = lv_font_get_glyph_dsc(f1, &g1, letter, letter_next);
+    bool found2 = lv_font_get_glyph_dsc(f2, &g2, letter, letter_next);
+    lv_test_assert_int_eq(found1, found2, "glyph found");
+    if(!found1 || !found2) return;
+
+    lv_test_assert_int_eq(g1.adv_w, g2.adv_w, "adv_w");
+    lv_test_assert_int_eq(g1.box_w, g2.box_w, "box_w");
+    lv_test_assert_int_eq(g1.box_h, g2.box_h, "box_h");
+    lv_test_assert_int_eq(g1.ofs_x, g2.ofs_x, "ofs_x");
+    lv_test_assert_int_eq(g1.ofs_y, g2.ofs_y, "ofs_y");
+    lv_test_assert_int_eq(g1.bpp, g2.bpp, "bpp");
+
+    if(letter == '\t') return;
+
+    /*Compressed bitmaps are decompressed into the same buffer so save the first one*/
+    static uint8_t bmp1[1024];
+    uint32_t size = (g1.box_w * g1.box_h * g1.bpp + 7) / 8;
+    if(size == 0 || size > sizeof(bmp1)) return;
+
+    /*Without LV_USE_FONT_COMPRESSED both return NULL for compressed fonts*/
+    const uint8_t * b1 = lv_font_get_glyph_bitmap(f1, letter);
+    if(b1) memcpy(bmp1, b1, size);
+
+    const uint8_t * b2 = lv_font_get_glyph_bitmap(f2, letter);
+    lv_test_assert_int_eq(b1 != NULL, b2 != NULL, "glyph_bitmap");
+    if(b1 && b2) lv_test_assert_array_eq(bmp1, b2, size, "glyph_bitmap");
+}
 #endif
 
 #pragma GCC diagnostic pop
@@ -0,0 +1,369 @@
+/**
+ * @file lv_test_fs.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_fs.h"
+
+#if LV_BUILD_TEST
+#include <stdio.h>
+#include <unistd.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define TEST_FILE_SIZE  5000
+#define TEST_LATENCY    100     /*[us] added to every read and seek of the driver*/
+#define BENCH_IMG_W     100
+#define BENCH_IMG_H     60
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_USE_FILESYSTEM
+static uint8_t pattern(uint32_t i);
+#if LV_USE_FS_MMAP
+static void mmap_read(void);
+static void mmap_img(void);
+#endif
+#if LV_FS_CACHE
+static void random_reads(void);
+static void sequential_reads(void);
+static void benchmark(void);
+static void slow_drv_register(void);
+static void cache_enable(bool en);
+static lv_fs_res_t open_cb(struct _lv_fs_drv_t * drv, void * file_p, const char * path, lv_fs_mode_t mode);
+static lv_fs_res_t close_cb(struct _lv_fs_drv_t * drv, void * file_p);
+static lv_fs_res_t read_cb(struct _lv_fs_drv_t * drv, void * file_p, void * buf, uint32_t btr, uint32_t * br);
+static lv_fs_res_t seek_cb(struct _lv_fs_drv_t * drv, void * file_p, uint32_t pos);
+static lv_fs_res_t tell_cb(struct _lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p);
+#endif
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_fs(void)
+{
+#if LV_USE_FILESYSTEM
+    lv_test_print("");
+    lv_test_print("==================");
+    lv_test_print("Start lv_fs tests");
+    lv_test_print("==================");
+
+    FILE * f = fopen("lv_test_fs.bin", "wb");
+    uint32_t i;
+    for(i = 0; i < TEST_FILE_SIZE; i++) fputc(pattern(i), f);
+    fclose(f);
+
+#if LV_USE_FS_MMAP
+    mmap_read();
+    mmap_img();
+#endif
+
+#if LV_FS_CACHE
+    slow_drv_register();
+    random_reads();
+    sequential_reads();
+    benchmark();
+#endif
+
+    remove("lv_test_fs.bin");
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_USE_FILESYSTEM
+static uint8_t pattern(uint32_t i)
+{
+    return (i * 7 + (i >> 8)) & 0xFF;
+}
+
+#if LV_USE_FS_MMAP
+static void mmap_read(void)
+{
+    lv_test_print("");
+    lv_test_print("Memory mapped files:");
+    lv_test_print("--------------------");
+
+    lv_fs_file_t f;
+    lv_test_assert_int_eq(LV_FS_RES_OK, lv_fs_open(&f, "M:lv_test_fs.bin", LV_FS_MODE_RD), "Open the file");
+
+    const void * map;
+    uint32_t size;
+    lv_test_assert_int_eq(LV_FS_RES_OK, lv_fs_map(&f, &map, &size), "Map the file");
+    lv_test_assert_int_eq(TEST_FILE_SIZE, size, "Size of the mapped file");
+
+    bool ok = true;
+    uint32_t i;
+    for(i = 0; i < size; i++) {
+        if(((const uint8_t *)map)[i] != pattern(i)) ok = false;
+    }
+    lv_test_assert_true(ok, "Content of the mapped file");
+
+    uint8_t buf[16];
+    uint32_t br = 0;
+    lv_fs_seek(&f, TEST_FILE_SIZE - 10);
+    lv_fs_read(&f, buf, sizeof(buf), &br);
+    lv_test_assert_int_eq(10, br, "Read the end of the mapped file");
+    lv_test_assert_int_eq(pattern(TEST_FILE_SIZE - 1), buf[9], "Read from the mapped file");
+    lv_fs_close(&f);
+
+    lv_test_assert_int_eq(LV_FS_RES_OK, lv_fs_open(&f, "f:lv_test_fs.bin", LV_FS_MODE_RD), "Open a not mappable file");
+    lv_test_assert_int_eq(LV_FS_RES_NOT_IMP, lv_fs_map(&f, &map, &size), "Can't map the file");
+    lv_test_assert_ptr_eq(NULL, map, "No pointer to the not mapped file");
+    lv_fs_close(&f);
+}
+
+static void mmap_img(void)
+{
+    lv_img_header_t header;
+    _lv_memset_00(&header, sizeof(header));
+    header.cf = LV_IMG_CF_TRUE_COLOR;
+    header.w = BENCH_IMG_W;
+    header.h = BENCH_IMG_H;
+
+    FILE * f = fopen("lv_test_fs_img.bin", "wb");
+    fwrite(&header, sizeof(header), 1, f);
+    uint32_t i;
+    for(i = 0; i < BENCH_IMG_W * BENCH_IMG_H * sizeof(lv_color_t); i++) fputc(pattern(i), f);
+    fclose(f);
+
+    lv_img_decoder_dsc_t dsc;
+    lv_test_assert_int_eq(LV_RES_OK, lv_img_decoder_open(&dsc, "M:lv_test_fs_img.bin", LV_COLOR_BLACK),
+                          "Open a mapped image");
+    lv_test_assert_true(dsc.img_data != NULL, "Draw the mapped image directly");
+    lv_test_assert_int_eq(pattern(100), dsc.img_data[100], "Pixels of the mapped image");
+    lv_img_decoder_close(&dsc);
+
+    lv_test_assert_int_eq(LV_RES_OK, lv_img_decoder_open(&dsc, "f:lv_test_fs_img.bin", LV_COLOR_BLACK),
+                          "Open a not mapped image");
+    lv_test_assert_ptr_eq(NULL, dsc.img_data, "Read the not mapped image line-by-line");
+    lv_img_decoder_close(&dsc);
+
+    remove("lv_test_fs_img.bin");
+}
+#endif
+
+#if LV_FS_CACHE
+static void random_reads(void)
+{
+    lv_test_print("");
+    lv_test_print("Read from random positions:");
+    lv_test_print("---------------------------");
+
+    /*Small and large reads, crossing the blocks and the end of the file*/
+    static const uint32_t reads[][2] = {{0, 10}, {5, 10}, {1000, 1}, {3, 2000}, {511, 2}, {4990, 20},
+        {2000, 700}, {4999, 1}, {1020, 8}, {0, TEST_FILE_SIZE}, {TEST_FILE_SIZE, 4}, {2500, 300}
+    };
+
+    static uint8_t buf[TEST_FILE_SIZE];
+    uint32_t c;
+    for(c = 0; c < 2; c++) {
+        cache_enable(c == 0);
+
+        lv_fs_file_t f;
+        lv_test_assert_int_eq(LV_FS_RES_OK, lv_fs_open(&f, "L:lv_test_fs.bin", LV_FS_MODE_RD), "Open the file");
+
+        bool ok = true;
+        uint32_t i;
+        for(i = 0; i < sizeof(reads) / sizeof(reads[0]); i++) {
+            uint32_t pos = reads[i][0];
+            uint32_t len = reads[i][1];
+            uint32_t exp_len = pos + len > TEST_FILE_SIZE ? TEST_FILE_SIZE - pos : len;
+
+            uint32_t br = 0;
+            lv_fs_seek(&f, pos);
+            lv_fs_read(&f, buf, len, &br);
+            if(br != exp_len) ok = false;
+
+            uint32_t j;
+            for(j = 0; j < br; j++) {
+                if(buf[j] != pattern(pos + j)) ok = false;
+            }
+
+            uint32_t tell = 0;
+            lv_fs_tell(&f, &tell);
+            if(tell != pos + br) ok = false;
+        }
+
+        lv_fs_close(&f);
+        lv_test_assert_true(ok, c == 0 ? "Same data with cache" : "Same data without cache");
+    }
+}
+
+static void sequential_reads(void)
+{
+    lv_test_print("");
+    lv_test_print("Read sequentially:");
+    lv_test_print("------------------");
+
+    uint32_t drv_read_cnt[2];
+    uint32_t c;
+    for(c = 0; c < 2; c++) {
+        cache_enable(c == 0);
+        lv_fs_reset_stat('L');
+
+        lv_fs_file_t f;
+        lv_fs_open(&f, "L:lv_test_fs.bin", LV_FS_MODE_RD);
+
+        uint8_t buf[10];
+        uint32_t br;
+        uint32_t sum = 0;
+        do {
+            br = 0;
+            lv_fs_read(&f, buf, sizeof(buf), &br);
+            sum += br;
+        } while(br > 0);
+        lv_fs_close(&f);
+
+        lv_fs_stat_t stat;
+        lv_fs_get_stat('L', &stat);
+        drv_read_cnt[c] = stat.drv_read_cnt;
+
+        lv_test_assert_int_eq(TEST_FILE_SIZE, sum, "Read the whole file");
+        lv_test_assert_int_eq(TEST_FILE_SIZE / sizeof(buf) + 1, stat.read_cnt, "Read count");
+        lv_test_assert_int_eq(TEST_FILE_SIZE, stat.read_bytes, "Read bytes");
+    }
+
+    lv_test_assert_true(drv_read_cnt[0] * 10 < drv_read_cnt[1], "Less driver reads with cache");
+}
+
+/**
+ * Read an image line-by-line from the slow drive with and without cache
+ */
+static void benchmark(void)
+{
+    lv_test_print("");
+    lv_test_print("Read image rows:");
+    lv_test_print("----------------");
+
+    lv_img_header_t header;
+    _lv_memset_00(&header, sizeof(header));
+    header.cf = LV_IMG_CF_TRUE_COLOR;
+    header.w = BENCH_IMG_W;
+    header.h = BENCH_IMG_H;
+
+    FILE * f = fopen("lv_test_fs_img.bin", "wb");
+    fwrite(&header, sizeof(header), 1, f);
+    uint32_t i;
+    for(i = 0; i < BENCH_IMG_W * BENCH_IMG_H * sizeof(lv_color_t); i++) fputc(pattern(i), f);
+    fclose(f);
+
+    uint8_t buf[BENCH_IMG_W * sizeof(lv_color_t)];
+    uint32_t t[2];
+    uint32_t c;
+    for(c = 0; c < 2; c++) {
+        cache_enable(c == 0);
+        lv_fs_reset_stat('L');
+
+        uint32_t t_start = custom_tick_get();
+        lv_img_decoder_dsc_t dsc;
+        lv_img_decoder_open(&dsc, "L:lv_test_fs_img.bin", LV_COLOR_BLACK);
+        lv_coord_t y;
+        for(y = 0; y < BENCH_IMG_H; y++) {
+            lv_img_decoder_read_line(&dsc, 0, y, BENCH_IMG_W, buf);
+        }
+        lv_img_decoder_close(&dsc);
+        t[c] = custom_tick_get() - t_start;
+
+        lv_fs_stat_t stat;
+        lv_fs_get_stat('L', &stat);
+        lv_test_print("%s cache: %d ms, %d driver reads, %d driver seeks", c == 0 ? "With" : "Without", (int)t[c],
+                      (int)stat.drv_read_cnt, (int)stat.drv_seek_cnt);
+    }
+
+    lv_test_assert_true(t[0] <= t[1], "Faster with cache");
+
+    remove("lv_test_fs_img.bin");
+}
+
+static void slow_drv_register(void)
+{
+    if(lv_fs_get_drv('L')) return;
+
+    lv_fs_drv_t drv;
+    lv_fs_drv_init(&drv);
+    drv.letter = 'L';
+    drv.file_size = sizeof(FILE *);
+    drv.open_cb = open_cb;
+    drv.close_cb = close_cb;
+    drv.read_cb = read_cb;
+    drv.seek_cb = seek_cb;
+    drv.tell_cb = tell_cb;
+    lv_fs_drv_register(&drv);
+}
+
+static void cache_enable(bool en)
+{
+    lv_fs_get_drv('L')->cache_block_cnt = en ? LV_FS_CACHE_BLOCK_CNT : 0;
+}
+
+static lv_fs_res_t open_cb(struct _lv_fs_drv_t * drv, void * file_p, const char * path, lv_fs_mode_t mode)
+{
+    LV_UNUSED(drv);
+    LV_UNUSED(mode);
+
+    FILE * fp = fopen(path, "rb");
+    *((FILE **)file_p) = fp;
+    return fp == NULL ? LV_FS_RES_NOT_EX : LV_FS_RES_OK;
+}
+
+static lv_fs_res_t close_cb(struct _lv_fs_drv_t * drv, void * file_p)
+{
+    LV_UNUSED(drv);
+
+    fclose(*((FILE **)file_p));
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t read_cb(struct _lv_fs_drv_t * drv, void * file_p, void * buf, uint32_t btr, uint32_t * br)
+{
+    LV_UNUSED(drv);
+
+    usleep(TEST_LATENCY);
+    *br = fread(buf, 1, btr, *((FILE **)file_p));
+    return *br == 0 ? LV_FS_RES_UNKNOWN : LV_FS_RES_OK;
+}
+
+static lv_fs_res_t seek_cb(struct _lv_fs_drv_t * drv, void * file_p, uint32_t pos)
+{
+    LV_UNUSED(drv);
+
+    usleep(TEST_LATENCY);
+    fseek(*((FILE **)file_p), pos, SEEK_SET);
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t tell_cb(struct _lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p)
+{
+    LV_UNUSED(drv);
+
+    *pos_p = ftell(*((FILE **)file_p));
+    return LV_FS_RES_OK;
+}
+#endif
+#endif
+
+#endif
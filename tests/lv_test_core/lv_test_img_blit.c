@@ -0,0 +1,262 @@
+/**
+ * @file lv_test_img_blit.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_img_blit.h"
+
+#if LV_BUILD_TEST
+#include <stdio.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define ICON_SIZE       32
+#define ICON_GAP        8
+#define BENCH_REFR_CNT  20
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void same_result(void);
+static void benchmark(void);
+static void icons_create(const lv_img_dsc_t * dsc, lv_opa_t opa);
+static lv_design_res_t icons_design(lv_obj_t * obj, const lv_area_t * clip_area, lv_design_mode_t mode);
+static uint32_t draw_and_hash(bool generic);
+static void mask_add(void);
+static void init_icons(void);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static uint8_t icon_true_color_map[ICON_SIZE * ICON_SIZE * sizeof(lv_color_t)];
+static uint8_t icon_chroma_keyed_map[ICON_SIZE * ICON_SIZE * sizeof(lv_color_t)];
+static uint8_t icon_alpha_map[ICON_SIZE * ICON_SIZE * LV_IMG_PX_SIZE_ALPHA_BYTE];
+static lv_img_dsc_t icon_true_color;
+static lv_img_dsc_t icon_chroma_keyed;
+static lv_img_dsc_t icon_alpha;
+static int16_t mask_id = LV_MASK_ID_INV;
+static lv_draw_mask_radius_param_t mask_param;
+static lv_design_cb_t ancestor_design;
+static const lv_img_dsc_t * icons_src;
+static lv_opa_t icons_opa;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_img_blit(void)
+{
+    lv_test_print("");
+    lv_test_print("=======================");
+    lv_test_print("Start lv_img blit tests");
+    lv_test_print("=======================");
+
+    init_icons();
+
+    same_result();
+    benchmark();
+
+    lv_obj_clean(lv_scr_act());
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void same_result(void)
+{
+    lv_test_print("");
+    lv_test_print("Same result as the generic path:");
+    lv_test_print("--------------------------------");
+
+    const lv_img_dsc_t * dscs[] = {&icon_true_color, &icon_chroma_keyed, &icon_alpha};
+    const char * names[] = {"True color", "Chroma keyed", "Alpha byte"};
+    lv_opa_t opas[] = {LV_OPA_COVER, LV_OPA_50};
+
+    uint32_t i;
+    uint32_t o;
+    for(i = 0; i < sizeof(dscs) / sizeof(dscs[0]); i++) {
+        for(o = 0; o < sizeof(opas) / sizeof(opas[0]); o++) {
+            icons_create(dscs[i], opas[o]);
+            uint32_t hash_fast = draw_and_hash(false);
+            uint32_t hash_generic = draw_and_hash(true);
+
+            char s[64];
+            lv_snprintf(s, sizeof(s), "%s with opa %d", names[i], opas[o]);
+            lv_test_assert_int_eq(hash_generic, hash_fast, s);
+        }
+    }
+}
+
+static void benchmark(void)
+{
+    lv_test_print("");
+    lv_test_print("Benchmark:");
+    lv_test_print("----------");
+
+    const lv_img_dsc_t * dscs[] = {&icon_true_color, &icon_chroma_keyed, &icon_alpha};
+    const char * names[] = {"True color", "Chroma keyed", "Alpha byte"};
+
+    uint32_t i;
+    for(i = 0; i < sizeof(dscs) / sizeof(dscs[0]); i++) {
+        icons_create(dscs[i], LV_OPA_COVER);
+
+        uint32_t t[2];
+        uint32_t g;
+        for(g = 0; g < 2; g++) {
+            if(g) mask_add();
+            /*The tick is not incremented in the tests so measure the real time*/
+            uint32_t t_start = custom_tick_get();
+            uint32_t r;
+            for(r = 0; r < BENCH_REFR_CNT; r++) {
+                lv_obj_invalidate(lv_scr_act());
+                lv_refr_now(NULL);
+            }
+            t[g] = custom_tick_get() - t_start;
+            if(g) lv_draw_mask_remove_id(mask_id);
+        }
+
+        char s[128];
+        lv_snprintf(s, sizeof(s), "%s icons, %d refreshes: %d ms (generic path: %d ms)", names[i], BENCH_REFR_CNT,
+                    t[0], t[1]);
+        lv_test_print(s);
+    }
+}
+
+/**
+ * Fill the screen with icons.
+ * The icons are drawn by a single object to not run out of memory with small `LV_MEM_SIZE`
+ * @param dsc the image of the icons
+ * @param opa opacity of the icons
+ */
+static void icons_create(const lv_img_dsc_t * dsc, lv_opa_t opa)
+{
+    lv_obj_clean(lv_scr_act());
+
+    icons_src = dsc;
+    icons_opa = opa;
+
+    lv_obj_t * obj = lv_obj_create(lv_scr_act(), NULL);
+    lv_obj_set_size(obj, lv_disp_get_hor_res(NULL), lv_disp_get_ver_res(NULL));
+    ancestor_design = lv_obj_get_design_cb(obj);
+    lv_obj_set_design_cb(obj, icons_design);
+}
+
+static lv_design_res_t icons_design(lv_obj_t * obj, const lv_area_t * clip_area, lv_design_mode_t mode)
+{
+    lv_design_res_t res = ancestor_design(obj, clip_area, mode);
+    if(mode != LV_DESIGN_DRAW_MAIN) return res;
+
+    lv_draw_img_dsc_t dsc;
+    lv_draw_img_dsc_init(&dsc);
+    dsc.opa = icons_opa;
+
+    lv_coord_t x;
+    lv_coord_t y;
+    /*Start from -ICON_SIZE / 2 to clip some icons on the edges*/
+    for(y = obj->coords.y1 - ICON_SIZE / 2; y <= obj->coords.y2; y += ICON_SIZE + ICON_GAP) {
+        for(x = obj->coords.x1 - ICON_SIZE / 2; x <= obj->coords.x2; x += ICON_SIZE + ICON_GAP) {
+            lv_area_t coords;
+            lv_area_set(&coords, x, y, x + ICON_SIZE - 1, y + ICON_SIZE - 1);
+            lv_draw_img(&coords, clip_area, icons_src, &dsc);
+        }
+    }
+
+    return res;
+}
+
+/**
+ * Draw the screen and get its hash
+ * @param generic true: add a mask which covers everything to force the generic path
+ * @return hash of the rendered screen
+ */
+static uint32_t draw_and_hash(bool generic)
+{
+    if(generic) mask_add();
+
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+
+    if(generic) lv_draw_mask_remove_id(mask_id);
+
+    lv_disp_buf_t * vdb = lv_disp_get_buf(lv_disp_get_default());
+    const uint8_t * buf_u8 = (const uint8_t *)vdb->buf1;
+    uint32_t size = lv_area_get_size(&vdb->area) * sizeof(lv_color_t);
+    uint32_t hash = 2166136261u;
+    uint32_t i;
+    for(i = 0; i < size; i++) {
+        hash = (hash ^ buf_u8[i]) * 16777619u;
+    }
+
+    return hash;
+}
+
+/**
+ * Add a mask which doesn't hide anything but makes `lv_draw_map` use the generic path
+ */
+static void mask_add(void)
+{
+    lv_area_t a;
+    lv_area_set(&a, -1, -1, lv_disp_get_hor_res(NULL), lv_disp_get_ver_res(NULL));
+    lv_draw_mask_radius_init(&mask_param, &a, 0, false);
+    mask_id = lv_draw_mask_add(&mask_param, NULL);
+}
+
+/**
+ * Create the icons: a colorful pattern with transparent corners and semi-transparent edges
+ */
+static void init_icons(void)
+{
+    uint32_t x;
+    uint32_t y;
+    for(y = 0; y < ICON_SIZE; y++) {
+        for(x = 0; x < ICON_SIZE; x++) {
+            lv_color_t c = LV_COLOR_MAKE(x * 8, y * 8, (x + y) * 4);
+            uint32_t dx = x < ICON_SIZE / 2 ? ICON_SIZE / 2 - x : x - ICON_SIZE / 2;
+            uint32_t dy = y < ICON_SIZE / 2 ? ICON_SIZE / 2 - y : y - ICON_SIZE / 2;
+            uint32_t d = dx * dx + dy * dy;
+            lv_opa_t a = d > 256 ? LV_OPA_TRANSP : d > 196 ? (256 - d) * 4 : LV_OPA_COVER;
+
+            uint32_t i = y * ICON_SIZE + x;
+            _lv_memcpy(&icon_true_color_map[i * sizeof(lv_color_t)], &c, sizeof(lv_color_t));
+
+            lv_color_t ck = d > 256 ? LV_COLOR_TRANSP : c;
+            _lv_memcpy(&icon_chroma_keyed_map[i * sizeof(lv_color_t)], &ck, sizeof(lv_color_t));
+
+            uint8_t * px = &icon_alpha_map[i * LV_IMG_PX_SIZE_ALPHA_BYTE];
+            _lv_memcpy(px, &c, LV_IMG_PX_SIZE_ALPHA_BYTE - 1);
+            px[LV_IMG_PX_SIZE_ALPHA_BYTE - 1] = a;
+        }
+    }
+
+    icon_true_color.header.cf = LV_IMG_CF_TRUE_COLOR;
+    icon_true_color.header.w = ICON_SIZE;
+    icon_true_color.header.h = ICON_SIZE;
+    icon_true_color.data_size = sizeof(icon_true_color_map);
+    icon_true_color.data = icon_true_color_map;
+
+    icon_chroma_keyed = icon_true_color;
+    icon_chroma_keyed.header.cf = LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED;
+    icon_chroma_keyed.data = icon_chroma_keyed_map;
+
+    icon_alpha = icon_true_color;
+    icon_alpha.header.cf = LV_IMG_CF_TRUE_COLOR_ALPHA;
+    icon_alpha.data_size = sizeof(icon_alpha_map);
+    icon_alpha.data = icon_alpha_map;
+}
+
+#endif
@@ -0,0 +1,426 @@
+/**
+ * @file lv_test_img_cache.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_img_cache.h"
+
+#if LV_BUILD_TEST
+
+/*********************
+ *      DEFINES
+ *********************/
+#define TEST_IMG_W          10
+#define TEST_IMG_H          10
+#define TEST_IMG_MEM_SIZE   (TEST_IMG_W * TEST_IMG_H * LV_IMG_PX_SIZE_ALPHA_BYTE)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_IMG_CACHE_DEF_SIZE
+static void hit_miss(void);
+static void mem_limit(void);
+static void pin(void);
+static void prefetch(void);
+static void worker(void);
+#if LV_IMG_CACHE_ASYNC
+static void async_open(void);
+#endif
+#if LV_IMG_CACHE_MIPMAP
+static void mipmap(void);
+#endif
+static lv_res_t test_decoder_info(lv_img_decoder_t * decoder, const void * src, lv_img_header_t * header);
+static lv_res_t test_decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc);
+static uint32_t open_and_release(const void * src);
+static void test_worker_cb(lv_img_cache_job_t * job);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+#if LV_IMG_CACHE_DEF_SIZE
+static uint32_t open_cnt;
+static char last_src[16];
+static uint8_t test_img_data[TEST_IMG_MEM_SIZE];
+static lv_img_cache_job_t * worker_job;
+static uint32_t worker_job_cnt;
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_img_cache(void)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    lv_test_print("");
+    lv_test_print("========================");
+    lv_test_print("Start lv_img_cache tests");
+    lv_test_print("========================");
+
+    lv_img_decoder_t * decoder = lv_img_decoder_create();
+    lv_img_decoder_set_info_cb(decoder, test_decoder_info);
+    lv_img_decoder_set_open_cb(decoder, test_decoder_open);
+
+    lv_img_cache_set_size(4);
+
+    hit_miss();
+    mem_limit();
+    pin();
+    prefetch();
+    worker();
+#if LV_IMG_CACHE_ASYNC
+    async_open();
+#endif
+#if LV_IMG_CACHE_MIPMAP
+    mipmap();
+#endif
+
+    lv_img_cache_set_mem_limit(LV_IMG_CACHE_DEF_MEM_LIMIT);
+    lv_img_cache_set_size(LV_IMG_CACHE_DEF_SIZE);
+    lv_img_decoder_delete(decoder);
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_IMG_CACHE_DEF_SIZE
+static void hit_miss(void)
+{
+    lv_test_print("");
+    lv_test_print("Find the opened images:");
+    lv_test_print("-----------------------");
+
+    lv_img_cache_stat_t start;
+    lv_img_cache_stat_t stat;
+    lv_img_cache_get_stat(&start);
+
+    lv_test_assert_int_eq(1, open_and_release("T:img_a"), "Open a new image");
+    lv_test_assert_int_eq(0, open_and_release("T:img_a"), "Open the same image again");
+    lv_test_assert_int_eq(1, open_and_release("T:img_b"), "Open an other image");
+    lv_test_assert_int_eq(0, open_and_release("T:img_a"), "The first image is still cached");
+
+    lv_img_cache_get_stat(&stat);
+    lv_test_assert_int_eq(2, stat.hit_cnt - start.hit_cnt, "Hit count");
+    lv_test_assert_int_eq(2, stat.miss_cnt - start.miss_cnt, "Miss count");
+    lv_test_assert_int_eq(2, stat.entry_cnt, "Opened images");
+    lv_test_assert_int_eq(2 * TEST_IMG_MEM_SIZE, stat.mem_used, "Memory used by the opened images");
+
+    lv_img_cache_invalidate_src("T:img_a");
+    lv_img_cache_get_stat(&stat);
+    lv_test_assert_int_eq(1, stat.entry_cnt, "Opened images after invalidate");
+    lv_test_assert_int_eq(TEST_IMG_MEM_SIZE, stat.mem_used, "Memory used after invalidate");
+    lv_test_assert_int_eq(1, open_and_release("T:img_a"), "Open the invalidated image again");
+
+    lv_img_cache_invalidate_src(NULL);
+    lv_img_cache_get_stat(&stat);
+    lv_test_assert_int_eq(0, stat.entry_cnt, "Opened images after invalidating all");
+    lv_test_assert_int_eq(0, stat.mem_used, "Memory used after invalidating all");
+}
+
+static void mem_limit(void)
+{
+    lv_test_print("");
+    lv_test_print("Close images to fit into the memory budget:");
+    lv_test_print("-------------------------------------------");
+
+    lv_img_cache_stat_t start;
+    lv_img_cache_stat_t stat;
+    lv_img_cache_get_stat(&start);
+
+    lv_img_cache_set_mem_limit(2 * TEST_IMG_MEM_SIZE + TEST_IMG_MEM_SIZE / 2);
+    open_and_release("T:img_a");
+    open_and_release("T:img_b");
+    open_and_release("T:img_a");
+    open_and_release("T:img_c");
+
+    lv_img_cache_get_stat(&stat);
+    lv_test_assert_int_eq(1, stat.evict_cnt - start.evict_cnt, "Close an image");
+    lv_test_assert_int_eq(2 * TEST_IMG_MEM_SIZE, stat.mem_used, "Memory used in the budget");
+    lv_test_assert_int_eq(1, open_and_release("T:img_b"), "The least recently used image was closed");
+    lv_test_assert_int_eq(0, open_and_release("T:img_b"), "The reopened image is cached");
+
+    lv_img_cache_set_mem_limit(TEST_IMG_MEM_SIZE / 2);
+    lv_img_cache_get_stat(&stat);
+    lv_test_assert_int_eq(0, stat.entry_cnt, "Close all images which doesn't fit into the new budget");
+    lv_test_assert_int_eq(0, stat.mem_used, "No memory is used");
+
+    lv_img_cache_set_mem_limit(0);
+}
+
+static void pin(void)
+{
+    lv_test_print("");
+    lv_test_print("Keep the pinned images:");
+    lv_test_print("-----------------------");
+
+    lv_img_cache_stat_t stat;
+    lv_img_cache_set_mem_limit(TEST_IMG_MEM_SIZE);
+
+    lv_test_assert_int_eq(LV_RES_OK, lv_img_cache_pin("T:img_a", LV_COLOR_BLACK), "Pin an image");
+    open_and_release("T:img_b");
+
+    lv_img_cache_get_stat(&stat);
+    lv_test_assert_int_eq(1, stat.pinned_cnt, "Pinned images");
+    lv_test_assert_int_eq(1, stat.entry_cnt, "Opened images");
+    lv_test_assert_int_eq(0, open_and_release("T:img_a"), "The pinned image is kept");
+    lv_test_assert_int_eq(1, open_and_release("T:img_b"), "The other image is closed");
+
+    lv_img_cache_unpin("T:img_a", LV_COLOR_BLACK);
+    lv_test_assert_int_eq(1, open_and_release("T:img_b"), "Open an other image");
+    lv_test_assert_int_eq(1, open_and_release("T:img_a"), "The unpinned image is closed");
+
+    lv_img_cache_set_mem_limit(0);
+    lv_img_cache_invalidate_src(NULL);
+
+    lv_test_print("Invalidate a pinned image");
+    lv_test_assert_int_eq(LV_RES_OK, lv_img_cache_pin("T:img_a", LV_COLOR_BLACK), "Pin an image");
+    lv_img_cache_invalidate_src("T:img_a");
+    lv_img_cache_set_size(2);
+    lv_img_cache_get_stat(&stat);
+    lv_test_assert_int_eq(1, stat.pinned_cnt, "The invalidated image is still pinned");
+    lv_test_assert_int_eq(4, stat.entry_max, "The cache is not resized while an image is pinned");
+    lv_test_assert_int_eq(0, open_and_release("T:img_a"), "The pinned image is still used");
+
+    lv_img_cache_unpin("T:img_a", LV_COLOR_BLACK);
+    lv_img_cache_get_stat(&stat);
+    lv_test_assert_int_eq(0, stat.pinned_cnt, "No pinned images");
+    lv_test_assert_int_eq(0, stat.entry_cnt, "The invalidated image is closed when unpinned");
+    lv_test_assert_int_eq(1, open_and_release("T:img_a"), "The invalidated image is opened again");
+
+    lv_img_cache_invalidate_src(NULL);
+}
+
+static void prefetch(void)
+{
+    lv_test_print("");
+    lv_test_print("Prefetch images:");
+    lv_test_print("----------------");
+
+    uint32_t open_cnt_start = open_cnt;
+    lv_test_assert_int_eq(LV_RES_OK, lv_img_cache_prefetch("T:img_a", LV_COLOR_BLACK), "Queue an image");
+    lv_test_assert_int_eq(0, open_cnt - open_cnt_start, "The image is not opened immediately");
+    lv_test_assert_int_eq(0, lv_img_cache_is_cached("T:img_a", LV_COLOR_BLACK), "The image is not cached yet");
+
+    lv_task_handler();
+    lv_test_assert_int_eq(1, open_cnt - open_cnt_start, "The image is opened by the task");
+    lv_test_assert_int_eq(1, lv_img_cache_is_cached("T:img_a", LV_COLOR_BLACK), "The image is cached");
+    lv_test_assert_int_eq(0, open_and_release("T:img_a"), "The prefetched image is not opened again");
+
+#if LV_USE_IMG
+    lv_obj_t * scr = lv_obj_create(NULL, NULL);
+    lv_obj_t * cont = lv_obj_create(scr, NULL);
+    lv_obj_t * img = lv_img_create(cont, NULL);
+    lv_img_set_src(img, "T:img_b");
+
+    lv_test_assert_int_eq(0, lv_img_tree_is_cached(scr), "The images of the screen are not cached");
+
+    lv_img_prefetch_tree(scr);
+    lv_task_handler();
+    lv_test_assert_int_eq(1, lv_img_tree_is_cached(scr), "The images of the screen are prefetched");
+
+    lv_obj_del(scr);
+#endif
+
+    lv_img_cache_invalidate_src(NULL);
+}
+
+static void worker(void)
+{
+    lv_test_print("");
+    lv_test_print("Open images in a worker:");
+    lv_test_print("------------------------");
+
+    lv_img_cache_set_worker(test_worker_cb);
+    worker_job_cnt = 0;
+
+    uint32_t open_cnt_start = open_cnt;
+    lv_test_assert_int_eq(LV_RES_OK, lv_img_cache_prefetch("T:img_a", LV_COLOR_BLACK), "Queue an image");
+    lv_task_handler();
+    lv_test_assert_int_eq(1, worker_job_cnt, "The image is passed to the worker");
+    lv_test_assert_int_eq(0, open_cnt - open_cnt_start, "The task doesn't open the image");
+    lv_task_handler();
+    lv_test_assert_int_eq(1, worker_job_cnt, "The image is passed to the worker only once");
+
+    /*Called by the worker thread*/
+    lv_img_cache_job_open(worker_job);
+    lv_test_assert_int_eq(1, open_cnt - open_cnt_start, "The worker opens the image");
+    lv_test_assert_int_eq(0, lv_img_cache_is_cached("T:img_a", LV_COLOR_BLACK), "Not cached until it's ready");
+    lv_img_cache_job_ready(worker_job);
+    lv_test_assert_int_eq(1, lv_img_cache_is_cached("T:img_a", LV_COLOR_BLACK), "The image is cached");
+    lv_test_assert_int_eq(0, open_and_release("T:img_a"), "The image is not opened again");
+
+    lv_test_assert_int_eq(LV_RES_OK, lv_img_cache_prefetch("T:fail", LV_COLOR_BLACK), "Queue an invalid image");
+    lv_task_handler();
+    lv_test_assert_int_eq(2, worker_job_cnt, "The invalid image is passed to the worker");
+    lv_img_cache_job_open(worker_job);
+    lv_img_cache_job_ready(worker_job);
+    lv_test_assert_int_eq(LV_RES_INV, lv_img_cache_prefetch("T:fail", LV_COLOR_BLACK),
+                          "The invalid image is not queued again");
+
+    lv_img_cache_set_worker(NULL);
+    lv_img_cache_invalidate_src(NULL);
+}
+
+#if LV_IMG_CACHE_ASYNC
+static void async_open(void)
+{
+    lv_test_print("");
+    lv_test_print("Open images asynchronously:");
+    lv_test_print("---------------------------");
+
+    lv_area_t area;
+    lv_area_set(&area, 10, 10, 10 + TEST_IMG_W - 1, 10 + TEST_IMG_H - 1);
+
+    bool pending;
+    uint32_t open_cnt_start = open_cnt;
+    lv_img_cache_entry_t * entry;
+    entry = _lv_img_cache_open_async("T:img_a", LV_COLOR_BLACK, LV_IMG_CACHE_PRIO_VISIBLE, &area, &pending);
+    lv_test_assert_ptr_eq(NULL, entry, "The image is not opened during drawing");
+    lv_test_assert_int_eq(1, pending, "The image is queued");
+    lv_test_assert_int_eq(0, open_cnt - open_cnt_start, "The decoder is not called");
+
+    lv_task_handler();
+    lv_test_assert_int_eq(1, open_cnt - open_cnt_start, "The image is opened by the task");
+
+    entry = _lv_img_cache_open_async("T:img_a", LV_COLOR_BLACK, LV_IMG_CACHE_PRIO_VISIBLE, &area, &pending);
+    lv_test_assert_int_eq(0, pending, "The opened image is not queued again");
+    lv_test_assert_true(entry != NULL, "The opened image is found in the cache");
+    if(entry) _lv_img_cache_release(entry);
+
+    _lv_img_cache_open_async("T:img_b", LV_COLOR_BLACK, LV_IMG_CACHE_PRIO_PREFETCH, NULL, &pending);
+    _lv_img_cache_open_async("T:img_c", LV_COLOR_BLACK, LV_IMG_CACHE_PRIO_VISIBLE, &area, &pending);
+    lv_task_handler();
+    lv_test_assert_str_eq("T:img_c", last_src, "The visible image is opened first");
+    lv_task_handler();
+    lv_test_assert_str_eq("T:img_b", last_src, "The prefetched image is opened then");
+
+    entry = _lv_img_cache_open_async("T:fail", LV_COLOR_BLACK, LV_IMG_CACHE_PRIO_VISIBLE, &area, &pending);
+    lv_test_assert_int_eq(1, pending, "An invalid image is queued too");
+    lv_task_handler();
+    entry = _lv_img_cache_open_async("T:fail", LV_COLOR_BLACK, LV_IMG_CACHE_PRIO_VISIBLE, &area, &pending);
+    lv_test_assert_int_eq(0, pending, "The invalid image is not queued again");
+    lv_test_assert_ptr_eq(NULL, entry, "The invalid image can't be opened");
+
+    lv_img_cache_invalidate_src(NULL);
+}
+#endif
+
+#if LV_IMG_CACHE_MIPMAP
+static void mipmap(void)
+{
+    lv_test_print("");
+    lv_test_print("Downscale the zoomed out images:");
+    lv_test_print("--------------------------------");
+
+    /*Fill the image with the same pixels*/
+    uint32_t i;
+    for(i = 0; i < TEST_IMG_W * TEST_IMG_H; i++) {
+        lv_color_t c = LV_COLOR_RED;
+        _lv_memcpy_small(&test_img_data[i * LV_IMG_PX_SIZE_ALPHA_BYTE], &c, LV_IMG_PX_SIZE_ALPHA_BYTE - 1);
+        test_img_data[i * LV_IMG_PX_SIZE_ALPHA_BYTE + LV_IMG_PX_SIZE_ALPHA_BYTE - 1] = LV_OPA_50;
+    }
+
+    lv_img_cache_stat_t stat;
+    lv_img_cache_entry_t * entry = _lv_img_cache_open("T:img_a", LV_COLOR_BLACK);
+    uint8_t level;
+    const uint8_t * data;
+
+    data = _lv_img_cache_get_mipmap(entry, 200, &level);
+    lv_test_assert_int_eq(0, level, "No level if zoomed out less than half");
+    lv_test_assert_ptr_eq(test_img_data, data, "Draw the original image");
+
+    data = _lv_img_cache_get_mipmap(entry, 128, &level);
+    lv_test_assert_int_eq(1, level, "Use the 1/2 level for half zoom");
+    lv_img_cache_get_stat(&stat);
+    /*The levels of the 10x10 image: 5x5, 2x2, 1x1*/
+    lv_test_assert_int_eq(TEST_IMG_MEM_SIZE + (25 + 4 + 1) * LV_IMG_PX_SIZE_ALPHA_BYTE, stat.mem_used,
+                          "The levels are counted in the memory");
+
+    lv_color_t c;
+    _lv_memset_00(&c, sizeof(c));
+    _lv_memcpy_small(&c, data, LV_IMG_PX_SIZE_ALPHA_BYTE - 1);
+    lv_test_assert_int_eq(LV_COLOR_RED.full & 0xFFFFFF, c.full & 0xFFFFFF, "Keep the color");
+    lv_test_assert_int_eq(LV_OPA_50, data[LV_IMG_PX_SIZE_ALPHA_BYTE - 1], "Keep the opacity");
+
+    _lv_img_cache_get_mipmap(entry, 64, &level);
+    lv_test_assert_int_eq(2, level, "Use the 1/4 level for quarter zoom");
+    _lv_img_cache_get_mipmap(entry, 10, &level);
+    lv_test_assert_int_eq(3, level, "Use the smallest level if zoomed out more");
+
+    _lv_img_cache_release(entry);
+    lv_img_cache_invalidate_src(NULL);
+    lv_img_cache_get_stat(&stat);
+    lv_test_assert_int_eq(0, stat.mem_used, "The levels are freed");
+
+    _lv_memset_00(test_img_data, sizeof(test_img_data));
+}
+#endif
+
+static lv_res_t test_decoder_info(lv_img_decoder_t * decoder, const void * src, lv_img_header_t * header)
+{
+    LV_UNUSED(decoder);
+
+    if(lv_img_src_get_type(src) != LV_IMG_SRC_FILE) return LV_RES_INV;
+    if(strncmp(src, "T:", 2) != 0) return LV_RES_INV;
+    if(strcmp(src, "T:fail") == 0) return LV_RES_INV;
+
+    header->cf = LV_IMG_CF_TRUE_COLOR_ALPHA;
+    header->w = TEST_IMG_W;
+    header->h = TEST_IMG_H;
+    return LV_RES_OK;
+}
+
+static lv_res_t test_decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc)
+{
+    LV_UNUSED(decoder);
+
+    open_cnt++;
+    strncpy(last_src, dsc->src, sizeof(last_src) - 1);
+    dsc->img_data = test_img_data;
+    dsc->mem_size = TEST_IMG_MEM_SIZE;
+    dsc->time_to_open = 1;
+    return LV_RES_OK;
+}
+
+/**
+ * Open and release an image like drawing does
+ * @param src the image source
+ * @return number of times the decoder opened the image
+ */
+static uint32_t open_and_release(const void * src)
+{
+    uint32_t open_cnt_start = open_cnt;
+    lv_img_cache_entry_t * entry = _lv_img_cache_open(src, LV_COLOR_BLACK);
+    if(entry) _lv_img_cache_release(entry);
+
+    return open_cnt - open_cnt_start;
+}
+
+/**
+ * Keep the job to open it later like a worker thread would do
+ * @param job the job to open
+ */
+static void test_worker_cb(lv_img_cache_job_t * job)
+{
+    worker_job = job;
+    worker_job_cnt++;
+}
+#endif
+
+#endif
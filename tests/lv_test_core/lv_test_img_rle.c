@@ -0,0 +1,341 @@
+/**
+ * @file lv_test_img_rle.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_img_rle.h"
+
+#if LV_BUILD_TEST
+#include <stdio.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define TEST_IMG_W      37
+#define TEST_IMG_H      9
+#define BENCH_IMG_W     240
+#define BENCH_IMG_H     160
+#define BENCH_TIME      100     /*[ms]*/
+
+/*Worst case: a control byte for every pixel*/
+#define RLE_MAX_SIZE(w, h, px_size) (((h) + 1) * 4 + (w) * (h) * ((px_size) + 1))
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_IMG_CF_RLE
+static void decode_variable(void);
+#if LV_USE_FILESYSTEM
+static void decode_file(void);
+static void benchmark(void);
+static uint32_t bench_read(const void * src, lv_coord_t w, lv_coord_t h, uint8_t px_size);
+static void write_bin(const char * path, lv_img_cf_t cf, lv_coord_t w, lv_coord_t h, const uint8_t * data,
+                      uint32_t size);
+#endif
+static void fill_pixels(uint8_t * buf, lv_coord_t w, lv_coord_t h, uint8_t px_size);
+static uint32_t rle_encode(const uint8_t * px, lv_coord_t w, lv_coord_t h, uint8_t px_size, uint8_t * out);
+static bool check_lines(lv_img_decoder_dsc_t * dsc, const uint8_t * ref, uint8_t px_size);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+#if LV_IMG_CF_RLE
+static uint8_t raw_px[TEST_IMG_W * TEST_IMG_H * LV_IMG_PX_SIZE_ALPHA_BYTE];
+static uint8_t rle_data[RLE_MAX_SIZE(TEST_IMG_W, TEST_IMG_H, LV_IMG_PX_SIZE_ALPHA_BYTE)];
+static uint32_t rle_size;
+#if LV_USE_FILESYSTEM
+/*Too large for the heap of the small configurations*/
+static uint8_t bench_raw[BENCH_IMG_W * BENCH_IMG_H * (LV_COLOR_SIZE >> 3)];
+static uint8_t bench_rle[RLE_MAX_SIZE(BENCH_IMG_W, BENCH_IMG_H, LV_COLOR_SIZE >> 3)];
+#endif
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_img_rle(void)
+{
+#if LV_IMG_CF_RLE
+    lv_test_print("");
+    lv_test_print("==========================");
+    lv_test_print("Start lv_img RLE tests");
+    lv_test_print("==========================");
+
+    fill_pixels(raw_px, TEST_IMG_W, TEST_IMG_H, LV_IMG_PX_SIZE_ALPHA_BYTE);
+    rle_size = rle_encode(raw_px, TEST_IMG_W, TEST_IMG_H, LV_IMG_PX_SIZE_ALPHA_BYTE, rle_data);
+
+    decode_variable();
+#if LV_USE_FILESYSTEM
+    decode_file();
+    benchmark();
+#endif
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_IMG_CF_RLE
+static void decode_variable(void)
+{
+    lv_test_print("");
+    lv_test_print("Decode RLE variables:");
+    lv_test_print("---------------------");
+
+    lv_img_dsc_t img;
+    _lv_memset_00(&img, sizeof(img));
+    img.header.cf = LV_IMG_CF_RLE_TRUE_COLOR_ALPHA;
+    img.header.w = TEST_IMG_W;
+    img.header.h = TEST_IMG_H;
+    img.data = rle_data;
+    img.data_size = rle_size;
+
+    lv_test_assert_true(rle_size < sizeof(raw_px), "The image is compressed");
+
+    lv_img_header_t header;
+    lv_test_assert_int_eq(LV_RES_OK, lv_img_decoder_get_info((const char *)&img, &header), "Get the info");
+    lv_test_assert_int_eq(LV_IMG_CF_RLE_TRUE_COLOR_ALPHA, header.cf, "Color format");
+    lv_test_assert_true(lv_img_cf_has_alpha(header.cf), "Has alpha");
+
+    lv_img_decoder_dsc_t dsc;
+    lv_test_assert_int_eq(LV_RES_OK, lv_img_decoder_open(&dsc, &img, LV_COLOR_BLACK), "Open the image");
+#if LV_IMG_RLE_DECODE_FULL
+    lv_test_assert_true(memcmp(raw_px, dsc.img_data, sizeof(raw_px)) == 0, "Decode the whole image");
+    lv_test_assert_int_eq(sizeof(raw_px), dsc.mem_size, "Memory of the decoded image");
+#else
+    lv_test_assert_ptr_eq(NULL, dsc.img_data, "Decode line-by-line");
+#endif
+    lv_test_assert_true(check_lines(&dsc, raw_px, LV_IMG_PX_SIZE_ALPHA_BYTE), "Decode parts of the lines");
+    lv_img_decoder_close(&dsc);
+
+    /*Cut the last row*/
+    img.data_size = rle_size - 1;
+    lv_res_t res = lv_img_decoder_open(&dsc, &img, LV_COLOR_BLACK);
+    if(res == LV_RES_OK) {
+        uint8_t buf[TEST_IMG_W * LV_IMG_PX_SIZE_ALPHA_BYTE];
+        res = lv_img_decoder_read_line(&dsc, 0, TEST_IMG_H - 1, TEST_IMG_W, buf);
+        lv_img_decoder_close(&dsc);
+    }
+    lv_test_assert_int_eq(LV_RES_INV, res, "Detect truncated data");
+}
+
+#if LV_USE_FILESYSTEM
+static void decode_file(void)
+{
+    lv_test_print("");
+    lv_test_print("Decode RLE files:");
+    lv_test_print("-----------------");
+
+    write_bin("lv_test_rle.bin", LV_IMG_CF_RLE_TRUE_COLOR_ALPHA, TEST_IMG_W, TEST_IMG_H, rle_data, rle_size);
+
+    lv_img_decoder_dsc_t dsc;
+    lv_test_assert_int_eq(LV_RES_OK, lv_img_decoder_open(&dsc, "f:lv_test_rle.bin", LV_COLOR_BLACK),
+                          "Open the file");
+    lv_test_assert_true(check_lines(&dsc, raw_px, LV_IMG_PX_SIZE_ALPHA_BYTE), "Decode parts of the lines");
+    lv_img_decoder_close(&dsc);
+
+    remove("lv_test_rle.bin");
+}
+
+static void benchmark(void)
+{
+    lv_test_print("");
+    lv_test_print("Decode speed:");
+    lv_test_print("-------------");
+
+    uint8_t px_size = LV_COLOR_SIZE >> 3;
+    uint32_t raw_size = sizeof(bench_raw);
+    uint8_t * raw = bench_raw;
+    uint8_t * rle = bench_rle;
+
+    fill_pixels(raw, BENCH_IMG_W, BENCH_IMG_H, px_size);
+    uint32_t rle_bench_size = rle_encode(raw, BENCH_IMG_W, BENCH_IMG_H, px_size, rle);
+
+    write_bin("lv_test_raw.bin", LV_IMG_CF_TRUE_COLOR, BENCH_IMG_W, BENCH_IMG_H, raw, raw_size);
+    write_bin("lv_test_rle.bin", LV_IMG_CF_RLE_TRUE_COLOR, BENCH_IMG_W, BENCH_IMG_H, rle, rle_bench_size);
+
+    lv_img_dsc_t img;
+    _lv_memset_00(&img, sizeof(img));
+    img.header.cf = LV_IMG_CF_RLE_TRUE_COLOR;
+    img.header.w = BENCH_IMG_W;
+    img.header.h = BENCH_IMG_H;
+    img.data = rle;
+    img.data_size = rle_bench_size;
+
+    uint32_t speed_raw = bench_read("f:lv_test_raw.bin", BENCH_IMG_W, BENCH_IMG_H, px_size);
+    uint32_t speed_rle_file = bench_read("f:lv_test_rle.bin", BENCH_IMG_W, BENCH_IMG_H, px_size);
+    uint32_t speed_rle_var = bench_read(&img, BENCH_IMG_W, BENCH_IMG_H, px_size);
+
+    lv_test_print("Compressed to %d%%", (int)(rle_bench_size * 100 / raw_size));
+    lv_test_print("Raw file read with lv_fs: %d kB/s", (int)speed_raw);
+    lv_test_print("RLE file decode:          %d kB/s", (int)speed_rle_file);
+    lv_test_print("RLE variable decode:      %d kB/s", (int)speed_rle_var);
+    lv_test_assert_true(speed_rle_file > 0 && speed_rle_var > 0, "Decoded the images");
+
+    remove("lv_test_raw.bin");
+    remove("lv_test_rle.bin");
+}
+
+/**
+ * Read all lines of an image repeatedly
+ * @param src the image source
+ * @param w width of the image
+ * @param h height of the image
+ * @param px_size size of a decoded pixel in bytes
+ * @return decoded kB/s
+ */
+static uint32_t bench_read(const void * src, lv_coord_t w, lv_coord_t h, uint8_t px_size)
+{
+    lv_img_decoder_dsc_t dsc;
+    if(lv_img_decoder_open(&dsc, src, LV_COLOR_BLACK) != LV_RES_OK) return 0;
+
+    uint8_t * buf = lv_mem_alloc(w * px_size);
+    LV_ASSERT_MEM(buf);
+    if(buf == NULL) {
+        lv_img_decoder_close(&dsc);
+        return 0;
+    }
+
+    uint32_t bytes = 0;
+    /*The tick is not incremented in the tests so measure the real time*/
+    uint32_t t_start = custom_tick_get();
+    while(custom_tick_get() - t_start < BENCH_TIME) {
+        lv_coord_t y;
+        for(y = 0; y < h; y++) {
+            if(dsc.img_data) _lv_memcpy(buf, &dsc.img_data[y * w * px_size], w * px_size);
+            else lv_img_decoder_read_line(&dsc, 0, y, w, buf);
+        }
+        bytes += w * h * px_size;
+    }
+    uint32_t t_elaps = custom_tick_get() - t_start;
+
+    lv_mem_free(buf);
+    lv_img_decoder_close(&dsc);
+
+    return bytes / t_elaps;
+}
+
+static void write_bin(const char * path, lv_img_cf_t cf, lv_coord_t w, lv_coord_t h, const uint8_t * data,
+                      uint32_t size)
+{
+    lv_img_header_t header;
+    _lv_memset_00(&header, sizeof(header));
+    header.cf = cf;
+    header.w = w;
+    header.h = h;
+
+    FILE * f = fopen(path, "wb");
+    fwrite(&header, sizeof(header), 1, f);
+    fwrite(data, 1, size, f);
+    fclose(f);
+}
+#endif
+
+/**
+ * Create a UI-like image: flat bands with some details on the top and a photo-like area on the bottom
+ */
+static void fill_pixels(uint8_t * buf, lv_coord_t w, lv_coord_t h, uint8_t px_size)
+{
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = 0; y < h; y++) {
+        for(x = 0; x < w; x++) {
+            uint8_t * px = &buf[(y * w + x) * px_size];
+            uint32_t v;
+            if(y < (h * 2) / 3) v = (y / 3) * 40 + (x > w / 2 && x < w / 2 + 4 ? x * 13 : 0);
+            else v = x * 7 + y * 3 + ((x * y) & 0x0F);
+            uint32_t i;
+            for(i = 0; i < px_size; i++) px[i] = (v >> i) & 0xFF;
+        }
+    }
+}
+
+/**
+ * Encode an image to `LV_IMG_CF_RLE_...` data
+ * @return size of the encoded data
+ */
+static uint32_t rle_encode(const uint8_t * px, lv_coord_t w, lv_coord_t h, uint8_t px_size, uint8_t * out)
+{
+    uint8_t * table = out;
+    uint8_t * rows = out + (h + 1) * 4;
+    uint32_t ofs = 0;
+    lv_coord_t y;
+    for(y = 0; y <= h; y++) {
+        table[y * 4 + 0] = ofs & 0xFF;
+        table[y * 4 + 1] = (ofs >> 8) & 0xFF;
+        table[y * 4 + 2] = (ofs >> 16) & 0xFF;
+        table[y * 4 + 3] = (ofs >> 24) & 0xFF;
+        if(y == h) break;
+
+        const uint8_t * row = &px[y * w * px_size];
+        lv_coord_t x = 0;
+        while(x < w) {
+            lv_coord_t run = 1;
+            while(x + run < w && run < 128 && memcmp(&row[x * px_size], &row[(x + run) * px_size], px_size) == 0) run++;
+            if(run >= 2) {
+                rows[ofs++] = LV_IMG_RLE_RUN | (run - 1);
+                memcpy(&rows[ofs], &row[x * px_size], px_size);
+                ofs += px_size;
+                x += run;
+            }
+            else {
+                lv_coord_t lit = 1;
+                while(x + lit < w && lit < 128 &&
+                      (x + lit + 1 >= w || memcmp(&row[(x + lit) * px_size], &row[(x + lit + 1) * px_size], px_size) != 0)) {
+                    lit++;
+                }
+                rows[ofs++] = lit - 1;
+                memcpy(&rows[ofs], &row[x * px_size], lit * px_size);
+                ofs += lit * px_size;
+                x += lit;
+            }
+        }
+    }
+
+    return (h + 1) * 4 + ofs;
+}
+
+/**
+ * Read parts of all lines and compare them with the reference
+ */
+static bool check_lines(lv_img_decoder_dsc_t * dsc, const uint8_t * ref, uint8_t px_size)
+{
+    static const lv_coord_t parts[][2] = {{0, TEST_IMG_W}, {0, 1}, {5, 20}, {18, 3}, {TEST_IMG_W - 1, 1}};
+    uint8_t buf[TEST_IMG_W * LV_IMG_PX_SIZE_ALPHA_BYTE];
+    lv_coord_t y;
+    for(y = 0; y < TEST_IMG_H; y++) {
+        uint32_t i;
+        for(i = 0; i < sizeof(parts) / sizeof(parts[0]); i++) {
+            lv_coord_t x = parts[i][0];
+            lv_coord_t len = parts[i][1];
+            if(dsc->img_data) {
+                if(memcmp(&dsc->img_data[(y * TEST_IMG_W + x) * px_size], &ref[(y * TEST_IMG_W + x) * px_size],
+                          len * px_size) != 0) return false;
+                continue;
+            }
+            if(lv_img_decoder_read_line(dsc, x, y, len, buf) != LV_RES_OK) return false;
+            if(memcmp(buf, &ref[(y * TEST_IMG_W + x) * px_size], len * px_size) != 0) return false;
+        }
+    }
+
+    return true;
+}
+#endif
+
+#endif
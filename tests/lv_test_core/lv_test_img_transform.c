@@ -0,0 +1,245 @@
+/**
+ * @file lv_test_img_transform.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_img_transform.h"
+
+#if LV_BUILD_TEST
+
+/*********************
+ *      DEFINES
+ *********************/
+#define TEST_IMG_W      60
+#define TEST_IMG_H      40
+#define TEST_LINE_LEN   100
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_USE_IMG_TRANSFORM
+static void line_eq_px(void);
+static bool check_transform(uint16_t angle, uint16_t zoom, bool antialias);
+static void read_lines(void);
+static uint32_t draw_and_hash(const void * src);
+static lv_res_t test_decoder_info(lv_img_decoder_t * decoder, const void * src, lv_img_header_t * header);
+static lv_res_t test_decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc);
+static lv_res_t test_decoder_read_line(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc,
+                                       lv_coord_t x, lv_coord_t y, lv_coord_t len, uint8_t * buf);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+#if LV_USE_IMG_TRANSFORM
+static uint8_t test_img_data[TEST_IMG_W * TEST_IMG_H * LV_IMG_PX_SIZE_ALPHA_BYTE];
+static uint32_t read_line_cnt;
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_img_transform(void)
+{
+#if LV_USE_IMG_TRANSFORM
+    lv_test_print("");
+    lv_test_print("============================");
+    lv_test_print("Start lv_img_transform tests");
+    lv_test_print("============================");
+
+    uint32_t i;
+    for(i = 0; i < sizeof(test_img_data); i++) {
+        test_img_data[i] = (i * 37 + (i >> 3)) & 0xFF;
+    }
+
+    line_eq_px();
+    read_lines();
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_USE_IMG_TRANSFORM
+static void line_eq_px(void)
+{
+    lv_test_print("");
+    lv_test_print("Transform lines like pixels:");
+
+    static const uint16_t angles[] = {0, 1, 450, 900, 1800, 2700, 3333};
+    static const uint16_t zooms[] = {1, 100, 256, 300, 512, 768};
+
+    uint32_t a;
+    uint32_t z;
+    for(a = 0; a < sizeof(angles) / sizeof(angles[0]); a++) {
+        for(z = 0; z < sizeof(zooms) / sizeof(zooms[0]); z++) {
+            if(angles[a] == 0 && zooms[z] == LV_IMG_ZOOM_NONE) continue;
+            lv_test_assert_true(check_transform(angles[a], zooms[z], true), "Same result with anti-aliasing");
+            lv_test_assert_true(check_transform(angles[a], zooms[z], false), "Same result without anti-aliasing");
+        }
+    }
+}
+
+/**
+ * Transform an area with `_lv_img_buf_transform_line` and `_lv_img_buf_transform` and compare the results
+ * @param angle angle of the image
+ * @param zoom zoom of the image
+ * @param antialias enable anti-aliasing
+ * @return true: the results are the same
+ */
+static bool check_transform(uint16_t angle, uint16_t zoom, bool antialias)
+{
+    lv_img_transform_dsc_t dsc_line;
+    _lv_memset_00(&dsc_line, sizeof(dsc_line));
+    dsc_line.cfg.angle = angle;
+    dsc_line.cfg.zoom = zoom;
+    dsc_line.cfg.src = test_img_data;
+    dsc_line.cfg.src_w = TEST_IMG_W;
+    dsc_line.cfg.src_h = TEST_IMG_H;
+    dsc_line.cfg.cf = LV_IMG_CF_TRUE_COLOR_ALPHA;
+    dsc_line.cfg.pivot_x = TEST_IMG_W / 3;
+    dsc_line.cfg.pivot_y = TEST_IMG_H / 2;
+    dsc_line.cfg.antialias = antialias;
+
+    lv_img_transform_dsc_t dsc_px;
+    _lv_memcpy(&dsc_px, &dsc_line, sizeof(dsc_px));
+
+    _lv_img_buf_transform_init(&dsc_line);
+    _lv_img_buf_transform_init(&dsc_px);
+
+    lv_color_t cbuf[TEST_LINE_LEN];
+    lv_opa_t abuf[TEST_LINE_LEN];
+
+    lv_coord_t y;
+    for(y = -40; y < 60; y++) {
+        _lv_img_buf_transform_line(&dsc_line, -40, y, TEST_LINE_LEN, cbuf, abuf);
+
+        lv_coord_t x;
+        for(x = 0; x < TEST_LINE_LEN; x++) {
+            bool ret = _lv_img_buf_transform(&dsc_px, x - 40, y);
+            if(ret == false) {
+                if(abuf[x] != LV_OPA_TRANSP) return false;
+            }
+            else {
+                if(abuf[x] != dsc_px.res.opa) return false;
+                if(abuf[x] != LV_OPA_TRANSP && cbuf[x].full != dsc_px.res.color.full) return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+static void read_lines(void)
+{
+    lv_test_print("");
+    lv_test_print("Transform images read line-by-line:");
+
+    lv_img_decoder_t * decoder = lv_img_decoder_create();
+    lv_img_decoder_set_info_cb(decoder, test_decoder_info);
+    lv_img_decoder_set_open_cb(decoder, test_decoder_open);
+    lv_img_decoder_set_read_line_cb(decoder, test_decoder_read_line);
+
+    lv_img_dsc_t img_var;
+    _lv_memset_00(&img_var, sizeof(img_var));
+    img_var.header.cf = LV_IMG_CF_TRUE_COLOR_ALPHA;
+    img_var.header.w = TEST_IMG_W;
+    img_var.header.h = TEST_IMG_H;
+    img_var.data_size = sizeof(test_img_data);
+    img_var.data = test_img_data;
+
+    read_line_cnt = 0;
+    uint32_t hash_lines = draw_and_hash("L:img");
+    uint32_t hash_var = draw_and_hash(&img_var);
+
+    lv_test_assert_true(read_line_cnt > 0, "The image is read line-by-line");
+    lv_test_assert_int_eq(hash_var, hash_lines, "Same result as with the whole image");
+
+    lv_img_cache_invalidate_src("L:img");
+    lv_img_decoder_delete(decoder);
+}
+
+/**
+ * Draw a rotated and zoomed image and get the hash of the screen
+ * @param src source of the image
+ * @return hash of the rendered screen
+ */
+static uint32_t draw_and_hash(const void * src)
+{
+    lv_obj_clean(lv_scr_act());
+
+    lv_obj_t * img = lv_img_create(lv_scr_act(), NULL);
+    lv_img_set_src(img, src);
+    lv_obj_set_pos(img, 50, 40);
+    lv_img_set_angle(img, 300);
+    lv_img_set_zoom(img, 384);
+
+    /*Let the image open if it's opened asynchronously*/
+    lv_refr_now(NULL);
+    lv_task_handler();
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+
+    lv_disp_buf_t * vdb = lv_disp_get_buf(lv_disp_get_default());
+    const uint8_t * buf_u8 = (const uint8_t *)vdb->buf1;
+    uint32_t size = lv_area_get_size(&vdb->area) * sizeof(lv_color_t);
+    uint32_t hash = 2166136261u;
+    uint32_t i;
+    for(i = 0; i < size; i++) {
+        hash = (hash ^ buf_u8[i]) * 16777619u;
+    }
+
+    lv_obj_del(img);
+
+    return hash;
+}
+
+static lv_res_t test_decoder_info(lv_img_decoder_t * decoder, const void * src, lv_img_header_t * header)
+{
+    LV_UNUSED(decoder);
+    if(lv_img_src_get_type(src) != LV_IMG_SRC_FILE) return LV_RES_INV;
+    if(strncmp(src, "L:", 2) != 0) return LV_RES_INV;
+
+    header->cf = LV_IMG_CF_TRUE_COLOR_ALPHA;
+    header->w = TEST_IMG_W;
+    header->h = TEST_IMG_H;
+    return LV_RES_OK;
+}
+
+static lv_res_t test_decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc)
+{
+    if(test_decoder_info(decoder, dsc->src, &dsc->header) != LV_RES_OK) return LV_RES_INV;
+
+    /*Don't give the pixels to force reading the image line-by-line*/
+    dsc->img_data = NULL;
+    return LV_RES_OK;
+}
+
+static lv_res_t test_decoder_read_line(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc,
+                                       lv_coord_t x, lv_coord_t y, lv_coord_t len, uint8_t * buf)
+{
+    LV_UNUSED(decoder);
+    LV_UNUSED(dsc);
+    read_line_cnt++;
+    uint32_t px_i = (y * TEST_IMG_W + x) * LV_IMG_PX_SIZE_ALPHA_BYTE;
+    _lv_memcpy(buf, &test_img_data[px_i], len * LV_IMG_PX_SIZE_ALPHA_BYTE);
+    return LV_RES_OK;
+}
+#endif
+
+#endif
@@ -0,0 +1,821 @@
+/**
+ * @file lv_test_mem.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_mem.h"
+
+#if LV_BUILD_TEST
+#include <stdio.h>
+#if LV_MEM_THREAD_SAFE
+#include <pthread.h>
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+#define SLOT_CNT        64
+#define SIZE_MAX_RAND   200
+#define STEP_CNT        4000
+#define BENCH_CNT       100000
+#define POOL_SIZE       4096
+#define REBUILD_BTN_CNT 20
+#define REBUILD_CNT     50
+#define THREAD_CNT      4
+#define THREAD_SLOT_CNT 16
+#define THREAD_STEP_CNT 20000
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+#if LV_MEM_THREAD_SAFE
+typedef struct {
+    uint32_t seed;
+    uint8_t id;         /*Written into the memories of the thread*/
+    uint32_t err_cnt;   /*Number of overwritten memories*/
+} thread_data_t;
+#endif
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF
+static void random_alloc_free(void);
+static void realloc_in_place(void);
+static void add_pool(void);
+static void benchmark(void);
+static uint32_t rand_next(void);
+static bool slot_check(uint32_t i);
+#endif
+#if LV_MEM_BUF_ARENA
+static void buf_arena(void);
+static void buf_arena_refr(void);
+#endif
+#if LV_MEM_SLAB
+#if LV_MEM_PROFILER == 0 && LV_MEM_THREAD_SAFE == 0
+static void slab_alloc_free(void);
+#endif
+static void slab_rebuild(void);
+static void slab_build_list(void);
+#endif
+#if LV_MEM_PROFILER
+static void prof_tags(void);
+static void prof_leaks(void);
+static void prof_leak_cb(const lv_mem_prof_block_t * block);
+#endif
+#if LV_MEM_THREAD_SAFE
+static void thread_stress(void);
+static void * thread_alloc_free(void * param);
+static bool thread_mem_check(const uint8_t * p, uint32_t size, uint8_t id);
+#endif
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF == 0 && LV_MEM_DEFRAG_INCREMENTAL
+static void defrag_incremental(void);
+#endif
+#if LV_MEM_PAUSE_HIST
+static void pause_hist(void);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF
+static uint8_t * slots[SLOT_CNT];
+static uint16_t slot_sizes[SLOT_CNT];
+static uint32_t rand_seed = 1;
+static uint8_t pool[POOL_SIZE];
+#endif
+#if LV_MEM_PROFILER
+static lv_mem_prof_block_t leak_last;
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_mem(void)
+{
+#if (LV_MEM_CUSTOM == 0 && LV_MEM_TLSF) || LV_MEM_BUF_ARENA || LV_MEM_SLAB || LV_MEM_PROFILER || LV_MEM_THREAD_SAFE || \
+    (LV_MEM_CUSTOM == 0 && LV_MEM_DEFRAG_INCREMENTAL) || LV_MEM_PAUSE_HIST
+    lv_test_print("");
+    lv_test_print("==================");
+    lv_test_print("Start lv_mem tests");
+    lv_test_print("==================");
+#endif
+
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF
+    random_alloc_free();
+    realloc_in_place();
+    benchmark();
+    add_pool();
+#endif
+
+#if LV_MEM_BUF_ARENA
+    buf_arena();
+    buf_arena_refr();
+#endif
+
+#if LV_MEM_SLAB
+    /*The header of the profiler and the thread caches changes which pool serves an allocation*/
+#if LV_MEM_PROFILER == 0 && LV_MEM_THREAD_SAFE == 0
+    slab_alloc_free();
+#endif
+    slab_rebuild();
+#endif
+
+#if LV_MEM_PROFILER
+    prof_tags();
+    prof_leaks();
+#endif
+
+#if LV_MEM_THREAD_SAFE
+    thread_stress();
+#endif
+
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF == 0 && LV_MEM_DEFRAG_INCREMENTAL
+    defrag_incremental();
+#endif
+
+#if LV_MEM_PAUSE_HIST
+    pause_hist();
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF
+static void random_alloc_free(void)
+{
+    lv_test_print("");
+    lv_test_print("Allocate and free randomly:");
+    lv_test_print("---------------------------");
+
+    lv_mem_monitor_t mon_start;
+    lv_mem_monitor(&mon_start);
+
+    bool data_ok = true;
+    bool heap_ok = true;
+    uint32_t step;
+    for(step = 0; step < STEP_CNT; step++) {
+        uint32_t i = rand_next() % SLOT_CNT;
+        if(slots[i]) {
+            if(!slot_check(i)) data_ok = false;
+            lv_mem_free(slots[i]);
+            slots[i] = NULL;
+        }
+        else {
+            slot_sizes[i] = 1 + rand_next() % SIZE_MAX_RAND;
+            slots[i] = lv_mem_alloc(slot_sizes[i]);
+            if(slots[i]) _lv_memset(slots[i], i, slot_sizes[i]);
+        }
+
+        if(step % 64 == 0 && lv_mem_test() != LV_RES_OK) heap_ok = false;
+    }
+
+    lv_test_assert_true(data_ok, "The allocated data is not overwritten");
+    lv_test_assert_true(heap_ok, "Memory integrity check");
+
+    uint32_t i;
+    for(i = 0; i < SLOT_CNT; i++) {
+        lv_mem_free(slots[i]);
+        slots[i] = NULL;
+    }
+
+    lv_mem_monitor_t mon_end;
+    lv_mem_monitor(&mon_end);
+    lv_test_assert_int_eq(mon_start.free_size, mon_end.free_size, "Free size after freeing everything");
+    lv_test_assert_int_eq(mon_start.free_cnt, mon_end.free_cnt, "The free blocks are joined");
+    lv_test_assert_int_eq(mon_start.used_cnt, mon_end.used_cnt, "Used blocks after freeing everything");
+}
+
+static void realloc_in_place(void)
+{
+    lv_test_print("");
+    lv_test_print("Reallocate:");
+    lv_test_print("-----------");
+
+    /*Larger than the blocks of the fixed size pools*/
+    uint8_t * a = lv_mem_alloc(200);
+    uint8_t * b = lv_mem_alloc(200);
+    uint8_t * c = lv_mem_alloc(200);
+    _lv_memset(a, 0x5a, 200);
+
+    uint8_t * a2 = lv_mem_realloc(a, 180);
+    lv_test_assert_ptr_eq(a, a2, "Shrink in place");
+
+    lv_mem_free(b);
+    a2 = lv_mem_realloc(a, 380);
+    lv_test_assert_ptr_eq(a, a2, "Grow in place into the next free block");
+    lv_test_assert_int_gt(379, _lv_mem_get_size(a2), "Size of the grown block");
+
+    uint8_t ref[40];
+    _lv_memset(ref, 0x5a, sizeof(ref));
+    lv_test_assert_array_eq(ref, a2, sizeof(ref), "The content is kept");
+
+    a2 = lv_mem_realloc(a2, 1000);
+    lv_test_assert_true(a2 != a, "Move if the next block is not free");
+    lv_test_assert_array_eq(ref, a2, sizeof(ref), "The content is moved");
+
+    lv_mem_free(a2);
+    lv_mem_free(c);
+    lv_test_assert_int_eq(LV_RES_OK, lv_mem_test(), "Memory integrity check");
+}
+
+static void add_pool(void)
+{
+    lv_test_print("");
+    lv_test_print("Add a pool:");
+    lv_test_print("-----------");
+
+    lv_mem_monitor_t mon_start;
+    lv_mem_monitor(&mon_start);
+
+    lv_test_assert_int_eq(LV_RES_INV, lv_mem_add_pool(pool, 8), "Too small pool");
+    lv_test_assert_int_eq(LV_RES_OK, lv_mem_add_pool(pool, sizeof(pool)), "Add a pool");
+
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    lv_test_assert_int_eq(mon_start.total_size + POOL_SIZE, mon.total_size, "Total size with the new pool");
+    lv_test_assert_int_eq(mon_start.free_cnt + 1, mon.free_cnt, "The new pool is a free block");
+
+    /*Allocate until a block is allocated from the new pool*/
+    bool in_pool = false;
+    uint32_t i;
+    for(i = 0; i < SLOT_CNT && !in_pool; i++) {
+        slots[i] = lv_mem_alloc(POOL_SIZE / 2);
+        if(slots[i] == NULL) break;
+        if(slots[i] >= pool && slots[i] < pool + POOL_SIZE) in_pool = true;
+    }
+    lv_test_assert_true(in_pool, "Allocate from the new pool");
+    lv_test_assert_int_eq(LV_RES_OK, lv_mem_test(), "Memory integrity check");
+
+    for(i = 0; i < SLOT_CNT; i++) {
+        lv_mem_free(slots[i]);
+        slots[i] = NULL;
+    }
+    lv_mem_monitor(&mon);
+    lv_test_assert_int_gt(mon_start.free_size + POOL_SIZE - 64, mon.free_size, "Free size after freeing everything");
+    lv_test_assert_int_eq(mon_start.free_cnt + 1, mon.free_cnt, "The free blocks are joined");
+}
+
+static void benchmark(void)
+{
+    lv_test_print("");
+    lv_test_print("Benchmark:");
+    lv_test_print("----------");
+
+    /*Fragment the heap with the half of the slots*/
+    uint32_t i;
+    for(i = 0; i < SLOT_CNT; i++) {
+        slot_sizes[i] = 1 + rand_next() % SIZE_MAX_RAND;
+        slots[i] = lv_mem_alloc(slot_sizes[i]);
+    }
+    for(i = 0; i < SLOT_CNT; i += 2) {
+        lv_mem_free(slots[i]);
+        slots[i] = NULL;
+    }
+
+    /*The tick is not incremented in the tests so measure the real time*/
+    uint32_t t_start = custom_tick_get();
+    for(i = 0; i < BENCH_CNT; i++) {
+        uint32_t s = (i * 2) % SLOT_CNT;
+        slots[s] = lv_mem_alloc(slot_sizes[(i * 7) % SLOT_CNT]);
+        lv_mem_free(slots[s]);
+        slots[s] = NULL;
+    }
+    uint32_t t = custom_tick_get() - t_start;
+
+    char s[64];
+    lv_snprintf(s, sizeof(s), "%d alloc/free pairs: %d ms", BENCH_CNT, t);
+    lv_test_print(s);
+
+    for(i = 0; i < SLOT_CNT; i++) {
+        lv_mem_free(slots[i]);
+        slots[i] = NULL;
+    }
+    lv_test_assert_int_eq(LV_RES_OK, lv_mem_test(), "Memory integrity check");
+}
+
+static uint32_t rand_next(void)
+{
+    rand_seed = rand_seed * 1103515245 + 12345;
+    return (rand_seed >> 16) & 0x7FFF;
+}
+
+static bool slot_check(uint32_t i)
+{
+    uint16_t j;
+    for(j = 0; j < slot_sizes[i]; j++) {
+        if(slots[i][j] != (uint8_t)i) return false;
+    }
+    return true;
+}
+#endif
+
+#if LV_MEM_BUF_ARENA
+static void buf_arena(void)
+{
+    lv_test_print("");
+    lv_test_print("Temporary buffer arena:");
+    lv_test_print("-----------------------");
+
+    _lv_mem_buf_free_all();
+    lv_mem_buf_reset_stat();
+
+    lv_mem_monitor_t mon_start;
+    lv_mem_monitor(&mon_start);
+
+    lv_mem_buf_stat_t stat;
+    uint8_t * a = _lv_mem_buf_get(100);
+    lv_mem_buf_get_stat(&stat);
+    uint32_t used_a = stat.used;
+    uint8_t * b = _lv_mem_buf_get(200);
+    uint8_t * c = _lv_mem_buf_get(50);
+    lv_mem_buf_get_stat(&stat);
+    uint32_t used_abc = stat.used;
+
+    lv_test_assert_true(a < b && b < c, "Buffers are allocated upwards");
+    lv_test_assert_int_eq(0, (lv_uintptr_t)b % sizeof(void *), "Buffers are aligned");
+    lv_test_assert_int_eq(used_abc, stat.max_used, "High-water mark");
+
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    lv_test_assert_int_eq(mon_start.free_size, mon.free_size, "The heap is not used");
+
+    _lv_mem_buf_release(b);
+    lv_mem_buf_get_stat(&stat);
+    lv_test_assert_int_eq(used_abc, stat.used, "Releasing a buffer under the top keeps the space");
+
+    _lv_mem_buf_release(c);
+    lv_mem_buf_get_stat(&stat);
+    lv_test_assert_int_eq(used_a, stat.used, "Releasing the top frees the released buffers below it");
+
+    uint8_t * big = _lv_mem_buf_get(stat.size);
+    lv_mem_buf_get_stat(&stat);
+    lv_test_assert_true(big != NULL, "Get a buffer larger than the arena");
+    lv_test_assert_int_eq(1, stat.fallback_cnt, "The large buffer falls back to the heap");
+    _lv_mem_buf_release(big);
+
+    _lv_mem_buf_release(a);
+    lv_mem_buf_get_stat(&stat);
+    lv_test_assert_int_eq(0, stat.used, "Everything is released");
+    _lv_mem_buf_free_all();
+}
+
+static void buf_arena_refr(void)
+{
+    lv_test_print("");
+    lv_test_print("Temporary buffer arena in refresh:");
+    lv_test_print("----------------------------------");
+
+    lv_mem_buf_reset_stat();
+
+    lv_obj_t * obj = lv_obj_create(lv_scr_act(), NULL);
+    lv_obj_set_style_local_radius(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 10);
+    lv_obj_t * label = lv_label_create(obj, NULL);
+    lv_label_set_text(label, "Arena");
+    lv_refr_now(NULL);
+
+    lv_mem_buf_stat_t stat;
+    lv_mem_buf_get_stat(&stat);
+    lv_test_assert_int_eq(0, stat.used, "The arena is empty after refresh");
+    lv_test_assert_int_gt(0, stat.max_used, "The arena was used while drawing");
+
+    char s[64];
+    lv_snprintf(s, sizeof(s), "Arena high-water mark: %d / %d bytes", stat.max_used, stat.size);
+    lv_test_print(s);
+
+    lv_obj_del(obj);
+}
+#endif
+
+#if LV_MEM_SLAB
+#if LV_MEM_PROFILER == 0 && LV_MEM_THREAD_SAFE == 0
+static void slab_alloc_free(void)
+{
+    lv_test_print("");
+    lv_test_print("Fixed size pools:");
+    lv_test_print("-----------------");
+
+    lv_mem_monitor_t mon_start;
+    lv_mem_monitor(&mon_start);
+
+    lv_mem_slab_stat_t stat_start;
+    lv_mem_slab_get_stat(0, &stat_start);
+
+    uint8_t * a = lv_mem_alloc(10);
+    uint8_t * b = lv_mem_alloc(10);
+    lv_test_assert_int_eq(16, _lv_mem_get_size(a), "Block size of the smallest pool");
+
+    lv_mem_slab_stat_t stat;
+    lv_mem_slab_get_stat(0, &stat);
+    lv_test_assert_int_eq(stat_start.used_cnt + 2, stat.used_cnt, "Used blocks of the pool");
+
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    lv_test_assert_int_eq(mon_start.free_size, mon.free_size, "The heap is not used");
+
+    _lv_memset(a, 0x5a, 10);
+    uint8_t * a2 = lv_mem_realloc(a, 16);
+    lv_test_assert_ptr_eq(a, a2, "Grow in place in the block");
+
+    a2 = lv_mem_realloc(a, 40);
+    uint8_t ref[10];
+    _lv_memset(ref, 0x5a, sizeof(ref));
+    lv_test_assert_true(a2 != a, "Move to a larger pool");
+    lv_test_assert_int_eq(48, _lv_mem_get_size(a2), "Block size of the larger pool");
+    lv_test_assert_array_eq(ref, a2, sizeof(ref), "The content is moved");
+
+    uint8_t * big = lv_mem_alloc(1000);
+    lv_test_assert_int_gt(999, _lv_mem_get_size(big), "Large allocations are on the heap");
+    lv_test_assert_int_eq(LV_RES_OK, lv_mem_test(), "Memory integrity check");
+
+    lv_mem_free(a2);
+    lv_mem_free(b);
+    lv_mem_free(big);
+
+    lv_mem_slab_get_stat(0, &stat);
+    lv_test_assert_int_eq(stat_start.used_cnt, stat.used_cnt, "The blocks are given back");
+    lv_test_assert_int_eq(LV_RES_OK, lv_mem_test(), "Memory integrity check");
+}
+#endif
+
+static void slab_rebuild(void)
+{
+    lv_test_print("");
+    lv_test_print("Rebuild a list:");
+    lv_test_print("---------------");
+
+    /*Warm up to let the styles and caches allocate their memory*/
+    slab_build_list();
+
+#if LV_MEM_THREAD_SAFE
+    /*Measure the heap without the blocks cached by this thread*/
+    lv_mem_thread_flush();
+#endif
+    lv_mem_monitor_t mon_start;
+    lv_mem_monitor(&mon_start);
+
+    uint32_t t_start = custom_tick_get();
+    uint32_t i;
+    for(i = 0; i < REBUILD_CNT; i++) {
+        slab_build_list();
+    }
+    uint32_t t = custom_tick_get() - t_start;
+
+#if LV_MEM_THREAD_SAFE
+    lv_mem_thread_flush();
+#endif
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    lv_test_assert_int_eq(mon_start.free_size, mon.free_size, "Free size of the heap is the same after rebuilds");
+    lv_test_assert_int_eq(mon_start.frag_pct, mon.frag_pct, "Fragmentation is the same after rebuilds");
+    lv_test_assert_int_eq(LV_RES_OK, lv_mem_test(), "Memory integrity check");
+
+    char s[64];
+    lv_snprintf(s, sizeof(s), "%d rebuilds of %d buttons: %d ms", REBUILD_CNT, REBUILD_BTN_CNT, t);
+    lv_test_print(s);
+
+    uint8_t pool_cnt = lv_mem_slab_get_pool_cnt();
+    uint8_t id;
+    for(id = 0; id < pool_cnt; id++) {
+        lv_mem_slab_stat_t stat;
+        lv_mem_slab_get_stat(id, &stat);
+        lv_snprintf(s, sizeof(s), "Pool %d bytes: max. %d blocks, %d fallbacks", stat.block_size, stat.max_used_cnt,
+                    stat.fallback_cnt);
+        lv_test_print(s);
+    }
+}
+
+static void slab_build_list(void)
+{
+    lv_obj_t * cont = lv_cont_create(lv_scr_act(), NULL);
+    uint32_t i;
+    for(i = 0; i < REBUILD_BTN_CNT; i++) {
+        lv_obj_t * btn = lv_btn_create(cont, NULL);
+        lv_obj_t * label = lv_label_create(btn, NULL);
+        lv_label_set_text_fmt(label, "Item %d", i);
+    }
+
+    lv_obj_del(cont);
+}
+#endif
+
+#if LV_MEM_PROFILER
+static void prof_tags(void)
+{
+    lv_test_print("");
+    lv_test_print("Profiler tags:");
+    lv_test_print("--------------");
+
+    lv_mem_prof_snapshot_t snap;
+    lv_mem_prof_take_snapshot(&snap);
+
+    uint32_t label_cnt_start;
+    lv_obj_mem_prof_get_type_size("lv_label", &label_cnt_start);
+
+    lv_obj_t * label = lv_label_create(lv_scr_act(), NULL);
+    lv_label_set_text(label, "Some text to allocate");
+    lv_obj_set_style_local_text_color(label, LV_LABEL_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_RED);
+
+    lv_mem_prof_stat_t stat;
+    lv_mem_prof_get_stat(LV_MEM_TAG_TEXT, &stat);
+    lv_test_assert_int_eq(snap.tags[LV_MEM_TAG_TEXT].size + sizeof("Some text to allocate"), stat.size,
+                          "The text is accounted");
+    lv_test_assert_int_eq(snap.tags[LV_MEM_TAG_TEXT].cnt + 1, stat.cnt, "Blocks of the texts");
+
+    lv_mem_prof_get_stat(LV_MEM_TAG_OBJ, &stat);
+    lv_test_assert_int_gt(snap.tags[LV_MEM_TAG_OBJ].size + sizeof(lv_obj_t) - 1, stat.size,
+                          "The object and its ext. attr. are accounted");
+
+    lv_mem_prof_get_stat(LV_MEM_TAG_STYLE, &stat);
+    lv_test_assert_int_gt(snap.tags[LV_MEM_TAG_STYLE].size, stat.size, "The local style is accounted");
+
+    uint32_t label_cnt;
+    uint32_t label_size = lv_obj_mem_prof_get_type_size("lv_label", &label_cnt);
+    lv_test_assert_int_eq(label_cnt_start + 1, label_cnt, "Number of labels");
+    lv_test_assert_int_gt(sizeof(lv_obj_t) + sizeof(lv_label_ext_t) - 1, label_size, "Memory of the labels");
+
+    lv_obj_del(label);
+
+    lv_mem_prof_get_stat(LV_MEM_TAG_TEXT, &stat);
+    lv_test_assert_int_eq(snap.tags[LV_MEM_TAG_TEXT].size, stat.size, "The text is freed");
+    lv_test_assert_int_gt(snap.tags[LV_MEM_TAG_TEXT].size, stat.max_size, "High-water mark of the texts");
+
+    /*Indirect allocations get the tag of the scope*/
+    lv_mem_prof_get_stat(LV_MEM_TAG_USER, &stat);
+    _lv_mem_tag_push(LV_MEM_TAG_USER);
+    void * p = lv_mem_alloc(40);
+    _lv_mem_tag_pop();
+    void * p_other = lv_mem_alloc(40);
+
+    lv_mem_prof_stat_t stat_user;
+    lv_mem_prof_get_stat(LV_MEM_TAG_USER, &stat_user);
+    lv_test_assert_int_eq(stat.size + 40, stat_user.size, "Allocation in a tag scope");
+
+    p = lv_mem_realloc(p, 100);
+    lv_mem_prof_get_stat(LV_MEM_TAG_USER, &stat_user);
+    lv_test_assert_int_eq(stat.size + 100, stat_user.size, "Reallocation keeps the tag");
+    lv_test_assert_int_eq(100, _lv_mem_get_size(p), "Requested size");
+
+    lv_mem_free(p);
+    lv_mem_free(p_other);
+    lv_mem_prof_get_stat(LV_MEM_TAG_USER, &stat_user);
+    lv_test_assert_int_eq(stat.size, stat_user.size, "Freed in the tag");
+
+    lv_mem_prof_dump();
+    lv_obj_mem_prof_dump();
+}
+
+static void prof_leaks(void)
+{
+    lv_test_print("");
+    lv_test_print("Profiler leaks:");
+    lv_test_print("---------------");
+
+    lv_mem_prof_snapshot_t snap1;
+    lv_mem_prof_take_snapshot(&snap1);
+
+    void * leak = lv_mem_alloc_tag(24, LV_MEM_TAG_USER);
+    void * tmp = lv_mem_alloc(64);
+    lv_mem_free(tmp);
+
+    lv_obj_t * btn = lv_btn_create(lv_scr_act(), NULL);
+    lv_obj_del(btn);
+
+    lv_mem_prof_snapshot_t snap2;
+    lv_mem_prof_take_snapshot(&snap2);
+
+    void * later = lv_mem_alloc(16);
+
+    _lv_memset_00(&leak_last, sizeof(leak_last));
+    lv_test_assert_int_eq(1, lv_mem_prof_get_leaks(&snap1, &snap2, prof_leak_cb), "One leak between the snapshots");
+    lv_test_assert_ptr_eq(leak, leak_last.p, "Pointer of the leak");
+    lv_test_assert_int_eq(24, leak_last.size, "Size of the leak");
+    lv_test_assert_int_eq(LV_MEM_TAG_USER, leak_last.tag, "Tag of the leak");
+#if LV_MEM_PROFILER_CALLER && defined(__GNUC__)
+    lv_test_assert_true(leak_last.caller != NULL, "Caller of the leak");
+#endif
+
+    lv_test_assert_int_eq(2, lv_mem_prof_get_leaks(&snap1, NULL, NULL), "Leaks until now");
+
+    lv_mem_free(leak);
+    lv_mem_free(later);
+    lv_test_assert_int_eq(0, lv_mem_prof_get_leaks(&snap1, NULL, NULL), "No leaks after freeing");
+}
+
+static void prof_leak_cb(const lv_mem_prof_block_t * block)
+{
+    leak_last = *block;
+}
+#endif
+
+#if LV_MEM_THREAD_SAFE
+static void thread_stress(void)
+{
+    lv_test_print("");
+    lv_test_print("Allocate and free from several threads:");
+    lv_test_print("---------------------------------------");
+
+    /*Start from a state where the released memories are given back to the heap*/
+    _lv_mem_buf_free_all();
+    lv_mem_thread_flush();
+    lv_mem_monitor_t mon_start;
+    lv_mem_monitor(&mon_start);
+
+    pthread_t threads[THREAD_CNT];
+    thread_data_t data[THREAD_CNT];
+    uint32_t i;
+    for(i = 0; i < THREAD_CNT; i++) {
+        data[i].seed = i + 1;
+        data[i].id = i + 1;
+        data[i].err_cnt = 0;
+        pthread_create(&threads[i], NULL, thread_alloc_free, &data[i]);
+    }
+
+    uint32_t err_cnt = 0;
+    for(i = 0; i < THREAD_CNT; i++) {
+        pthread_join(threads[i], NULL);
+        err_cnt += data[i].err_cnt;
+    }
+
+    lv_test_assert_int_eq(0, err_cnt, "The memories are not overwritten by the other threads");
+    lv_test_assert_int_eq(LV_RES_OK, lv_mem_test(), "Memory integrity check");
+
+    _lv_mem_buf_free_all();
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    lv_test_assert_int_eq(mon_start.free_size, mon.free_size, "Everything is given back to the heap");
+}
+
+static void * thread_alloc_free(void * param)
+{
+    thread_data_t * data = param;
+    uint8_t * mems[THREAD_SLOT_CNT];
+    uint16_t sizes[THREAD_SLOT_CNT];
+    _lv_memset_00(mems, sizeof(mems));
+    _lv_memset_00(sizes, sizeof(sizes));
+
+    uint8_t * buf;
+    uint32_t step;
+    for(step = 0; step < THREAD_STEP_CNT; step++) {
+        data->seed = data->seed * 1103515245 + 12345;
+        uint32_t r = data->seed >> 8;
+        uint32_t i = r % THREAD_SLOT_CNT;
+        uint16_t size = (r >> 5) % SIZE_MAX_RAND;
+
+        if(mems[i] && !thread_mem_check(mems[i], sizes[i], data->id)) data->err_cnt++;
+
+        switch((r >> 13) % 4) {
+            case 0:
+                lv_mem_free(mems[i]);
+                mems[i] = NULL;
+                sizes[i] = 0;
+                break;
+            case 1:
+                lv_mem_free(mems[i]);
+                mems[i] = lv_mem_alloc(size);
+                break;
+            case 2:
+                mems[i] = lv_mem_realloc(mems[i], size);
+                break;
+            case 3:
+                /*A temporary buffer is used only for a short time*/
+                buf = _lv_mem_buf_get(size + 1);
+                _lv_memset(buf, data->id, size + 1);
+                if(!thread_mem_check(buf, size + 1, data->id)) data->err_cnt++;
+                _lv_mem_buf_release(buf);
+                continue;
+        }
+
+        if(mems[i]) {
+            sizes[i] = size;
+            _lv_memset(mems[i], data->id, size);
+        }
+    }
+
+    for(step = 0; step < THREAD_SLOT_CNT; step++) {
+        lv_mem_free(mems[step]);
+    }
+    lv_mem_thread_flush();
+
+    return NULL;
+}
+
+static bool thread_mem_check(const uint8_t * p, uint32_t size, uint8_t id)
+{
+    uint32_t i;
+    for(i = 0; i < size; i++) {
+        if(p[i] != id) return false;
+    }
+    return true;
+}
+#endif
+
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF == 0 && LV_MEM_DEFRAG_INCREMENTAL
+static void defrag_incremental(void)
+{
+    lv_test_print("");
+    lv_test_print("Incremental defrag:");
+    lv_test_print("-------------------");
+
+    lv_mem_defrag();
+    lv_mem_monitor_t mon_start;
+    lv_mem_monitor(&mon_start);
+
+    /*Freeing in allocation order leaves the free entries unjoined as only the following ones are joined*/
+    uint8_t * p[16];
+    uint32_t i;
+    for(i = 0; i < 16; i++) p[i] = lv_mem_alloc(64);
+    for(i = 0; i < 16; i++) lv_mem_free(p[i]);
+
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    lv_test_assert_int_gt(mon_start.free_cnt, mon.free_cnt, "The freed entries are not joined yet");
+
+    uint32_t step_cnt = 1;
+    while(lv_mem_defrag_step(4) == false) step_cnt++;
+    lv_test_print("Steps to defrag: %d", step_cnt);
+    lv_test_assert_int_gt(1, step_cnt, "Defrag in more steps");
+
+    lv_mem_monitor(&mon);
+    lv_test_assert_int_eq(mon_start.free_cnt, mon.free_cnt, "The free entries are joined");
+    lv_test_assert_int_eq(mon_start.free_biggest_size, mon.free_biggest_size, "Biggest free entry");
+    lv_test_assert_true(lv_mem_defrag_step(4), "Nothing was freed since the last round");
+
+    /*The allocation joins the free entries it passes*/
+    for(i = 0; i < 16; i++) p[i] = lv_mem_alloc(64);
+    for(i = 0; i < 16; i++) lv_mem_free(p[i]);
+    uint8_t * big = lv_mem_alloc(8 * 64);
+    lv_test_assert_ptr_eq(p[0], big, "Allocate in the joined free entries");
+    lv_mem_free(big);
+
+    /*The free tail of a shrunk memory is joined with the following free entry*/
+    for(i = 0; i < 16; i++) p[i] = lv_mem_alloc(64);
+    for(i = 15; i > 0; i--) lv_mem_free(p[i]);
+    lv_mem_monitor(&mon);
+    uint8_t * small = lv_mem_realloc(p[0], 16);
+    lv_test_assert_ptr_eq(p[0], small, "Shrink in place");
+    lv_mem_monitor_t mon_shrink;
+    lv_mem_monitor(&mon_shrink);
+    lv_test_assert_int_eq(mon.free_cnt, mon_shrink.free_cnt, "The free tail is joined");
+    lv_mem_free(small);
+
+    lv_mem_defrag();
+    lv_mem_monitor(&mon);
+    lv_test_assert_int_eq(mon_start.free_cnt, mon.free_cnt, "The free entries are joined");
+    lv_test_assert_int_eq(LV_RES_OK, lv_mem_test(), "Memory integrity check");
+}
+#endif
+
+#if LV_MEM_PAUSE_HIST
+static void pause_hist(void)
+{
+    lv_test_print("");
+    lv_test_print("Allocator pauses:");
+    lv_test_print("-----------------");
+
+    lv_mem_pause_reset_stat();
+
+    uint32_t i;
+    for(i = 0; i < 100; i++) {
+        void * p = lv_mem_alloc(32 + i);
+        lv_mem_free(p);
+    }
+
+    lv_mem_defrag();
+
+    /*The thread caches serve most of the allocations without calling the allocator*/
+    lv_mem_pause_stat_t stat;
+    lv_mem_pause_get_stat(&stat);
+#if LV_MEM_THREAD_SAFE
+    lv_test_assert_int_gt(0, stat.cnt, "The calls are measured");
+#else
+    lv_test_assert_int_gt(200, stat.cnt, "Every call is measured");
+#endif
+
+    uint32_t sum = 0;
+    for(i = 0; i < LV_MEM_PAUSE_HIST_CNT; i++) {
+        sum += stat.hist[i];
+        if(stat.hist[i]) lv_test_print("%d..%d us: %d", i ? 1 << (i - 1) : 0, (1 << i) - 1, stat.hist[i]);
+    }
+    lv_test_print("Longest: %d us", stat.max);
+    lv_test_assert_int_eq(stat.cnt, sum, "Every call is in the histogram");
+
+    lv_mem_pause_reset_stat();
+    lv_mem_pause_get_stat(&stat);
+    lv_test_assert_int_eq(0, stat.cnt, "Reset the histogram");
+}
+#endif
+
+#endif
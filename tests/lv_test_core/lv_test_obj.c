@@ -24,10 +24,31 @@
  *  STATIC PROTOTYPES
  **********************/
 static void create_delete_change_parent(void);
+static void child_order(void);
+#if LV_USE_OBJ_REALIGN
+static void auto_realign(void);
+#endif
+#if LV_OBJ_SIDE_TABLE
+static void side_table(void);
+static void side_table_event_cb(lv_obj_t * obj, lv_event_t event);
+#endif
+#if LV_MEM_ARENA_CNT
+static void arena_screen(void);
+static void arena_event_cb(lv_obj_t * obj, lv_event_t event);
+#endif
+#if LV_USE_DEBUG && LV_USE_ASSERT_OBJ
+static void valid_check(void);
+#endif
+#if LV_OBJ_SIDE_TABLE || LV_MEM_ARENA_CNT
+static uint32_t used_block_cnt(void);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+#if LV_MEM_ARENA_CNT
+static uint32_t arena_top_on_del;
+#endif
 
 /**********************
  *      MACROS
@@ -45,6 +66,19 @@ void lv_test_obj(void)
     lv_test_print("==================");
 
     create_delete_change_parent();
+    child_order();
+#if LV_USE_OBJ_REALIGN
+    auto_realign();
+#endif
+#if LV_OBJ_SIDE_TABLE
+    side_table();
+#endif
+#if LV_MEM_ARENA_CNT
+    arena_screen();
+#endif
+#if LV_USE_DEBUG && LV_USE_ASSERT_OBJ
+    valid_check();
+#endif
 }
 
 /**********************
@@ -85,4 +119,309 @@ static void create_delete_change_parent(void)
     lv_obj_del(obj_parent);
     lv_test_assert_int_eq(0, lv_obj_count_children(lv_scr_act()), "Screen's children count after delete");
 }
+
+static void child_order(void)
+{
+    lv_test_print("");
+    lv_test_print("Order of the children:");
+    lv_test_print("----------------------");
+
+    lv_obj_t * parent = lv_obj_create(lv_scr_act(), NULL);
+    lv_obj_t * children[5];
+    uint32_t i;
+    for(i = 0; i < 5; i++) children[i] = lv_obj_create(parent, NULL);
+
+    lv_test_print("The last created child is in the foreground");
+    lv_test_assert_ptr_eq(children[4], lv_obj_get_child(parent, NULL), "First child from the foreground");
+    lv_test_assert_ptr_eq(children[3], lv_obj_get_child(parent, children[4]), "Next child from the foreground");
+    lv_test_assert_ptr_eq(children[0], lv_obj_get_child_back(parent, NULL), "First child from the background");
+    lv_test_assert_ptr_eq(NULL, lv_obj_get_child(parent, children[0]), "No child after the oldest");
+    lv_test_assert_ptr_eq(children[2], lv_obj_get_child_by_id(parent, 2), "Child by index");
+    lv_test_assert_ptr_eq(NULL, lv_obj_get_child_by_id(parent, 5), "Child by too large index");
+    lv_test_assert_int_eq(3, lv_obj_get_child_id(children[3]), "Index of a child");
+
+    lv_test_print("Move to the foreground and background");
+    lv_obj_move_foreground(children[1]);
+    lv_test_assert_ptr_eq(children[1], lv_obj_get_child(parent, NULL), "Moved to the foreground");
+    lv_test_assert_int_eq(4, lv_obj_get_child_id(children[1]), "Index in the foreground");
+    lv_test_assert_int_eq(1, lv_obj_get_child_id(children[2]), "Index of a shifted child");
+    lv_obj_move_background(children[4]);
+    lv_test_assert_ptr_eq(children[4], lv_obj_get_child_back(parent, NULL), "Moved to the background");
+    lv_test_assert_int_eq(1, lv_obj_get_child_id(children[0]), "Index of a shifted child");
+
+    lv_test_print("Delete a child and change the parent of an other");
+    lv_obj_del(children[2]);
+    lv_obj_set_parent(children[3], lv_scr_act());
+    lv_test_assert_int_eq(3, lv_obj_count_children(parent), "Children count");
+    lv_test_assert_ptr_eq(children[4], lv_obj_get_child_by_id(parent, 0), "Child 0");
+    lv_test_assert_ptr_eq(children[0], lv_obj_get_child_by_id(parent, 1), "Child 1");
+    lv_test_assert_ptr_eq(children[1], lv_obj_get_child_by_id(parent, 2), "Child 2");
+    lv_test_assert_ptr_eq(children[3], lv_obj_get_child(lv_scr_act(), NULL), "New parent's foreground child");
+
+    lv_test_print("Set the same parent again");
+    lv_obj_set_parent(children[4], parent);
+    lv_test_assert_int_eq(3, lv_obj_count_children(parent), "Children count with the same parent");
+    lv_test_assert_ptr_eq(children[4], lv_obj_get_child(parent, NULL), "Moved to the foreground");
+    lv_test_assert_ptr_eq(children[0], lv_obj_get_child_by_id(parent, 0), "Shifted child 0");
+    lv_test_assert_ptr_eq(children[1], lv_obj_get_child_by_id(parent, 1), "Shifted child 1");
+
+    lv_obj_set_parent(children[4], children[3]);
+    lv_obj_set_parent(children[4], children[3]);
+    lv_test_assert_int_eq(1, lv_obj_count_children(children[3]), "Only child with the same parent");
+    lv_test_assert_ptr_eq(children[4], lv_obj_get_child(children[3], NULL), "The only child is kept");
+    lv_test_assert_ptr_eq(children[3], lv_obj_get_parent(children[4]), "The parent is kept");
+
+    lv_obj_del(children[3]);
+    lv_obj_del(parent);
+    lv_test_assert_int_eq(0, lv_obj_count_children(lv_scr_act()), "Screen's children count after delete");
+}
+
+#if LV_USE_OBJ_REALIGN
+static void auto_realign(void)
+{
+    lv_test_print("");
+    lv_test_print("Realign automatically:");
+    lv_test_print("----------------------");
+
+    lv_obj_t * parent = lv_obj_create(lv_scr_act(), NULL);
+    lv_obj_set_size(parent, 100, 100);
+    lv_obj_t * obj = lv_obj_create(parent, NULL);
+    lv_obj_set_size(obj, 20, 20);
+
+    lv_test_print("Align then enable auto realign");
+    lv_obj_align(obj, NULL, LV_ALIGN_IN_BOTTOM_RIGHT, -5, -5);
+    lv_obj_set_auto_realign(obj, true);
+    lv_test_assert_int_eq(75, lv_obj_get_x(obj), "x after align");
+    lv_test_assert_int_eq(75, lv_obj_get_y(obj), "y after align");
+
+    lv_obj_set_size(parent, 200, 150);
+    lv_test_assert_int_eq(175, lv_obj_get_x(obj), "x after resizing the parent");
+    lv_test_assert_int_eq(125, lv_obj_get_y(obj), "y after resizing the parent");
+
+    lv_obj_set_size(obj, 40, 40);
+    lv_test_assert_int_eq(155, lv_obj_get_x(obj), "x after resizing the object");
+    lv_test_assert_int_eq(105, lv_obj_get_y(obj), "y after resizing the object");
+
+#if LV_USE_CONT && LV_OBJ_SIDE_TABLE
+    lv_test_print("The layouts don't save the align parameters");
+    lv_obj_t * cont = lv_cont_create(lv_scr_act(), NULL);
+    lv_obj_t * child = lv_obj_create(cont, NULL);
+    lv_cont_set_layout(cont, LV_LAYOUT_COLUMN_MID);
+    lv_test_assert_ptr_eq(NULL, child->side, "No side table for the layout");
+    lv_obj_del(cont);
+#endif
+
+    lv_obj_del(parent);
+}
+#endif
+
+#if LV_OBJ_SIDE_TABLE
+static void side_table(void)
+{
+    lv_test_print("");
+    lv_test_print("Side table of the rarely used attributes:");
+    lv_test_print("-----------------------------------------");
+
+    lv_test_print("sizeof(lv_obj_t): %d, sizeof(lv_obj_side_t): %d", (int)sizeof(lv_obj_t), (int)sizeof(lv_obj_side_t));
+
+#if LV_MEM_THREAD_SAFE
+    lv_mem_thread_flush();
+#endif
+    lv_mem_monitor_t mon_start;
+    lv_mem_monitor(&mon_start);
+    uint32_t used_cnt_start = used_block_cnt();
+
+    lv_obj_t * obj = lv_obj_create(lv_scr_act(), NULL);
+    lv_test_assert_ptr_eq(NULL, obj->side, "No side table after create");
+    lv_obj_set_event_cb(obj, NULL);
+    lv_test_assert_ptr_eq(NULL, obj->side, "No side table after removing the not set event cb");
+    lv_test_assert_true(lv_obj_get_event_cb(obj) == NULL, "Default event cb");
+    lv_test_assert_ptr_eq(NULL, lv_obj_get_group(obj), "Default group");
+    lv_test_assert_int_eq(0, lv_obj_get_ext_click_pad_left(obj), "Default ext. click pad");
+
+    lv_test_print("Set attributes");
+    lv_obj_set_event_cb(obj, side_table_event_cb);
+    lv_test_assert_true(obj->side != NULL, "Side table after setting the event cb");
+    lv_obj_set_user_data(obj, (lv_obj_user_data_t)0x1234);
+    lv_obj_set_ext_click_area(obj, 5, 5, 7, 7);
+    lv_obj_set_auto_realign(obj, true);
+    lv_test_assert_true(lv_obj_get_event_cb(obj) == side_table_event_cb, "Event cb");
+    lv_test_assert_ptr_eq((void *)0x1234, lv_obj_get_user_data(obj), "User data");
+    lv_test_assert_int_eq(5, lv_obj_get_ext_click_pad_left(obj), "Ext. click pad");
+    lv_test_assert_int_eq(7, lv_obj_get_ext_click_pad_top(obj), "Ext. click pad");
+    lv_test_assert_int_eq(1, lv_obj_get_auto_realign(obj), "Auto realign");
+    lv_obj_align(obj, NULL, LV_ALIGN_CENTER, 0, 0);
+    lv_obj_set_size(obj, 30, 30);
+    lv_test_assert_int_eq((lv_obj_get_width(lv_scr_act()) - 30) / 2, lv_obj_get_x(obj), "Realigned after resize");
+
+    lv_test_print("Copy the object");
+    lv_obj_t * copy = lv_obj_create(lv_scr_act(), obj);
+    lv_test_assert_true(copy->side != NULL && copy->side != obj->side, "Own side table of the copy");
+    lv_test_assert_true(lv_obj_get_event_cb(copy) == side_table_event_cb, "Event cb of the copy");
+    lv_test_assert_ptr_eq((void *)0x1234, lv_obj_get_user_data(copy), "User data of the copy");
+
+    lv_test_print("Add to a group");
+    lv_group_t * g = lv_group_create();
+    lv_obj_t * obj_g = lv_obj_create(lv_scr_act(), NULL);
+    lv_group_add_obj(g, obj_g);
+    lv_test_assert_ptr_eq(g, lv_obj_get_group(obj_g), "Group of the object");
+    lv_test_assert_int_eq(1, lv_obj_is_focused(obj_g), "Focused in the group");
+    lv_group_remove_obj(obj_g);
+    lv_test_assert_ptr_eq(NULL, lv_obj_get_group(obj_g), "Group after remove");
+    lv_group_del(g);
+
+    lv_test_print("Delete the objects");
+    lv_obj_del(obj);
+    lv_obj_del(copy);
+    lv_obj_del(obj_g);
+
+#if LV_MEM_THREAD_SAFE
+    lv_mem_thread_flush();
+#endif
+    lv_mem_monitor_t mon_end;
+    lv_mem_monitor(&mon_end);
+    lv_test_assert_int_eq(mon_start.free_size, mon_end.free_size, "Free size after delete");
+    lv_test_assert_int_eq(used_cnt_start, used_block_cnt(), "Used blocks after delete");
+}
+
+static void side_table_event_cb(lv_obj_t * obj, lv_event_t event)
+{
+    LV_UNUSED(obj);
+    LV_UNUSED(event);
+}
+#endif
+
+#if LV_MEM_ARENA_CNT
+static void arena_screen(void)
+{
+    lv_test_print("");
+    lv_test_print("Screen with arena:");
+    lv_test_print("------------------");
+
+#if LV_MEM_THREAD_SAFE
+    lv_mem_thread_flush();
+#endif
+    lv_mem_monitor_t mon_start;
+    lv_mem_monitor(&mon_start);
+    uint32_t used_cnt_start = used_block_cnt();
+    uint16_t anim_cnt_start = lv_anim_count_running();
+
+    lv_test_print("Create a screen with buttons and labels");
+    lv_obj_t * scr = lv_obj_create_scr_arena(8 * 1024);
+    const lv_mem_arena_t * arena = lv_obj_get_arena(scr);
+    lv_test_assert_true(arena != NULL, "Arena of the screen");
+
+    lv_obj_t * btn = NULL;
+    uint32_t i;
+    for(i = 0; i < 5; i++) {
+        btn = lv_btn_create(scr, NULL);
+        if(i == 0) lv_obj_set_event_cb(btn, arena_event_cb);
+        lv_obj_t * label = lv_label_create(btn, NULL);
+        lv_label_set_text_fmt(label, "Button %d", i);
+        lv_obj_set_style_local_bg_color(btn, LV_BTN_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_RED);
+    }
+
+    lv_test_assert_true(_lv_mem_arena_find(btn) == arena, "The object is in the arena");
+    lv_test_assert_true(_lv_mem_arena_find(btn->ext_attr) == arena, "The ext. data is in the arena");
+    lv_test_assert_true(_lv_mem_arena_find(btn->style_list.style_list) == arena, "The style list is in the arena");
+    lv_test_assert_true(_lv_mem_arena_find(scr->children) == arena, "The children of the screen are in the arena");
+    lv_test_assert_ptr_eq(arena, lv_obj_get_arena(lv_obj_get_child(btn, NULL)), "Arena of a label");
+    lv_test_assert_int_eq(0, arena->fallback_cnt, "All fit into the arena");
+    lv_test_print("Arena used: %d of %d bytes", (int)arena->top, (int)arena->size);
+
+    lv_test_print("Can't move an object out of the arena");
+    lv_obj_set_parent(btn, lv_scr_act());
+    lv_test_assert_ptr_eq(scr, lv_obj_get_parent(btn), "Parent after moving to an other screen");
+
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, btn);
+    lv_anim_set_exec_cb(&a, (lv_anim_exec_xcb_t)lv_obj_set_x);
+    lv_anim_set_values(&a, 0, 100);
+    lv_anim_set_time(&a, 1000);
+    lv_anim_start(&a);
+    lv_test_assert_int_eq(anim_cnt_start + 1, lv_anim_count_running(), "Animation of a button started");
+
+    lv_test_print("Delete the screen");
+    uint32_t last_btn_ofs = (uint32_t)((uint8_t *)btn - arena->buf);
+    lv_obj_del(scr);
+    lv_test_assert_int_eq(anim_cnt_start, lv_anim_count_running(), "Animations after delete");
+    lv_test_assert_true(arena_top_on_del > last_btn_ofs, "The deleted buttons weren't freed one by one");
+
+#if LV_MEM_THREAD_SAFE
+    lv_mem_thread_flush();
+#endif
+    lv_mem_monitor_t mon_end;
+    lv_mem_monitor(&mon_end);
+    lv_test_assert_int_eq(mon_start.free_size, mon_end.free_size, "Free size after delete");
+    lv_test_assert_int_eq(used_cnt_start, used_block_cnt(), "Used blocks after delete");
+}
+
+static void arena_event_cb(lv_obj_t * obj, lv_event_t event)
+{
+    /*The first button is deleted after the others*/
+    if(event == LV_EVENT_DELETE) arena_top_on_del = lv_obj_get_arena(obj)->top;
+}
+#endif
+
+#if LV_USE_DEBUG && LV_USE_ASSERT_OBJ
+static void valid_check(void)
+{
+    lv_test_print("");
+    lv_test_print("Check the objects' validity:");
+    lv_test_print("----------------------------");
+
+    /*Enough objects to grow the table a few times*/
+    lv_obj_t * scr = lv_obj_create(NULL, NULL);
+    lv_obj_t * parent = lv_obj_create(scr, NULL);
+    lv_obj_t * children[200];
+    uint32_t i;
+    for(i = 0; i < 200; i++) children[i] = lv_obj_create(parent, NULL);
+
+    bool valid = true;
+    for(i = 0; i < 200; i++) valid = valid && lv_debug_check_obj_valid(children[i]);
+    lv_test_assert_true(valid, "The created objects are valid");
+    lv_test_assert_true(lv_debug_check_obj_valid(scr), "The screen is valid");
+    lv_test_assert_true(lv_debug_check_obj_valid(lv_scr_act()), "The earlier objects are valid");
+
+    /*The addresses of the deleted objects are not reused as nothing is created in the meantime*/
+    for(i = 0; i < 200; i += 2) lv_obj_del(children[i]);
+    bool deleted_valid = false;
+    valid = true;
+    for(i = 0; i < 200; i++) {
+        if(i % 2) valid = valid && lv_debug_check_obj_valid(children[i]);
+        else deleted_valid = deleted_valid || lv_debug_check_obj_valid(children[i]);
+    }
+    lv_test_assert_true(valid, "The remaining objects are valid");
+    lv_test_assert_true(deleted_valid == false, "The deleted objects are invalid");
+
+    lv_obj_del(scr);
+    valid = false;
+    for(i = 1; i < 200; i += 2) valid = valid || lv_debug_check_obj_valid(children[i]);
+    lv_test_assert_true(valid == false, "The children of a deleted screen are invalid");
+    lv_test_assert_true(lv_debug_check_obj_valid(parent) == false, "The deleted parent is invalid");
+    lv_test_assert_true(lv_debug_check_obj_valid(lv_scr_act()), "The active screen is still valid");
+}
+#endif
+
+#if LV_OBJ_SIDE_TABLE || LV_MEM_ARENA_CNT
+/*The memories can be allocated from the slabs too which are not part of `lv_mem_monitor()`*/
+static uint32_t used_block_cnt(void)
+{
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    uint32_t cnt = mon.used_cnt;
+
+#if LV_MEM_SLAB
+    uint8_t id;
+    for(id = 0; id < lv_mem_slab_get_pool_cnt(); id++) {
+        lv_mem_slab_stat_t stat;
+        lv_mem_slab_get_stat(id, &stat);
+        cnt += stat.used_cnt;
+    }
+#endif
+    return cnt;
+}
+#endif
+
 #endif
@@ -142,4 +142,11 @@ uint32_t custom_tick_get(void)
     return time_ms;
 }
 
+uint32_t custom_us_get(void)
+{
+    struct timeval tv_now;
+    gettimeofday(&tv_now, NULL);
+    return (uint32_t)(tv_now.tv_sec * 1000000 + tv_now.tv_usec);
+}
+
 #endif
@@ -15,6 +15,8 @@
 /*********************
  *      DEFINES
  *********************/
+#define OVERLAP_CANVAS_W    80
+#define OVERLAP_CANVAS_H    30
 
 /**********************
  *      TYPEDEFS
@@ -24,6 +26,8 @@
  *  STATIC PROTOTYPES
  **********************/
 static void create_copy(void);
+static void bidi_cache(void);
+static void overlapping_letters(void);
 
 /**********************
  *  STATIC VARIABLES
@@ -46,6 +50,8 @@ void lv_test_label(void)
 
 #if LV_USE_LABEL
     create_copy();
+    bidi_cache();
+    overlapping_letters();
 #else
     lv_test_print("Skip label test: LV_USE_LABEL == 0");
 #endif
@@ -66,4 +72,72 @@ static void create_copy(void)
     lv_test_assert_img_eq("lv_test_img32_label_1.png", "Create a label and leave the default settings");
 #endif
 }
+
+static void bidi_cache(void)
+{
+#if LV_USE_BIDI
+    lv_test_print("");
+    lv_test_print("Cache the bidi processed text");
+    lv_test_print("---------------------------");
+
+    lv_obj_t * label = lv_label_create(lv_scr_act(), NULL);
+    lv_label_ext_t * ext = lv_obj_get_ext_attr(label);
+    lv_obj_set_base_dir(label, LV_BIDI_DIR_RTL);
+    lv_label_set_text(label, "abc 123.");
+    lv_refr_now(NULL);
+
+    lv_test_assert_ptr_eq(ext->text, ext->bidi_cache.txt, "the cache is created when the label is drawn");
+
+    char bidi_txt[16];
+    _lv_bidi_process(ext->text, bidi_txt, LV_BIDI_DIR_RTL);
+    lv_test_assert_str_eq(bidi_txt, ext->bidi_cache.bidi_txt, "the cached text is in visual order");
+
+    lv_label_set_text(label, "xyz");
+    lv_test_assert_ptr_eq(NULL, ext->bidi_cache.txt, "the cache is invalidated when the text changes");
+
+    lv_obj_del(label);
+#endif
+}
+
+static void overlapping_letters(void)
+{
+#if LV_USE_CANVAS
+    lv_test_print("");
+    lv_test_print("Draw overlapping letters like one by one");
+    lv_test_print("---------------------------");
+
+    static lv_color_t buf_line[LV_CANVAS_BUF_SIZE_TRUE_COLOR(OVERLAP_CANVAS_W, OVERLAP_CANVAS_H)];
+    static lv_color_t buf_letters[LV_CANVAS_BUF_SIZE_TRUE_COLOR(OVERLAP_CANVAS_W, OVERLAP_CANVAS_H)];
+
+    lv_obj_t * canvas_line = lv_canvas_create(lv_scr_act(), NULL);
+    lv_canvas_set_buffer(canvas_line, buf_line, OVERLAP_CANVAS_W, OVERLAP_CANVAS_H, LV_IMG_CF_TRUE_COLOR);
+    lv_canvas_fill_bg(canvas_line, LV_COLOR_WHITE, LV_OPA_COVER);
+    lv_obj_t * canvas_letters = lv_canvas_create(lv_scr_act(), NULL);
+    lv_canvas_set_buffer(canvas_letters, buf_letters, OVERLAP_CANVAS_W, OVERLAP_CANVAS_H, LV_IMG_CF_TRUE_COLOR);
+    lv_canvas_fill_bg(canvas_letters, LV_COLOR_WHITE, LV_OPA_COVER);
+
+    /*The negative letter space makes the letters overlap*/
+    lv_draw_label_dsc_t dsc;
+    lv_draw_label_dsc_init(&dsc);
+    dsc.opa = LV_OPA_50;
+    dsc.letter_space = -5;
+
+    const char * txt = "AVWMA";
+    lv_canvas_draw_text(canvas_line, 0, 0, OVERLAP_CANVAS_W, &dsc, txt, LV_LABEL_ALIGN_LEFT);
+
+    lv_coord_t x = 0;
+    uint32_t i;
+    for(i = 0; txt[i] != '\0'; i++) {
+        char letter[2] = {txt[i], '\0'};
+        lv_canvas_draw_text(canvas_letters, x, 0, OVERLAP_CANVAS_W - x, &dsc, letter, LV_LABEL_ALIGN_LEFT);
+        x += lv_font_get_glyph_width(dsc.font, txt[i], txt[i + 1]) + dsc.letter_space;
+    }
+
+    lv_test_assert_true(memcmp(buf_line, buf_letters, sizeof(buf_line)) == 0, "Same pixels as drawn one by one");
+
+    lv_obj_del(canvas_line);
+    lv_obj_del(canvas_letters);
+#endif
+}
+
 #endif